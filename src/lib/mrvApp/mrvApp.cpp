@@ -2095,6 +2095,7 @@ namespace mrv
             string::Format("{0}").arg(fastYUV420PConversion);
         out["FFmpeg/ThreadCount"] = string::Format("{0}").arg(
             p.settings->getValue<int>("Performance/FFmpegThreadCount"));
+        out["FFmpeg/KeyframeIndexDir"] = cachepath() + "ffmpeg_index";
 
         TimelineClass* c = ui->uiTimeWindow;
         int idx = c->uiAudioTracks->current_track();
@@ -2570,6 +2571,7 @@ namespace mrv
         timeline::PlayerCacheOptions options;
         options.readAhead = _cacheReadAhead();
         options.readBehind = _cacheReadBehind();
+        options.adaptive = p.settings->getValue<bool>("Cache/Adaptive");
 
         const auto& info = p.player->ioInfo();
 
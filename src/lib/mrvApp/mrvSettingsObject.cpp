@@ -122,6 +122,9 @@
              timeline::PlayerCacheOptions().readAhead.value();
          p.defaultValues["Cache/ReadBehind"] =
              timeline::PlayerCacheOptions().readBehind.value();
+         p.defaultValues["Cache/Adaptive"] =
+             timeline::PlayerCacheOptions().adaptive;
+         p.defaultValues["Cache/ThumbnailDiskCache"] = false;
          p.defaultValues["FileSequence/Audio"] =
              static_cast<int>(timeline::FileSequenceAudio::BaseName);
          p.defaultValues["FileSequence/AudioFileName"] = std::string();
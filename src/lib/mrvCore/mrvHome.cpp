@@ -182,6 +182,34 @@ namespace mrv
         return prefs;
     }
 
+    std::string cachepath()
+    {
+        std::string path;
+        char* e = nullptr;
+#ifdef _WIN32
+        if ((e = fl_getenv("LOCALAPPDATA")))
+        {
+            path = string::normalizePath(e);
+        }
+#elif defined(__APPLE__)
+        path = mrv::homepath() + "/Library/Caches";
+#else
+        // The XDG base directory specification ignores relative paths.
+        if ((e = fl_getenv("XDG_CACHE_HOME")) && '/' == e[0])
+        {
+            path = e;
+        }
+        else
+        {
+            path = mrv::homepath() + "/.cache";
+        }
+#endif
+        if (path.empty())
+            path = tmppath();
+        path += "/filmaura/";
+        return path;
+    }
+
     std::string pythonpath()
     {
         std::string path = mrv::rootpath();
@@ -39,6 +39,11 @@ namespace mrv
     //! Path to preference's directory (with a trailing slash)
     std::string prefspath();
 
+    //! Path to the user's cache directory (with a trailing slash).  This
+    //! is $XDG_CACHE_HOME (or ~/.cache) on Linux, ~/Library/Caches on macOS
+    //! and %LOCALAPPDATA% on Windows.
+    std::string cachepath();
+
     //! Path to the built-in python script demos
     std::string pythonpath();
 
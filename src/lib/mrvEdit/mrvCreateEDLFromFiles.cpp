@@ -112,6 +112,7 @@ namespace mrv
                     tl::file::ListOptions listOptions;
                     listOptions.sequenceExtensions = { path.getExtension() };
                     listOptions.maxNumberDigits = options.pathOptions.seqMaxDigits;
+                    listOptions.stat = false;
                     tl::file::list(path.getDirectory(), list, listOptions);
                     const auto i = std::find_if(
                         list.begin(),
@@ -5,6 +5,7 @@
 #include "mrViewer.h"
 
 #include "mrvEdit/mrvEditCallbacks.h"
+#include "mrvEdit/mrvEditUndo.h"
 #include "mrvEdit/mrvEditUtil.h"
 
 #include "mrvUI/mrvDesktop.h"
@@ -85,16 +86,52 @@ namespace mrv
         //! (Audio and Video for example).
         static std::vector<FrameInfo> copiedFrames;
 
-        //! Undo/Redo queue element
-        struct UndoRedo
+        //! Undo/Redo history.
+        static UndoHistory undoHistory;
+
+        //! Timeline with the undo state it is equal to.
+        struct UndoTimeline
         {
-            std::string json;
-            std::string fileName;
-            std::vector<std::shared_ptr<draw::Annotation>> annotations;
+            std::shared_ptr<UndoState> state;
+            otio::SerializableObject::Retainer<otio::Timeline> timeline;
         };
 
-        static std::vector<UndoRedo> undoBuffer;
-        static std::vector<UndoRedo> redoBuffer;
+        //! The timeline last written to the EDL file. Until it is changed its
+        //! state is stored again instead of writing the timeline to JSON.
+        static UndoTimeline currentUndoTimeline;
+
+        //! The timelines replaced by the last redo and undo. They are not
+        //! edited anymore, so undoing or redoing back to them does not need
+        //! to parse the JSON.
+        static UndoTimeline undoTimeline;
+        static UndoTimeline redoTimeline;
+
+        //! Write a timeline to JSON for the undo history.
+        std::shared_ptr<UndoState> createUndoState(
+            const otio::Timeline* timeline)
+        {
+            // The JSON is written without indentation, which makes it
+            // smaller to keep in the history.
+            otio::ErrorStatus errorStatus;
+            return undoHistory.createState(
+                timeline->to_json_string(&errorStatus, nullptr, 0));
+        }
+
+        //! Get the undo state of a timeline.
+        std::shared_ptr<UndoState> getUndoState(const otio::Timeline* timeline)
+        {
+            std::shared_ptr<UndoState> out;
+            if (currentUndoTimeline.state &&
+                currentUndoTimeline.timeline.value == timeline)
+            {
+                out = currentUndoTimeline.state;
+            }
+            else
+            {
+                out = createUndoState(timeline);
+            }
+            return out;
+        }
 
         std::vector<Composition*> getTracks(otio::Timeline* timeline)
         {
@@ -141,6 +178,24 @@ namespace mrv
             return timeline;
         }
 
+        //! Get the timeline of a state taken from the history.
+        otio::SerializableObject::Retainer<otio::Timeline> getUndoTimeline(
+            const std::shared_ptr<UndoState>& state, UndoTimeline& replaced)
+        {
+            otio::SerializableObject::Retainer<otio::Timeline> out;
+            if (replaced.state == state)
+            {
+                out = replaced.timeline;
+            }
+            else
+            {
+                out = otio::SerializableObject::Retainer<otio::Timeline>(
+                    createTimelineFromString(state->getJSON()));
+            }
+            replaced = UndoTimeline();
+            return out;
+        }
+
         int getIndex(const otio::Composable* composable)
         {
             auto parent = composable->parent();
@@ -150,6 +205,8 @@ namespace mrv
         void updateTimeline(
             otio::Timeline* timeline, const RationalTime& time, ViewerUI* ui)
         {
+            currentUndoTimeline = UndoTimeline();
+
             auto player = ui->uiView->getTimelinePlayer();
             timeline->set_global_start_time(std::nullopt);
             player->setTimeline(timeline);
@@ -287,6 +344,7 @@ namespace mrv
                 {
                     urlPath = timeline::getPath(media, directory, options);
                     ref->set_target_url(urlPath.get());
+                    currentUndoTimeline = UndoTimeline();
                 }
             }
             else if (auto ref = dynamic_cast<otio::ImageSequenceReference*>(media))
@@ -296,6 +354,7 @@ namespace mrv
                 {
                     urlPath = timeline::getPath(media, directory, options);
                     ref->set_target_url_base(urlPath.getDirectory());
+                    currentUndoTimeline = UndoTimeline();
                 }
             }
         }
@@ -483,8 +542,16 @@ namespace mrv
             return out;
         }
 
-        void toOtioFile(const otio::Timeline* timeline, ViewerUI* ui)
+        //! Write a timeline to the EDL file. The state is the JSON of the
+        //! timeline when it is already known.
+        void toOtioFile(
+            const otio::Timeline* timeline, ViewerUI* ui,
+            std::shared_ptr<UndoState> state = nullptr)
         {
+            // The timeline is written out after it is changed.
+            if (currentUndoTimeline.timeline.value == timeline)
+                currentUndoTimeline = UndoTimeline();
+
             auto model = ui->app->filesModel();
             int index = model->observeAIndex()->get();
             if (index < 0)
@@ -511,7 +578,16 @@ namespace mrv
 
             bool refreshCache = hasEmptyTracks(stack);
 
-            timeline->to_json_file(otioFile);
+            // The JSON is kept, so that storing the next undo state does
+            // not have to write the timeline again.
+            if (!state)
+                state = createUndoState(timeline);
+            std::ofstream ofs(otioFile);
+            ofs << state->getJSON();
+            ofs.close();
+            currentUndoTimeline.state = state;
+            currentUndoTimeline.timeline =
+                const_cast<otio::Timeline*>(timeline);
             destItem->path = file::Path(otioFile);
 
             if (refreshCache)
@@ -796,42 +872,46 @@ namespace mrv
 
         makePathsAbsolute(timeline, ui);
 
-        const std::string state = timeline->to_json_string();
-        if (!undoBuffer.empty())
+        auto state = getUndoState(timeline);
+
+        // The timeline is edited after its state is stored.
+        currentUndoTimeline = UndoTimeline();
+
+        if (auto last = undoHistory.getUndo())
         {
             // Don't store anything if no change.
-            if (undoBuffer.back().json == state)
+            if (last->isTimelineEqual(*state))
             {
                 return;
             }
         }
 
-        toOtioFile(timeline, ui);
-        UndoRedo buffer;
-        buffer.json = state;
-        buffer.fileName = getEDLName(ui);
+        toOtioFile(timeline, ui, state);
+        currentUndoTimeline = UndoTimeline();
+        state->fileName = getEDLName(ui);
 
         player = ui->uiView->getTimelinePlayer();
-        buffer.annotations = player->getAllAnnotations();
-        undoBuffer.push_back(buffer);
+        state->annotations = player->getAllAnnotations();
+        undoHistory.pushUndo(state);
 
         ui->uiUndoEdit->activate();
     }
 
     void edit_clear_redo(ViewerUI* ui)
     {
-        redoBuffer.clear();
+        undoHistory.clearRedo();
+        redoTimeline = UndoTimeline();
         ui->uiRedoEdit->deactivate();
     }
 
     bool edit_has_undo()
     {
-        return !undoBuffer.empty();
+        return undoHistory.hasUndo();
     }
 
     bool edit_has_redo()
     {
-        return !redoBuffer.empty();
+        return undoHistory.hasRedo();
     }
 
     void edit_store_redo(TimelinePlayer* player, ViewerUI* ui)
@@ -840,23 +920,26 @@ namespace mrv
         if (!timeline)
             return;
         auto view = ui->uiView;
-        const std::string state = timeline->to_json_string();
-        if (!redoBuffer.empty())
+        auto state = getUndoState(timeline);
+
+        // The timeline is edited after its state is stored.
+        currentUndoTimeline = UndoTimeline();
+
+        if (auto last = undoHistory.getRedo())
         {
             // Don't store anything if no change.
-            if (redoBuffer.back().json == state)
+            if (last->isTimelineEqual(*state))
             {
                 return;
             }
         }
 
-        toOtioFile(timeline, ui);
-        UndoRedo buffer;
-        buffer.json = state;
-        buffer.fileName = getEDLName(ui);
+        toOtioFile(timeline, ui, state);
+        currentUndoTimeline = UndoTimeline();
+        state->fileName = getEDLName(ui);
         player = ui->uiView->getTimelinePlayer();
-        buffer.annotations = player->getAllAnnotations();
-        redoBuffer.push_back(buffer);
+        state->annotations = player->getAllAnnotations();
+        undoHistory.pushRedo(state);
         ui->uiRedoEdit->activate();
     }
 
@@ -1183,7 +1266,7 @@ namespace mrv
         // If we sliced on the start or end of all clips, we don't need to
         // store the undo.
         if (remove_undo)
-            undoBuffer.pop_back();
+            undoHistory.popUndo();
 
         edit_clear_redo(ui);
 
@@ -2168,35 +2251,38 @@ namespace mrv
         if (!player)
             return;
 
-        if (undoBuffer.empty())
+        if (!undoHistory.hasUndo())
             return;
 
         tcp->pushMessage("Edit/Undo", 0);
 
-        auto buffer = undoBuffer.back();
-        undoBuffer.pop_back();
-        if (undoBuffer.empty())
+        auto buffer = undoHistory.popUndo();
+        if (!undoHistory.hasUndo())
             ui->uiUndoEdit->deactivate();
 
-        if (!switchToEDL(buffer.fileName, ui))
+        if (!switchToEDL(buffer->fileName, ui))
             return;
 
         // We must get player again, as we might have changed clips.
         player = ui->uiView->getTimelinePlayer();
         edit_store_redo(player, ui);
 
-        const auto otioTimeline = createTimelineFromString(buffer.json);
-        if (!otioTimeline)
-            return;
+        // The timeline is replaced below, keep it for the redo.
+        if (player->getTimeline())
+        {
+            redoTimeline.state = undoHistory.getRedo();
+            redoTimeline.timeline = player->getTimeline();
+        }
 
-        otio::SerializableObject::Retainer<otio::Timeline> timeline(
-            otioTimeline);
+        auto timeline = getUndoTimeline(buffer, undoTimeline);
+        if (!timeline.value)
+            return;
 
         TimeRange timeRange;
         double videoRate = 0.F, sampleRate = 0.F;
         sanitizeVideoAndAudioRates(timeline, timeRange, videoRate, sampleRate);
 
-        player->setAllAnnotations(buffer.annotations);
+        player->setAllAnnotations(buffer->annotations);
         updateTimeline(timeline, player->currentTime(), ui);
 
         toOtioFile(timeline, ui);
@@ -2210,38 +2296,41 @@ namespace mrv
         if (!player)
             return;
 
-        if (redoBuffer.empty())
+        if (!undoHistory.hasRedo())
             return;
 
         tcp->pushMessage("Edit/Redo", 0);
 
-        auto buffer = redoBuffer.back();
-        redoBuffer.pop_back();
-        if (redoBuffer.empty())
+        auto buffer = undoHistory.popRedo();
+        if (!undoHistory.hasRedo())
             ui->uiRedoEdit->deactivate();
 
-        if (!switchToEDL(buffer.fileName, ui))
+        if (!switchToEDL(buffer->fileName, ui))
             return;
 
         // We must get player again, as we might have changed clips.
         player = ui->uiView->getTimelinePlayer();
         edit_store_undo(player, ui);
 
+        // The timeline is replaced below, keep it for the undo.
+        if (player->getTimeline())
+        {
+            undoTimeline.state = undoHistory.getUndo();
+            undoTimeline.timeline = player->getTimeline();
+        }
+
         auto stack = player->getTimeline()->tracks();
         const bool refreshCache = hasEmptyTracks(stack);
 
-        const auto otioTimeline = createTimelineFromString(buffer.json);
-        if (!otioTimeline)
+        auto timeline = getUndoTimeline(buffer, redoTimeline);
+        if (!timeline.value)
             return;
 
-        otio::SerializableObject::Retainer<otio::Timeline> timeline(
-            otioTimeline);
-
         TimeRange timeRange;
         double videoRate = 0.F, sampleRate = 0.F;
         sanitizeVideoAndAudioRates(timeline, timeRange, videoRate, sampleRate);
 
-        player->setAllAnnotations(buffer.annotations);
+        player->setAllAnnotations(buffer->annotations);
         updateTimeline(timeline, player->currentTime(), ui);
 
         toOtioFile(timeline, ui);
@@ -2388,12 +2477,16 @@ namespace mrv
         otio::Timeline* timeline, const std::string& otioFile,
         bool makeRelativePaths)
     {
-        const std::string& s = timeline->to_json_string();
-        const auto otioTimeline = createTimelineFromString(s);
-        if (!otioTimeline)
+        otio::SerializableObject::Retainer<otio::Timeline> out;
+        try
+        {
+            out = tl::timeline::copy(timeline);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR(e.what());
             return;
-
-        otio::SerializableObject::Retainer<otio::Timeline> out(otioTimeline);
+        }
         makePathsAbsolute(out, App::ui);
         auto stack = out->tracks();
         if (makeRelativePaths)
@@ -2843,13 +2936,16 @@ namespace mrv
 
         // Make a copy of the timeline, so we don't modify the original in
         // place.
-        const std::string& s = timeline->to_json_string();
-        const auto otioTimeline = createTimelineFromString(s);
-        if (!otioTimeline)
+        otio::SerializableObject::Retainer<otio::Timeline> sourceTimeline;
+        try
+        {
+            sourceTimeline = tl::timeline::copy(timeline);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR(e.what());
             return;
-
-        otio::SerializableObject::Retainer<otio::Timeline> sourceTimeline(
-            otioTimeline);
+        }
 
         makePathsAbsolute(sourceTimeline, ui);
 
@@ -0,0 +1,396 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include "mrvEdit/mrvEditUndo.h"
+
+namespace mrv
+{
+    namespace
+    {
+        const size_t npos = std::string::npos;
+
+        size_t skipSpace(const std::string& s, size_t i)
+        {
+            while (i < s.size() && (' ' == s[i] || '\t' == s[i] ||
+                                    '\n' == s[i] || '\r' == s[i]))
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        //! Skip a string, returning the index past the closing quote.
+        size_t skipString(const std::string& s, size_t i)
+        {
+            for (++i; i < s.size(); ++i)
+            {
+                if ('\\' == s[i])
+                {
+                    ++i;
+                }
+                else if ('"' == s[i])
+                {
+                    return i + 1;
+                }
+            }
+            return npos;
+        }
+
+        //! Skip a value, returning the index past it.
+        size_t skipValue(const std::string& s, size_t i)
+        {
+            if (i >= s.size())
+                return npos;
+            switch (s[i])
+            {
+            case '"':
+                return skipString(s, i);
+            case '{':
+            case '[':
+            {
+                size_t depth = 0;
+                while (i < s.size())
+                {
+                    switch (s[i])
+                    {
+                    case '"':
+                        i = skipString(s, i);
+                        if (npos == i)
+                            return npos;
+                        continue;
+                    case '{':
+                    case '[':
+                        ++depth;
+                        break;
+                    case '}':
+                    case ']':
+                        if (0 == --depth)
+                            return i + 1;
+                        break;
+                    default:
+                        break;
+                    }
+                    ++i;
+                }
+                return npos;
+            }
+            default:
+                while (i < s.size() && ',' != s[i] && '}' != s[i] &&
+                       ']' != s[i] && ' ' != s[i] && '\t' != s[i] &&
+                       '\n' != s[i] && '\r' != s[i])
+                {
+                    ++i;
+                }
+                return i;
+            }
+        }
+
+        //! Find the value of a member of the object that starts at the
+        //! given index.
+        size_t findMember(const std::string& s, size_t i, std::string_view key)
+        {
+            if (i >= s.size() || s[i] != '{')
+                return npos;
+            ++i;
+            while (true)
+            {
+                i = skipSpace(s, i);
+                if (i >= s.size() || s[i] != '"')
+                    return npos;
+                const size_t keyEnd = skipString(s, i);
+                if (npos == keyEnd)
+                    return npos;
+                const std::string_view memberKey(
+                    s.data() + i + 1, keyEnd - i - 2);
+                i = skipSpace(s, keyEnd);
+                if (i >= s.size() || s[i] != ':')
+                    return npos;
+                i = skipSpace(s, i + 1);
+                if (memberKey == key)
+                    return i;
+                i = skipSpace(s, skipValue(s, i));
+                if (i >= s.size() || s[i] != ',')
+                    return npos;
+                ++i;
+            }
+        }
+
+        //! Split the JSON of a timeline at the items of each track. The text
+        //! around the items is returned in shell and the items of each
+        //! track in items.
+        bool split(
+            const std::string& s, std::vector<std::string_view>& shell,
+            std::vector<std::vector<std::string_view> >& items)
+        {
+            const size_t stack = findMember(s, skipSpace(s, 0), "tracks");
+            const size_t tracks = findMember(s, stack, "children");
+            if (npos == tracks || s[tracks] != '[')
+                return false;
+
+            size_t pos = 0;
+            size_t i = tracks + 1;
+            while (true)
+            {
+                i = skipSpace(s, i);
+                if (i >= s.size())
+                    return false;
+                if (']' == s[i])
+                    break;
+                const size_t track = i;
+                const size_t children = findMember(s, track, "children");
+                if (children != npos && '[' == s[children])
+                {
+                    shell.push_back(
+                        std::string_view(s.data() + pos, children + 1 - pos));
+                    items.push_back(std::vector<std::string_view>());
+                    size_t j = children + 1;
+                    while (true)
+                    {
+                        j = skipSpace(s, j);
+                        if (j >= s.size())
+                            return false;
+                        if (']' == s[j])
+                            break;
+                        const size_t end = skipValue(s, j);
+                        if (npos == end)
+                            return false;
+                        items.back().push_back(
+                            std::string_view(s.data() + j, end - j));
+                        j = skipSpace(s, end);
+                        if (j < s.size() && ',' == s[j])
+                            ++j;
+                        else if (j >= s.size() || s[j] != ']')
+                            return false;
+                    }
+                    pos = j;
+                }
+                i = skipSpace(s, skipValue(s, track));
+                if (i >= s.size())
+                    return false;
+                if (',' == s[i])
+                    ++i;
+            }
+            shell.push_back(std::string_view(s.data() + pos, s.size() - pos));
+            return true;
+        }
+    } // namespace
+
+    std::string UndoState::getJSON() const
+    {
+        size_t size = 0;
+        for (const auto& i : shell)
+            size += i->size();
+        for (const auto& i : items)
+        {
+            for (const auto& j : i)
+                size += j->size() + 1;
+        }
+        std::string out;
+        out.reserve(size);
+        for (size_t i = 0; i < shell.size(); ++i)
+        {
+            out += *shell[i];
+            if (i < items.size())
+            {
+                for (size_t j = 0; j < items[i].size(); ++j)
+                {
+                    if (j > 0)
+                        out += ',';
+                    out += *items[i][j];
+                }
+            }
+        }
+        return out;
+    }
+
+    bool UndoState::isTimelineEqual(const UndoState& other) const
+    {
+        // The text is shared between the states, so comparing the pointers
+        // compares the text.
+        return shell == other.shell && items == other.items;
+    }
+
+    UndoHistory::UndoHistory() :
+        _text(std::make_shared<TextTable>())
+    {
+    }
+
+    UndoHistory::~UndoHistory()
+    {
+        _undo.clear();
+        _redo.clear();
+    }
+
+    size_t UndoHistory::getMax() const
+    {
+        return _max;
+    }
+
+    void UndoHistory::setMax(size_t value)
+    {
+        _max = value;
+        _evict();
+    }
+
+    size_t UndoHistory::getByteCount() const
+    {
+        return _text->byteCount + _stateByteCount;
+    }
+
+    std::shared_ptr<UndoState>
+    UndoHistory::createState(const std::string& json)
+    {
+        auto out = std::make_shared<UndoState>();
+        std::vector<std::string_view> shell;
+        std::vector<std::vector<std::string_view> > items;
+        if (!split(json, shell, items))
+        {
+            shell = {json};
+            items.clear();
+        }
+        for (const auto& i : shell)
+        {
+            out->shell.push_back(_getText(i));
+        }
+        for (const auto& i : items)
+        {
+            out->items.push_back(
+                std::vector<std::shared_ptr<const std::string> >());
+            out->items.back().reserve(i.size());
+            for (const auto& j : i)
+            {
+                out->items.back().push_back(_getText(j));
+            }
+        }
+        return out;
+    }
+
+    bool UndoHistory::hasUndo() const
+    {
+        return !_undo.empty();
+    }
+
+    std::shared_ptr<UndoState> UndoHistory::getUndo() const
+    {
+        return !_undo.empty() ? _undo.back() : nullptr;
+    }
+
+    void UndoHistory::pushUndo(const std::shared_ptr<UndoState>& value)
+    {
+        _undo.push_back(value);
+        _stateByteCount += _getStateByteCount(*value);
+        _evict();
+    }
+
+    std::shared_ptr<UndoState> UndoHistory::popUndo()
+    {
+        std::shared_ptr<UndoState> out;
+        if (!_undo.empty())
+        {
+            out = _undo.back();
+            _undo.pop_back();
+            _stateByteCount -= _getStateByteCount(*out);
+        }
+        return out;
+    }
+
+    bool UndoHistory::hasRedo() const
+    {
+        return !_redo.empty();
+    }
+
+    std::shared_ptr<UndoState> UndoHistory::getRedo() const
+    {
+        return !_redo.empty() ? _redo.back() : nullptr;
+    }
+
+    void UndoHistory::pushRedo(const std::shared_ptr<UndoState>& value)
+    {
+        _redo.push_back(value);
+        _stateByteCount += _getStateByteCount(*value);
+        _evict();
+    }
+
+    std::shared_ptr<UndoState> UndoHistory::popRedo()
+    {
+        std::shared_ptr<UndoState> out;
+        if (!_redo.empty())
+        {
+            out = _redo.back();
+            _redo.pop_back();
+            _stateByteCount -= _getStateByteCount(*out);
+        }
+        return out;
+    }
+
+    void UndoHistory::clearRedo()
+    {
+        for (const auto& i : _redo)
+        {
+            _stateByteCount -= _getStateByteCount(*i);
+        }
+        _redo.clear();
+    }
+
+    std::shared_ptr<const std::string>
+    UndoHistory::_getText(std::string_view value)
+    {
+        auto& table = *_text;
+        const auto i = table.text.find(value);
+        if (i != table.text.end())
+        {
+            if (auto out = i->second.lock())
+            {
+                return out;
+            }
+            table.text.erase(i);
+        }
+        auto text = new std::string(value);
+        std::shared_ptr<const std::string> out(
+            text,
+            [weak = std::weak_ptr<TextTable>(_text)](
+                const std::string* value)
+            {
+                if (auto table = weak.lock())
+                {
+                    const auto i = table->text.find(std::string_view(*value));
+                    if (i != table->text.end() &&
+                        i->first.data() == value->data())
+                    {
+                        table->text.erase(i);
+                    }
+                    table->byteCount -= value->size();
+                }
+                delete value;
+            });
+        table.text[std::string_view(*text)] = out;
+        table.byteCount += text->size();
+        return out;
+    }
+
+    size_t UndoHistory::_getStateByteCount(const UndoState& value) const
+    {
+        size_t out = sizeof(UndoState) + value.fileName.size() +
+                     value.shell.size() * sizeof(value.shell[0]);
+        for (const auto& i : value.items)
+        {
+            out += sizeof(i) + i.size() * sizeof(value.shell[0]);
+        }
+        return out;
+    }
+
+    void UndoHistory::_evict()
+    {
+        while (getByteCount() > _max && _undo.size() > 1)
+        {
+            _stateByteCount -= _getStateByteCount(*_undo.front());
+            _undo.pop_front();
+        }
+        while (getByteCount() > _max && _redo.size() > 1)
+        {
+            _stateByteCount -= _getStateByteCount(*_redo.front());
+            _redo.pop_front();
+        }
+    }
+} // namespace mrv
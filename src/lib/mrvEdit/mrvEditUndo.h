@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tl
+{
+    namespace draw
+    {
+        class Annotation;
+    }
+} // namespace tl
+
+namespace mrv
+{
+    //! Timeline state stored in the undo/redo history.
+    //!
+    //! The JSON of the timeline is split at the items of each track (clips,
+    //! gaps, transitions, etc.). The text around the items is kept in
+    //! shell, with one more entry than there are tracks, and the text of
+    //! the items of each track in items.
+    struct UndoState
+    {
+        std::vector<std::shared_ptr<const std::string> > shell;
+        std::vector<std::vector<std::shared_ptr<const std::string> > > items;
+
+        std::string fileName;
+        std::vector<std::shared_ptr<tl::draw::Annotation> > annotations;
+
+        //! Get the JSON of the timeline.
+        std::string getJSON() const;
+
+        //! Get whether the timeline is the same as in another state. The
+        //! file name and annotations are not compared.
+        bool isTimelineEqual(const UndoState&) const;
+    };
+
+    //! Undo/redo history of timeline edits.
+    //!
+    //! Text that is the same in more than one state is stored once and
+    //! shared, so an edit only adds the items it changed to the history
+    //! instead of a copy of the whole timeline. The oldest states are
+    //! discarded when the memory used by the history exceeds the maximum.
+    class UndoHistory
+    {
+    public:
+        UndoHistory();
+        ~UndoHistory();
+
+        //! Get the maximum memory used by the history in bytes.
+        size_t getMax() const;
+
+        //! Set the maximum memory used by the history in bytes. The last
+        //! undo and redo states are always kept.
+        void setMax(size_t);
+
+        //! Get the memory used by the history in bytes.
+        size_t getByteCount() const;
+
+        //! Create a state from the JSON of a timeline. If the JSON cannot be
+        //! split the whole text is stored.
+        std::shared_ptr<UndoState> createState(const std::string& json);
+
+        //! \name Undo
+        ///@{
+
+        bool hasUndo() const;
+        std::shared_ptr<UndoState> getUndo() const;
+        void pushUndo(const std::shared_ptr<UndoState>&);
+        std::shared_ptr<UndoState> popUndo();
+
+        ///@}
+
+        //! \name Redo
+        ///@{
+
+        bool hasRedo() const;
+        std::shared_ptr<UndoState> getRedo() const;
+        void pushRedo(const std::shared_ptr<UndoState>&);
+        std::shared_ptr<UndoState> popRedo();
+        void clearRedo();
+
+        ///@}
+
+    private:
+        std::shared_ptr<const std::string> _getText(std::string_view);
+        size_t _getStateByteCount(const UndoState&) const;
+        void _evict();
+
+        size_t _max = 256 * 1024 * 1024;
+        size_t _stateByteCount = 0;
+
+        // The text shared by the states. The keys view the text they map
+        // to, and are removed when the last state using the text is
+        // destroyed. The text only holds a weak reference to the table, so
+        // states may outlive the history.
+        struct TextTable
+        {
+            std::unordered_map<
+                std::string_view, std::weak_ptr<const std::string> >
+                text;
+            size_t byteCount = 0;
+        };
+        std::shared_ptr<TextTable> _text;
+
+        std::deque<std::shared_ptr<UndoState> > _undo;
+        std::deque<std::shared_ptr<UndoState> > _redo;
+    };
+} // namespace mrv
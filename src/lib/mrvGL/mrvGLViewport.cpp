@@ -123,6 +123,7 @@ namespace mrv
             if (auto context = gl.context.lock())
             {
                 gl.render = timeline_gl::Render::create(context);
+                gl.render->setOCIOPrebuild(true);
                 p.fontSystem = image::FontSystem::create(context);
 
                 gl.lines = std::make_shared<opengl::Lines>();
@@ -765,8 +766,9 @@ namespace mrv
 
                         if (panel::colorAreaPanel)
                         {
-                            _calculateColorArea(p.colorAreaInfo);
-                            panel::colorAreaPanel->update(p.colorAreaInfo);
+                            if (_calculateColorArea(p.colorAreaInfo))
+                                panel::colorAreaPanel->update(
+                                    p.colorAreaInfo);
                         }
                         if (panel::histogramPanel)
                         {
@@ -1016,131 +1018,44 @@ namespace mrv
 #endif
         }
 
-        void Viewport::_calculateColorAreaFullValues(area::Info& info) noexcept
+        bool Viewport::_calculateColorAreaFullValues(
+            area::Info& info) noexcept
         {
             TLRENDER_P();
-            MRV2_GL();
             if (!p.image)
-                return;
+                return false;
 
             PixelToolBarClass* c = p.ui->uiPixelWindow;
-            BrightnessType brightness_type = (BrightnessType)c->uiLType->value();
-            int hsv_colorspace = c->uiBColorType->value() + 1;
-
-            const auto& renderSize = gl.buffer->getSize();
-
-            const uint32_t W = info.box.w();
-            const uint32_t H = info.box.h();
-
-            const uint8_t* ptr = reinterpret_cast<const uint8_t*>(p.image);
-
-            const int channelCount = image::getChannelCount(info.pixelType);
-            const int byteCount = image::getBitDepth(info.pixelType) / 8;
-
-            const size_t dataSize = W * H;
-
-            image::Color4f rgba, hsv;
-
-            for (size_t i = 0; i < dataSize; ++i)
-            {
-                rgba = color::fromVoidPtr(ptr, info.pixelType);
-                std::swap(rgba.r, rgba.b);
-
-                info.rgba.mean.r += rgba.r;
-                info.rgba.mean.g += rgba.g;
-                info.rgba.mean.b += rgba.b;
-                info.rgba.mean.a += rgba.a;
-
-                if (rgba.r < info.rgba.min.r)
-                    info.rgba.min.r = rgba.r;
-                if (rgba.g < info.rgba.min.g)
-                    info.rgba.min.g = rgba.g;
-                if (rgba.b < info.rgba.min.b)
-                    info.rgba.min.b = rgba.b;
-                if (rgba.a < info.rgba.min.a)
-                    info.rgba.min.a = rgba.a;
-
-                if (rgba.r > info.rgba.max.r)
-                    info.rgba.max.r = rgba.r;
-                if (rgba.g > info.rgba.max.g)
-                    info.rgba.max.g = rgba.g;
-                if (rgba.b > info.rgba.max.b)
-                    info.rgba.max.b = rgba.b;
-                if (rgba.a > info.rgba.max.a)
-                    info.rgba.max.a = rgba.a;
-
-                hsv = rgba_to_hsv(hsv_colorspace, rgba);
-                hsv.a = calculate_brightness(rgba, brightness_type);
-                hsv_to_info(hsv, info);
-
-                ptr += channelCount * byteCount;
-            }
-
-            int num = info.box.w() * info.box.h();
-            info.rgba.mean.r /= num;
-            info.rgba.mean.g /= num;
-            info.rgba.mean.b /= num;
-            info.rgba.mean.a /= num;
-
-            info.rgba.diff.r = info.rgba.max.r - info.rgba.min.r;
-            info.rgba.diff.g = info.rgba.max.g - info.rgba.min.g;
-            info.rgba.diff.b = info.rgba.max.b - info.rgba.min.b;
-            info.rgba.diff.a = info.rgba.max.a - info.rgba.min.a;
-
-            info.hsv.mean.r /= num;
-            info.hsv.mean.g /= num;
-            info.hsv.mean.b /= num;
-            info.hsv.mean.a /= num;
-
-            info.hsv.diff.r = info.hsv.max.r - info.hsv.min.r;
-            info.hsv.diff.g = info.hsv.max.g - info.hsv.min.g;
-            info.hsv.diff.b = info.hsv.max.b - info.hsv.min.b;
-            info.hsv.diff.a = info.hsv.max.a - info.hsv.min.a;
+            area::StatsOptions options;
+            options.colorSpace = c->uiBColorType->value() + 1;
+            options.brightnessType = (BrightnessType)c->uiLType->value();
+
+            // OpenGL reads the pixels back as BGRA.
+            area::BufferOptions bufferOptions;
+            bufferOptions.pixelType = info.pixelType;
+            bufferOptions.swapRB = true;
+
+            return p.colorAreaStats->request(
+                info, reinterpret_cast<const uint8_t*>(p.image), bufferOptions,
+                options);
         }
 
-        void Viewport::_calculateColorArea(area::Info& info)
+        bool Viewport::_calculateColorArea(area::Info& info)
         {
             TLRENDER_P();
             MRV2_GL();
 
             if (!p.image || !gl.buffer)
-                return;
-
-            info.rgba.max.r = std::numeric_limits<float>::min();
-            info.rgba.max.g = std::numeric_limits<float>::min();
-            info.rgba.max.b = std::numeric_limits<float>::min();
-            info.rgba.max.a = std::numeric_limits<float>::min();
-
-            info.rgba.min.r = std::numeric_limits<float>::max();
-            info.rgba.min.g = std::numeric_limits<float>::max();
-            info.rgba.min.b = std::numeric_limits<float>::max();
-            info.rgba.min.a = std::numeric_limits<float>::max();
-
-            info.rgba.mean.r = info.rgba.mean.g = info.rgba.mean.b =
-            info.rgba.mean.a = 0.F;
-
-            info.hsv.max.r = std::numeric_limits<float>::min();
-            info.hsv.max.g = std::numeric_limits<float>::min();
-            info.hsv.max.b = std::numeric_limits<float>::min();
-            info.hsv.max.a = std::numeric_limits<float>::min();
-
-            info.hsv.min.r = std::numeric_limits<float>::max();
-            info.hsv.min.g = std::numeric_limits<float>::max();
-            info.hsv.min.b = std::numeric_limits<float>::max();
-            info.hsv.min.a = std::numeric_limits<float>::max();
-
-            info.hsv.mean.r = info.hsv.mean.g = info.hsv.mean.b = info.hsv.mean.a =
-                              0.F;
+                return false;
 
             switch(p.ui->uiPixelWindow->uiPixelValue->value())
             {
             case PixelValue::kFull:
             case PixelValue::kLinear:
             case PixelValue::kNits:
-                _calculateColorAreaFullValues(info);
-                break;
+                return _calculateColorAreaFullValues(info);
             default:
-                _calculateColorAreaRawValues(info);
+                return _calculateColorAreaRawValues(info);
             }
         }
 
@@ -1295,7 +1210,7 @@ namespace mrv
                             _getPixelValue(pixel, image, pos);
                         }
 
-                        const auto& imageB = layer.image;
+                        const auto& imageB = layer.imageB;
                         if (imageB && imageB->isValid())
                         {
                             _getPixelValue(pixelB, imageB, pos);
@@ -37,17 +37,451 @@
 #include <FL/Fl.H>
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <thread>
 
+namespace
+{
+    const char* kModule = "save";
 
+    //! Number of pixel pack buffers used to read back frames
+    //! asynchronously.
+    const size_t kReadbackCount = 3;
 
+    //! Maximum number of items waiting to be encoded.
+    const size_t kEncodeQueueMax = 4;
 
+    using namespace tl;
 
-namespace
-{
-    const char* kModule = "save";
-}
+    typedef std::chrono::steady_clock Clock;
+
+    double elapsedMs(const Clock::time_point& t)
+    {
+        const std::chrono::duration<double, std::milli> diff =
+            Clock::now() - t;
+        return diff.count();
+    }
+
+    //! Average time spent in one of the export stages.
+    struct StageTime
+    {
+        double total = 0.0;
+        size_t count = 0;
+
+        void add(double ms)
+        {
+            total += ms;
+            ++count;
+        }
+
+        double average() const { return count > 0 ? total / count : 0.0; }
+    };
+
+    //! Reuses the output images once the encoder is done with them.
+    class ImagePool
+    {
+    public:
+        explicit ImagePool(const image::Info& info) :
+            _info(info)
+        {
+        }
+
+        std::shared_ptr<image::Image> get()
+        {
+            // An image that is only referenced by the pool is no longer
+            // queued for encoding.
+            for (const auto& image : _images)
+            {
+                if (1 == image.use_count())
+                    return image;
+            }
+            auto out = image::Image::create(_info);
+            _images.push_back(out);
+            return out;
+        }
+
+    private:
+        image::Info _info;
+        std::vector<std::shared_ptr<image::Image> > _images;
+    };
+
+    //! Writes the video and audio on a separate thread, so encoding
+    //! overlaps with rendering and reading back the next frames.
+    class MovieEncoder
+    {
+    public:
+        explicit MovieEncoder(const std::shared_ptr<io::IWrite>& writer) :
+            _writer(writer)
+        {
+            _thread = std::thread([this] { _run(); });
+        }
+
+        ~MovieEncoder()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _cv.notify_all();
+            if (_thread.joinable())
+                _thread.join();
+        }
+
+        //! Write a video frame. The tags are set on the image by the
+        //! encoder thread, since the same image may be queued more than
+        //! once when frames are repeated.
+        void writeVideo(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image,
+            const image::Tags& tags)
+        {
+            Item item;
+            item.time = time;
+            item.image = image;
+            item.tags = tags;
+            _push(std::move(item));
+        }
+
+        void writeAudio(
+            const otime::TimeRange& range,
+            const std::shared_ptr<audio::Audio>& audio)
+        {
+            Item item;
+            item.range = range;
+            item.audio = audio;
+            _push(std::move(item));
+        }
+
+        //! Wait for the queued items to be written.
+        void finish()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(
+                lock, [this] { return _queue.empty() && !_busy; });
+            if (!_error.empty())
+                throw std::runtime_error(_error);
+        }
+
+        //! Get the average time to encode a frame in milliseconds.
+        double getEncodeMs() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _encodeTime.average();
+        }
+
+    private:
+        struct Item
+        {
+            otime::RationalTime time = time::invalidTime;
+            std::shared_ptr<image::Image> image;
+            image::Tags tags;
+            otime::TimeRange range = time::invalidTimeRange;
+            std::shared_ptr<audio::Audio> audio;
+        };
+
+        void _push(Item&& item)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(
+                lock,
+                [this]
+                {
+                    return _queue.size() < kEncodeQueueMax ||
+                           !_error.empty();
+                });
+            if (!_error.empty())
+                throw std::runtime_error(_error);
+            _queue.push_back(std::move(item));
+            _cv.notify_all();
+        }
+
+        void _run()
+        {
+            while (true)
+            {
+                Item item;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(
+                        lock, [this] { return !_queue.empty() || _stop; });
+                    if (_queue.empty())
+                        break;
+                    item = std::move(_queue.front());
+                    _queue.pop_front();
+                    _busy = true;
+                    _cv.notify_all();
+                }
+                const auto t = Clock::now();
+                std::string error;
+                try
+                {
+                    if (item.image)
+                    {
+                        item.image->setTags(item.tags);
+                        _writer->writeVideo(item.time, item.image);
+                    }
+                    else if (item.audio)
+                    {
+                        _writer->writeAudio(item.range, item.audio);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                }
+                const double ms = elapsedMs(t);
+                // Release the image before finishing so the pool can
+                // reuse it.
+                item = Item();
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    if (!error.empty())
+                    {
+                        _error = error;
+                        _queue.clear();
+                    }
+                    else
+                    {
+                        _encodeTime.add(ms);
+                    }
+                    _busy = false;
+                }
+                _cv.notify_all();
+            }
+        }
+
+        std::shared_ptr<io::IWrite> _writer;
+        std::deque<Item> _queue;
+        bool _busy = false;
+        bool _stop = false;
+        std::string _error;
+        StageTime _encodeTime;
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        std::thread _thread;
+    };
+
+    //! Reads back rendered frames through a ring of pixel pack buffers, so
+    //! the copy of one frame overlaps rendering the next ones. Audio and
+    //! frames that were read synchronously are queued behind the pending
+    //! read backs, so everything reaches the encoder in order.
+    //!
+    //! OpenGL ES 2 has no pixel pack buffers or fences, so there the frames
+    //! are read synchronously.
+    class ReadbackQueue
+    {
+    public:
+        ReadbackQueue(
+            const image::Info& info, GLenum format, GLenum type,
+            MovieEncoder& encoder) :
+            _info(info),
+            _format(format),
+            _type(type),
+            _encoder(encoder),
+            _pool(info)
+        {
+        }
+
+        ~ReadbackQueue()
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            for (auto& item : _items)
+            {
+                if (item.fence)
+                    glDeleteSync(item.fence);
+            }
+            if (!_buffers.empty())
+            {
+                glDeleteBuffers(_buffers.size(), _buffers.data());
+            }
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        //! Get an image to fill synchronously.
+        std::shared_ptr<image::Image> getImage() { return _pool.get(); }
+
+        //! Start reading back the current framebuffer.
+        void readPixels(
+            const otime::RationalTime& time, bool write,
+            const image::Tags& tags)
+        {
+#if defined(TLRENDER_API_GL_4_1)
+            if (_buffers.empty())
+            {
+                _buffers.resize(kReadbackCount);
+                glGenBuffers(_buffers.size(), _buffers.data());
+                for (auto buffer : _buffers)
+                {
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+                    glBufferData(
+                        GL_PIXEL_PACK_BUFFER, image::getDataByteCount(_info),
+                        nullptr, GL_STREAM_READ);
+                }
+            }
+            flush(kReadbackCount - 1);
+
+            Item item;
+            item.time = time;
+            item.write = write;
+            item.tags = tags;
+            item.buffer = _buffers[_next];
+            _next = (_next + 1) % _buffers.size();
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, item.buffer);
+            glReadPixels(
+                0, 0, _info.size.w, _info.size.h, _format, _type, nullptr);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            item.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            _items.push_back(item);
+            ++_readbacks;
+#else  // TLRENDER_API_GL_4_1
+            const auto t = Clock::now();
+            auto image = _pool.get();
+            glReadPixels(
+                0, 0, _info.size.w, _info.size.h, _format, _type,
+                image->getData());
+            _readbackTime.add(elapsedMs(t));
+            addImage(time, image, write, tags);
+#endif // TLRENDER_API_GL_4_1
+        }
+
+        //! Add an image that was already read.
+        void addImage(
+            const otime::RationalTime& time,
+            const std::shared_ptr<image::Image>& image, bool write,
+            const image::Tags& tags)
+        {
+            Item item;
+            item.time = time;
+            item.image = image;
+            item.write = write;
+            item.tags = tags;
+            _items.push_back(item);
+            flush(kReadbackCount);
+        }
+
+        //! Write the previous frame again.
+        void repeat(
+            const otime::RationalTime& time, bool write,
+            const image::Tags& tags)
+        {
+            Item item;
+            item.time = time;
+            item.repeat = true;
+            item.write = write;
+            item.tags = tags;
+            _items.push_back(item);
+            flush(kReadbackCount);
+        }
+
+        void addAudio(
+            const otime::TimeRange& range,
+            const std::shared_ptr<audio::Audio>& audio)
+        {
+            Item item;
+            item.range = range;
+            item.audio = audio;
+            _items.push_back(item);
+            flush(kReadbackCount);
+        }
+
+        //! Pass the finished items on to the encoder, waiting for the
+        //! oldest read backs while more than the given number are pending.
+        void flush(size_t maxReadbacks = 0)
+        {
+            while (!_items.empty() &&
+                   (!_items.front().buffer || _readbacks > maxReadbacks))
+            {
+                Item item = _items.front();
+                _items.pop_front();
+#if defined(TLRENDER_API_GL_4_1)
+                if (item.buffer)
+                {
+                    const auto t = Clock::now();
+                    glClientWaitSync(
+                        item.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                        GL_TIMEOUT_IGNORED);
+                    glDeleteSync(item.fence);
+                    item.image = _pool.get();
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, item.buffer);
+                    const void* data =
+                        glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+                    if (!data)
+                    {
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                        throw std::runtime_error(
+                            _("Cannot map the pixel pack buffer"));
+                    }
+                    memcpy(
+                        item.image->getData(), data,
+                        item.image->getDataByteCount());
+                    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                    --_readbacks;
+                    _readbackTime.add(elapsedMs(t));
+                }
+                else
+#endif // TLRENDER_API_GL_4_1
+                if (item.repeat)
+                {
+                    item.image = _last;
+                    if (!item.image)
+                    {
+                        item.image = _pool.get();
+                        item.image->zero();
+                    }
+                }
+
+                if (item.image)
+                {
+                    _last = item.image;
+                    if (item.write)
+                    {
+                        _encoder.writeVideo(item.time, item.image, item.tags);
+                    }
+                }
+                else if (item.audio)
+                {
+                    _encoder.writeAudio(item.range, item.audio);
+                }
+            }
+        }
+
+        //! Get the average time waiting for a read back in milliseconds.
+        double getReadbackMs() const { return _readbackTime.average(); }
+
+    private:
+        struct Item
+        {
+            otime::RationalTime time = time::invalidTime;
+            GLuint buffer = 0;
+#if defined(TLRENDER_API_GL_4_1)
+            GLsync fence = nullptr;
+#endif // TLRENDER_API_GL_4_1
+            std::shared_ptr<image::Image> image;
+            bool repeat = false;
+            bool write = false;
+            image::Tags tags;
+            otime::TimeRange range = time::invalidTimeRange;
+            std::shared_ptr<audio::Audio> audio;
+        };
+
+        image::Info _info;
+        GLenum _format = GL_NONE;
+        GLenum _type = GL_NONE;
+        MovieEncoder& _encoder;
+        ImagePool _pool;
+        std::vector<GLuint> _buffers;
+        size_t _next = 0;
+        size_t _readbacks = 0;
+        std::deque<Item> _items;
+        std::shared_ptr<image::Image> _last;
+        StageTime _readbackTime;
+    };
+} // namespace
 
 namespace mrv
 {
@@ -459,7 +893,6 @@ namespace mrv
             image::Info outputInfo;
 
             outputInfo.size = renderSize;
-            std::shared_ptr<image::Image> outputImage;
 
             outputInfo.pixelType = info.video[layerId].pixelType;
 
@@ -624,7 +1057,6 @@ namespace mrv
 #ifdef TLRENDER_EXR
                 ioOptions["OpenEXR/PixelType"] = getLabel(outputInfo.pixelType);
 #endif
-                outputImage = image::Image::create(outputInfo);
                 ioInfo.videoTime = videoTime;
                 ioInfo.video.push_back(outputInfo);
 
@@ -740,6 +1172,13 @@ namespace mrv
                 LOG_STATUS(msg);
             }
 
+            // Encode on a separate thread, and read back the frames
+            // asynchronously, so that rendering, reading back, and encoding
+            // overlap.
+            MovieEncoder encoder(writer);
+            ReadbackQueue readback(outputInfo, format, type, encoder);
+            StageTime renderTime;
+
             // Turn off hud so it does not get captured by glReadPixels.
             view->setHudActive(false);
 
@@ -854,7 +1293,7 @@ namespace mrv
                         {
                             if (!skip)
                             {
-                                writer->writeAudio(range, audio);
+                                readback.addAudio(range, audio);
 
                                 const size_t sampleCount =
                                     audio->getSampleCount();
@@ -867,8 +1306,12 @@ namespace mrv
 
                 if (hasVideo)
                 {
+                    const bool write = videoTime.contains(currentTime);
+                    const auto& tags = ui->uiView->getTags();
+                    const auto renderStart = Clock::now();
                     if (options.annotations)
                     {
+                        auto outputImage = readback.getImage();
                         view->redraw();
                         view->flush();
                         Fl::flush();
@@ -934,6 +1377,8 @@ namespace mrv
 #  endif
                         
 #endif
+                        renderTime.add(elapsedMs(renderStart));
+                        readback.addImage(currentTime, outputImage, write, tags);
                     }
                     else
                     {
@@ -950,6 +1395,7 @@ namespace mrv
                                                  "{0}.  Repeating frame."))
                                     .arg(currentTime);
                             LOG_WARNING(err);
+                            readback.repeat(currentTime, write, tags);
                         }
                         else
                         {
@@ -1013,18 +1459,23 @@ namespace mrv
                             void* imageData = buffer->getLatestReadPixels();
                             if (imageData)
                             {
+                                auto outputImage = readback.getImage();
                                 std::memcpy(outputImage->getData(), imageData,
                                             outputImage->getDataByteCount());
+                                readback.addImage(
+                                    currentTime, outputImage, write, tags);
                                     
                                 vkFreeCommandBuffers(device, commandPool, 1,
                                                      &cmd);    
                             }
                                     
 #else
+#if defined(TLRENDER_API_GL_4_1)
                             // back to conventional pixel operation
                             glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
                             // CHECK_GL;
                             glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif // TLRENDER_API_GL_4_1
 
                             if (interactive)
                                 gl::initGLAD();
@@ -1055,19 +1506,20 @@ namespace mrv
                                                         memory::getEndian());
 #endif // TLRENDER_API_GL_4_1
 
-                            glReadPixels(
-                                0, 0, outputInfo.size.w, outputInfo.size.h,
-                                format, type, outputImage->getData());
+                            renderTime.add(elapsedMs(renderStart));
+                            readback.readPixels(currentTime, write, tags);
 #endif
                         }
                     }
 
-                    if (videoTime.contains(currentTime))
-                    {
-                        const auto& tags = ui->uiView->getTags();
-                        outputImage->setTags(tags);
-                        writer->writeVideo(currentTime, outputImage);
-                    }
+                    /* xgettext:c++-format */
+                    msg = string::Format(
+                              _("Render {0} ms, read back {1} ms, "
+                                "encode {2} ms"))
+                              .arg(renderTime.average(), 1)
+                              .arg(readback.getReadbackMs(), 1)
+                              .arg(encoder.getEncodeMs(), 1);
+                    progress.set_info(msg.c_str());
                 }
 
                 if (hasVideo)
@@ -1099,6 +1551,22 @@ namespace mrv
                 frameIndex = (frameIndex + 1) % vlk::MAX_FRAMES_IN_FLIGHT;
 #endif
             }
+
+            // Write the frames that are still being read back or encoded.
+            readback.flush();
+            encoder.finish();
+
+            if (hasVideo)
+            {
+                /* xgettext:c++-format */
+                msg = string::Format(
+                          _("Average render {0} ms, read back {1} ms, "
+                            "encode {2} ms"))
+                          .arg(renderTime.average(), 1)
+                          .arg(readback.getReadbackMs(), 1)
+                          .arg(encoder.getEncodeMs(), 1);
+                LOG_STATUS(msg);
+            }
         }
         catch (const std::exception& e)
         {
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "mrvViewport/mrvColorAreaStats.h"
+
 #include "mrvOS/mrvString.h"
 
 #include <tlTimeline/BackgroundOptions.h>
@@ -139,6 +141,14 @@ namespace mrv
             //! Color area information
             area::Info colorAreaInfo;
 
+            //! Color area statistics calculated in the background.
+            std::shared_ptr<area::StatsCalculator> colorAreaStats;
+
+            //! Handle passed to Fl::awake() for redrawing when the color
+            //! area statistics are ready, reset when the viewport is
+            //! destroyed.
+            std::shared_ptr<TimelineViewport*> colorAreaStatsView;
+
             //! Safe Areas
             static bool safeAreas;
 
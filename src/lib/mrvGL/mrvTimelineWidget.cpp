@@ -18,6 +18,7 @@
 #include <tlGL/Shader.h>
 
 #include "mrvCore/mrvFile.h"
+#include "mrvCore/mrvHome.h"
 #include "mrvCore/mrvHotkey.h"
 #include "mrvCore/mrvTimeObject.h"
 
@@ -259,7 +260,10 @@ namespace mrv
             p.timelineWindow = TimelineWindow::create(context);
             p.timelineWidget->setParent(p.timelineWindow);
 
-            p.thumbnailSystem = context->getSystem<timelineui::ThumbnailSystem>();
+            auto thumbnailSystem = context->getSystem<timelineui::ThumbnailSystem>();
+            p.thumbnailSystem = thumbnailSystem;
+            setThumbnailDiskCache(
+                settings->getValue<bool>("Cache/ThumbnailDiskCache"));
 
             setStopOnScrub(false);
 
@@ -652,6 +656,18 @@ namespace mrv
             _p->timelineWidget->setDisplayOptions(p.displayOptions);
         }
 
+        void TimelineWidget::setThumbnailDiskCache(bool value)
+        {
+            TLRENDER_P();
+            if (auto thumbnailSystem = p.thumbnailSystem.lock())
+            {
+                // Keep the thumbnails and waveforms on disk so the timeline
+                // is drawn right away when a session is opened again.
+                thumbnailSystem->getCache()->setDiskCacheDir(
+                    value ? cachepath() + "thumbnails" : std::string());
+            }
+        }
+
         void TimelineWidget::setMouseWheelScale(float value)
         {
             _p->timelineWidget->setMouseWheelScale(value);
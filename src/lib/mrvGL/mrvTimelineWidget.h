@@ -75,6 +75,10 @@ namespace mrv
             //! Set whether thumbnails are enabled.
             void setThumbnails(bool);
 
+            //! Set whether thumbnails and waveforms are also kept on disk,
+            //! in the user cache directory.
+            void setThumbnailDiskCache(bool);
+
             //! Set the mouse wheel scale.
             void setMouseWheelScale(float);
 
@@ -153,6 +153,37 @@ namespace mrv
                     App::app->cacheUpdate();
                 });
 
+            auto cV = new Widget< Fl_Check_Button >(
+                g->x() + 90, 90, g->w(), 20, _("Adaptive Read Ahead"));
+            c = cV;
+            c->labelsize(12);
+            c->tooltip(_("Size the read ahead to the decoding speed, "
+                         "reading ahead less when decoding keeps up with "
+                         "playback and more when it falls behind."));
+            c->value(settings->getValue<bool>("Cache/Adaptive"));
+            cV->callback(
+                [=](auto w)
+                {
+                    settings->setValue("Cache/Adaptive", (int)w->value());
+                    App::app->cacheUpdate();
+                });
+
+            cV = new Widget< Fl_Check_Button >(
+                g->x() + 90, 90, g->w(), 20, _("Thumbnail Disk Cache"));
+            c = cV;
+            c->labelsize(12);
+            c->tooltip(_("Keep the timeline thumbnails and waveforms in the "
+                         "user cache directory, so they are drawn right away "
+                         "when a file is opened again."));
+            c->value(settings->getValue<bool>("Cache/ThumbnailDiskCache"));
+            cV->callback(
+                [=](auto w)
+                {
+                    settings->setValue(
+                        "Cache/ThumbnailDiskCache", (int)w->value());
+                    App::ui->uiTimeline->setThumbnailDiskCache(w->value());
+                });
+
             cg->end();
             std::string key = prefix + "Cache";
             std_any value = settings->getValue<std::any>(key);
@@ -391,7 +422,7 @@ namespace mrv
 
             bg->end();
 
-            auto cV = new Widget< Fl_Check_Button >(
+            cV = new Widget< Fl_Check_Button >(
                 g->x() + 90, 398, g->w(), 20,
                 _("FFmpeg YUV to RGB conversion"));
             c = cV;
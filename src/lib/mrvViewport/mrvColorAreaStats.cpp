@@ -0,0 +1,853 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include "mrvCore/mrvBackend.h"
+#include "mrvCore/mrvColor.h"
+
+#include "mrvViewport/mrvColorAreaStats.h"
+
+#include <tlIO/ThreadPool.h>
+
+#include <tlCore/Memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+namespace mrv
+{
+    namespace area
+    {
+        namespace
+        {
+            //! Number of pixels in each chunk of rows given to a thread.
+            const size_t kPixelsPerChunk = 64 * 1024;
+
+            inline uint32_t byteSwap32(uint32_t x)
+            {
+                return ((x >> 24) & 0x000000FF) | ((x >> 8) & 0x0000FF00) |
+                       ((x << 8) & 0x00FF0000) | ((x << 24) & 0xFF000000);
+            }
+
+            template <typename T, int C>
+            inline image::Color4f
+            fetchInterleaved(const uint8_t* row, int X, float scale) noexcept
+            {
+                const T* f = reinterpret_cast<const T*>(row) + X * C;
+                image::Color4f out;
+                out.r = static_cast<float>(f[0]) * scale;
+                if constexpr (C >= 3)
+                {
+                    out.g = static_cast<float>(f[1]) * scale;
+                    out.b = static_cast<float>(f[2]) * scale;
+                }
+                else
+                {
+                    out.g = out.b = out.r;
+                }
+                if constexpr (2 == C)
+                    out.a = static_cast<float>(f[1]) * scale;
+                else if constexpr (4 == C)
+                    out.a = static_cast<float>(f[3]) * scale;
+                else
+                    out.a = 1.F;
+                return out;
+            }
+
+            //! Decode a run of pixels of a row with a function that fetches
+            //! the pixel at an image column.
+            template <typename F>
+            inline void decodeRun(
+                const math::Vector2i& pos, int count, image::Color4f* out,
+                const image::Size& size, bool mirror, F&& fetch) noexcept
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    int X = static_cast<int>(
+                        (pos.x + i) / size.pixelAspectRatio);
+                    if (mirror)
+                        X = size.w - X - 1;
+                    if (X < 0 || X >= size.w)
+                        continue;
+                    out[i] = fetch(X);
+                }
+            }
+
+            //! Statistics of part of the area.
+            struct Partial
+            {
+                image::Color4f rgbaMin;
+                image::Color4f rgbaMax;
+                double rgbaSum[4] = {0.0, 0.0, 0.0, 0.0};
+                image::Color4f hsvMin;
+                image::Color4f hsvMax;
+                double hsvSum[4] = {0.0, 0.0, 0.0, 0.0};
+
+                Partial()
+                {
+                    const float min = std::numeric_limits<float>::max();
+                    const float max = std::numeric_limits<float>::lowest();
+                    rgbaMin = hsvMin = image::Color4f(min, min, min, min);
+                    rgbaMax = hsvMax = image::Color4f(max, max, max, max);
+                }
+
+                static void add(
+                    const image::Color4f& value, image::Color4f& min,
+                    image::Color4f& max, double* sum) noexcept
+                {
+                    min.r = std::min(min.r, value.r);
+                    min.g = std::min(min.g, value.g);
+                    min.b = std::min(min.b, value.b);
+                    min.a = std::min(min.a, value.a);
+                    max.r = std::max(max.r, value.r);
+                    max.g = std::max(max.g, value.g);
+                    max.b = std::max(max.b, value.b);
+                    max.a = std::max(max.a, value.a);
+                    sum[0] += value.r;
+                    sum[1] += value.g;
+                    sum[2] += value.b;
+                    sum[3] += value.a;
+                }
+
+                void add(
+                    const image::Color4f& rgba,
+                    const StatsOptions& options) noexcept
+                {
+                    add(rgba, rgbaMin, rgbaMax, rgbaSum);
+                    image::Color4f hsv = toColorSpace(options.colorSpace, rgba);
+                    hsv.a = calculate_brightness(rgba, options.brightnessType);
+                    add(hsv, hsvMin, hsvMax, hsvSum);
+                }
+
+                static void merge(
+                    const image::Color4f& otherMin,
+                    const image::Color4f& otherMax, const double* otherSum,
+                    image::Color4f& min, image::Color4f& max,
+                    double* sum) noexcept
+                {
+                    min.r = std::min(min.r, otherMin.r);
+                    min.g = std::min(min.g, otherMin.g);
+                    min.b = std::min(min.b, otherMin.b);
+                    min.a = std::min(min.a, otherMin.a);
+                    max.r = std::max(max.r, otherMax.r);
+                    max.g = std::max(max.g, otherMax.g);
+                    max.b = std::max(max.b, otherMax.b);
+                    max.a = std::max(max.a, otherMax.a);
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        sum[i] += otherSum[i];
+                    }
+                }
+
+                void merge(const Partial& other) noexcept
+                {
+                    merge(
+                        other.rgbaMin, other.rgbaMax, other.rgbaSum, rgbaMin,
+                        rgbaMax, rgbaSum);
+                    merge(
+                        other.hsvMin, other.hsvMax, other.hsvSum, hsvMin,
+                        hsvMax, hsvSum);
+                }
+
+                static void finish(
+                    Channels& out, const image::Color4f& min,
+                    const image::Color4f& max, const double* sum, size_t num)
+                {
+                    out.min = min;
+                    out.max = max;
+                    out.mean = image::Color4f(
+                        sum[0] / num, sum[1] / num, sum[2] / num, sum[3] / num);
+                    out.diff = image::Color4f(
+                        max.r - min.r, max.g - min.g, max.b - min.b,
+                        max.a - min.a);
+                }
+            };
+        } // namespace
+
+        bool StatsOptions::operator==(const StatsOptions& other) const
+        {
+            return colorSpace == other.colorSpace &&
+                   brightnessType == other.brightnessType &&
+                   mirror == other.mirror;
+        }
+
+        bool StatsOptions::operator!=(const StatsOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool BufferOptions::operator==(const BufferOptions& other) const
+        {
+            return pixelType == other.pixelType && swapRB == other.swapRB &&
+                   transfer == other.transfer;
+        }
+
+        bool BufferOptions::operator!=(const BufferOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        image::Color4f
+        toColorSpace(int colorSpace, const image::Color4f& rgba) noexcept
+        {
+            image::Color4f hsv;
+
+            switch (colorSpace)
+            {
+            case color::kHSV:
+                hsv = color::rgb::to_hsv(rgba);
+                break;
+            case color::kHSL:
+                hsv = color::rgb::to_hsl(rgba);
+                break;
+#ifdef TLRENDER_HSV
+            case color::kCIE_XYZ:
+                hsv = color::rgb::to_xyz(rgba);
+                break;
+            case color::kCIE_xyY:
+                hsv = color::rgb::to_xyY(rgba);
+                break;
+            case color::kCIE_Lab:
+                hsv = color::rgb::to_lab(rgba);
+                break;
+            case color::kCIE_Luv:
+                hsv = color::rgb::to_luv(rgba);
+                break;
+#endif
+            case color::kYUV:
+                hsv = color::rgb::to_yuv(rgba);
+                break;
+            case color::kYDbDr:
+                hsv = color::rgb::to_YDbDr(rgba);
+                break;
+            case color::kYIQ:
+                hsv = color::rgb::to_yiq(rgba);
+                break;
+            case color::kITU_601:
+                hsv = color::rgb::to_ITU601(rgba);
+                break;
+            case color::kITU_709:
+                hsv = color::rgb::to_ITU709(rgba);
+                break;
+            case color::kRGB:
+            default:
+                hsv = rgba;
+                break;
+            }
+            return hsv;
+        }
+
+        void reset(Info& info) noexcept
+        {
+            const float min = std::numeric_limits<float>::max();
+            const float max = std::numeric_limits<float>::lowest();
+            for (Channels* channels : {&info.rgba, &info.hsv})
+            {
+                channels->min = image::Color4f(min, min, min, min);
+                channels->max = image::Color4f(max, max, max, max);
+                channels->mean = image::Color4f(0.F, 0.F, 0.F, 0.F);
+                channels->diff = image::Color4f(0.F, 0.F, 0.F, 0.F);
+            }
+        }
+
+        PixelDecoder::PixelDecoder(
+            const std::shared_ptr<image::Image>& image,
+            const image::Mirror& mirror) :
+            _mirror(mirror)
+        {
+            if (image && image->isValid())
+            {
+                _image = image;
+                const auto& info = image->getInfo();
+                _pixelType = info.pixelType;
+                _size = info.size;
+                _videoLevels = info.videoLevels;
+                _yuvCoefficients =
+                    image::getYUVCoefficients(info.yuvCoefficients);
+                _byteSwap = memory::getEndian() != info.layout.endian;
+            }
+        }
+
+        bool PixelDecoder::isValid() const noexcept
+        {
+            return _image.get();
+        }
+
+        void PixelDecoder::decode(
+            const math::Vector2i& pos, int count,
+            image::Color4f* out) const noexcept
+        {
+            if (!_image)
+                return;
+
+#ifdef VULKAN_BACKEND
+            int Y = pos.y;
+#endif
+#ifdef OPENGL_BACKEND
+            int Y = _size.h - pos.y - 1;
+#endif
+            if (_mirror.y)
+                Y = _size.h - Y - 1;
+
+            // Do some sanity check just in case
+            if (Y < 0 || Y >= _size.h)
+                return;
+
+            const uint8_t* data = _image->getData();
+            const size_t channels = image::getChannelCount(_pixelType);
+            const size_t depth = image::getBitDepth(_pixelType) / 8;
+            const uint8_t* row =
+                data ? data + Y * _size.w * channels * depth : nullptr;
+            const bool mirror = _mirror.x;
+
+            constexpr float u8 = 1.F / 255.F;
+            constexpr float u16 = 1.F / 65535.F;
+            constexpr float u32 =
+                1.F / static_cast<float>(std::numeric_limits<uint32_t>::max());
+
+#define INTERLEAVED(T, C, scale)                                               \
+    if (!row)                                                                  \
+        return;                                                                \
+    decodeRun(                                                                 \
+        pos, count, out, _size, mirror,                                        \
+        [row, s = scale](int X)                                                \
+        { return fetchInterleaved<T, C>(row, X, s); });                        \
+    break
+
+#define PLANAR(T, XS, YS, max)                                                 \
+    {                                                                          \
+        const uint8_t* p0 = _image->getPlaneData(0);                           \
+        const uint8_t* p1 = _image->getPlaneData(1);                           \
+        const uint8_t* p2 = _image->getPlaneData(2);                           \
+        if (!p0 || !p1 || !p2)                                                 \
+            return;                                                            \
+        const T* y = reinterpret_cast<const T*>(                               \
+            p0 + Y * _image->getLineSize(0));                                  \
+        const T* u = reinterpret_cast<const T*>(                               \
+            p1 + (Y >> YS) * _image->getLineSize(1));                          \
+        const T* v = reinterpret_cast<const T*>(                               \
+            p2 + (Y >> YS) * _image->getLineSize(2));                          \
+        decodeRun(                                                             \
+            pos, count, out, _size, mirror,                                    \
+            [this, y, u, v](int X)                                             \
+            {                                                                  \
+                image::Color4f rgba(                                           \
+                    y[X] / max, u[X >> XS] / max, v[X >> XS] / max, 1.F);      \
+                color::checkLevels(rgba, _videoLevels);                        \
+                return color::YPbPr::to_rgb(rgba, _yuvCoefficients);           \
+            });                                                                \
+        break;                                                                 \
+    }
+
+            switch (_pixelType)
+            {
+            case image::PixelType::L_U8:
+                INTERLEAVED(uint8_t, 1, u8);
+            case image::PixelType::LA_U8:
+                INTERLEAVED(uint8_t, 2, u8);
+            case image::PixelType::L_U16:
+                INTERLEAVED(uint16_t, 1, u16);
+            case image::PixelType::LA_U16:
+                INTERLEAVED(uint16_t, 2, u16);
+            case image::PixelType::L_U32:
+                INTERLEAVED(uint32_t, 1, u32);
+            case image::PixelType::LA_U32:
+                INTERLEAVED(uint32_t, 2, u32);
+            case image::PixelType::L_F16:
+                INTERLEAVED(half, 1, 1.F);
+            case image::PixelType::LA_F16:
+                INTERLEAVED(half, 2, 1.F);
+            case image::PixelType::L_F32:
+                INTERLEAVED(float, 1, 1.F);
+            case image::PixelType::LA_F32:
+                INTERLEAVED(float, 2, 1.F);
+            case image::PixelType::RGB_U8:
+                INTERLEAVED(uint8_t, 3, u8);
+            case image::PixelType::RGBA_U8:
+                INTERLEAVED(uint8_t, 4, u8);
+            case image::PixelType::RGB_U16:
+                INTERLEAVED(uint16_t, 3, u16);
+            case image::PixelType::RGBA_U16:
+                INTERLEAVED(uint16_t, 4, u16);
+            case image::PixelType::RGB_U32:
+                INTERLEAVED(uint32_t, 3, u32);
+            case image::PixelType::RGBA_U32:
+                INTERLEAVED(uint32_t, 4, u32);
+            case image::PixelType::RGB_F16:
+                INTERLEAVED(half, 3, 1.F);
+            case image::PixelType::RGBA_F16:
+                INTERLEAVED(half, 4, 1.F);
+            case image::PixelType::RGB_F32:
+                INTERLEAVED(float, 3, 1.F);
+            case image::PixelType::RGBA_F32:
+                INTERLEAVED(float, 4, 1.F);
+            case image::PixelType::RGB_U10:
+            {
+                if (!data)
+                    return;
+                const uint32_t* packed = reinterpret_cast<const uint32_t*>(
+                    data + Y * _size.w * sizeof(uint32_t));
+                const bool byteSwap = _byteSwap;
+                decodeRun(
+                    pos, count, out, _size, mirror,
+                    [packed, byteSwap](int X)
+                    {
+                        constexpr float max = 1023.F;
+                        uint32_t value = packed[X];
+                        if (byteSwap)
+                            value = byteSwap32(value);
+                        const image::U10 f =
+                            *reinterpret_cast<const image::U10*>(&value);
+                        return image::Color4f(
+                            f.r / max, f.g / max, f.b / max, 1.F);
+                    });
+                break;
+            }
+            case image::PixelType::YUV_420P_U8:
+                PLANAR(uint8_t, 1, 1, 255.F);
+            case image::PixelType::YUV_422P_U8:
+                PLANAR(uint8_t, 1, 0, 255.F);
+            case image::PixelType::YUV_444P_U8:
+                PLANAR(uint8_t, 0, 0, 255.F);
+            case image::PixelType::YUV_420P_U10:
+                PLANAR(uint16_t, 1, 1, 1023.F);
+            case image::PixelType::YUV_422P_U10:
+                PLANAR(uint16_t, 1, 0, 1023.F);
+            case image::PixelType::YUV_444P_U10:
+                PLANAR(uint16_t, 0, 0, 1023.F);
+            case image::PixelType::YUV_420P_U12:
+                PLANAR(uint16_t, 1, 1, 4095.F);
+            case image::PixelType::YUV_422P_U12:
+                PLANAR(uint16_t, 1, 0, 4095.F);
+            case image::PixelType::YUV_444P_U12:
+                PLANAR(uint16_t, 0, 0, 4095.F);
+            case image::PixelType::YUV_420P_U16:
+                PLANAR(uint16_t, 1, 1, 65535.F);
+            case image::PixelType::YUV_422P_U16:
+                PLANAR(uint16_t, 1, 0, 65535.F);
+            case image::PixelType::YUV_444P_U16:
+                PLANAR(uint16_t, 0, 0, 65535.F);
+            default:
+                break;
+            }
+
+#undef INTERLEAVED
+#undef PLANAR
+        }
+
+        FrameDecoder::FrameDecoder(
+            const std::vector<timeline::VideoFrame>& frames,
+            const image::Mirror& mirror)
+        {
+            for (const auto& frame : frames)
+            {
+                for (const auto& layer : frame.layers)
+                {
+                    _layers.push_back(
+                        {PixelDecoder(layer.image, mirror),
+                         PixelDecoder(layer.imageB, mirror),
+                         timeline::Transition::Dissolve == layer.transition,
+                         layer.transitionValue});
+                }
+            }
+        }
+
+        void FrameDecoder::decode(
+            const math::Vector2i& pos, int count, image::Color4f* out,
+            std::vector<image::Color4f>& scratch) const noexcept
+        {
+            const image::Color4f zero(0.F, 0.F, 0.F, 0.F);
+            std::fill(out, out + count, zero);
+            if (scratch.size() < static_cast<size_t>(count) * 2)
+                scratch.resize(count * 2);
+            image::Color4f* pixel = scratch.data();
+            image::Color4f* pixelB = scratch.data() + count;
+            for (const auto& layer : _layers)
+            {
+                std::fill(pixel, pixel + count, zero);
+                layer.image.decode(pos, count, pixel);
+                if (layer.imageB.isValid())
+                {
+                    std::fill(pixelB, pixelB + count, zero);
+                    layer.imageB.decode(pos, count, pixelB);
+                    if (layer.dissolve)
+                    {
+                        const float f2 = layer.transitionValue;
+                        const float f = 1.F - f2;
+                        for (int i = 0; i < count; ++i)
+                        {
+                            pixel[i].r = pixel[i].r * f + pixelB[i].r * f2;
+                            pixel[i].g = pixel[i].g * f + pixelB[i].g * f2;
+                            pixel[i].b = pixel[i].b * f + pixelB[i].b * f2;
+                            pixel[i].a = pixel[i].a * f + pixelB[i].a * f2;
+                        }
+                    }
+                }
+                for (int i = 0; i < count; ++i)
+                {
+                    out[i].r += pixel[i].r;
+                    out[i].g += pixel[i].g;
+                    out[i].b += pixel[i].b;
+                    out[i].a += pixel[i].a;
+                }
+            }
+        }
+
+        namespace
+        {
+            //! Calculate the statistics with a function that decodes a row
+            //! of the box.
+            template <typename F>
+            bool calculateRows(
+                Info& info, const StatsOptions& options,
+                const std::function<bool(void)>& cancelled, F&& decodeRow)
+            {
+                reset(info);
+                const math::Box2i box = info.box;
+                const int w = box.w();
+                const int h = box.h();
+                if (w <= 0 || h <= 0)
+                    return true;
+
+                Partial total;
+                std::mutex mutex;
+                std::atomic<bool> stop(false);
+                auto rows = [&](size_t begin, size_t end)
+                {
+                    Partial partial;
+                    std::vector<image::Color4f> row(w);
+                    std::vector<image::Color4f> scratch;
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        if (stop || (cancelled && cancelled()))
+                        {
+                            stop = true;
+                            return;
+                        }
+                        decodeRow(static_cast<int>(y), w, row.data(), scratch);
+                        for (const auto& rgba : row)
+                        {
+                            partial.add(rgba, options);
+                        }
+                    }
+                    std::unique_lock<std::mutex> lock(mutex);
+                    total.merge(partial);
+                };
+
+                const size_t rowsPerChunk =
+                    std::max(kPixelsPerChunk / w, static_cast<size_t>(1));
+                io::ThreadPool::getGlobal()->parallelFor(
+                    h, rowsPerChunk, rows);
+                if (stop)
+                    return false;
+
+                const size_t num = static_cast<size_t>(w) * h;
+                Partial::finish(
+                    info.rgba, total.rgbaMin, total.rgbaMax, total.rgbaSum,
+                    num);
+                Partial::finish(
+                    info.hsv, total.hsvMin, total.hsvMax, total.hsvSum, num);
+                return true;
+            }
+        } // namespace
+
+        bool calculate(
+            Info& info, const FrameDecoder& decoder,
+            const StatsOptions& options,
+            const std::function<bool(void)>& cancelled)
+        {
+            const math::Vector2i min = info.box.min;
+            return calculateRows(
+                info, options, cancelled,
+                [&decoder, min](
+                    int y, int w, image::Color4f* out,
+                    std::vector<image::Color4f>& scratch)
+                {
+                    decoder.decode(
+                        math::Vector2i(min.x, min.y + y), w, out, scratch);
+                });
+        }
+
+        bool calculate(
+            Info& info, const uint8_t* data, const BufferOptions& buffer,
+            const StatsOptions& options,
+            const std::function<bool(void)>& cancelled)
+        {
+            const size_t pixelByteCount =
+                image::getChannelCount(buffer.pixelType) *
+                image::getBitDepth(buffer.pixelType) / 8;
+            return calculateRows(
+                info, options, cancelled,
+                [data, &buffer, pixelByteCount](
+                    int y, int w, image::Color4f* out,
+                    std::vector<image::Color4f>&)
+                {
+                    const uint8_t* p =
+                        data + static_cast<size_t>(y) * w * pixelByteCount;
+                    for (int x = 0; x < w; ++x, p += pixelByteCount)
+                    {
+                        image::Color4f rgba =
+                            color::fromVoidPtr(p, buffer.pixelType);
+                        if (buffer.swapRB)
+                            std::swap(rgba.r, rgba.b);
+                        switch (buffer.transfer)
+                        {
+                        case BufferTransfer::kPQToLinear:
+                            rgba = color::pqToLinear(rgba);
+                            break;
+                        case BufferTransfer::kPQToNits:
+                            rgba = color::pqToNits(rgba);
+                            break;
+                        default:
+                            break;
+                        }
+                        out[x] = rgba;
+                    }
+                });
+        }
+
+        namespace
+        {
+            struct Request
+            {
+                uint64_t generation = 0;
+                math::Box2i box;
+                std::vector<timeline::VideoFrame> frames;
+                std::shared_ptr<const std::vector<uint8_t> > data;
+                BufferOptions bufferOptions;
+                StatsOptions options;
+            };
+
+            bool isSameFrames(
+                const std::vector<timeline::VideoFrame>& a,
+                const std::vector<timeline::VideoFrame>& b)
+            {
+                if (a.size() != b.size())
+                    return false;
+                for (size_t i = 0; i < a.size(); ++i)
+                {
+                    const auto& layersA = a[i].layers;
+                    const auto& layersB = b[i].layers;
+                    if (layersA.size() != layersB.size())
+                        return false;
+                    for (size_t j = 0; j < layersA.size(); ++j)
+                    {
+                        if (layersA[j].image != layersB[j].image ||
+                            layersA[j].imageB != layersB[j].imageB ||
+                            layersA[j].transition != layersB[j].transition ||
+                            layersA[j].transitionValue !=
+                                layersB[j].transitionValue)
+                            return false;
+                    }
+                }
+                return true;
+            }
+        } // namespace
+
+        struct StatsCalculator::Private
+        {
+            //! State shared with the worker threads, which may outlive the
+            //! calculator.
+            struct Shared : std::enable_shared_from_this<Shared>
+            {
+                void start();
+                void run(const Request&);
+
+                //! Incremented to cancel the calculation in progress.
+                std::atomic<uint64_t> generation = 0;
+
+                std::mutex mutex;
+                bool running = false;
+                std::optional<Request> pending;
+                bool hasResult = false;
+                uint64_t resultGeneration = 0;
+                Info result;
+                std::function<void(void)> callback;
+            };
+            std::shared_ptr<Shared> shared;
+
+            void request(Request&&);
+            bool getResult(Info&);
+
+            bool requested = false;
+            math::Box2i box;
+            std::vector<timeline::VideoFrame> frames;
+            std::shared_ptr<const std::vector<uint8_t> > data;
+            BufferOptions bufferOptions;
+            StatsOptions options;
+        };
+
+        void StatsCalculator::Private::Shared::start()
+        {
+            // This is called with the mutex locked.
+            running = true;
+            Request request = std::move(*pending);
+            pending.reset();
+            io::ThreadPool::getGlobal()->submit(
+                [shared = shared_from_this(), request]
+                { shared->run(request); });
+        }
+
+        void StatsCalculator::Private::Shared::run(const Request& request)
+        {
+            Info info;
+            info.box = request.box;
+            const uint64_t requestGeneration = request.generation;
+            const auto cancelled = [this, requestGeneration]
+            { return generation != requestGeneration; };
+            bool done = false;
+            if (request.data)
+            {
+                done = calculate(
+                    info, request.data->data(), request.bufferOptions,
+                    request.options, cancelled);
+            }
+            else
+            {
+                const FrameDecoder decoder(
+                    request.frames, request.options.mirror);
+                done = calculate(info, decoder, request.options, cancelled);
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (done && generation == requestGeneration)
+            {
+                result = info;
+                resultGeneration = requestGeneration;
+                hasResult = true;
+                if (callback)
+                    callback();
+            }
+            if (pending)
+            {
+                start();
+            }
+            else
+            {
+                running = false;
+            }
+        }
+
+        StatsCalculator::StatsCalculator() :
+            _p(new Private)
+        {
+            _p->shared = std::make_shared<Private::Shared>();
+        }
+
+        StatsCalculator::~StatsCalculator()
+        {
+            cancel();
+            std::unique_lock<std::mutex> lock(_p->shared->mutex);
+            _p->shared->callback = nullptr;
+        }
+
+        void StatsCalculator::setCallback(
+            const std::function<void(void)>& value)
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.shared->mutex);
+            p.shared->callback = value;
+        }
+
+        void StatsCalculator::Private::request(Request&& value)
+        {
+            std::unique_lock<std::mutex> lock(shared->mutex);
+            shared->pending = std::move(value);
+            if (!shared->running)
+            {
+                shared->start();
+            }
+        }
+
+        bool StatsCalculator::Private::getResult(Info& info)
+        {
+            std::unique_lock<std::mutex> lock(shared->mutex);
+            if (shared->hasResult &&
+                shared->resultGeneration == shared->generation)
+            {
+                info.rgba = shared->result.rgba;
+                info.hsv = shared->result.hsv;
+                return true;
+            }
+            return false;
+        }
+
+        bool StatsCalculator::request(
+            Info& info, const std::vector<timeline::VideoFrame>& frames,
+            const StatsOptions& options)
+        {
+            TLRENDER_P();
+            auto& shared = *p.shared;
+
+            const bool changed = !p.requested || p.data ||
+                                 info.box != p.box || options != p.options;
+            if (changed || !isSameFrames(frames, p.frames))
+            {
+                if (changed)
+                {
+                    ++shared.generation;
+                }
+                p.requested = true;
+                p.box = info.box;
+                p.frames = frames;
+                p.data.reset();
+                p.options = options;
+                p.request(
+                    Request{shared.generation, info.box, frames, nullptr,
+                            BufferOptions(), options});
+            }
+            return p.getResult(info);
+        }
+
+        bool StatsCalculator::request(
+            Info& info, const uint8_t* data, const BufferOptions& bufferOptions,
+            const StatsOptions& options)
+        {
+            TLRENDER_P();
+            auto& shared = *p.shared;
+
+            const size_t byteCount =
+                static_cast<size_t>(std::max(info.box.w(), 0)) *
+                std::max(info.box.h(), 0) *
+                image::getChannelCount(bufferOptions.pixelType) *
+                image::getBitDepth(bufferOptions.pixelType) / 8;
+            const bool changed = !p.requested || !p.data ||
+                                 info.box != p.box ||
+                                 bufferOptions != p.bufferOptions ||
+                                 options != p.options;
+            if (changed || p.data->size() != byteCount ||
+                (byteCount > 0 &&
+                 std::memcmp(p.data->data(), data, byteCount) != 0))
+            {
+                if (changed)
+                {
+                    ++shared.generation;
+                }
+                p.requested = true;
+                p.box = info.box;
+                p.frames.clear();
+                p.data = std::make_shared<const std::vector<uint8_t> >(
+                    data, data + byteCount);
+                p.bufferOptions = bufferOptions;
+                p.options = options;
+                p.request(
+                    Request{shared.generation, info.box, {}, p.data,
+                            bufferOptions, options});
+            }
+            return p.getResult(info);
+        }
+
+        void StatsCalculator::cancel()
+        {
+            TLRENDER_P();
+            std::unique_lock<std::mutex> lock(p.shared->mutex);
+            ++p.shared->generation;
+            p.shared->pending.reset();
+            p.requested = false;
+        }
+    } // namespace area
+} // namespace mrv
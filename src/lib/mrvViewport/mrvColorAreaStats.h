@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include "mrvCore/mrvColorAreaInfo.h"
+#include "mrvCore/mrvColorSpaces.h"
+
+#include <tlTimeline/Video.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mrv
+{
+    namespace area
+    {
+        //! Options for calculating the color area statistics.
+        struct StatsOptions
+        {
+            //! Color space of the second set of statistics (a color::Space).
+            int colorSpace = color::kHSV;
+
+            //! How the brightness (the fourth channel of the second set of
+            //! statistics) is calculated.
+            BrightnessType brightnessType = kAsLuminance;
+
+            image::Mirror mirror;
+
+            bool operator==(const StatsOptions&) const;
+            bool operator!=(const StatsOptions&) const;
+        };
+
+        //! Transfer function of the pixels read back from the display.
+        enum class BufferTransfer
+        {
+            kNone,
+            kPQToLinear,
+            kPQToNits
+        };
+
+        //! Options for the pixels read back from the display.
+        struct BufferOptions
+        {
+            image::PixelType pixelType = image::PixelType::RGBA_F32;
+
+            //! Swap the red and blue channels.
+            bool swapRB = false;
+
+            BufferTransfer transfer = BufferTransfer::kNone;
+
+            bool operator==(const BufferOptions&) const;
+            bool operator!=(const BufferOptions&) const;
+        };
+
+        //! Convert a RGBA color to a color::Space.
+        image::Color4f
+        toColorSpace(int colorSpace, const image::Color4f& rgba) noexcept;
+
+        //! Reset the statistics so they can be accumulated.
+        void reset(Info&) noexcept;
+
+        //! Decodes the pixels of an image from viewport raster coordinates.
+        //! The pixel type, YUV coefficients and mirroring are resolved once
+        //! when the decoder is created, instead of once per pixel.
+        class PixelDecoder
+        {
+        public:
+            PixelDecoder(
+                const std::shared_ptr<image::Image>&,
+                const image::Mirror& mirror);
+
+            //! Is the image valid?
+            bool isValid() const noexcept;
+
+            //! Decode a run of pixels starting at the raster position. Pixels
+            //! that fall outside of the image are left untouched.
+            void decode(
+                const math::Vector2i& pos, int count,
+                image::Color4f* out) const noexcept;
+
+        private:
+            std::shared_ptr<image::Image> _image;
+            image::PixelType _pixelType = image::PixelType::kNone;
+            image::Size _size;
+            image::Mirror _mirror;
+            image::VideoLevels _videoLevels = image::VideoLevels::FullRange;
+            math::Vector4f _yuvCoefficients;
+            bool _byteSwap = false;
+        };
+
+        //! Decodes and composites the layers of video frames, the same way
+        //! the pixel bar does.
+        class FrameDecoder
+        {
+        public:
+            FrameDecoder(
+                const std::vector<timeline::VideoFrame>&,
+                const image::Mirror& mirror);
+
+            //! Decode a run of pixels starting at the raster position. The
+            //! scratch buffer is resized as needed, so that it can be reused
+            //! between calls.
+            void decode(
+                const math::Vector2i& pos, int count, image::Color4f* out,
+                std::vector<image::Color4f>& scratch) const noexcept;
+
+        private:
+            struct Layer
+            {
+                PixelDecoder image;
+                PixelDecoder imageB;
+                bool dissolve = false;
+                float transitionValue = 0.F;
+            };
+            std::vector<Layer> _layers;
+        };
+
+        //! Calculate the statistics of the pixels within the box of the
+        //! information. The rows are split between the threads of the I/O
+        //! thread pool, each one reducing its own partial results. Returns
+        //! false if the calculation was cancelled.
+        bool calculate(
+            Info&, const FrameDecoder&, const StatsOptions&,
+            const std::function<bool(void)>& cancelled = nullptr);
+
+        //! Calculate the statistics of the pixels read back from the
+        //! display, which hold the rows of the box of the information one
+        //! after the other.
+        bool calculate(
+            Info&, const uint8_t* data, const BufferOptions&,
+            const StatsOptions&,
+            const std::function<bool(void)>& cancelled = nullptr);
+
+        //! Calculates the color area statistics in the background.
+        //!
+        //! A request with a different box or options cancels the calculation
+        //! in progress. Requests for new frames with the same box and options
+        //! are queued behind it instead, so that results keep arriving
+        //! during playback.
+        class StatsCalculator
+        {
+            TLRENDER_NON_COPYABLE(StatsCalculator);
+
+        public:
+            StatsCalculator();
+            ~StatsCalculator();
+
+            //! Set a callback that is called from a worker thread when new
+            //! statistics are available.
+            void setCallback(const std::function<void(void)>&);
+
+            //! Request the statistics of the pixels within the box of the
+            //! information. Returns true and copies the statistics to the
+            //! information if they are available for the box and options,
+            //! the frames may lag behind by the calculation in progress.
+            bool request(
+                Info&, const std::vector<timeline::VideoFrame>&,
+                const StatsOptions&);
+
+            //! Request the statistics of the pixels read back from the
+            //! display. The pixels are copied, and the calculation only
+            //! starts again when they change.
+            bool request(
+                Info&, const uint8_t* data, const BufferOptions&,
+                const StatsOptions&);
+
+            //! Cancel the calculations.
+            void cancel();
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+    } // namespace area
+} // namespace mrv
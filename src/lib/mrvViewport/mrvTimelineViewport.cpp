@@ -29,6 +29,7 @@
 #include "mrvWidgets/mrvMultilineInput.h"
 #include "mrvWidgets/mrvTooltip.h"
 
+#include "mrvViewport/mrvColorAreaStats.h"
 #include "mrvViewport/mrvTimelineViewport.h"
 
 #include "mrvNetwork/mrvTCP.h"
@@ -60,6 +61,8 @@
 
 #include <tlDevice/IOutput.h>
 
+#include <tlIO/ThreadPool.h>
+
 #include <tlCore/HDR.h>
 #include <tlCore/Matrix.h>
 
@@ -80,14 +83,6 @@ namespace
 {
     const double kFullScreenTimeout = 0.01;
 
-    inline uint32_t byteSwap32(uint32_t x)
-    {
-        return ((x >> 24) & 0x000000FF) |
-            ((x >> 8)  & 0x0000FF00) |
-            ((x << 8)  & 0x00FF0000) |
-            ((x << 24) & 0xFF000000);
-    }
-
     inline int normalizeAngle0to360(float angle)
     {
         int out = static_cast<int>(std::fmod(angle, 360.0f));
@@ -148,6 +143,14 @@ namespace mrv
             view->clearHelpText();
         }
 
+        static void colorAreaStats_cb(void* data)
+        {
+            auto weak = static_cast<std::weak_ptr<TimelineViewport*>*>(data);
+            if (auto view = weak->lock())
+                (*view)->redraw();
+            delete weak;
+        }
+
         void TimelineViewport::_init()
         {
             TLRENDER_P();
@@ -171,10 +174,26 @@ namespace mrv
             p.backgroundOptions =
                 observer::Value<timeline::BackgroundOptions>::create(
                     backgroundOptions);
+
+            // The color area statistics are calculated in the background,
+            // redraw to show them when they are ready. The viewport may be
+            // destroyed before the main thread runs the awake handler, so
+            // it is given a weak handle.
+            p.colorAreaStatsView = std::make_shared<TimelineViewport*>(this);
+            p.colorAreaStats = std::make_shared<area::StatsCalculator>();
+            p.colorAreaStats->setCallback(
+                [weak = std::weak_ptr<TimelineViewport*>(p.colorAreaStatsView)]
+                {
+                    Fl::awake(
+                        colorAreaStats_cb,
+                        new std::weak_ptr<TimelineViewport*>(weak));
+                });
         }
 
         TimelineViewport::~TimelineViewport()
         {
+            _p->colorAreaStats.reset();
+            _p->colorAreaStatsView.reset();
             _unmapBuffer();
         }
 
@@ -2706,730 +2725,28 @@ namespace mrv
             }
         }
 
-        void TimelineViewport::hsv_to_info(
-            const image::Color4f& hsv, area::Info& info) const noexcept
-        {
-            info.hsv.mean.r += hsv.r;
-            info.hsv.mean.g += hsv.g;
-            info.hsv.mean.b += hsv.b;
-            info.hsv.mean.a += hsv.a;
-
-            if (hsv.r < info.hsv.min.r)
-                info.hsv.min.r = hsv.r;
-            if (hsv.g < info.hsv.min.g)
-                info.hsv.min.g = hsv.g;
-            if (hsv.b < info.hsv.min.b)
-                info.hsv.min.b = hsv.b;
-            if (hsv.a < info.hsv.min.a)
-                info.hsv.min.a = hsv.a;
-
-            if (hsv.r > info.hsv.max.r)
-                info.hsv.max.r = hsv.r;
-            if (hsv.g > info.hsv.max.g)
-                info.hsv.max.g = hsv.g;
-            if (hsv.b > info.hsv.max.b)
-                info.hsv.max.b = hsv.b;
-            if (hsv.a > info.hsv.max.a)
-                info.hsv.max.a = hsv.a;
-        }
-
-        image::Color4f TimelineViewport::rgba_to_hsv(
-            int hsv_colorspace, image::Color4f& rgba) const noexcept
-        {
-            image::Color4f hsv;
-
-            switch (hsv_colorspace)
-            {
-            case color::kHSV:
-                hsv = color::rgb::to_hsv(rgba);
-                break;
-            case color::kHSL:
-                hsv = color::rgb::to_hsl(rgba);
-                break;
-#ifdef TLRENDER_HSV
-            case color::kCIE_XYZ:
-                hsv = color::rgb::to_xyz(rgba);
-                break;
-            case color::kCIE_xyY:
-                hsv = color::rgb::to_xyY(rgba);
-                break;
-            case color::kCIE_Lab:
-                hsv = color::rgb::to_lab(rgba);
-                break;
-            case color::kCIE_Luv:
-                hsv = color::rgb::to_luv(rgba);
-                break;
-#endif
-            case color::kYUV:
-                hsv = color::rgb::to_yuv(rgba);
-                break;
-            case color::kYDbDr:
-                hsv = color::rgb::to_YDbDr(rgba);
-                break;
-            case color::kYIQ:
-                hsv = color::rgb::to_yiq(rgba);
-                break;
-            case color::kITU_601:
-                hsv = color::rgb::to_ITU601(rgba);
-                break;
-            case color::kITU_709:
-                hsv = color::rgb::to_ITU709(rgba);
-                break;
-            case color::kRGB:
-            default:
-                hsv = rgba;
-                break;
-            }
-            return hsv;
-        }
-
         void TimelineViewport::_getPixelValue(
             image::Color4f& rgba, const std::shared_ptr<image::Image>& image,
             const math::Vector2i& pos) const noexcept
         {
             TLRENDER_P();
-            image::PixelType type = image->getPixelType();
-            uint8_t channels = image::getChannelCount(type);
-            uint8_t depth = image::getBitDepth(type) / 8;
-            const auto& info = image->getInfo();
-            auto pixelAspectRatio = info.size.pixelAspectRatio;
-            image::VideoLevels videoLevels = info.videoLevels;
-            const math::Vector4f& yuvCoefficients =
-                getYUVCoefficients(info.yuvCoefficients);
-            auto size = image->getSize();
-
-            const uint8_t* data = image->getData();
-            int X = pos.x / pixelAspectRatio;
-#ifdef VULKAN_BACKEND
-            int Y = pos.y;
-#endif
-#ifdef OPENGL_BACKEND
-            int Y = size.h - pos.y - 1;
-#endif
-            if (p.displayOptions[0].mirror.x)
-                X = size.w - X - 1;
-            if (p.displayOptions[0].mirror.y)
-                Y = size.h - Y - 1;
-
-            // Do some sanity check just in case
-            if (X < 0 || Y < 0 || X >= size.w || Y >= size.h)
-                return;
-
-            size_t stride;
-            size_t offset = (Y * size.w + X);
-
-            switch (type)
-            {
-            case image::PixelType::YUV_420P_U8:
-            case image::PixelType::YUV_422P_U8:
-            case image::PixelType::YUV_444P_U8:
-                break;
-            case image::PixelType::YUV_420P_U16:
-            case image::PixelType::YUV_422P_U16:
-            case image::PixelType::YUV_444P_U16:
-                break;
-            case image::PixelType::RGB_U10:
-                offset *= sizeof(uint32_t);
-                break;
-            default:
-                offset *= channels * depth;
-                break;
-            }
-
-
-            rgba.a = 1.0f;
-            switch (type)
-            {
-            case image::PixelType::L_U8:
-                if (!data) return;
-                rgba.r = data[offset] / 255.0f;
-                rgba.g = data[offset] / 255.0f;
-                rgba.b = data[offset] / 255.0f;
-                break;
-            case image::PixelType::LA_U8:
-                if (!data) return;
-                rgba.r = data[offset] / 255.0f;
-                rgba.g = data[offset] / 255.0f;
-                rgba.b = data[offset] / 255.0f;
-                rgba.a = data[offset + 1] / 255.0f;
-                break;
-            case image::PixelType::L_U16:
-            {
-                if (!data) return;
-                uint16_t* f = (uint16_t*)(&data[offset]);
-                rgba.r = f[0] / 65535.0f;
-                rgba.g = f[0] / 65535.0f;
-                rgba.b = f[0] / 65535.0f;
-                break;
-            }
-            case image::PixelType::LA_U16:
-            {
-                if (!data) return;
-                uint16_t* f = (uint16_t*)(&data[offset]);
-                rgba.r = f[0] / 65535.0f;
-                rgba.g = f[0] / 65535.0f;
-                rgba.b = f[0] / 65535.0f;
-                rgba.a = f[1] / 65535.0f;
-                break;
-            }
-            case image::PixelType::L_U32:
-            {
-                if (!data) return;
-                uint32_t* f = (uint32_t*)(&data[offset]);
-                constexpr float max =
-                    static_cast<float>(std::numeric_limits<uint32_t>::max());
-                rgba.r = f[0] / max;
-                rgba.g = f[0] / max;
-                rgba.b = f[0] / max;
-                break;
-            }
-            case image::PixelType::LA_U32:
-            {
-                if (!data) return;
-                uint32_t* f = (uint32_t*)(&data[offset]);
-                constexpr float max =
-                    static_cast<float>(std::numeric_limits<uint32_t>::max());
-                rgba.r = f[0] / max;
-                rgba.g = f[0] / max;
-                rgba.b = f[0] / max;
-                rgba.a = f[1] / max;
-                break;
-            }
-            case image::PixelType::L_F16:
-            {
-                if (!data) return;
-                half* f = (half*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[0];
-                rgba.b = f[0];
-                break;
-            }
-            case image::PixelType::LA_F16:
-            {
-                if (!data) return;
-                half* f = (half*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[0];
-                rgba.b = f[0];
-                rgba.a = f[1];
-                break;
-            }
-            case image::PixelType::RGB_U8:
-                if (!data) return;
-                rgba.r = data[offset] / 255.0f;
-                rgba.g = data[offset + 1] / 255.0f;
-                rgba.b = data[offset + 2] / 255.0f;
-                break;
-            case image::PixelType::RGB_U10:
-            {
-                if (!data) return;
-                constexpr float max = 1023.F;
-
-                uint32_t packed = *((uint32_t*)&data[offset]);
-                if (tl::memory::getEndian() != info.layout.endian)
-                    packed = byteSwap32(packed);
-
-                image::U10 f = *((image::U10*)&packed);
-                rgba.r = f.r / max;
-                rgba.g = f.g / max;
-                rgba.b = f.b / max;
-                break;
-            }
-            case image::PixelType::RGBA_U8:
-                if (!data) return;
-                rgba.r = data[offset] / 255.0f;
-                rgba.g = data[offset + 1] / 255.0f;
-                rgba.b = data[offset + 2] / 255.0f;
-                rgba.a = data[offset + 3] / 255.0f;
-                break;
-            case image::PixelType::RGB_U16:
-            {
-                if (!data) return;
-                uint16_t* f = (uint16_t*)(&data[offset]);
-                rgba.r = f[0] / 65535.0f;
-                rgba.g = f[1] / 65535.0f;
-                rgba.b = f[2] / 65535.0f;
-                break;
-            }
-            case image::PixelType::RGBA_U16:
-            {
-                if (!data) return;
-                uint16_t* f = (uint16_t*)(&data[offset]);
-                rgba.r = f[0] / 65535.0f;
-                rgba.g = f[1] / 65535.0f;
-                rgba.b = f[2] / 65535.0f;
-                rgba.a = f[3] / 65535.0f;
-                break;
-            }
-            case image::PixelType::RGB_U32:
-            {
-                if (!data) return;
-                uint32_t* f = (uint32_t*)(&data[offset]);
-                constexpr float max =
-                    static_cast<float>(std::numeric_limits<uint32_t>::max());
-                rgba.r = f[0] / max;
-                rgba.g = f[1] / max;
-                rgba.b = f[2] / max;
-                break;
-            }
-            case image::PixelType::RGBA_U32:
-            {
-                if (!data) return;
-                uint32_t* f = (uint32_t*)(&data[offset]);
-                constexpr float max =
-                    static_cast<float>(std::numeric_limits<uint32_t>::max());
-                rgba.r = f[0] / max;
-                rgba.g = f[1] / max;
-                rgba.b = f[2] / max;
-                rgba.a = f[3] / max;
-                break;
-            }
-            case image::PixelType::RGB_F16:
-            {
-                if (!data) return;
-                half* f = (half*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[1];
-                rgba.b = f[2];
-                break;
-            }
-            case image::PixelType::RGBA_F16:
-            {
-                half* f = (half*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[1];
-                rgba.b = f[2];
-                rgba.a = f[3];
-                break;
-            }
-            case image::PixelType::RGB_F32:
-            {
-                if (!data) return;
-                float* f = (float*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[1];
-                rgba.b = f[2];
-                break;
-            }
-            case image::PixelType::RGBA_F32:
-            {
-                if (!data) return;
-                float* f = (float*)(&data[offset]);
-                rgba.r = f[0];
-                rgba.g = f[1];
-                rgba.b = f[2];
-                rgba.a = f[3];
-                break;
-            }
-            case image::PixelType::YUV_420P_U8:
-            {
-                data = image->getPlaneData(0);
-                if (!data) return;
-                stride = image->getLineSize(0);
-                offset = Y * stride + X;
-                rgba.r = data[offset] / 255.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1);
-                offset = (Y / 2) * stride + X / 2;
-                rgba.g = data[offset] / 255.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2);
-                offset = (Y / 2) * stride + X / 2;
-                rgba.b = data[offset] / 255.0f;
-
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_422P_U8:
-            {
-                data = image->getPlaneData(0);
-                if (!data) return;
-                stride = image->getLineSize(0);
-                offset = Y * stride + X;
-                rgba.r = data[offset] / 255.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1);
-                offset = Y * stride + X / 2;
-                rgba.g = data[offset] / 255.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2);
-                offset = Y * stride + X / 2;
-                rgba.b = data[offset] / 255.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_444P_U8:
-            {
-                data = image->getPlaneData(0);
-                if (!data) return;
-                stride = image->getLineSize(0);
-                offset = Y * stride + X;
-                rgba.r = data[offset] / 255.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1);
-                offset = Y * stride + X;
-                rgba.g = data[offset] / 255.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2);
-                offset = Y * stride + X;
-                rgba.b = data[offset] / 255.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_420P_U10:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 1023.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 1023.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 1023.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_420P_U12:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 4095.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 4095.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 4095.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_420P_U16:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = (Y / 2) * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 65535.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_422P_U10:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 1023.F;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 1023.F;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 1023.F;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_422P_U12:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 4095.F;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 4095.F;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 4095.F;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_422P_U16:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X / 2;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 65535.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_444P_U10:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 1023.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 1023.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 1023.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_444P_U12:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 4095.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 4095.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 4095.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            case image::PixelType::YUV_444P_U16:
-            {
-                const uint16_t* f;
-
-                data = image->getPlaneData(0);
-                stride = image->getLineSize(0) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.r = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(1);
-                stride = image->getLineSize(1) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.g = f[offset] / 65535.0f;
-
-                data = image->getPlaneData(2);
-                stride = image->getLineSize(2) / sizeof(uint16_t);
-                offset = Y * stride + X;
-                f = reinterpret_cast<const uint16_t*>(data);
-                rgba.b = f[offset] / 65535.0f;
-
-                color::checkLevels(rgba, videoLevels);
-                rgba = color::YPbPr::to_rgb(rgba, yuvCoefficients);
-                break;
-            }
-            default:
-                break;
-            }
+            const area::PixelDecoder decoder(
+                image, p.displayOptions[0].mirror);
+            decoder.decode(pos, 1, &rgba);
         }
 
-        void TimelineViewport::_calculateColorAreaRawValues(
+        bool TimelineViewport::_calculateColorAreaRawValues(
             area::Info& info) const noexcept
         {
             TLRENDER_P();
 
             PixelToolBarClass* c = p.ui->uiPixelWindow;
-            BrightnessType brightness_type = (BrightnessType)c->uiLType->value();
-            int hsv_colorspace = c->uiBColorType->value() + 1;
-
-            int maxX = info.box.max.x;
-            int maxY = info.box.max.y;
+            area::StatsOptions options;
+            options.colorSpace = c->uiBColorType->value() + 1;
+            options.brightnessType = (BrightnessType)c->uiLType->value();
+            options.mirror = p.displayOptions[0].mirror;
 
-            for (int Y = info.box.y(); Y <= maxY; ++Y)
-            {
-                for (int X = info.box.x(); X <= maxX; ++X)
-                {
-                    image::Color4f rgba, hsv;
-                    rgba.r = rgba.g = rgba.b = rgba.a = 0.f;
-
-                    math::Vector2i pos(X, Y);
-                    for (const auto& video : p.videoData)
-                    {
-                        for (const auto& layer : video.layers)
-                        {
-                            const auto image = layer.image;
-
-                            image::Color4f pixel, pixelB;
-
-                            if (image && image->isValid())
-                                _getPixelValue(pixel, image, pos);
-
-                            const auto imageB = layer.image;
-                            if (imageB && imageB->isValid())
-                            {
-                                _getPixelValue(pixelB, imageB, pos);
-
-                                if (layer.transition ==
-                                    timeline::Transition::Dissolve)
-                                {
-                                    float f2 = layer.transitionValue;
-                                    float f = 1.0 - f2;
-                                    pixel.r = pixel.r * f + pixelB.r * f2;
-                                    pixel.g = pixel.g * f + pixelB.g * f2;
-                                    pixel.b = pixel.b * f + pixelB.b * f2;
-                                    pixel.a = pixel.a * f + pixelB.a * f2;
-                                }
-                            }
-                            rgba.r += pixel.r;
-                            rgba.g += pixel.g;
-                            rgba.b += pixel.b;
-                            rgba.a += pixel.a;
-                        }
-
-                        info.rgba.mean.r += rgba.r;
-                        info.rgba.mean.g += rgba.g;
-                        info.rgba.mean.b += rgba.b;
-                        info.rgba.mean.a += rgba.a;
-
-                        if (rgba.r < info.rgba.min.r)
-                            info.rgba.min.r = rgba.r;
-                        if (rgba.g < info.rgba.min.g)
-                            info.rgba.min.g = rgba.g;
-                        if (rgba.b < info.rgba.min.b)
-                            info.rgba.min.b = rgba.b;
-                        if (rgba.a < info.rgba.min.a)
-                            info.rgba.min.a = rgba.a;
-
-                        if (rgba.r > info.rgba.max.r)
-                            info.rgba.max.r = rgba.r;
-                        if (rgba.g > info.rgba.max.g)
-                            info.rgba.max.g = rgba.g;
-                        if (rgba.b > info.rgba.max.b)
-                            info.rgba.max.b = rgba.b;
-                        if (rgba.a > info.rgba.max.a)
-                            info.rgba.max.a = rgba.a;
-
-                        hsv = rgba_to_hsv(hsv_colorspace, rgba);
-                        hsv.a = calculate_brightness(rgba, brightness_type);
-                        hsv_to_info(hsv, info);
-                    }
-                }
-            }
-
-            int num = info.box.w() * info.box.h();
-            info.rgba.mean.r /= num;
-            info.rgba.mean.g /= num;
-            info.rgba.mean.b /= num;
-            info.rgba.mean.a /= num;
-
-            info.rgba.diff.r = info.rgba.max.r - info.rgba.min.r;
-            info.rgba.diff.g = info.rgba.max.g - info.rgba.min.g;
-            info.rgba.diff.b = info.rgba.max.b - info.rgba.min.b;
-            info.rgba.diff.a = info.rgba.max.a - info.rgba.min.a;
-
-            info.hsv.mean.r /= num;
-            info.hsv.mean.g /= num;
-            info.hsv.mean.b /= num;
-            info.hsv.mean.a /= num;
-
-            info.hsv.diff.r = info.hsv.max.r - info.hsv.min.r;
-            info.hsv.diff.g = info.hsv.max.g - info.hsv.min.g;
-            info.hsv.diff.b = info.hsv.max.b - info.hsv.min.b;
-            info.hsv.diff.a = info.hsv.max.a - info.hsv.min.a;
+            return p.colorAreaStats->request(info, p.videoData, options);
         }
 
         void TimelineViewport::_mallocBuffer() const noexcept
@@ -3463,57 +2780,32 @@ namespace mrv
 
             const math::Box2i box = p.colorAreaInfo.box;
 
-            const uint32_t x = box.x();
-            const uint32_t y = box.y();
             const uint32_t w = box.w();
             const uint32_t h = box.h();
 
-            for (int Y = 0; Y < h; ++Y)
+            const area::FrameDecoder decoder(
+                p.videoData, p.displayOptions[0].mirror);
+            image::Color4f* data = reinterpret_cast<image::Color4f*>(p.image);
+            auto rows = [&](size_t begin, size_t end)
             {
-                for (int X = 0; X < w; ++X)
+                std::vector<image::Color4f> scratch;
+                for (size_t Y = begin; Y < end; ++Y)
                 {
-                    float* data = reinterpret_cast<float*>(p.image);
-                    image::Color4f& rgba = (image::Color4f&)data[(X + w * Y) * 4];
-                    rgba.r = rgba.g = rgba.b = rgba.a = 0.f;
-
-                    math::Vector2i pos(X + x, Y + y);
-                    for (const auto& video : p.videoData)
-                    {
-                        for (const auto& layer : video.layers)
-                        {
-                            image::Color4f pixel, pixelB;
-
-                            const auto image = layer.image;
-                            if (image && image->isValid())
-                                _getPixelValue(pixel, image, pos);
-
-                            const auto imageB = layer.imageB;
-                            if (imageB && imageB->isValid())
-                            {
-                                _getPixelValue(pixelB, imageB, pos);
-
-                                if (layer.transition ==
-                                    timeline::Transition::Dissolve)
-                                {
-                                    float f2 = layer.transitionValue;
-                                    float f = 1.0 - f2;
-                                    pixel.r = pixel.r * f + pixelB.r * f2;
-                                    pixel.g = pixel.g * f + pixelB.g * f2;
-                                    pixel.b = pixel.b * f + pixelB.b * f2;
-                                    pixel.a = pixel.a * f + pixelB.a * f2;
-                                }
-                            }
-                            rgba.r += pixel.r;
-                            rgba.g += pixel.g;
-                            rgba.b += pixel.b;
-                            rgba.a += pixel.a;
-                        }
+                    image::Color4f* row = data + Y * w;
+                    decoder.decode(
+                        math::Vector2i(
+                            box.min.x, box.min.y + static_cast<int>(Y)),
+                        w, row, scratch);
 #ifdef OPENGL_BACKEND
-                        std::swap(rgba.r, rgba.b);
+                    for (uint32_t X = 0; X < w; ++X)
+                        std::swap(row[X].r, row[X].b);
 #endif
-                    }
                 }
-            }
+            };
+            const size_t rowsPerChunk = std::max(
+                static_cast<size_t>(64 * 1024) / std::max(w, 1U),
+                static_cast<size_t>(1));
+            io::ThreadPool::getGlobal()->parallelFor(h, rowsPerChunk, rows);
         }
 
         void TimelineViewport::_unmapBuffer() const noexcept
@@ -552,12 +552,7 @@ namespace mrv
                 image::Color4f& rgba,
                 const std::shared_ptr<image::Image>& image,
                 const math::Vector2i& pos) const noexcept;
-            void _calculateColorAreaRawValues(area::Info& info) const noexcept;
-
-            void hsv_to_info(
-                const image::Color4f& hsv, area::Info& info) const noexcept;
-            image::Color4f rgba_to_hsv(
-                int hsv_colorspace, image::Color4f& rgba) const noexcept;
+            bool _calculateColorAreaRawValues(area::Info& info) const noexcept;
 
             void _scrub(float change) noexcept;
 
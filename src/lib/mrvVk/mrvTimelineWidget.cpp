@@ -19,6 +19,7 @@
 #include "mrvVk/mrvTimelineWidget.h"
 
 #include "mrvCore/mrvFile.h"
+#include "mrvCore/mrvHome.h"
 #include "mrvCore/mrvHotkey.h"
 #include "mrvCore/mrvTimeObject.h"
 
@@ -266,7 +267,10 @@ namespace mrv
                 context->addSystem(timelineui_vk::ThumbnailSystem::create(context, ctx));
             }
 
-            p.thumbnailSystem = context->getSystem<timelineui_vk::ThumbnailSystem>();
+            auto thumbnailSystem = context->getSystem<timelineui_vk::ThumbnailSystem>();
+            p.thumbnailSystem = thumbnailSystem;
+            setThumbnailDiskCache(
+                settings->getValue<bool>("Cache/ThumbnailDiskCache"));
 
             setStopOnScrub(false);
 
@@ -671,6 +675,18 @@ namespace mrv
             _p->timelineWidget->setDisplayOptions(p.displayOptions);
         }
 
+        void TimelineWidget::setThumbnailDiskCache(bool value)
+        {
+            TLRENDER_P();
+            if (auto thumbnailSystem = p.thumbnailSystem.lock())
+            {
+                // Keep the thumbnails and waveforms on disk so the timeline
+                // is drawn right away when a session is opened again.
+                thumbnailSystem->getCache()->setDiskCacheDir(
+                    value ? cachepath() + "thumbnails" : std::string());
+            }
+        }
+
         void TimelineWidget::setMouseWheelScale(float value)
         {
             _p->timelineWidget->setMouseWheelScale(value);
@@ -783,6 +799,8 @@ namespace mrv
 
             p.vbo.reset();
             p.vao.reset();
+
+            _removePipelineCache();
         }
 
         void TimelineWidget::hide()
@@ -43,6 +43,7 @@
 
 #include <tlTimelineVk/RenderPrivate.h>
 
+#include <tlVk/PipelineCache.h>
 #include <tlVk/PipelineCreationState.h>
 #include <tlVk/OffscreenBuffer.h>
 #include <tlVk/Init.h>
@@ -543,6 +544,8 @@ namespace mrv
                 vk.annotation_pipeline_layout = VK_NULL_HANDLE;
             }
 
+            _removePipelineCache();
+
             VkWindow::destroy();
         }
 
@@ -1480,8 +1483,9 @@ namespace mrv
                     {
                         if (panel::colorAreaPanel)
                         {
-                            _calculateColorArea(p.colorAreaInfo);
-                            panel::colorAreaPanel->update(p.colorAreaInfo);
+                            if (_calculateColorArea(p.colorAreaInfo))
+                                panel::colorAreaPanel->update(
+                                    p.colorAreaInfo);
                         }
                         if (panel::histogramPanel)
                         {
@@ -1508,145 +1512,77 @@ namespace mrv
 
             // After first run, we can read pixels.
             vk.readPixels = true;
+
+            if (!vk.firstFrameLogged)
+            {
+                vk.firstFrameLogged = true;
+                const auto now = std::chrono::steady_clock::now();
+                const auto stats = vlk::getPipelineCacheStats(device());
+                const std::string msg =
+                    string::Format(
+                        _("First frame drawn in {0} ms (pipeline cache: "
+                          "{1} KB loaded in {2} ms, {3} pipelines created in "
+                          "{4} ms)."))
+                        .arg(std::chrono::duration_cast<
+                                 std::chrono::milliseconds>(
+                                 now - vk.startTime)
+                                 .count())
+                        .arg(stats.loadByteCount / 1024)
+                        .arg(stats.loadTime.count() / 1000)
+                        .arg(stats.pipelineCount)
+                        .arg(stats.pipelineTime.count() / 1000);
+                LOG_INFO(msg);
+            }
         }
 
 
-        void Viewport::_calculateColorAreaFullValues(area::Info& info) noexcept
+        bool Viewport::_calculateColorAreaFullValues(
+            area::Info& info) noexcept
         {
             TLRENDER_P();
-            MRV2_VK();
             if (!p.image)
-                return;
+                return false;
 
             PixelToolBarClass* c = p.ui->uiPixelWindow;
-            BrightnessType brightness_type =
-                (BrightnessType)c->uiLType->value();
-            int hsv_colorspace = c->uiBColorType->value() + 1;
-
-            const uint32_t W = info.box.w();
-            const uint32_t H = info.box.h();
+            area::StatsOptions options;
+            options.colorSpace = c->uiBColorType->value() + 1;
+            options.brightnessType = (BrightnessType)c->uiLType->value();
 
-            const uint8_t* ptr = reinterpret_cast<const uint8_t*>(p.image);
-            const int channelCount = image::getChannelCount(info.pixelType);
-            const int byteCount = image::getBitDepth(info.pixelType) / 8;
-
-            const size_t dataSize = W * H;
-
-            image::Color4f rgba, hsv;
-
-            for (size_t i = 0; i < dataSize; ++i)
+            area::BufferOptions bufferOptions;
+            bufferOptions.pixelType = info.pixelType;
+            if (colorSpace() == VK_COLOR_SPACE_HDR10_ST2084_EXT)
             {
-                rgba = color::fromVoidPtr(ptr, info.pixelType);
-
-                if (colorSpace() == VK_COLOR_SPACE_HDR10_ST2084_EXT)
+                switch (c->uiPixelValue->value())
                 {
-                    switch(p.ui->uiPixelWindow->uiPixelValue->value())
-                    {
-                    case PixelValue::kLinear:
-                        rgba = color::pqToLinear(rgba);
-                        break;
-                    case PixelValue::kNits:
-                        rgba = color::pqToNits(rgba);
-                        break;
-                    case PixelValue::kFull:
-                        break;
-                    default:
-                        break;
-                    }
+                case PixelValue::kLinear:
+                    bufferOptions.transfer = area::BufferTransfer::kPQToLinear;
+                    break;
+                case PixelValue::kNits:
+                    bufferOptions.transfer = area::BufferTransfer::kPQToNits;
+                    break;
+                default:
+                    break;
                 }
+            }
 
-
-                info.rgba.mean.r += rgba.r;
-                info.rgba.mean.g += rgba.g;
-                info.rgba.mean.b += rgba.b;
-                info.rgba.mean.a += rgba.a;
-
-                if (rgba.r < info.rgba.min.r)
-                    info.rgba.min.r = rgba.r;
-                if (rgba.g < info.rgba.min.g)
-                    info.rgba.min.g = rgba.g;
-                if (rgba.b < info.rgba.min.b)
-                    info.rgba.min.b = rgba.b;
-                if (rgba.a < info.rgba.min.a)
-                    info.rgba.min.a = rgba.a;
-
-                if (rgba.r > info.rgba.max.r)
-                    info.rgba.max.r = rgba.r;
-                if (rgba.g > info.rgba.max.g)
-                    info.rgba.max.g = rgba.g;
-                if (rgba.b > info.rgba.max.b)
-                    info.rgba.max.b = rgba.b;
-                if (rgba.a > info.rgba.max.a)
-                    info.rgba.max.a = rgba.a;
-
-                hsv = rgba_to_hsv(hsv_colorspace, rgba);
-                hsv.a = calculate_brightness(rgba, brightness_type);
-                hsv_to_info(hsv, info);
-
-                ptr += channelCount * byteCount;
-            }
-
-            info.rgba.mean.r /= dataSize;
-            info.rgba.mean.g /= dataSize;
-            info.rgba.mean.b /= dataSize;
-            info.rgba.mean.a /= dataSize;
-
-            info.rgba.diff.r = info.rgba.max.r - info.rgba.min.r;
-            info.rgba.diff.g = info.rgba.max.g - info.rgba.min.g;
-            info.rgba.diff.b = info.rgba.max.b - info.rgba.min.b;
-            info.rgba.diff.a = info.rgba.max.a - info.rgba.min.a;
-
-            info.hsv.mean.r /= dataSize;
-            info.hsv.mean.g /= dataSize;
-            info.hsv.mean.b /= dataSize;
-            info.hsv.mean.a /= dataSize;
-
-            info.hsv.diff.r = info.hsv.max.r - info.hsv.min.r;
-            info.hsv.diff.g = info.hsv.max.g - info.hsv.min.g;
-            info.hsv.diff.b = info.hsv.max.b - info.hsv.min.b;
-            info.hsv.diff.a = info.hsv.max.a - info.hsv.min.a;
+            return p.colorAreaStats->request(
+                info, reinterpret_cast<const uint8_t*>(p.image), bufferOptions,
+                options);
         }
 
-        void Viewport::_calculateColorArea(area::Info& info)
+        bool Viewport::_calculateColorArea(area::Info& info)
         {
             TLRENDER_P();
             MRV2_VK();
 
-            info.rgba.max.r = std::numeric_limits<float>::min();
-            info.rgba.max.g = std::numeric_limits<float>::min();
-            info.rgba.max.b = std::numeric_limits<float>::min();
-            info.rgba.max.a = std::numeric_limits<float>::min();
-
-            info.rgba.min.r = std::numeric_limits<float>::max();
-            info.rgba.min.g = std::numeric_limits<float>::max();
-            info.rgba.min.b = std::numeric_limits<float>::max();
-            info.rgba.min.a = std::numeric_limits<float>::max();
-
-            info.rgba.mean.r = info.rgba.mean.g = info.rgba.mean.b =
-                info.rgba.mean.a = 0.F;
-
-            info.hsv.max.r = std::numeric_limits<float>::min();
-            info.hsv.max.g = std::numeric_limits<float>::min();
-            info.hsv.max.b = std::numeric_limits<float>::min();
-            info.hsv.max.a = std::numeric_limits<float>::min();
-
-            info.hsv.min.r = std::numeric_limits<float>::max();
-            info.hsv.min.g = std::numeric_limits<float>::max();
-            info.hsv.min.b = std::numeric_limits<float>::max();
-            info.hsv.min.a = std::numeric_limits<float>::max();
-
-            info.hsv.mean.r = info.hsv.mean.g = info.hsv.mean.b =
-                info.hsv.mean.a = 0.F;
-
             switch(p.ui->uiPixelWindow->uiPixelValue->value())
             {
             case PixelValue::kLinear:
             case PixelValue::kFull:
             case PixelValue::kNits:
-                _calculateColorAreaFullValues(info);
-                break;
+                return _calculateColorAreaFullValues(info);
             default:
-                _calculateColorAreaRawValues(info);
+                return _calculateColorAreaRawValues(info);
             }
         }
 
@@ -1702,7 +1638,7 @@ namespace mrv
                             _getPixelValue(pixel, image, pos);
                         }
 
-                        const auto& imageB = layer.image;
+                        const auto& imageB = layer.imageB;
                         if (imageB && imageB->isValid())
                         {
                             _getPixelValue(pixelB, imageB, pos);
@@ -76,7 +76,7 @@ namespace mrv
 
             math::Matrix4x4f _createTexturedRectangle();
 
-            void _calculateColorArea(mrv::area::Info& info);
+            bool _calculateColorArea(mrv::area::Info& info);
 
             void _drawAnaglyph(int, int) const noexcept;
 
@@ -169,7 +169,7 @@ namespace mrv
                 const float alphamult = 1.F,
                 const float resolutionMultiplier = 1.F) noexcept;
 
-            void _calculateColorAreaFullValues(area::Info& info) noexcept;
+            bool _calculateColorAreaFullValues(area::Info& info) noexcept;
 
             void _drawWindowArea(const std::string& pipelineName,
                                  const std::string&) noexcept;
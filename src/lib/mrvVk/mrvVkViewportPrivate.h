@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <tlVk/Mesh.h>
@@ -76,6 +77,11 @@ namespace mrv
             std::shared_ptr<vulkan::Lines> viewport;
             
             bool init_debug = false;
+
+            //! Startup timing, logged when the first frame is drawn.
+            std::chrono::steady_clock::time_point startTime =
+                std::chrono::steady_clock::now();
+            bool firstFrameLogged = false;
         };
 
     } // namespace vulkan
@@ -15,6 +15,10 @@
 
 #include "mrvVk/mrvVkWindow.h"
 
+#include "mrvCore/mrvHome.h"
+
+#include <tlVk/PipelineCache.h>
+
 namespace mrv
 {
     namespace vulkan
@@ -40,6 +44,14 @@ namespace mrv
         // m_depth (optionally) -> creates m_renderPass
         void VkWindow::prepare_render_pass()
         {
+            if (_pipelineCacheDevice == VK_NULL_HANDLE)
+            {
+                _pipelineCacheDevice = device();
+                tl::vlk::addPipelineCache(
+                    _pipelineCacheDevice, ctx.gpu,
+                    cachepath() + "vk_pipeline_cache.bin");
+            }
+
             if (m_renderPass != VK_NULL_HANDLE &&
                 _oldRenderPassFormat == ctx.format)
             {
@@ -150,6 +162,15 @@ namespace mrv
         }
 
 
+        void VkWindow::_removePipelineCache()
+        {
+            if (_pipelineCacheDevice != VK_NULL_HANDLE)
+            {
+                tl::vlk::removePipelineCache(_pipelineCacheDevice);
+                _pipelineCacheDevice = VK_NULL_HANDLE;
+            }
+        }
+
         void VkWindow::show()
         {
             Fl_Vk_Window::show();
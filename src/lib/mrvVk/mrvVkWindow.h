@@ -37,11 +37,18 @@ namespace mrv
             void set_window_transparency(double alpha);
 #endif
             //! Main swapchain render pass (common to all Vulkan windows).
+            //! This also adds a reference to the pipeline cache of the
+            //! device.
             void prepare_render_pass(); 
 
+            //! Remove the reference to the pipeline cache of the device,
+            //! saving it to disk.  Call from destroy().
+            void _removePipelineCache();
+
             void _init();
 
             VkFormat _oldRenderPassFormat = VK_FORMAT_UNDEFINED;
+            VkDevice _pipelineCacheDevice = VK_NULL_HANDLE;
         };
 
     } // namespace vulkan
@@ -3,16 +3,11 @@
 // Copyright Contributors to the mrv2 Project. All rights reserved.
 
 
-#include "mrvCore/mrvBackend.h"
-
 #include "mrvWidgets/mrvHistogram.h"
 
-#include "mrViewer.h"
-
-#include "mrvCore/mrvColor.h"
 #include "mrvOS/mrvI8N.h"
 
-#include <tlCore/Math.h>
+#include <cmath>
 
 #include <FL/Enumerations.H>
 #include <FL/fl_draw.H>
@@ -24,88 +19,39 @@ namespace mrv
         Fl_Box(X, Y, W, H, L),
         _channel(kRGB),
         _histtype(kLog),
-        maxLumma(0),
-        maxColor(0)
+        _client(std::make_shared<scope::Client>(this)),
+        ui(nullptr)
     {
         tooltip(_("Mark an area in the image with SHIFT + the left mouse "
                   "button"));
     }
 
+    Histogram::~Histogram()
+    {
+        _client->detach();
+    }
+
     void Histogram::draw()
     {
         fl_antialias(0);
         fl_rectf(x(), y(), w(), h(), 0, 0, 0);
-        if (maxLumma > 0)
-            draw_pixels();
+        auto result = _client->getResult();
+        if (result && result->histogram.maxLumma > 0)
+            draw_pixels(result->histogram);
         fl_antialias(1);
     }
 
-    void Histogram::count_pixel(const uint8_t* rgb) noexcept
-    {
-        uint8_t r = rgb[0];
-        uint8_t g = rgb[1];
-        uint8_t b = rgb[2];
-
-        ++red[r];
-        if (red[r] > maxColor)
-            maxColor = red[r];
-
-        ++green[g];
-        if (green[g] > maxColor)
-            maxColor = green[g];
-
-        ++blue[b];
-        if (blue[b] > maxColor)
-            maxColor = blue[b];
-
-        unsigned int lum = unsigned(r * 0.30f + g * 0.59f + b * 0.11f);
-        lumma[lum] += 1;
-        if (lumma[lum] > maxLumma)
-            maxLumma = lumma[lum];
-    }
-
     void Histogram::update(const area::Info& info)
     {
-        using namespace tl;
-        
-        MyViewport* view = ui->uiView;
-        const auto& renderSize = view->getRenderSize();
-        const void* image = view->image();
-
-        maxColor = maxLumma = 0;
-        memset(red, 0, sizeof(float) * 256);
-        memset(green, 0, sizeof(float) * 256);
-        memset(blue, 0, sizeof(float) * 256);
-        memset(lumma, 0, sizeof(float) * 256);
-
-        if (!image || !renderSize.isValid())
+        scope::Request request;
+        if (!scope::initRequest(request, ui, info))
         {
+            _client->clear();
             redraw();
             return;
         }
-
-        size_t dataSize = info.box.w() * info.box.h();            
-        const int channelCount = image::getChannelCount(info.pixelType);
-        const int byteCount = image::getBitDepth(info.pixelType) / 8;
-
-        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(image); 
-        image::Color4f pixel;
-        uint8_t rgb[3];
-        for (size_t i = 0; i < dataSize; ++i)
-        {
-            pixel = color::fromVoidPtr(ptr, info.pixelType);
-#ifdef OPENGL_BACKEND
-            std::swap(pixel.r, pixel.b);
-#endif
-            rgb[0] = (uint8_t)math::clamp(pixel.r * 255.0f, 0.f, 255.f);
-            rgb[1] = (uint8_t)math::clamp(pixel.g * 255.0f, 0.f, 255.f);
-            rgb[2] = (uint8_t)math::clamp(pixel.b * 255.0f, 0.f, 255.f);
-
-            count_pixel(rgb);
-            ptr += channelCount * byteCount;
-        }
-
-        redraw();
+        request.histogram = true;
+        scope::Service::getGlobal()->request(_client, request);
     }
 
     float Histogram::histogram_scale(float val, float maxVal) const noexcept
@@ -122,8 +68,14 @@ namespace mrv
         }
     }
 
-    void Histogram::draw_pixels() const noexcept
+    void Histogram::draw_pixels(const scope::Histogram& histogram) const noexcept
     {
+        const float maxLumma = histogram.maxLumma;
+        const float maxColor = histogram.maxColor;
+        const float* lumma = histogram.lumma;
+        const float* red = histogram.red;
+        const float* green = histogram.green;
+        const float* blue = histogram.blue;
 
         // Draw the pixel info
         int W = w() - 8 - 3;
@@ -8,6 +8,8 @@
 
 #include <tlCore/Util.h>
 
+#include "mrvWidgets/mrvScopes.h"
+
 #include "mrvCore/mrvColorAreaInfo.h"
 
 class ViewerUI;
@@ -35,6 +37,7 @@ namespace mrv
 
     public:
         Histogram(int X, int Y, int W, int H, const char* L = 0);
+        ~Histogram();
 
         void channel(Channel c)
         {
@@ -58,23 +61,15 @@ namespace mrv
         ViewerUI* main() { return ui; };
 
     protected:
-        void draw_pixels() const noexcept;
-
-        void count_pixel(const uint8_t* rgb) noexcept;
+        void draw_pixels(const scope::Histogram&) const noexcept;
 
         inline float histogram_scale(float val, float maxVal) const noexcept;
 
         Channel _channel;
         Type _histtype;
 
-        float maxLumma;
-        float lumma[256];
-
-        float maxColor;
-
-        float red[256];
-        float green[256];
-        float blue[256];
+        //! The bins are counted in the background by the scope service.
+        std::shared_ptr<scope::Client> _client;
 
         ViewerUI* ui;
     };
@@ -32,10 +32,10 @@ namespace mrv
         Fl_Group::current(0);
         w = new Fl_Double_Window(
             main->x() + main->w() / 2 - 320,
-            main->y() + main->h() / 2 - 120 / 2, 640, 120);
-        w->size_range(640, 120);
+            main->y() + main->h() / 2 - 150 / 2, 640, 150);
+        w->size_range(640, 150);
         w->begin();
-        Fl_Group* g = new Fl_Group(0, 0, w->w(), 120);
+        Fl_Group* g = new Fl_Group(0, 0, w->w(), 150);
         g->begin();
         g->box(FL_UP_BOX);
         progress = new Fl_Progress(20, 20, g->w() - 40, 40);
@@ -58,6 +58,9 @@ namespace mrv
         fps->box(FL_FLAT_BOX);
         fps->textcolor(FL_BLACK);
         fps->set_output(); // needed so no selection appears
+        info = new Fl_Box(20, 115, g->w() - 40, 20);
+        info->labelsize(14);
+        info->align(FL_ALIGN_INSIDE | FL_ALIGN_LEFT);
         g->end();
         w->resizable(w);
         w->set_modal();
@@ -74,6 +77,7 @@ namespace mrv
         w = nullptr;
         progress = nullptr;
         fps = nullptr;
+        info = nullptr;
         remain = nullptr;
         elapsed = nullptr;
         tcp->unlock();
@@ -99,6 +103,12 @@ namespace mrv
             progress->copy_label(title);
     }
 
+    void ProgressReport::set_info(const char* value)
+    {
+        if (info)
+            info->copy_label(value);
+    }
+
     void ProgressReport::show()
     {
         w->show();
@@ -179,6 +189,7 @@ namespace mrv
             w = nullptr;
             progress = nullptr;
             fps = nullptr;
+            info = nullptr;
             remain = nullptr;
             elapsed = nullptr;
             tcp->unlock();
@@ -7,6 +7,7 @@
 class Fl_Window;
 class Fl_Progress;
 class Fl_Output;
+class Fl_Box;
 
 namespace mrv
 {
@@ -27,6 +28,10 @@ namespace mrv
         void set_value(int64_t);
 
         void set_title(const char* title);
+
+        //! Set an additional line of information, like the time spent in
+        //! each stage.
+        void set_info(const char* info);
         void set_start(int64_t start);
         void set_end(int64_t end);
 
@@ -43,6 +48,7 @@ namespace mrv
         Fl_Output* elapsed;
         Fl_Output* remain;
         Fl_Output* fps;
+        Fl_Box* info;
 
         int64_t _frame;
         int64_t _end;
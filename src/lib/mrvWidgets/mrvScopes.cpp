@@ -0,0 +1,677 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#include "mrvCore/mrvBackend.h"
+
+#include "mrvWidgets/mrvScopes.h"
+
+#include "mrViewer.h"
+
+#include "mrvCore/mrvColor.h"
+#include "mrvCore/mrvColorSpaces.h"
+
+#include <tlIO/ThreadPool.h>
+
+#include <tlCore/Math.h>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Widget.H>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <thread>
+
+namespace mrv
+{
+    namespace scope
+    {
+        namespace
+        {
+            image::Color4f
+            toYCbCr(const image::Color4f& src, VectorscopeMethod method)
+            {
+                switch (method)
+                {
+                case VectorscopeMethod::ITU709:
+                    return color::rgb::to_ITU709(src);
+                case VectorscopeMethod::Rec2020:
+                    return color::rgb::to_Rec2020(src);
+                case VectorscopeMethod::ITU601:
+                default:
+                    return color::rgb::to_ITU601(src);
+                }
+            }
+
+            inline float oetf709(float L)
+            {
+                return (L < 0.018053968510807f)
+                           ? 4.5f * L
+                           : 1.0993f * std::pow(L, 0.45f) - 0.0993f;
+            }
+
+            inline float eotfSRGB(float V)
+            {
+                return (V <= 0.04045f) ? V / 12.92f
+                                       : std::pow((V + 0.055f) / 1.055f, 2.4f);
+            }
+
+            inline void multiply(const double M[3][3], image::Color4f& c)
+            {
+                const double r = M[0][0] * c.r + M[0][1] * c.g + M[0][2] * c.b;
+                const double g = M[1][0] * c.r + M[1][1] * c.g + M[1][2] * c.b;
+                const double b = M[2][0] * c.r + M[2][1] * c.g + M[2][2] * c.b;
+                c.r = static_cast<float>(std::max(0.0, r));
+                c.g = static_cast<float>(std::max(0.0, g));
+                c.b = static_cast<float>(std::max(0.0, b));
+            }
+
+            inline void
+            plot(Plot& plot, int X, int Y, uint8_t r, uint8_t g, uint8_t b)
+            {
+                uint8_t* p = plot.data.data() + (Y * plot.w + X) * 4;
+                p[0] = r;
+                p[1] = g;
+                p[2] = b;
+                p[3] = 255;
+            }
+
+            void waveformSample(
+                Plot& plot, const image::Color4f& rgba, int column,
+                const WaveformOptions& options, DisplaySpace displaySpace)
+            {
+                float luma = calculate_brightness(rgba, kAsLuminance);
+                if (options.hdrMode)
+                {
+                    switch (displaySpace)
+                    {
+                    case DisplaySpace::ST2084:
+                        // Display 2084 Nonlinear uses PQ transfer function.
+                        // We map the non-linear luma back to linear space.
+                        luma = color::pqToLinear(luma, 203.F);
+                        break;
+                    case DisplaySpace::DisplayP3:
+                        // Display P3 Nonlinear uses the sRGB transfer
+                        // function.
+                        luma = color::srgbToLinear(luma);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+
+                const float norm = luminanceToNorm(
+                    luma, options.hdrMode, options.hdrMaxValue,
+                    options.hdrLogScale);
+
+                // norm == 0 → bottom of the plot, norm == 1 → top
+                const int Y = plot.h - static_cast<int>(norm * plot.h);
+                if (Y < 0 || Y >= plot.h)
+                    return;
+
+                float dr = math::clamp(rgba.r, 0.f, 1.f);
+                float dg = math::clamp(rgba.g, 0.f, 1.f);
+                float db = math::clamp(rgba.b, 0.f, 1.f);
+                if (options.hdrMode)
+                {
+                    // Blend super-white channels toward white so the
+                    // operator can clearly see which columns contain HDR
+                    // data.
+                    const float blend = math::clamp(luma - 1.f, 0.f, 1.f);
+                    dr = dr + (1.f - dr) * blend;
+                    dg = dg + (1.f - dg) * blend;
+                    db = db + (1.f - db) * blend;
+                }
+
+                scope::plot(
+                    plot, column, Y, static_cast<uint8_t>(dr * 255.f),
+                    static_cast<uint8_t>(dg * 255.f),
+                    static_cast<uint8_t>(db * 255.f));
+            }
+
+            void vectorscopeSample(
+                Plot& plot, const image::Color4f& color,
+                const VectorscopeOptions& options, DisplaySpace displaySpace)
+            {
+                // See Vectorscope::setReferenceWhiteNits() for the HDR
+                // normalisation.
+                image::Color4f chromaInput = color;
+                bool sdrConverted = false;
+
+                if (DisplaySpace::ST2084 == displaySpace &&
+                    options.referenceWhiteLinear > 0.f)
+                {
+                    // PQ EOTF → linear BT.2020 (1 = 10 000 nits).
+                    chromaInput.r = color::inverse_st2084_eotf(chromaInput.r);
+                    chromaInput.g = color::inverse_st2084_eotf(chromaInput.g);
+                    chromaInput.b = color::inverse_st2084_eotf(chromaInput.b);
+
+                    const float inv = 1.f / options.referenceWhiteLinear;
+                    if (VectorscopeMethod::Rec2020 == options.method)
+                    {
+                        chromaInput.r *= inv;
+                        chromaInput.g *= inv;
+                        chromaInput.b *= inv;
+                    }
+                    else
+                    {
+                        // BT.2020 linear → BT.709 linear (D65).
+                        static constexpr double M[3][3] = {
+                            {1.66049100, -0.58764114, -0.07284987},
+                            {-0.12455047, 1.13288989, -0.00833942},
+                            {-0.01815076, -0.10057889, 1.11872966}};
+                        multiply(M, chromaInput);
+
+                        // SDR reference white → 1.0, then the BT.709 OETF as
+                        // the YCbCr matrices are defined for R'G'B'.
+                        chromaInput.r = oetf709(
+                            math::clamp(chromaInput.r * inv, 0.f, 1.f));
+                        chromaInput.g = oetf709(
+                            math::clamp(chromaInput.g * inv, 0.f, 1.f));
+                        chromaInput.b = oetf709(
+                            math::clamp(chromaInput.b * inv, 0.f, 1.f));
+                        sdrConverted = true;
+                    }
+                }
+                else if (DisplaySpace::DisplayP3 == displaySpace)
+                {
+                    // sRGB EOTF → linear Display P3.
+                    chromaInput.r = eotfSRGB(chromaInput.r);
+                    chromaInput.g = eotfSRGB(chromaInput.g);
+                    chromaInput.b = eotfSRGB(chromaInput.b);
+
+                    if (VectorscopeMethod::Rec2020 == options.method)
+                    {
+                        // Display P3 linear → BT.2020 linear (D65).
+                        static constexpr double M[3][3] = {
+                            {0.75383303, 0.19859737, 0.04756960},
+                            {0.04574385, 0.94177722, 0.01247893},
+                            {-0.00121034, 0.01760243, 0.98360900}};
+                        multiply(M, chromaInput);
+                    }
+                    else
+                    {
+                        // Display P3 linear → BT.709 linear (D65).
+                        static constexpr double M[3][3] = {
+                            {1.22494018, -0.22494018, 0.00000000},
+                            {-0.04205695, 1.04205695, 0.00000000},
+                            {-0.01963755, -0.07863605, 1.09827360}};
+                        multiply(M, chromaInput);
+                        chromaInput.r = oetf709(chromaInput.r);
+                        chromaInput.g = oetf709(chromaInput.g);
+                        chromaInput.b = oetf709(chromaInput.b);
+                        sdrConverted = true;
+                    }
+                }
+
+                const image::Color4f ycbcr =
+                    toYCbCr(chromaInput, options.method);
+                const float cbNorm = ycbcr.g / options.chromaNorm;
+                const float crNorm = ycbcr.b / options.chromaNorm;
+
+                // Keeps the targets comfortably inside.
+                constexpr float kScale = 0.85f;
+
+                const int diameter = options.diameter;
+                const float R = diameter / 2.0f;
+                const int offX = math::clamp(
+                    static_cast<int>(cbNorm * R * kScale), -diameter,
+                    diameter);
+                const int offY = math::clamp(
+                    static_cast<int>(-crNorm * R * kScale), -diameter,
+                    diameter);
+                const int posX = diameter / 2 + offX;
+                const int posY = diameter / 2 + offY;
+
+                float dr = color.r, dg = color.g, db = color.b;
+                if (VectorscopeMethod::Rec2020 == options.method)
+                {
+                    // A 2.2 gamma so the dots look vibrant on an SDR UI,
+                    // highlights bloom toward white.
+                    dr = std::pow(std::max(0.f, chromaInput.r), 1.f / 2.2f);
+                    dg = std::pow(std::max(0.f, chromaInput.g), 1.f / 2.2f);
+                    db = std::pow(std::max(0.f, chromaInput.b), 1.f / 2.2f);
+                }
+                else if (sdrConverted)
+                {
+                    dr = chromaInput.r;
+                    dg = chromaInput.g;
+                    db = chromaInput.b;
+                }
+                dr = math::clamp(dr, 0.f, 1.f);
+                dg = math::clamp(dg, 0.f, 1.f);
+                db = math::clamp(db, 0.f, 1.f);
+                const uint8_t r8 = static_cast<uint8_t>(dr * 255.f);
+                const uint8_t g8 = static_cast<uint8_t>(dg * 255.f);
+                const uint8_t b8 = static_cast<uint8_t>(db * 255.f);
+
+                const int pixelSize = std::max(diameter / 270, 1);
+                const int x0 = std::max(posX - pixelSize / 2, 0);
+                const int y0 = std::max(posY - pixelSize / 2, 0);
+                const int x1 = std::min(posX - pixelSize / 2 + pixelSize, plot.w);
+                const int y1 = std::min(posY - pixelSize / 2 + pixelSize, plot.h);
+                for (int Y = y0; Y < y1; ++Y)
+                {
+                    for (int X = x0; X < x1; ++X)
+                    {
+                        scope::plot(plot, X, Y, r8, g8, b8);
+                    }
+                }
+            }
+
+            void initPlot(Plot& plot, int w, int h)
+            {
+                plot.w = std::max(w, 0);
+                plot.h = std::max(h, 0);
+                plot.data.assign(plot.w * plot.h * 4, 0);
+            }
+
+            //! Copy the plotted pixels of a partial plot. Later partials
+            //! are drawn over the earlier ones, like the rows were drawn in
+            //! order.
+            void mergePlot(Plot& out, const Plot& in)
+            {
+                const size_t size = out.data.size();
+                if (in.data.size() != size)
+                    return;
+                const uint32_t* src =
+                    reinterpret_cast<const uint32_t*>(in.data.data());
+                uint32_t* dst = reinterpret_cast<uint32_t*>(out.data.data());
+                for (size_t i = 0; i < size / 4; ++i)
+                {
+                    if (src[i])
+                        dst[i] = src[i];
+                }
+            }
+
+            //! Bins and plots of a chunk of rows.
+            struct Partial
+            {
+                uint32_t red[256] = {};
+                uint32_t green[256] = {};
+                uint32_t blue[256] = {};
+                uint32_t lumma[256] = {};
+                Plot waveform;
+                Plot vectorscope;
+            };
+        } // namespace
+
+        DisplaySpace getDisplaySpace(ViewerUI* ui)
+        {
+            DisplaySpace out = DisplaySpace::SDR;
+#ifdef VULKAN_BACKEND
+            if (ui && ui->uiPixelWindow->uiPixelValue->value() !=
+                          PixelValue::kOriginal)
+            {
+                Fl_Vk_Context& ctx = ui->uiView->getContext();
+                if (ctx.colorSpace == VK_COLOR_SPACE_HDR10_ST2084_EXT)
+                    out = DisplaySpace::ST2084;
+                else if (
+                    ctx.colorSpace == VK_COLOR_SPACE_DISPLAY_P3_NONLINEAR_EXT)
+                    out = DisplaySpace::DisplayP3;
+            }
+#endif
+            return out;
+        }
+
+        bool initRequest(Request& out, ViewerUI* ui, const area::Info& info)
+        {
+            const void* viewImage = ui->uiView->image();
+            if (!viewImage || !info.box.isValid())
+                return false;
+
+            out.image = image::Image::create(
+                info.box.w(), info.box.h(), info.pixelType);
+            std::memcpy(
+                out.image->getData(), viewImage,
+                out.image->getDataByteCount());
+#ifdef OPENGL_BACKEND
+            out.swapRB = true;
+#endif
+            out.displaySpace = getDisplaySpace(ui);
+            return true;
+        }
+
+        float luminanceToNorm(
+            float luma, bool hdrMode, float hdrMaxValue, bool hdrLogScale)
+        {
+            if (!hdrMode)
+            {
+                // Original SDR path – clamp to [0, 1].
+                return math::clamp(luma, 0.f, 1.f);
+            }
+
+            if (hdrLogScale)
+            {
+                // Map [0, hdrMaxValue] onto [0, 1] in log2 space.
+                // We add 1 before taking the log so that 0 maps cleanly to 0.
+                const float logMax = std::log2(hdrMaxValue + 1.f);
+                const float norm = std::log2(std::max(luma, 0.f) + 1.f) / logMax;
+                return math::clamp(norm, 0.f, 1.f);
+            }
+            else
+            {
+                // Linear HDR: simply divide by the ceiling value.
+                return math::clamp(luma / hdrMaxValue, 0.f, 1.f);
+            }
+        }
+
+        void calculate(const Request& request, Result& result)
+        {
+            result = Result();
+            const auto& image = request.image;
+            if (!image || !image->isValid())
+                return;
+
+            const int W = image->getWidth();
+            const int H = image->getHeight();
+            const image::PixelType pixelType = image->getPixelType();
+            const size_t pixelByteCount = image::getChannelCount(pixelType) *
+                                          image::getBitDepth(pixelType) / 8;
+            const uint8_t* data = image->getData();
+
+            const WaveformOptions& waveform = request.waveform;
+            const VectorscopeOptions& vectorscope = request.vectorscope;
+            const bool hasWaveform = waveform.enabled &&
+                                     waveform.size.w > 0 &&
+                                     waveform.size.h > 0;
+            const bool hasVectorscope =
+                vectorscope.enabled && vectorscope.diameter > 0;
+
+            // Decimate the image when it is larger than the plots.
+            const int waveformStepX =
+                hasWaveform ? std::max((W - 1) / waveform.size.w, 1) : 1;
+            const int waveformStepY =
+                hasWaveform ? std::max((H - 1) / waveform.size.h, 1) : 1;
+            const int vectorscopeStep =
+                hasVectorscope
+                    ? std::max(
+                          std::max(W - 1, H - 1) / vectorscope.diameter, 1)
+                    : 1;
+
+            // The waveform column of each image column.
+            std::vector<int> columns;
+            if (hasWaveform)
+            {
+                columns.resize(W);
+                for (int X = 0; X < W; ++X)
+                {
+                    const float pct = static_cast<float>(X) / W;
+                    columns[X] = static_cast<int>(pct * waveform.size.w);
+                }
+            }
+
+            // One chunk of rows per thread, so the partial plots don't take
+            // more memory than needed.
+            auto threadPool = io::ThreadPool::getGlobal();
+            const size_t threadCount = threadPool->getThreadCount() + 1;
+            const size_t rowsPerChunk = std::max(
+                (static_cast<size_t>(H) + threadCount - 1) / threadCount,
+                static_cast<size_t>(1));
+            const size_t chunks = (H + rowsPerChunk - 1) / rowsPerChunk;
+            std::vector<Partial> partials(chunks);
+
+            auto rows = [&](size_t begin, size_t end)
+            {
+                Partial& partial = partials[begin / rowsPerChunk];
+                if (hasWaveform)
+                    initPlot(
+                        partial.waveform, waveform.size.w, waveform.size.h);
+                if (hasVectorscope)
+                    initPlot(
+                        partial.vectorscope, vectorscope.diameter,
+                        vectorscope.diameter);
+
+                std::vector<image::Color4f> row(W);
+                std::vector<uint8_t> rgb(W * 3);
+                for (size_t Y = begin; Y < end; ++Y)
+                {
+                    const bool waveformRow =
+                        hasWaveform && 0 == Y % waveformStepY;
+                    const bool vectorscopeRow =
+                        hasVectorscope && 0 == Y % vectorscopeStep;
+                    if (!request.histogram && !waveformRow && !vectorscopeRow)
+                        continue;
+
+                    const uint8_t* p = data + Y * W * pixelByteCount;
+                    if (image::PixelType::RGBA_F32 == pixelType)
+                    {
+                        std::memcpy(
+                            row.data(), p, W * sizeof(image::Color4f));
+                    }
+                    else
+                    {
+                        for (int X = 0; X < W; ++X, p += pixelByteCount)
+                        {
+                            row[X] = color::fromVoidPtr(p, pixelType);
+                        }
+                    }
+                    if (request.swapRB)
+                    {
+                        for (int X = 0; X < W; ++X)
+                            std::swap(row[X].r, row[X].b);
+                    }
+
+                    if (request.histogram)
+                    {
+                        for (int X = 0; X < W; ++X)
+                        {
+                            rgb[X * 3] = static_cast<uint8_t>(
+                                math::clamp(row[X].r * 255.F, 0.F, 255.F));
+                            rgb[X * 3 + 1] = static_cast<uint8_t>(
+                                math::clamp(row[X].g * 255.F, 0.F, 255.F));
+                            rgb[X * 3 + 2] = static_cast<uint8_t>(
+                                math::clamp(row[X].b * 255.F, 0.F, 255.F));
+                        }
+                        for (int X = 0; X < W; ++X)
+                        {
+                            const uint8_t r = rgb[X * 3];
+                            const uint8_t g = rgb[X * 3 + 1];
+                            const uint8_t b = rgb[X * 3 + 2];
+                            ++partial.red[r];
+                            ++partial.green[g];
+                            ++partial.blue[b];
+                            ++partial.lumma[static_cast<unsigned>(
+                                r * 0.30f + g * 0.59f + b * 0.11f)];
+                        }
+                    }
+                    if (waveformRow)
+                    {
+                        for (int X = 0; X < W; X += waveformStepX)
+                        {
+                            waveformSample(
+                                partial.waveform, row[X], columns[X],
+                                waveform, request.displaySpace);
+                        }
+                    }
+                    if (vectorscopeRow)
+                    {
+                        for (int X = 0; X < W; X += vectorscopeStep)
+                        {
+                            vectorscopeSample(
+                                partial.vectorscope, row[X], vectorscope,
+                                request.displaySpace);
+                        }
+                    }
+                }
+            };
+            threadPool->parallelFor(H, rowsPerChunk, rows);
+
+            // Merge the partial results in order.
+            Histogram& histogram = result.histogram;
+            if (hasWaveform)
+                initPlot(result.waveform, waveform.size.w, waveform.size.h);
+            if (hasVectorscope)
+                initPlot(
+                    result.vectorscope, vectorscope.diameter,
+                    vectorscope.diameter);
+            for (const auto& partial : partials)
+            {
+                if (request.histogram)
+                {
+                    for (int i = 0; i < 256; ++i)
+                    {
+                        histogram.red[i] += partial.red[i];
+                        histogram.green[i] += partial.green[i];
+                        histogram.blue[i] += partial.blue[i];
+                        histogram.lumma[i] += partial.lumma[i];
+                    }
+                }
+                if (hasWaveform)
+                    mergePlot(result.waveform, partial.waveform);
+                if (hasVectorscope)
+                    mergePlot(result.vectorscope, partial.vectorscope);
+            }
+            for (int i = 0; i < 256; ++i)
+            {
+                histogram.maxColor = std::max(
+                    {histogram.maxColor, histogram.red[i], histogram.green[i],
+                     histogram.blue[i]});
+                histogram.maxLumma =
+                    std::max(histogram.maxLumma, histogram.lumma[i]);
+            }
+        }
+
+        Client::Client(Fl_Widget* widget) :
+            _widget(widget)
+        {
+        }
+
+        void Client::detach()
+        {
+            _widget = nullptr;
+            clear();
+        }
+
+        void Client::clear()
+        {
+            ++_generation;
+            std::unique_lock<std::mutex> lock(_mutex);
+            _result.reset();
+        }
+
+        std::shared_ptr<Result> Client::getResult() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _result;
+        }
+
+        void Client::_setResult(
+            const std::shared_ptr<Result>& value, uint64_t generation)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (generation == _generation)
+            {
+                _result = value;
+            }
+        }
+
+        void Client::_ready_cb(void* data)
+        {
+            auto weak = static_cast<std::weak_ptr<Client>*>(data);
+            if (auto client = weak->lock())
+            {
+                if (client->_widget)
+                    client->_widget->redraw();
+            }
+            delete weak;
+        }
+
+        struct Service::Private
+        {
+            struct Pending
+            {
+                Request request;
+                uint64_t generation = 0;
+            };
+            std::map<
+                std::weak_ptr<Client>, Pending,
+                std::owner_less<std::weak_ptr<Client> > >
+                pending;
+            bool running = true;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::thread thread;
+        };
+
+        Service::Service() :
+            _p(new Private)
+        {
+            _p->thread = std::thread([this] { _run(); });
+        }
+
+        Service::~Service()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_one();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+        }
+
+        std::shared_ptr<Service> Service::getGlobal()
+        {
+            static std::shared_ptr<Service> service(new Service);
+            return service;
+        }
+
+        void Service::request(
+            const std::shared_ptr<Client>& client, const Request& request)
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.pending[client] = {request, client->_generation};
+            }
+            p.cv.notify_one();
+        }
+
+        void Service::_run()
+        {
+            TLRENDER_P();
+            while (true)
+            {
+                std::weak_ptr<Client> weak;
+                Private::Pending pending;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this] { return !_p->pending.empty() || !_p->running; });
+                    if (!p.running)
+                        break;
+                    auto i = p.pending.begin();
+                    weak = i->first;
+                    pending = std::move(i->second);
+                    p.pending.erase(i);
+                }
+                if (weak.expired())
+                    continue;
+
+                auto result = std::make_shared<Result>();
+                try
+                {
+                    calculate(pending.request, *result);
+                }
+                catch (const std::exception&)
+                {
+                    continue;
+                }
+
+                if (auto client = weak.lock())
+                {
+                    client->_setResult(result, pending.generation);
+                    Fl::awake(Client::_ready_cb, new std::weak_ptr<Client>(weak));
+                }
+            }
+        }
+    } // namespace scope
+} // namespace mrv
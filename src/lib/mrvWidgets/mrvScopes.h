@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+#pragma once
+
+#include "mrvCore/mrvColorAreaInfo.h"
+
+#include <tlCore/Image.h>
+#include <tlCore/Size.h>
+#include <tlCore/Util.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Fl_Widget;
+class ViewerUI;
+
+namespace mrv
+{
+    using namespace tl;
+
+    // VectorscopeMethod selects the YCbCr colour standard used for both pixel
+    // plotting and target-box placement.
+    //
+    //   ITU601  – ITU-R BT.601  (SD broadcast, Kr=0.299  Kb=0.114)
+    //   ITU709  – ITU-R BT.709  (HD broadcast, Kr=0.2126 Kb=0.0722)
+    //   Rec2020 – ITU-R BT.2020 (UHD / HDR,    Kr=0.2627 Kb=0.0593)
+    enum class VectorscopeMethod { ITU601, ITU709, Rec2020 };
+
+    namespace scope
+    {
+        //! Display color space of the pixels read back from the viewport.
+        //! The Vulkan swapchain may be HDR10 (ST 2084) or Display P3, in
+        //! which case the scopes map the pixels back to linear light.
+        enum class DisplaySpace { SDR, ST2084, DisplayP3 };
+
+        //! Get the display color space of the viewport.
+        DisplaySpace getDisplaySpace(ViewerUI*);
+
+        //! Map a linear luminance value to a normalised [0, 1] waveform
+        //! position (0 = bottom, 1 = top).
+        float luminanceToNorm(
+            float luma, bool hdrMode, float hdrMaxValue, bool hdrLogScale);
+
+        //! Waveform options.
+        struct WaveformOptions
+        {
+            bool enabled = false;
+
+            //! Size of the plot, usually the widget size.
+            math::Size2i size;
+
+            bool hdrMode = true;
+            float hdrMaxValue = 12.F;
+            bool hdrLogScale = true;
+        };
+
+        //! Vectorscope options.
+        struct VectorscopeOptions
+        {
+            bool enabled = false;
+            int diameter = 250;
+            VectorscopeMethod method = VectorscopeMethod::ITU709;
+
+            //! Maximum chroma vector length of the method's color targets.
+            float chromaNorm = 0.596F;
+
+            //! Reference white in linear ST 2084 units (nits / 10000).
+            float referenceWhiteLinear = 203.F / 10000.F;
+        };
+
+        //! Scope request.
+        struct Request
+        {
+            //! Pixels of the color area.
+            std::shared_ptr<image::Image> image;
+
+            //! Swap the red and blue channels (OpenGL reads back BGRA).
+            bool swapRB = false;
+
+            DisplaySpace displaySpace = DisplaySpace::SDR;
+
+            bool histogram = false;
+            WaveformOptions waveform;
+            VectorscopeOptions vectorscope;
+        };
+
+        //! Initialize a request with a copy of the viewport's color area
+        //! pixels. Returns false if there are no pixels.
+        bool initRequest(Request&, ViewerUI*, const area::Info&);
+
+        //! Histogram bins.
+        struct Histogram
+        {
+            float red[256] = {};
+            float green[256] = {};
+            float blue[256] = {};
+            float lumma[256] = {};
+            float maxColor = 0.F;
+            float maxLumma = 0.F;
+        };
+
+        //! Ready to draw RGBA plot. Pixels without samples are transparent.
+        struct Plot
+        {
+            int w = 0;
+            int h = 0;
+            std::vector<uint8_t> data;
+        };
+
+        //! Scope results.
+        struct Result
+        {
+            Histogram histogram;
+            Plot waveform;
+            Plot vectorscope;
+        };
+
+        //! Calculate the scopes in a single pass over the image. The rows
+        //! are split between the I/O thread pool threads, each with its own
+        //! bins and plots which are merged at the end. The waveform and
+        //! vectorscope are decimated when the image is larger than the
+        //! plot.
+        void calculate(const Request&, Result&);
+
+        class Service;
+
+        //! Receives the scope results for a widget.
+        class Client
+        {
+            TLRENDER_NON_COPYABLE(Client);
+
+        public:
+            explicit Client(Fl_Widget*);
+
+            //! Detach from the widget. Call this from the widget destructor.
+            void detach();
+
+            //! Clear the results and ignore the requests in progress.
+            void clear();
+
+            //! Get the latest results.
+            std::shared_ptr<Result> getResult() const;
+
+        private:
+            void _setResult(const std::shared_ptr<Result>&, uint64_t);
+
+            static void _ready_cb(void*);
+
+            Fl_Widget* _widget = nullptr;
+            std::atomic<uint64_t> _generation{0};
+            mutable std::mutex _mutex;
+            std::shared_ptr<Result> _result;
+
+            friend class Service;
+        };
+
+        //! Calculates the scopes in a background thread shared by the scope
+        //! widgets. A new request from a client replaces the client's
+        //! request that has not started yet, and the widget is redrawn when
+        //! the results are ready.
+        class Service
+        {
+            TLRENDER_NON_COPYABLE(Service);
+
+        protected:
+            Service();
+
+        public:
+            ~Service();
+
+            //! Get the global service.
+            static std::shared_ptr<Service> getGlobal();
+
+            //! Request the scopes for a client.
+            void request(const std::shared_ptr<Client>&, const Request&);
+
+        private:
+            void _run();
+
+            TLRENDER_PRIVATE();
+        };
+    } // namespace scope
+} // namespace mrv
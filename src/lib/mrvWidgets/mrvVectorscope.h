@@ -10,6 +10,8 @@
 #include <tlCore/Color.h>
 #include <tlCore/Image.h>
 
+#include "mrvWidgets/mrvScopes.h"
+
 #include "mrvCore/mrvColorAreaInfo.h"
 
 class ViewerUI;
@@ -18,12 +20,7 @@ namespace mrv
 {
     using namespace tl;
 
-    // VectorscopeMethod selects the YCbCr colour standard used for both pixel
-    // plotting and target-box placement.
-    //
-    //   ITU601  – ITU-R BT.601  (SD broadcast, Kr=0.299  Kb=0.114)
-    //   ITU709  – ITU-R BT.709  (HD broadcast, Kr=0.2126 Kb=0.0722)
-    //   Rec2020 – ITU-R BT.2020 (UHD / HDR,    Kr=0.2627 Kb=0.0593)
+    // See mrvScopes.h for VectorscopeMethod.
     //
     // HDR note (Rec2020 + HDR swapchain)
     // ─────────────────────────────────
@@ -44,7 +41,6 @@ namespace mrv
     // Dot colours use a per-channel Reinhard tone-map applied to the original
     // (un-normalised) values so that HDR specular highlights remain vividly
     // hued rather than washing out to white.
-    enum class VectorscopeMethod { ITU601, ITU709, Rec2020 };
 
     class Vectorscope : public Fl_Box
     {
@@ -73,8 +69,8 @@ namespace mrv
         
     protected:
         void draw_grid() noexcept;
-        void draw_pixel(image::Color4f& rgb) const noexcept;
-        void draw_pixels() const noexcept;
+        void draw_pixels(const scope::Plot&) const noexcept;
+        void request_plot() noexcept;
 
         TLRENDER_PRIVATE();
     };
@@ -6,55 +6,19 @@
 
 #include "mrvWidgets/mrvWaveform.h"
 
-#include "mrvCore/mrvColor.h"
-#include "mrvCore/mrvColorSpaces.h"
-
+#include <FL/Fl_RGB_Image.H>
 #include <FL/fl_draw.H>
 
 
 namespace mrv
 {
-    // ─────────────────────────────────────────────────────────────────────────
-    // Internal helpers
-    // ─────────────────────────────────────────────────────────────────────────
-    
-    // Map a raw linear luminance value to a normalised [0, 1] waveform position
-    // (0 = bottom, 1 = top) according to the current SDR/HDR mode.
-    static float luminanceToNorm(float luma,
-                                 bool  hdrMode,
-                                 float hdrMaxValue,
-                                 bool  hdrLogScale)
-    {
-        if (!hdrMode)
-        {
-            // Original SDR path – clamp to [0, 1].
-            return math::clamp(luma, 0.f, 1.f);
-        }
-        
-        if (hdrLogScale)
-        {
-            // Map [0, hdrMaxValue] onto [0, 1] in log2 space.
-            // We add 1 before taking the log so that 0 maps cleanly to 0.
-            const float logMax = std::log2(hdrMaxValue + 1.f);
-            const float norm   = std::log2(std::max(luma, 0.f) + 1.f) / logMax;
-            return math::clamp(norm, 0.f, 1.f);
-        }
-        else
-        {
-            // Linear HDR: simply divide by the ceiling value.
-            return math::clamp(luma / hdrMaxValue, 0.f, 1.f);
-        }
-    }
-    
     struct Waveform::Private
     {
         ViewerUI*         ui                  = nullptr;
-        math::Box2i       box;
-        image::PixelType  pixelType;
-        uint8_t*          image               = nullptr;
-        size_t            dataSize            = 0;
-
 
+        // The plot is calculated in the background by the scope service.
+        scope::Request                 request;
+        std::shared_ptr<scope::Client> client;
         
         float            st2084PeakNits       = 1000.f;
         
@@ -82,9 +46,10 @@ namespace mrv
     void Waveform::main(ViewerUI* m) { _p->ui = m; }
     
     Waveform::Waveform( int X, int Y, int W, int H, const char* L) :
-        Fl_Box( X, Y, W, Y, L ),
+        Fl_Box( X, Y, W, H, L ),
         _p(new Private)
     {
+        _p->client = std::make_shared<scope::Client>(this);
         color( FL_BLACK );
         tooltip( _("Mark an area in the image with SHIFT + the left mouse button") );
     }
@@ -92,7 +57,7 @@ namespace mrv
     Waveform::~Waveform()
     {
         TLRENDER_P();
-        free(p.image);
+        p.client->detach();
     }
 
     // ── HDR accessors ────────────────────────────────────────────────────────
@@ -100,14 +65,15 @@ namespace mrv
     {
         TLRENDER_P();
         p.hdrMode     = enabled;
+        request_plot();
         redraw();
     }
  
     bool  Waveform::isHDRMode()     const { return _p->hdrMode;     }
     float Waveform::hdrMaxValue()   const { return _p->hdrMaxValue; }
-    void  Waveform::setHDRMaxValue(float value)  { _p->hdrMaxValue = value; redraw(); }
+    void  Waveform::setHDRMaxValue(float value)  { _p->hdrMaxValue = value; request_plot(); redraw(); }
     bool  Waveform::isHDRLogScale() const { return _p->hdrLogScale; }
-    void  Waveform::setHDRLogScale(bool value)  { _p->hdrLogScale = value; redraw(); }
+    void  Waveform::setHDRLogScale(bool value)  { _p->hdrLogScale = value; request_plot(); redraw(); }
     
     // ─────────────────────────────────────────────────────────────────────────
     // update()
@@ -116,34 +82,30 @@ namespace mrv
     {
         TLRENDER_P();
 
-        MyViewport* view      = p.ui->uiView;
-        const void* viewImage = view->image();
-        p.box       = info.box;
-        p.pixelType = info.pixelType;
-
-        if (!viewImage)
+        p.request = scope::Request();
+        if (!scope::initRequest(p.request, p.ui, info))
         {
-            free(p.image);
-            p.image = nullptr;
+            p.client->clear();
             redraw();
             return;
         }
+        request_plot();
+    }
 
-        const int channelCount = image::getChannelCount(p.pixelType);
-        const int byteCount    = image::getBitDepth(p.pixelType) / 8;
+    void Waveform::request_plot()
+    {
+        TLRENDER_P();
 
-        const size_t dataSize =
-            info.box.w() * info.box.h() * channelCount * byteCount;
+        if (!p.request.image)
+            return;
 
-        if (dataSize != p.dataSize)
-        {
-            free(p.image);
-            p.dataSize = dataSize;
-            p.image = reinterpret_cast<uint8_t*>(malloc(dataSize));
-        }
-        memcpy(p.image, viewImage, dataSize);
-        
-        redraw();
+        scope::WaveformOptions& options = p.request.waveform;
+        options.enabled     = true;
+        options.size        = math::Size2i(w(), h());
+        options.hdrMode     = p.hdrMode;
+        options.hdrMaxValue = p.hdrMaxValue;
+        options.hdrLogScale = p.hdrLogScale;
+        scope::Service::getGlobal()->request(p.client, p.request);
     }
     
     void Waveform::resize(int X, int Y, int W, int H)
@@ -151,7 +113,10 @@ namespace mrv
         if (W < 250) W = 250;
         H = W / 2;
 
+        const bool changed = W != w() || H != h();
         Fl_Box::resize(X, Y, W, H);
+        if (changed)
+            request_plot();
     }
     
     void Waveform::draw_grid()
@@ -179,7 +144,7 @@ namespace mrv
         else
         {
             // HDR: always draw the SDR white-point (luma == 1.0) prominently.
-            const float sdrNorm = luminanceToNorm(
+            const float sdrNorm = scope::luminanceToNorm(
                 1.f, p.hdrMode, p.hdrMaxValue, p.hdrLogScale);
             drawHLine(sdrNorm, 220, 180,  50);  // amber – SDR legal limit
  
@@ -187,7 +152,7 @@ namespace mrv
             // as long as it falls within hdrMaxValue.
             for (float stops = 2.f; stops <= p.hdrMaxValue; stops *= 2.f)
             {
-                const float norm = luminanceToNorm(
+                const float norm = scope::luminanceToNorm(
                     stops, p.hdrMode, p.hdrMaxValue, p.hdrLogScale);
                 // Dimmer lines for the upper stops.
                 drawHLine(norm, 100, 100, 100);
@@ -209,132 +174,24 @@ namespace mrv
         fl_antialias(0);
         draw_grid();
         
-        if (p.image)
+        if (auto result = p.client->getResult())
         {
             fl_push_clip(x(), y(), w(), h());
-            draw_pixels();
+            draw_pixels(result->waveform);
             fl_pop_clip();
         }
         fl_antialias(1);
     }
 
-    void Waveform::draw_pixel(int X, const image::Color4f& rgba)
+    void Waveform::draw_pixels(const scope::Plot& plot)
     {
-        TLRENDER_P();
-        
-        const uint32_t W = p.box.w();
-        const float pct = static_cast<float>(X) / W;
-        
-        const int wh = h();
-        
-        X = x() + static_cast<int>(pct * w());
-
-        // ── Waveform Y position ──────────────────────────────────────────────
-        float luma = calculate_brightness(rgba, kAsLuminance);
-        
-#ifdef VULKAN_BACKEND
-        if (p.hdrMode)
-        {
-            if (p.ui->uiPixelWindow->uiPixelValue->value() !=
-                PixelValue::kOriginal)
-            {
-                Fl_Vk_Context& ctx = p.ui->uiView->getContext();
-                if (ctx.colorSpace == VK_COLOR_SPACE_HDR10_ST2084_EXT)
-                {
-                    // Display 2084 Nonlinear uses PQ transfer function.
-                    // We map the non-linear luma back to linear space.
-                    luma = color::pqToLinear(luma, 203.F);
-                }
-                else if (ctx.colorSpace == VK_COLOR_SPACE_DISPLAY_P3_NONLINEAR_EXT)
-                {
-                    // Display P3 Nonlinear uses the sRGB transfer function.
-                    // We map the non-linear luma back to linear space.
-                    luma = color::srgbToLinear(luma);
-                }
-            }
-        }
-#endif
-        
-        const float norm = luminanceToNorm(
-            luma, p.hdrMode, p.hdrMaxValue, p.hdrLogScale);
- 
-        // norm == 0 → bottom of widget, norm == 1 → top
-        const int Y = y() + wh - static_cast<int>(norm * wh);
-
-        // ── Display colour ───────────────────────────────────────────────────
-        float dr = rgba.r;
-        float dg = rgba.g;
-        float db = rgba.b;
-
-        if (p.hdrMode)
-        {
-            // Blend super-white channels toward white so the operator can
-            // clearly see which columns contain HDR data.  Values in [0,1]
-            // are unaffected; values above 1 move toward (1,1,1).
-            const float blend = math::clamp(luma - 1.f, 0.f, 1.f);
-            dr = math::clamp(dr, 0.f, 1.f);
-            dg = math::clamp(dg, 0.f, 1.f);
-            db = math::clamp(db, 0.f, 1.f);
-            dr = dr + (1.f - dr) * blend;
-            dg = dg + (1.f - dg) * blend;
-            db = db + (1.f - db) * blend;
-        }
-        else
-        {
-            // Original SDR path – hard clamp.
-            dr = math::clamp(dr, 0.f, 1.F);
-            dg = math::clamp(dg, 0.f, 1.F);
-            db = math::clamp(db, 0.f, 1.F);
-        }
-                
-        const uint8_t r8 = static_cast<uint8_t>(dr * 255.f);
-        const uint8_t g8 = static_cast<uint8_t>(dg * 255.f);
-        const uint8_t b8 = static_cast<uint8_t>(db * 255.f);
-
-        fl_color(r8, g8, b8);
-        fl_point(X, Y);
-    }
-
-    void Waveform::draw_pixels()
-    {
-        TLRENDER_P();
-        
-        if (!p.box.isValid())
+        if (plot.data.empty())
             return;
-        
-        int stepX = (p.box.max.x - p.box.min.x) / w();
-        int stepY = (p.box.max.y - p.box.min.y) / w();
-        if (stepX < 1) stepX = 1;
-        if (stepY < 1) stepY = 1;
-        
-        const int channelCount = image::getChannelCount(p.pixelType);
-        const int byteCount    = image::getBitDepth(p.pixelType) / 8;
 
-        const uint32_t W = p.box.w();
-        const uint32_t H = p.box.h();
-
-        image::Color4f rgba;
-
-        for (uint32_t X = 0; X < W; X += stepX)
-        {
-            for (uint32_t Y = 0; Y < H; Y += stepY)
-            {
-#ifdef VULKAN_BACKEND
-                const size_t offset =
-                    (X + Y * W) * channelCount * byteCount;
-                rgba = color::fromVoidPtr(p.image + offset, p.pixelType);
-#endif
-
-#ifdef OPENGL_BACKEND
-                const size_t offset =
-                    (X + Y * W) * channelCount * sizeof(float);
-                const uint8_t* ptr = p.image + offset;
-                rgba = *(reinterpret_cast<const image::Color4f*>(ptr));
-                std::swap(rgba.r, rgba.b);  // BGRA → RGBA
-#endif
-                draw_pixel(X, rgba);
-            }
-        }
+        // The plot is transparent where there are no samples, so the grid
+        // shows through.
+        Fl_RGB_Image image(plot.data.data(), plot.w, plot.h, 4);
+        image.draw(x(), y());
     }
 
 }
@@ -9,6 +9,8 @@
 #include <tlCore/Color.h>
 #include <tlCore/Image.h>
 
+#include "mrvWidgets/mrvScopes.h"
+
 #include "mrvCore/mrvColorAreaInfo.h"
 
 class ViewerUI;
@@ -43,8 +45,8 @@ namespace mrv
         
     protected:
         void draw_grid();
-        void draw_pixels();
-        void draw_pixel(const int X, const image::Color4f& rgba );
+        void draw_pixels(const scope::Plot&);
+        void request_plot();
 
         TLRENDER_PRIVATE();
     };
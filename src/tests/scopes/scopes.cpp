@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+// Benchmark of the histogram, waveform and vectorscope calculation with a
+// 4K color area.
+
+#include "mrvWidgets/mrvScopes.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+using namespace mrv;
+
+int main(int argc, char** argv)
+{
+    const int width = 3840;
+    const int height = 2160;
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+
+    for (auto pixelType : {image::PixelType::RGBA_U8,
+                           image::PixelType::RGBA_F16,
+                           image::PixelType::RGBA_F32})
+    {
+        scope::Request request;
+        request.image = image::Image::create(width, height, pixelType);
+        std::mt19937 rng(0);
+        uint8_t* data = request.image->getData();
+        const size_t byteCount = request.image->getDataByteCount();
+        for (size_t i = 0; i < byteCount; ++i)
+        {
+            data[i] = static_cast<uint8_t>(rng());
+        }
+        if (pixelType != image::PixelType::RGBA_U8)
+        {
+            // Keep the random floats within a sensible range.
+            const size_t channelCount = width * height * 4;
+            if (image::PixelType::RGBA_F32 == pixelType)
+            {
+                float* p = reinterpret_cast<float*>(data);
+                for (size_t i = 0; i < channelCount; ++i)
+                    p[i] = (rng() % 4096) / 2048.F;
+            }
+            else
+            {
+                half* p = reinterpret_cast<half*>(data);
+                for (size_t i = 0; i < channelCount; ++i)
+                    p[i] = (rng() % 4096) / 2048.F;
+            }
+        }
+        request.histogram = true;
+        request.waveform.enabled = true;
+        request.waveform.size = math::Size2i(512, 256);
+        request.vectorscope.enabled = true;
+        request.vectorscope.diameter = 512;
+
+        scope::Result result;
+        scope::calculate(request, result);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            scope::calculate(request, result);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double, std::milli> diff = end - start;
+        std::cout << pixelType << " " << width << "x" << height << ": "
+                  << diff.count() / iterations << " ms per calculation"
+                  << std::endl;
+    }
+
+    return 0;
+}
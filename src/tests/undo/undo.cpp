@@ -0,0 +1,317 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// mrv2
+// Copyright Contributors to the mrv2 Project. All rights reserved.
+
+// Tests of the undo/redo history: splitting the timeline JSON at the items
+// and joining it again, sharing the text between the states, and evicting
+// the oldest states.
+
+#include "mrvEdit/mrvEditUndo.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+using namespace mrv;
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool value, const char* text, int line)
+    {
+        if (!value)
+        {
+            std::cerr << "undo.cpp:" << line << ": failed: " << text
+                      << std::endl;
+            ++failures;
+        }
+    }
+
+#define CHECK(value) check(value, #value, __LINE__)
+
+    std::string createClip(const std::string& name)
+    {
+        return "{\"OTIO_SCHEMA\":\"Clip.2\",\"name\":\"" + name +
+               "\",\"source_range\":{\"duration\":{\"rate\":24.0,"
+               "\"value\":10.0}}}";
+    }
+
+    std::string createTrack(
+        const std::string& name, const std::vector<std::string>& items)
+    {
+        std::string out = "{\"OTIO_SCHEMA\":\"Track.1\",\"children\":[";
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (i > 0)
+                out += ',';
+            out += items[i];
+        }
+        out += "],\"kind\":\"Video\",\"name\":\"" + name + "\"}";
+        return out;
+    }
+
+    std::string createTimeline(const std::vector<std::string>& tracks)
+    {
+        std::string out = "{\"OTIO_SCHEMA\":\"Timeline.1\",\"name\":\"t\","
+                          "\"tracks\":{\"OTIO_SCHEMA\":\"Stack.1\","
+                          "\"children\":[";
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            if (i > 0)
+                out += ',';
+            out += tracks[i];
+        }
+        out += "],\"name\":\"tracks\"}}";
+        return out;
+    }
+
+    std::vector<std::string> createClips(size_t count, size_t changed = -1)
+    {
+        std::vector<std::string> out;
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::stringstream ss;
+            ss << "clip" << i << (i == changed ? "b" : "");
+            out.push_back(createClip(ss.str()));
+        }
+        return out;
+    }
+
+    void splitTests()
+    {
+        UndoHistory history;
+
+        // Timelines are split at the items of each track and joined back to
+        // the same text.
+        const std::vector<std::string> jsons = {
+            createTimeline({}),
+            createTimeline({createTrack("empty", {})}),
+            createTimeline(
+                {createTrack("V1", createClips(3)),
+                 createTrack("A1", createClips(2))}),
+            // Strings with brackets, braces and escaped quotes.
+            createTimeline({createTrack(
+                "[{\\\"}]", {createClip("a]\\\"b}"), createClip("\\\\")})}),
+            // Nested compositions are kept in one item.
+            createTimeline({createTrack(
+                "V1", {createTimeline({createTrack("nested", createClips(2))}),
+                       createClip("c")})}),
+            // Not a timeline, or not valid JSON.
+            "",
+            "{}",
+            "{\"tracks\":1}",
+            "{\"tracks\":{\"children\":[{\"children\":[{\"a\":1}",
+            "[1, 2, 3]"};
+        for (const auto& json : jsons)
+        {
+            const auto state = history.createState(json);
+            CHECK(json == state->getJSON());
+            CHECK(state->shell.size() == state->items.size() + 1 ||
+                  (1 == state->shell.size() && state->items.empty()));
+        }
+
+        // The whitespace around the items is not kept.
+        {
+            const auto state = history.createState(
+                "{\n  \"tracks\" : {\n    \"children\" : [\n      {\n"
+                "        \"children\" : [ {\"a\": 1} , {\"b\": [2, 3]} ]\n"
+                "      }\n    ]\n  }\n}\n");
+            CHECK(
+                "{\n  \"tracks\" : {\n    \"children\" : [\n      {\n"
+                "        \"children\" : [{\"a\": 1},{\"b\": [2, 3]}]\n"
+                "      }\n    ]\n  }\n}\n" == state->getJSON());
+            CHECK(1 == state->items.size());
+            CHECK(2 == state->items[0].size());
+        }
+
+        // The items of each track are split.
+        {
+            const auto state = history.createState(createTimeline(
+                {createTrack("V1", createClips(3)),
+                 createTrack("A1", createClips(2))}));
+            CHECK(3 == state->shell.size());
+            CHECK(2 == state->items.size());
+            CHECK(3 == state->items[0].size());
+            CHECK(2 == state->items[1].size());
+            CHECK(createClip("clip1") == *state->items[0][1]);
+        }
+        {
+            const auto state = history.createState(
+                createTimeline({createTrack("V1", {createTimeline({})})}));
+            CHECK(1 == state->items.size());
+            CHECK(1 == state->items[0].size());
+        }
+
+        // Text that can not be split is kept whole.
+        {
+            const auto state = history.createState("[1, 2, 3]");
+            CHECK(1 == state->shell.size());
+            CHECK(state->items.empty());
+        }
+    }
+
+    void shareTests()
+    {
+        UndoHistory history;
+        const auto json = createTimeline({createTrack("V1", createClips(100))});
+        {
+            const auto a = history.createState(json);
+            const size_t byteCount = history.getByteCount();
+            // The commas in between the items are not stored.
+            CHECK(byteCount >= json.size() - 99);
+
+            // The same timeline shares all of the text.
+            const auto b = history.createState(json);
+            CHECK(a->isTimelineEqual(*b));
+            CHECK(byteCount == history.getByteCount());
+
+            // An edit only adds the items that changed.
+            const auto c = history.createState(
+                createTimeline({createTrack("V1", createClips(100, 50))}));
+            CHECK(!a->isTimelineEqual(*c));
+            CHECK(a->items[0][49] == c->items[0][49]);
+            CHECK(a->items[0][50] != c->items[0][50]);
+            CHECK(a->items[0][51] == c->items[0][51]);
+            CHECK(history.getByteCount() - byteCount < json.size() / 10);
+
+            history.pushUndo(a);
+            history.pushUndo(c);
+            CHECK(c == history.getUndo());
+            CHECK(c == history.popUndo());
+            CHECK(a == history.popUndo());
+            CHECK(!history.hasUndo());
+            CHECK(nullptr == history.popUndo());
+        }
+
+        // The text is released with the last state using it.
+        CHECK(0 == history.getByteCount());
+    }
+
+    void evictTests()
+    {
+        const size_t count = 10;
+        std::vector<std::string> jsons;
+        for (size_t i = 0; i < count; ++i)
+        {
+            jsons.push_back(
+                createTimeline({createTrack("V1", createClips(20, i))}));
+        }
+
+        // Without a maximum nothing is evicted.
+        {
+            UndoHistory history;
+            for (const auto& json : jsons)
+            {
+                history.pushUndo(history.createState(json));
+            }
+            size_t undoCount = 0;
+            while (history.popUndo())
+                ++undoCount;
+            CHECK(count == undoCount);
+        }
+
+        // The oldest states are evicted first.
+        {
+            UndoHistory history;
+            std::vector<std::shared_ptr<UndoState> > states;
+            for (const auto& json : jsons)
+            {
+                states.push_back(history.createState(json));
+                history.pushUndo(states.back());
+            }
+            const size_t byteCount = history.getByteCount();
+            states.clear();
+
+            history.setMax(byteCount / 2);
+            CHECK(history.getByteCount() <= byteCount / 2);
+            size_t undoCount = 0;
+            std::string last;
+            while (auto state = history.popUndo())
+            {
+                if (0 == undoCount)
+                    last = state->getJSON();
+                ++undoCount;
+            }
+            CHECK(undoCount > 0);
+            CHECK(undoCount < count);
+            CHECK(jsons.back() == last);
+        }
+
+        // The last undo and redo states are always kept.
+        {
+            UndoHistory history;
+            history.setMax(0);
+            for (const auto& json : jsons)
+            {
+                history.pushUndo(history.createState(json));
+                history.pushRedo(history.createState(json));
+            }
+            CHECK(history.getByteCount() > 0);
+            CHECK(jsons.back() == history.popUndo()->getJSON());
+            CHECK(!history.hasUndo());
+            CHECK(jsons.back() == history.popRedo()->getJSON());
+            CHECK(!history.hasRedo());
+            CHECK(0 == history.getByteCount());
+        }
+
+        // Clearing the redo states releases them.
+        {
+            UndoHistory history;
+            history.pushUndo(history.createState(jsons[0]));
+            const size_t byteCount = history.getByteCount();
+            for (size_t i = 1; i < count; ++i)
+            {
+                history.pushRedo(history.createState(jsons[i]));
+            }
+            CHECK(history.getByteCount() > byteCount);
+            history.clearRedo();
+            CHECK(!history.hasRedo());
+            CHECK(byteCount == history.getByteCount());
+        }
+    }
+
+    void lifetimeTests()
+    {
+        // States and text may outlive the history.
+        const auto json = createTimeline({createTrack("V1", createClips(10))});
+        std::shared_ptr<UndoState> state;
+        std::shared_ptr<const std::string> text;
+        {
+            UndoHistory history;
+            state = history.createState(json);
+            history.pushUndo(state);
+            text = history.createState(json)->items[0][0];
+        }
+        CHECK(json == state->getJSON());
+        state.reset();
+        CHECK(createClip("clip0") == *text);
+        text.reset();
+
+        // Text that is no longer used is created again.
+        {
+            UndoHistory history;
+            history.createState(json);
+            CHECK(0 == history.getByteCount());
+            const auto a = history.createState(json);
+            CHECK(history.getByteCount() > 0);
+            const auto b = history.createState(json);
+            CHECK(a->isTimelineEqual(*b));
+        }
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    splitTests();
+    shareTests();
+    evictTests();
+    lifetimeTests();
+    if (failures > 0)
+    {
+        std::cerr << failures << " failures" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All tests passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -536,5 +536,33 @@ namespace tl
                 in.push_front(newItem);
             }
         }
+
+        size_t
+        discard(std::list<std::shared_ptr<Audio> >& in, size_t sampleCount)
+        {
+            size_t size = 0;
+            while (!in.empty() &&
+                   (size + in.front()->getSampleCount() <= sampleCount))
+            {
+                size += in.front()->getSampleCount();
+                in.pop_front();
+            }
+            if (!in.empty() && size < sampleCount)
+            {
+                auto item = in.front();
+                in.pop_front();
+                const size_t remainingSize = sampleCount - size;
+                auto newItem = audio::Audio::create(
+                    item->getInfo(), item->getSampleCount() - remainingSize);
+                std::memcpy(
+                    newItem->getData(),
+                    item->getData() +
+                        remainingSize * item->getInfo().getByteCount(),
+                    newItem->getByteCount());
+                in.push_front(newItem);
+                size = sampleCount;
+            }
+            return size;
+        }
     } // namespace audio
 } // namespace tl
@@ -215,6 +215,11 @@ namespace tl
             std::list<std::shared_ptr<Audio> >& in, uint8_t* out,
             size_t byteCount);
 
+        //! Discard samples from the front of a list of audio data, returning
+        //! the number of samples discarded.
+        size_t
+        discard(std::list<std::shared_ptr<Audio> >& in, size_t sampleCount);
+
         ///@}
     } // namespace audio
 } // namespace tl
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        void RingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            _info = info;
+            _byteCount = info.getByteCount();
+            _capacity = sampleCount;
+            _data.resize(_capacity * _byteCount);
+        }
+
+        RingBuffer::RingBuffer() {}
+
+        RingBuffer::~RingBuffer() {}
+
+        std::shared_ptr<RingBuffer>
+        RingBuffer::create(const Info& info, size_t sampleCount)
+        {
+            auto out = std::shared_ptr<RingBuffer>(new RingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        const Info& RingBuffer::getInfo() const
+        {
+            return _info;
+        }
+
+        size_t RingBuffer::getCapacity() const
+        {
+            return _capacity;
+        }
+
+        size_t RingBuffer::getWriteAvailable() const
+        {
+            const size_t writePos = _writePos.load(std::memory_order_relaxed);
+            const size_t readPos = _readPos.load(std::memory_order_acquire);
+            return _capacity - (writePos - readPos);
+        }
+
+        size_t RingBuffer::write(const uint8_t* data, size_t sampleCount)
+        {
+            const size_t writePos = _writePos.load(std::memory_order_relaxed);
+            const size_t readPos = _readPos.load(std::memory_order_acquire);
+            const size_t count =
+                std::min(sampleCount, _capacity - (writePos - readPos));
+            if (count > 0)
+            {
+                const size_t offset = writePos % _capacity;
+                const size_t count0 = std::min(count, _capacity - offset);
+                std::memcpy(
+                    _data.data() + offset * _byteCount, data,
+                    count0 * _byteCount);
+                std::memcpy(
+                    _data.data(), data + count0 * _byteCount,
+                    (count - count0) * _byteCount);
+                _writePos.store(writePos + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        size_t RingBuffer::takeUnderrun()
+        {
+            return _underrun.exchange(0, std::memory_order_acq_rel);
+        }
+
+        size_t RingBuffer::getReadAvailable() const
+        {
+            const size_t readPos = _readPos.load(std::memory_order_relaxed);
+            const size_t writePos = _writePos.load(std::memory_order_acquire);
+            return writePos - readPos;
+        }
+
+        size_t RingBuffer::read(uint8_t* data, size_t sampleCount)
+        {
+            const size_t readPos = _readPos.load(std::memory_order_relaxed);
+            const size_t writePos = _writePos.load(std::memory_order_acquire);
+            const size_t count = std::min(sampleCount, writePos - readPos);
+            if (count > 0)
+            {
+                const size_t offset = readPos % _capacity;
+                const size_t count0 = std::min(count, _capacity - offset);
+                std::memcpy(
+                    data, _data.data() + offset * _byteCount,
+                    count0 * _byteCount);
+                std::memcpy(
+                    data + count0 * _byteCount, _data.data(),
+                    (count - count0) * _byteCount);
+                _readPos.store(readPos + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        void RingBuffer::addUnderrun(size_t sampleCount)
+        {
+            _underrun.fetch_add(sampleCount, std::memory_order_acq_rel);
+        }
+
+        void RingBuffer::discard()
+        {
+            _underrun.store(0, std::memory_order_release);
+            _readPos.store(
+                _writePos.load(std::memory_order_acquire),
+                std::memory_order_release);
+        }
+    } // namespace audio
+} // namespace tl
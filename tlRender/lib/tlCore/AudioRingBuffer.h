@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+#include <atomic>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Lock-free audio ring buffer for a single producer and a single
+        //! consumer thread.
+        //!
+        //! The storage is allocated once when the buffer is created, so
+        //! reading does not allocate or block and is safe to call from the
+        //! audio device callback.
+        class RingBuffer
+        {
+            TLRENDER_NON_COPYABLE(RingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+
+            RingBuffer();
+
+        public:
+            ~RingBuffer();
+
+            //! Create a new ring buffer.
+            static std::shared_ptr<RingBuffer>
+            create(const Info& info, size_t sampleCount);
+
+            //! Get the audio information.
+            const Info& getInfo() const;
+
+            //! Get the capacity in samples.
+            size_t getCapacity() const;
+
+            //! \name Producer
+            ///@{
+
+            //! Get the number of samples that can be written.
+            size_t getWriteAvailable() const;
+
+            //! Write samples, returning the number of samples written.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Get and clear the number of samples the consumer was short.
+            //! The producer skips them to stay in sync with the consumer.
+            size_t takeUnderrun();
+
+            ///@}
+
+            //! \name Consumer
+            ///@{
+
+            //! Get the number of samples that can be read.
+            size_t getReadAvailable() const;
+
+            //! Read samples, returning the number of samples read.
+            size_t read(uint8_t*, size_t sampleCount);
+
+            //! Add to the number of samples the consumer was short, for
+            //! example when it output silence because the buffer ran dry.
+            void addUnderrun(size_t sampleCount);
+
+            //! Discard the samples that can be read, and the number of
+            //! samples the consumer was short.
+            void discard();
+
+            ///@}
+
+        private:
+            Info _info;
+            size_t _byteCount = 0;
+            size_t _capacity = 0;
+            std::vector<uint8_t> _data;
+
+            // The positions are the total number of samples written and
+            // read, the buffer offset is the position modulo the capacity.
+            std::atomic<size_t> _writePos{0};
+            std::atomic<size_t> _readPos{0};
+            std::atomic<size_t> _underrun{0};
+        };
+    } // namespace audio
+} // namespace tl
@@ -407,7 +407,10 @@ namespace tl
             if (ReadType::MemoryMapped == p.readType && Mode::Read == p.mode &&
                 p.size > 0)
             {
-                p.mMap = mmap(0, p.size, PROT_READ, MAP_SHARED, p.f, 0);
+                // The mapping is private so that writing to images that
+                // reference it changes a copy instead of faulting.
+                p.mMap = mmap(
+                    0, p.size, PROT_READ | PROT_WRITE, MAP_PRIVATE, p.f, 0);
                 madvise(p.mMap, p.size, MADV_SEQUENTIAL | MADV_SEQUENTIAL);
                 if (p.mMap == (void*)-1)
                 {
@@ -417,6 +420,13 @@ namespace tl
                 p.memoryStart = reinterpret_cast<const uint8_t*>(p.mMap);
                 p.memoryEnd = p.memoryStart + p.size;
                 p.memoryP = p.memoryStart;
+
+                // The mapping stays valid without the file descriptor, so
+                // close it. Images that reference the mapping may be kept
+                // in the cache for a long time, and they should not use up
+                // file descriptors.
+                ::close(p.f);
+                p.f = -1;
             }
         }
 
@@ -407,7 +407,9 @@ namespace tl
             if (ReadType::MemoryMapped == p.readType && Mode::Read == p.mode &&
                 p.size > 0)
             {
-                p.mMap = CreateFileMapping(p.f, 0, PAGE_READONLY, 0, 0, 0);
+                // The mapping is copy-on-write so that writing to images that
+                // reference it changes a copy instead of faulting.
+                p.mMap = CreateFileMapping(p.f, 0, PAGE_WRITECOPY, 0, 0, 0);
                 if (!p.mMap)
                 {
                     throw std::runtime_error(getErrorMessage(
@@ -415,7 +417,7 @@ namespace tl
                 }
 
                 p.memoryStart = reinterpret_cast<const uint8_t*>(
-                    MapViewOfFile(p.mMap, FILE_MAP_READ, 0, 0, 0));
+                    MapViewOfFile(p.mMap, FILE_MAP_COPY, 0, 0, 0));
                 if (!p.memoryStart)
                 {
                     throw std::runtime_error(
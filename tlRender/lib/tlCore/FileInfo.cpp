@@ -9,12 +9,24 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 namespace tl
 {
     namespace file
     {
+        namespace
+        {
+            // Reading the information for a file is mostly waiting on the
+            // file system, so use more threads than cores for network file
+            // systems.
+            const size_t listThreadsMax = 16;
+            const size_t listThreadEntriesMin = 64;
+        } // namespace
+
         TLRENDER_ENUM_IMPL(Type, "File", "Directory");
         TLRENDER_ENUM_SERIALIZE_IMPL(Type);
 
@@ -27,6 +39,13 @@ namespace tl
             _stat(&error);
         }
 
+        FileInfo::FileInfo(const Path& path, Type type) :
+            _path(path),
+            _exists(true),
+            _type(type)
+        {
+        }
+
         void FileInfo::sequence(const FileInfo& value)
         {
             if (_path.addSeq(value._path))
@@ -48,7 +67,8 @@ namespace tl
                    dotFiles == other.dotFiles && sequence == other.sequence &&
                    sequenceExtensions == other.sequenceExtensions &&
                    negativeNumbers == other.negativeNumbers &&
-                   maxNumberDigits == other.maxNumberDigits;
+                   maxNumberDigits == other.maxNumberDigits &&
+                   stat == other.stat;
         }
 
         bool ListOptions::operator!=(const ListOptions& other) const
@@ -78,16 +98,168 @@ namespace tl
             return out;
         }
 
-        void listSequence(
-            const std::string& path, const std::string& fileName,
-            std::vector<FileInfo>& out, const ListOptions& options)
+        struct ListInfo::Private
         {
+            void info(size_t begin, size_t end);
+
+            // Claim the next chunk of the batch, returns false when there
+            // are none left. Called with the mutex locked.
+            bool next(size_t& begin, size_t& end);
+
+            std::string path;
+            ListOptions options;
             PathOptions pathOptions;
-            pathOptions.seqMaxDigits =
+
+            // The current batch, guarded by the mutex.
+            const std::vector<ListEntry>* entries = nullptr;
+            std::vector<FileInfo>* out = nullptr;
+            size_t chunkSize = 0;
+            size_t chunks = 0;
+            size_t chunksNext = 0;
+            size_t chunksFinished = 0;
+
+            std::vector<std::thread> threads;
+            bool running = true;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::condition_variable finishedCV;
+        };
+
+        void ListInfo::Private::info(size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const Path p(path, (*entries)[i].fileName, pathOptions);
+                (*out)[i] = !options.stat && (*entries)[i].type.has_value()
+                                ? FileInfo(p, (*entries)[i].type.value())
+                                : FileInfo(p);
+            }
+        }
+
+        bool ListInfo::Private::next(size_t& begin, size_t& end)
+        {
+            if (chunksNext >= chunks)
+                return false;
+            begin = std::min(chunksNext * chunkSize, entries->size());
+            end = std::min(begin + chunkSize, entries->size());
+            ++chunksNext;
+            return true;
+        }
+
+        ListInfo::ListInfo(
+            const std::string& path, const ListOptions& options) :
+            _p(new Private)
+        {
+            TLRENDER_P();
+            p.path = path;
+            p.options = options;
+            p.pathOptions.seqMaxDigits =
                 options.sequence ? options.maxNumberDigits : 0;
-            const Path p(path, fileName, pathOptions);
-            const FileInfo f(p);
-            bool sequence = false;
+        }
+
+        ListInfo::~ListInfo()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                thread.join();
+            }
+        }
+
+        void ListInfo::run(
+            const std::vector<ListEntry>& entries, std::vector<FileInfo>& out)
+        {
+            TLRENDER_P();
+            out.resize(entries.size());
+
+            // Read the file information in parallel.
+            size_t threadCount = 1;
+            if (p.options.stat)
+            {
+                threadCount = std::min(
+                    std::max(
+                        static_cast<size_t>(
+                            std::thread::hardware_concurrency()) *
+                            2,
+                        size_t(1)),
+                    listThreadsMax);
+                threadCount = std::max(
+                    std::min(
+                        threadCount, entries.size() / listThreadEntriesMin),
+                    size_t(1));
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.entries = &entries;
+                p.out = &out;
+                p.chunkSize = (entries.size() + threadCount - 1) / threadCount;
+                p.chunks = threadCount;
+                p.chunksNext = 0;
+                p.chunksFinished = 0;
+            }
+            while (p.threads.size() + 1 < threadCount)
+            {
+                p.threads.push_back(std::thread(
+                    [this]
+                    {
+                        TLRENDER_P();
+                        std::unique_lock<std::mutex> lock(p.mutex);
+                        while (true)
+                        {
+                            p.cv.wait(
+                                lock,
+                                [this] {
+                                    return !_p->running ||
+                                           _p->chunksNext < _p->chunks;
+                                });
+                            if (!p.running)
+                                break;
+                            size_t begin = 0;
+                            size_t end = 0;
+                            while (p.next(begin, end))
+                            {
+                                lock.unlock();
+                                p.info(begin, end);
+                                lock.lock();
+                                if (++p.chunksFinished == p.chunks)
+                                {
+                                    p.finishedCV.notify_one();
+                                }
+                            }
+                        }
+                    }));
+            }
+            if (threadCount > 1)
+            {
+                p.cv.notify_all();
+            }
+
+            // Read chunks on this thread as well, then wait for the chunks
+            // the other threads are reading.
+            std::unique_lock<std::mutex> lock(p.mutex);
+            size_t begin = 0;
+            size_t end = 0;
+            while (p.next(begin, end))
+            {
+                lock.unlock();
+                p.info(begin, end);
+                lock.lock();
+                ++p.chunksFinished;
+            }
+            p.finishedCV.wait(
+                lock, [this] { return _p->chunksFinished == _p->chunks; });
+        }
+
+        void listSequence(
+            const FileInfo& f, std::vector<FileInfo>& out,
+            ListSequences& sequences, const ListOptions& options)
+        {
+            const Path& p = f.getPath();
             if (options.sequence && p.hasNumber() &&
                 f.getType() != Type::Directory)
             {
@@ -95,46 +267,76 @@ namespace tl
                 if (!options.sequenceExtensions.empty())
                 {
                     sequenceExtension =
-                        std::find(
-                            options.sequenceExtensions.begin(),
-                            options.sequenceExtensions.end(),
+                        options.sequenceExtensions.find(
                             string::toLower(p.getExtension())) !=
                         options.sequenceExtensions.end();
                 }
                 if (sequenceExtension)
                 {
-                    for (auto& i : out)
+                    // Look up the sequence by name instead of comparing
+                    // with every entry.
+                    const std::string key = p.getBaseName() + '\n' +
+                                            p.getSuffix() + '\n' +
+                                            p.getExtension();
+                    const auto i = sequences.find(key);
+                    if (i != sequences.end())
                     {
-                        if (i.getPath().sequence(p))
-                        {
-                            sequence = true;
-                            i.sequence(f);
-                            break;
-                        }
+                        out[i->second].sequence(f);
+                        return;
                     }
+                    sequences[key] = out.size();
                 }
             }
-            if (!sequence)
-            {
-                out.push_back(f);
-            }
+            out.push_back(f);
         }
 
         void list(
             const std::string& path, std::vector<FileInfo>& out,
             const ListOptions& options)
+        {
+            list(path, out, options, nullptr);
+        }
+
+        void list(
+            const std::string& path, std::vector<FileInfo>& out,
+            const ListOptions& options, const ListCallback& callback)
         {
             out.clear();
 
-            _list(path, out, options);
+            ListSequences sequences;
+            std::vector<ListEntry> filtered;
+            std::vector<FileInfo> infos;
+            ListInfo listInfo(path, options);
+            _list(
+                path,
+                [&out, &options, &callback, &sequences, &filtered, &infos,
+                 &listInfo](const std::vector<ListEntry>& entries)
+                {
+                    filtered.clear();
+                    for (const auto& entry : entries)
+                    {
+                        if (!listFilter(entry.fileName, options))
+                        {
+                            filtered.push_back(entry);
+                        }
+                    }
+                    listInfo.run(filtered, infos);
+                    for (const auto& info : infos)
+                    {
+                        listSequence(info, out, sequences, options);
+                    }
+                    return callback ? callback(out) : true;
+                });
 
+            // The directory entries are not read in any particular order,
+            // so sort by name first to make the other sorts stable.
+            std::sort(
+                out.begin(), out.end(),
+                [](const FileInfo& a, const FileInfo& b)
+                { return a.getPath().get() < b.getPath().get(); });
             std::function<int(const FileInfo& a, const FileInfo& b)> sort;
             switch (options.sort)
             {
-            case ListSort::Name:
-                sort = [](const FileInfo& a, const FileInfo& b)
-                { return a.getPath().get() < b.getPath().get(); };
-                break;
             case ListSort::Extension:
                 sort = [](const FileInfo& a, const FileInfo& b) {
                     return a.getPath().getExtension() <
@@ -154,14 +356,11 @@ namespace tl
             }
             if (sort)
             {
-                if (options.reverseSort)
-                {
-                    std::sort(out.rbegin(), out.rend(), sort);
-                }
-                else
-                {
-                    std::sort(out.begin(), out.end(), sort);
-                }
+                std::stable_sort(out.begin(), out.end(), sort);
+            }
+            if (options.reverseSort)
+            {
+                std::reverse(out.begin(), out.end());
             }
             if (options.sortDirectoriesFirst)
             {
@@ -6,6 +6,7 @@
 
 #include <tlCore/Path.h>
 
+#include <functional>
 #include <iostream>
 #include <set>
 
@@ -38,6 +39,10 @@ namespace tl
             FileInfo();
             explicit FileInfo(const Path&);
 
+            //! Create file system information with a known type, without
+            //! reading the rest of the information from the file system.
+            FileInfo(const Path&, Type);
+
             //! Get the path.
             const Path& getPath() const;
 
@@ -93,14 +98,30 @@ namespace tl
             bool negativeNumbers = false;
             size_t maxNumberDigits = 9;
 
+            //! Read the size, permissions, and time of each file. When this
+            //! is disabled only the names and types are listed, which avoids
+            //! a stat() per file on network file systems.
+            bool stat = true;
+
             bool operator==(const ListOptions&) const;
             bool operator!=(const ListOptions&) const;
         };
 
+        //! Directory list callback. This is called periodically with the
+        //! unsorted entries listed so far, return false to stop listing.
+        typedef std::function<bool(const std::vector<FileInfo>&)>
+            ListCallback;
+
         //! Get the contents of the given directory.
         void list(
             const std::string&, std::vector<FileInfo>&,
             const ListOptions& = ListOptions());
+
+        //! Get the contents of the given directory, with partial results
+        //! passed to the callback while the directory is read.
+        void list(
+            const std::string&, std::vector<FileInfo>&, const ListOptions&,
+            const ListCallback&);
     } // namespace file
 } // namespace tl
 
@@ -6,18 +6,53 @@
 
 #include <tlCore/FileInfo.h>
 
+#include <optional>
+#include <unordered_map>
+
 namespace tl
 {
     namespace file
     {
+        //! Directory entry.
+        struct ListEntry
+        {
+            std::string fileName;
+
+            //! The file type, if it is known without calling stat().
+            std::optional<Type> type;
+        };
+
+        //! Map from sequence names to indices in the directory list.
+        typedef std::unordered_map<std::string, size_t> ListSequences;
+
         bool listFilter(const std::string&, const ListOptions&);
 
+        //! Read the file information for batches of directory entries.
+        //! The threads are started by the first batch that needs them and
+        //! are used for the rest of the batches.
+        class ListInfo
+        {
+            TLRENDER_NON_COPYABLE(ListInfo);
+
+        public:
+            ListInfo(const std::string& path, const ListOptions&);
+
+            ~ListInfo();
+
+            void run(const std::vector<ListEntry>&, std::vector<FileInfo>&);
+
+        private:
+            TLRENDER_PRIVATE();
+        };
+
         void listSequence(
-            const std::string& path, const std::string& fileName,
-            std::vector<FileInfo>&, const ListOptions&);
+            const FileInfo&, std::vector<FileInfo>&, ListSequences&,
+            const ListOptions&);
 
+        //! Read the directory entries in batches, reading stops when the
+        //! callback returns false.
         void _list(
-            const std::string&, std::vector<FileInfo>&,
-            const ListOptions& = ListOptions());
+            const std::string&,
+            const std::function<bool(const std::vector<ListEntry>&)>&);
     } // namespace file
 } // namespace tl
@@ -53,31 +53,54 @@ namespace tl
         }
 
         void _list(
-            const std::string& path, std::vector<FileInfo>& out,
-            const ListOptions& options)
+            const std::string& path,
+            const std::function<bool(const std::vector<ListEntry>&)>& callback)
         {
-            struct dirent** namelist;
-            int n;
-
-            n = scandir(
-                !path.empty() ? path.c_str() : ".", &namelist, NULL, alphasort);
-            if (n < 0)
+            DIR* dir = opendir(!path.empty() ? path.c_str() : ".");
+            if (!dir)
             {
                 return;
             }
 
-            // Print filenames
-            for (int i = 0; i < n; i++)
+            // Read the names without a stat() per file, the file type is
+            // usually available from the directory entry.
+            const size_t batchSize = 4096;
+            std::vector<ListEntry> entries;
+            entries.reserve(batchSize);
+            bool running = true;
+            while (running)
             {
-                const std::string fileName(namelist[i]->d_name);
-                if (!listFilter(fileName, options))
+                const struct dirent* de = readdir(dir);
+                if (de)
+                {
+                    ListEntry entry;
+                    entry.fileName = de->d_name;
+#if defined(DT_DIR)
+                    switch (de->d_type)
+                    {
+                    case DT_DIR:
+                        entry.type = Type::Directory;
+                        break;
+                    case DT_REG:
+                        entry.type = Type::File;
+                        break;
+                    default:
+                        break;
+                    }
+#endif // DT_DIR
+                    entries.push_back(entry);
+                }
+                if (entries.size() >= batchSize || (!de && !entries.empty()))
                 {
-                    listSequence(path, fileName, out, options);
+                    running = callback(entries);
+                    entries.clear();
+                }
+                if (!de)
+                {
+                    break;
                 }
-                free(namelist[i]);
             }
-            free(namelist);
+            closedir(dir);
         }
-
     } // namespace file
 } // namespace tl
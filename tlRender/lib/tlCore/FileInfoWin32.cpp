@@ -2,8 +2,6 @@
 // Copyright (c) 2021-2024 Darby Johnston
 // All rights reserved.
 
-#include <algorithm> // for std::sort
-
 #include <tlCore/FileInfoPrivate.h>
 
 #include <tlCore/String.h>
@@ -57,8 +55,8 @@ namespace tl
         }
 
         void _list(
-            const std::string& path, std::vector<FileInfo>& out,
-            const ListOptions& options)
+            const std::string& path,
+            const std::function<bool(const std::vector<ListEntry>&)>& callback)
         {
             const std::string glob =
                 appendSeparator(!path.empty() ? path : std::string(".")) + "*";
@@ -66,36 +64,38 @@ namespace tl
             HANDLE hFind = FindFirstFileW(string::toWide(glob).c_str(), &ffd);
             if (hFind != INVALID_HANDLE_VALUE)
             {
-                // Container to store file names
-                std::vector<std::wstring> fileNames;
-
-                // Collect file names
+                const size_t batchSize = 4096;
+                std::vector<ListEntry> entries;
+                entries.reserve(batchSize);
+                bool running = true;
                 do
                 {
                     const std::wstring fileName(ffd.cFileName);
                     // Skip current and parent directories
                     if (fileName != L"." && fileName != L"..")
                     {
-                        fileNames.push_back(fileName);
+                        ListEntry entry;
+                        entry.fileName = string::fromWide(fileName);
+                        entry.type =
+                            (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+                                ? Type::Directory
+                                : Type::File;
+                        entries.push_back(entry);
+                        if (entries.size() >= batchSize)
+                        {
+                            running = callback(entries);
+                            entries.clear();
+                        }
                     }
-                } while (FindNextFileW(hFind, &ffd) != 0);
+                } while (running && FindNextFileW(hFind, &ffd) != 0);
 
                 FindClose(hFind);
 
-                // Sort the file names alphabetically
-                std::sort(fileNames.begin(), fileNames.end());
-
-                // Process the sorted file names
-                for (const auto& fileName : fileNames)
+                if (running && !entries.empty())
                 {
-                    const std::string fileNameStr = string::fromWide(fileName);
-                    if (!listFilter(fileNameStr, options))
-                    {
-                        listSequence(path, fileNameStr, out, options);
-                    }
+                    callback(entries);
                 }
             }
         }
-
     } // namespace file
 } // namespace tl
@@ -54,3 +54,19 @@ namespace tl
         }
     } // namespace image
 } // namespace tl
+
+namespace std
+{
+    template <> struct hash<tl::image::GlyphInfo>
+    {
+        inline std::size_t
+        operator()(const tl::image::GlyphInfo& value) const noexcept
+        {
+            std::size_t out = 0;
+            tl::memory::hashCombine(out, value.code);
+            tl::memory::hashCombine(out, value.fontInfo.family);
+            tl::memory::hashCombine(out, value.fontInfo.size);
+            return out;
+        }
+    };
+} // namespace std
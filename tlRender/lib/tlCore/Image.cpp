@@ -6,9 +6,18 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/Error.h>
+#include <tlCore/FileIO.h>
 #include <tlCore/String.h>
 #include <tlCore/Locale.h>
 
+#if defined(__SSSE3__) || defined(_M_X64)
+#    include <tmmintrin.h>
+#    define TLRENDER_RGBA_SSSE3
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#    include <arm_neon.h>
+#    define TLRENDER_RGBA_NEON
+#endif
+
 #include <algorithm>
 #include <array>
 #include <atomic>
@@ -362,6 +371,115 @@ namespace tl
             return out;
         }
 
+        namespace
+        {
+            // Copy RGB pixels with channels of the given size to RGBA.
+            template <size_t S>
+            void copyRGBToRGBA(
+                const uint8_t* in, size_t pixelCount, uint8_t* out,
+                const uint8_t (&alpha)[S])
+            {
+                size_t i = 0;
+#if defined(TLRENDER_RGBA_SSSE3) || defined(TLRENDER_RGBA_NEON)
+                // Each step reads 12 bytes and writes 16. The shuffle moves
+                // the RGB bytes into place and zeroes the alpha bytes,
+                // which are then set with a mask.
+                uint8_t shuffle[16];
+                uint8_t mask[16];
+                for (size_t j = 0; j < 16; ++j)
+                {
+                    const size_t pixel = j / (S * 4);
+                    const size_t channel = j % (S * 4) / S;
+                    const size_t byte = j % S;
+                    shuffle[j] = channel < 3 ? static_cast<uint8_t>(
+                                                   pixel * S * 3 +
+                                                   channel * S + byte)
+                                             : 0x80;
+                    mask[j] = channel < 3 ? 0 : alpha[byte];
+                }
+                const size_t stepPixels = 16 / (S * 4);
+#    if defined(TLRENDER_RGBA_SSSE3)
+                const __m128i vShuffle =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle));
+                const __m128i vMask =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+#    else
+                const uint8x16_t vShuffle = vld1q_u8(shuffle);
+                const uint8x16_t vMask = vld1q_u8(mask);
+#    endif
+                // The loads are 16 bytes wide, so stop while there are at
+                // least 4 bytes of input left after the step.
+                const size_t inByteCount = pixelCount * S * 3;
+                for (; (i + stepPixels) * S * 3 + 4 <= inByteCount;
+                     i += stepPixels)
+                {
+                    const uint8_t* inP = in + i * S * 3;
+                    uint8_t* outP = out + i * S * 4;
+#    if defined(TLRENDER_RGBA_SSSE3)
+                    const __m128i v = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(inP));
+                    _mm_storeu_si128(
+                        reinterpret_cast<__m128i*>(outP),
+                        _mm_or_si128(_mm_shuffle_epi8(v, vShuffle), vMask));
+#    else
+                    const uint8x16_t v = vld1q_u8(inP);
+                    vst1q_u8(
+                        outP, vorrq_u8(vqtbl1q_u8(v, vShuffle), vMask));
+#    endif
+                }
+#endif
+                for (; i < pixelCount; ++i)
+                {
+                    const uint8_t* inP = in + i * S * 3;
+                    uint8_t* outP = out + i * S * 4;
+                    std::memcpy(outP, inP, S * 3);
+                    std::memcpy(outP + S * 3, alpha, S);
+                }
+            }
+        } // namespace
+
+        bool copyRGBToRGBA(
+            const uint8_t* in, PixelType pixelType, size_t pixelCount,
+            uint8_t* out)
+        {
+            switch (pixelType)
+            {
+            case PixelType::RGB_U8:
+            {
+                const uint8_t alpha[1] = {0xff};
+                copyRGBToRGBA(in, pixelCount, out, alpha);
+                return true;
+            }
+            case PixelType::RGB_U16:
+            {
+                const uint16_t value = 0xffff;
+                uint8_t alpha[2];
+                std::memcpy(alpha, &value, sizeof(value));
+                copyRGBToRGBA(in, pixelCount, out, alpha);
+                return true;
+            }
+            case PixelType::RGB_F16:
+            {
+                const uint16_t value = 0x3c00;
+                uint8_t alpha[2];
+                std::memcpy(alpha, &value, sizeof(value));
+                copyRGBToRGBA(in, pixelCount, out, alpha);
+                return true;
+            }
+            case PixelType::RGB_F32:
+            {
+                const float value = 1.F;
+                uint8_t alpha[4];
+                std::memcpy(alpha, &value, sizeof(value));
+                copyRGBToRGBA(in, pixelCount, out, alpha);
+                return true;
+            }
+            default:
+                break;
+            }
+            return false;
+        }
+
         namespace
         {
             std::atomic<size_t> objectCount = 0;
@@ -444,6 +562,25 @@ namespace tl
             return out;
         }
 
+        std::shared_ptr<Image> Image::create(
+            const Info& info, const std::shared_ptr<file::FileIO>& fileIO,
+            size_t offset)
+        {
+            auto out = std::shared_ptr<Image>(new Image);
+            out->_init(info, false);
+            const uint8_t* memoryStart = fileIO->getMemoryStart();
+            if (!memoryStart ||
+                offset + out->_dataByteCount > fileIO->getSize())
+            {
+                throw std::runtime_error(
+                    fileIO->getFileName() +
+                    ": Memory-mapped image out of range");
+            }
+            out->_data = const_cast<uint8_t*>(memoryStart + offset);
+            out->_fileIO = fileIO;
+            return out;
+        }
+
         void Image::setTags(const Tags& value)
         {
             _tags = value;
@@ -26,6 +26,11 @@ extern "C"
 
 namespace tl
 {
+    namespace file
+    {
+        class FileIO;
+    }
+
     namespace image
     {
         //! \name Sizes
@@ -279,6 +284,12 @@ namespace tl
         //! Get the number of bytes used to store image data.
         std::size_t getDataByteCount(const Info&);
 
+        //! Copy tightly packed RGB pixels to RGBA, setting the alpha to one.
+        //! The pixel type is the type of the input: RGB_U8, RGB_U16,
+        //! RGB_F16, or RGB_F32. Returns false for other types.
+        bool copyRGBToRGBA(
+            const uint8_t* in, PixelType, size_t pixelCount, uint8_t* out);
+
         //! Image tags.
         typedef std::map<std::string, std::string> Tags;
 
@@ -311,6 +322,20 @@ namespace tl
                                                  const uint8_t* planes[3],
                                                  const int linesize[3]);
 
+            //! Create a new image that references memory-mapped file data
+            //! at the given offset without copying it. The file is kept
+            //! mapped for the lifetime of the image.
+            //!
+            //! The image is read-only. The mapping is copy-on-write, so
+            //! writing to getData() only changes a private copy of the pages
+            //! and not the file. The file must not be truncated or written
+            //! while the image is in use, accessing data past the new end of
+            //! the file raises SIGBUS and rewritten data may change the
+            //! image.
+            static std::shared_ptr<Image> create(
+                const Info&, const std::shared_ptr<file::FileIO>&,
+                size_t offset);
+
             //! Get the image information.
             const Info& getInfo() const;
 
@@ -356,6 +381,9 @@ namespace tl
             //! Get the image data.
             uint8_t* getData();
 
+            //! Get whether the image references memory-mapped file data.
+            bool isMemoryMapped() const;
+
             //! Zero the image data.
             void zero();
 
@@ -393,6 +421,7 @@ namespace tl
             std::shared_ptr<HDRData>  _hdr;
 
             std::shared_ptr<AVFrame> _avFrame;
+            std::shared_ptr<file::FileIO> _fileIO;
             const uint8_t* _planes[3] = { nullptr, nullptr, nullptr };
             int _linesize[3] = { 0, 0, 0 };
             bool _planar = false;
@@ -213,5 +213,10 @@ namespace tl
         {
             return _data;
         }
+
+        inline bool Image::isMemoryMapped() const
+        {
+            return _fileIO.get();
+        }
     } // namespace image
 } // namespace tl
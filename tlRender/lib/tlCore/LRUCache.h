@@ -5,7 +5,9 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
+#include <functional>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 namespace tl
@@ -13,7 +15,12 @@ namespace tl
     namespace memory
     {
         //! Least recently used (LRU) cache.
-        template <typename T, typename U> class LRUCache
+        //!
+        //! The entries are kept in a list ordered by use with a hash map
+        //! from the keys to the list nodes, so looking up, adding and
+        //! evicting entries are constant time operations.
+        template <typename T, typename U, typename H = std::hash<T> >
+        class LRUCache
         {
         public:
             //! \name Size
@@ -38,18 +45,31 @@ namespace tl
             void remove(const T& key);
             void clear();
 
+            //! Get the keys, from the least to the most recently used.
             std::vector<T> getKeys() const;
+
+            //! Get the values, from the least to the most recently used.
             std::vector<U> getValues() const;
 
             ///@}
 
         private:
+            struct Item
+            {
+                T key;
+                U value;
+                size_t size = 0;
+            };
+            typedef std::list<Item> List;
+
             void _maxUpdate();
 
             size_t _max = 10000;
-            std::map<T, std::pair<U, size_t> > _map;
-            mutable std::map<T, int64_t> _counts;
-            mutable int64_t _counter = 0;
+            size_t _size = 0;
+
+            // The most recently used item is at the front of the list.
+            mutable List _list;
+            std::unordered_map<T, typename List::iterator, H> _map;
         };
     } // namespace memory
 } // namespace tl
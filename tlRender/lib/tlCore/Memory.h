@@ -8,6 +8,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -80,6 +81,14 @@ namespace tl
         std::string getBitString(uint16_t);
 
         ///@}
+
+        //! \name Hashing
+        ///@{
+
+        //! Combine a value with a hash.
+        template <typename T> void hashCombine(std::size_t& seed, const T&);
+
+        ///@}
     } // namespace memory
 } // namespace tl
 
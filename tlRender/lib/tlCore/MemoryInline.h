@@ -39,5 +39,13 @@ namespace tl
         {
             return value ^ (1 << bit);
         }
+
+        template <typename T>
+        inline void hashCombine(std::size_t& seed, const T& value)
+        {
+            seed ^= std::hash<T>{}(value) +
+                    static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) +
+                    (seed << 6) + (seed >> 2);
+        }
     } // namespace memory
 } // namespace tl
@@ -4,11 +4,15 @@
 
 #include <tlIO/Cache.h>
 
-#include <tlCore/LRUCache.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <atomic>
+#include <list>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace tl
 {
@@ -28,62 +32,259 @@ namespace tl
             return string::join(s, ';');
         }
 
-        std::string getVideoCacheKey(
-            const file::Path& path, const otime::RationalTime& time,
-            const Options& initOptions, const Options& frameOptions)
+        uint64_t getCachePathID(const file::Path& path)
         {
-            std::vector<std::string> s;
-            s.push_back(path.get());
-            s.push_back(path.getNumber());
-            s.push_back(string::Format("{0}").arg(time));
-            for (const auto& i : initOptions)
+            // The frame number only holds digits, so the last separator
+            // splits it from the path.
+            const std::string key = path.get() + ';' + path.getNumber();
+            static std::shared_mutex mutex;
+            static std::unordered_map<std::string, uint64_t> ids;
             {
-                s.push_back(
-                    string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                const auto i = ids.find(key);
+                if (i != ids.end())
+                {
+                    return i->second;
+                }
             }
-            for (const auto& i : frameOptions)
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            return ids.emplace(key, ids.size() + 1).first->second;
+        }
+
+        namespace
+        {
+            void hashOptions(
+                std::size_t& out, const Options& options,
+                bool skipClearFrame = false)
             {
-                // Do not add ClearFrame frame option if present
-                if (i.first == "ClearFrame")
-                    continue;
+                for (const auto& i : options)
+                {
+                    // Do not add ClearFrame frame option if present
+                    if (skipClearFrame && i.first == "ClearFrame")
+                        continue;
 
-                s.push_back(
-                    string::Format("{0}:{1}").arg(i.first).arg(i.second));
+                    memory::hashCombine(out, i.first);
+                    memory::hashCombine(out, i.second);
+                }
             }
-            return string::join(s, ';');
+        } // namespace
+
+        CacheKey getVideoCacheKey(
+            const file::Path& path, const otime::RationalTime& time,
+            const Options& initOptions, const Options& frameOptions)
+        {
+            CacheKey out;
+            out.path = getCachePathID(path);
+            out.value = time.value();
+            out.rate = time.rate();
+            std::size_t options = 0;
+            hashOptions(options, initOptions);
+            hashOptions(options, frameOptions, true);
+            out.options = options;
+            return out;
         }
 
-        std::string getAudioCacheKey(
+        CacheKey getAudioCacheKey(
             const file::Path& path, const otime::TimeRange& timeRange,
             const Options& initOptions, const Options& frameOptions)
         {
-            std::vector<std::string> s;
-            s.push_back(path.get());
-            s.push_back(path.getNumber());
-            s.push_back(string::Format("{0}").arg(timeRange));
-            for (const auto& i : initOptions)
-            {
-                s.push_back(
-                    string::Format("{0}:{1}").arg(i.first).arg(i.second));
-            }
-            for (const auto& i : frameOptions)
-            {
-                s.push_back(
-                    string::Format("{0}:{1}").arg(i.first).arg(i.second));
-            }
-            return string::join(s, ';');
+            CacheKey out;
+            out.path = getCachePathID(path);
+            out.value = timeRange.start_time().value();
+            out.duration = timeRange.duration().value();
+            out.rate = timeRange.duration().rate();
+            std::size_t options = 0;
+            hashOptions(options, initOptions);
+            hashOptions(options, frameOptions);
+            out.options = options;
+            return out;
         }
 
+        namespace
+        {
+            //! Shard contents, from the most to the least recently used.
+            //! Each item records when it was last used, so the least
+            //! recently used item of the whole cache can be found by
+            //! comparing the oldest item of each shard.
+            template <typename T> struct ShardCache
+            {
+                struct Item
+                {
+                    CacheKey key;
+                    T value;
+                    size_t size = 0;
+                    uint64_t tick = 0;
+                };
+
+                bool contains(const CacheKey& key) const
+                {
+                    return map.find(key) != map.end();
+                }
+
+                bool get(const CacheKey& key, T& value, uint64_t tick)
+                {
+                    const auto i = map.find(key);
+                    if (i == map.end())
+                        return false;
+                    list.splice(list.begin(), list, i->second);
+                    i->second->tick = tick;
+                    value = i->second->value;
+                    return true;
+                }
+
+                // Returns the change in size.
+                int64_t add(
+                    const CacheKey& key, const T& value, size_t size,
+                    uint64_t tick)
+                {
+                    int64_t out = size;
+                    const auto i = map.find(key);
+                    if (i != map.end())
+                    {
+                        out -= i->second->size;
+                        i->second->value = value;
+                        i->second->size = size;
+                        i->second->tick = tick;
+                        list.splice(list.begin(), list, i->second);
+                    }
+                    else
+                    {
+                        list.push_front({key, value, size, tick});
+                        map[key] = list.begin();
+                    }
+                    return out;
+                }
+
+                // Returns the size that was removed.
+                size_t remove(const CacheKey& key)
+                {
+                    size_t out = 0;
+                    const auto i = map.find(key);
+                    if (i != map.end())
+                    {
+                        out = i->second->size;
+                        list.erase(i->second);
+                        map.erase(i);
+                    }
+                    return out;
+                }
+
+                // Returns the size that was removed.
+                size_t removeOldest()
+                {
+                    size_t out = 0;
+                    if (!list.empty())
+                    {
+                        out = list.back().size;
+                        map.erase(list.back().key);
+                        list.pop_back();
+                    }
+                    return out;
+                }
+
+                bool getOldestTick(uint64_t& tick) const
+                {
+                    if (list.empty())
+                        return false;
+                    tick = list.back().tick;
+                    return true;
+                }
+
+                // Returns the size that was removed.
+                size_t clear()
+                {
+                    size_t out = 0;
+                    for (const auto& i : list)
+                    {
+                        out += i.size;
+                    }
+                    list.clear();
+                    map.clear();
+                    return out;
+                }
+
+                std::list<Item> list;
+                std::unordered_map<CacheKey, typename std::list<Item>::iterator>
+                    map;
+            };
+        } // namespace
+
         struct Cache::Private
         {
-            size_t max = memory::gigabyte;
-            memory::LRUCache<std::string, VideoData> video;
-            memory::LRUCache<std::string, AudioData> audio;
-            std::mutex mutex;
+            struct Shard
+            {
+                ShardCache<VideoData> video;
+                ShardCache<AudioData> audio;
+                std::mutex mutex;
+            };
+
+            Shard& shard(const CacheKey& key) const
+            {
+                return *shards[std::hash<CacheKey>{}(key) % shards.size()];
+            }
+
+            // Remove the least recently used items of all the shards until
+            // the size is below the maximum.
+            template <typename T>
+            void evict(
+                ShardCache<T> Shard::*cache, std::atomic<size_t>& size,
+                size_t max);
+
+            std::atomic<size_t> max = memory::gigabyte;
+            std::vector<std::unique_ptr<Shard> > shards;
+
+            // The sizes of all the shards. The budget is shared by all of
+            // the shards, so a shard can hold items larger than an equal
+            // share of the maximum.
+            std::atomic<size_t> videoSize = 0;
+            std::atomic<size_t> audioSize = 0;
+
+            std::atomic<uint64_t> tick = 0;
+            std::mutex evictMutex;
         };
 
-        void Cache::_init()
+        template <typename T>
+        void Cache::Private::evict(
+            ShardCache<T> Shard::*cache, std::atomic<size_t>& size,
+            size_t max)
+        {
+            // Most adds leave the cache under the maximum, so check before
+            // serializing on the eviction lock.
+            if (size <= max)
+                return;
+            std::unique_lock<std::mutex> evictLock(evictMutex);
+            while (size > max)
+            {
+                // Find the shard with the oldest item. Only one shard is
+                // locked at a time.
+                Shard* oldest = nullptr;
+                uint64_t oldestTick = 0;
+                for (const auto& shard : shards)
+                {
+                    std::unique_lock<std::mutex> lock(shard->mutex);
+                    uint64_t tick = 0;
+                    if (((*shard).*cache).getOldestTick(tick) &&
+                        (!oldest || tick < oldestTick))
+                    {
+                        oldest = shard.get();
+                        oldestTick = tick;
+                    }
+                }
+                if (!oldest)
+                    break;
+                std::unique_lock<std::mutex> lock(oldest->mutex);
+                size -= ((*oldest).*cache).removeOldest();
+            }
+        }
+
+        void Cache::_init(size_t shardCount)
         {
+            TLRENDER_P();
+            shardCount = std::max(shardCount, static_cast<size_t>(1));
+            for (size_t i = 0; i < shardCount; ++i)
+            {
+                p.shards.push_back(std::make_unique<Private::Shard>());
+            }
             _maxUpdate();
         }
 
@@ -94,10 +295,10 @@ namespace tl
 
         Cache::~Cache() {}
 
-        std::shared_ptr<Cache> Cache::create()
+        std::shared_ptr<Cache> Cache::create(size_t shardCount)
         {
             auto out = std::shared_ptr<Cache>(new Cache);
-            out->_init();
+            out->_init(shardCount);
             return out;
         }
 
@@ -109,95 +310,115 @@ namespace tl
         void Cache::setMax(size_t value)
         {
             TLRENDER_P();
-            if (value == p.max)
+            if (value == p.max.exchange(value))
                 return;
-            p.max = value;
             _maxUpdate();
         }
 
+        size_t Cache::getShardCount() const
+        {
+            return _p->shards.size();
+        }
+
         size_t Cache::getSize() const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.getSize() + p.audio.getSize();
+            return p.videoSize + p.audioSize;
         }
 
         float Cache::getPercentage() const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return (p.video.getSize() + p.audio.getSize()) /
-                   static_cast<float>(p.video.getMax() + p.audio.getMax()) *
-                   100.F;
+            const size_t max = p.max;
+            return max > 0 ? (getSize() / static_cast<float>(max) * 100.F)
+                           : 0.F;
         }
 
-        void Cache::addVideo(const std::string& key, const VideoData& videoData)
+        void Cache::addVideo(const CacheKey& key, const VideoData& videoData)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.add(
-                key, videoData,
-                videoData.image ? videoData.image->getDataByteCount() : 1);
+            {
+                auto& shard = p.shard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                p.videoSize += shard.video.add(
+                    key, videoData,
+                    videoData.image ? videoData.image->getDataByteCount() : 1,
+                    ++p.tick);
+            }
+            p.evict(&Private::Shard::video, p.videoSize, p.max * .9F);
         }
 
-        void Cache::removeVideo(const std::string& key)
+        void Cache::removeVideo(const CacheKey& key)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.remove(key);
+            auto& shard = p.shard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            p.videoSize -= shard.video.remove(key);
         }
 
-        bool Cache::containsVideo(const std::string& key) const
+        bool Cache::containsVideo(const CacheKey& key) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.contains(key);
+            auto& shard = p.shard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.video.contains(key);
         }
 
-        bool Cache::getVideo(const std::string& key, VideoData& videoData) const
+        bool Cache::getVideo(const CacheKey& key, VideoData& videoData) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.video.get(key, videoData);
+            auto& shard = p.shard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.video.get(key, videoData, ++p.tick);
         }
 
-        void Cache::addAudio(const std::string& key, const AudioData& audioData)
+        void Cache::addAudio(const CacheKey& key, const AudioData& audioData)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.audio.add(
-                key, audioData,
-                audioData.audio ? audioData.audio->getByteCount() : 1);
+            {
+                auto& shard = p.shard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                p.audioSize += shard.audio.add(
+                    key, audioData,
+                    audioData.audio ? audioData.audio->getByteCount() : 1,
+                    ++p.tick);
+            }
+            p.evict(&Private::Shard::audio, p.audioSize, p.max * .1F);
         }
 
-        bool Cache::containsAudio(const std::string& key) const
+        bool Cache::containsAudio(const CacheKey& key) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.audio.contains(key);
+            auto& shard = p.shard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.audio.contains(key);
         }
 
-        bool Cache::getAudio(const std::string& key, AudioData& audioData) const
+        bool Cache::getAudio(const CacheKey& key, AudioData& audioData) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.audio.get(key, audioData);
+            auto& shard = p.shard(key);
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            return shard.audio.get(key, audioData, ++p.tick);
         }
 
         void Cache::clear()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.clear();
-            p.audio.clear();
+            for (const auto& shard : p.shards)
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                p.videoSize -= shard->video.clear();
+                p.audioSize -= shard->audio.clear();
+            }
         }
 
         void Cache::_maxUpdate()
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.video.setMax(p.max * .9F);
-            p.audio.setMax(p.max * .1F);
+            // The budget is split between video and audio.
+            p.evict(&Private::Shard::video, p.videoSize, p.max * .9F);
+            p.evict(&Private::Shard::audio, p.audioSize, p.max * .1F);
         }
     } // namespace io
 } // namespace tl
@@ -12,26 +12,63 @@ namespace tl
 {
     namespace io
     {
+        //! Cache key.
+        //!
+        //! A compact binary key made from the path ID (see getCachePathID()),
+        //! the time, and a hash of the options. The time is stored as a value
+        //! and a rate; audio keys also store the duration.
+        struct CacheKey
+        {
+            uint64_t path = 0;
+            double value = 0.0;
+            double duration = 0.0;
+            double rate = 0.0;
+            uint64_t options = 0;
+
+            bool operator==(const CacheKey&) const;
+            bool operator!=(const CacheKey&) const;
+            bool operator<(const CacheKey&) const;
+        };
+
+        //! Get the cache ID for a path. Each distinct path is given its own
+        //! ID the first time it is seen, so the keys for different paths
+        //! never compare equal. IDs are kept for the life of the process.
+        uint64_t getCachePathID(const file::Path&);
+
         //! Get an I/O information cache key.
         std::string getInfoCacheKey(const file::Path&, const Options&);
 
         //! Get a video cache key.
-        std::string getVideoCacheKey(
+        CacheKey getVideoCacheKey(
             const file::Path&, const otime::RationalTime&,
             const Options& initOptions, const Options& frameOptions);
 
         //! Get an audio cache key.
-        std::string getAudioCacheKey(
+        CacheKey getAudioCacheKey(
             const file::Path&, const otime::TimeRange&,
             const Options& initOptions, const Options& frameOptions);
 
+        //! Default number of I/O cache shards.
+        const size_t cacheShardCount = 16;
+
         //! I/O cache.
+        //!
+        //! The cache is split into shards by key hash, each with its own
+        //! lock, so that lookups from different threads do not serialize on
+        //! a single lock. The maximum size is shared by all of the shards,
+        //! and the least recently used items of the whole cache are evicted
+        //! first.
+        //!
+        //! Images that reference memory-mapped files (see
+        //! image::Image::isMemoryMapped()) keep the files mapped while they
+        //! are in the cache; they are counted at their full size, and the
+        //! mapping is released when the last reference is removed.
         class Cache : public std::enable_shared_from_this<Cache>
         {
             TLRENDER_NON_COPYABLE(Cache);
 
         protected:
-            void _init();
+            void _init(size_t shardCount);
 
             Cache();
 
@@ -39,7 +76,8 @@ namespace tl
             ~Cache();
 
             //! Create a new cache.
-            static std::shared_ptr<Cache> create();
+            static std::shared_ptr<Cache>
+            create(size_t shardCount = cacheShardCount);
 
             //! Get the maximum cache size in bytes.
             size_t getMax() const;
@@ -47,32 +85,37 @@ namespace tl
             //! Set the maximum cache size in bytes.
             void setMax(size_t);
 
-            //! Get the current cache size in bytes.
+            //! Get the number of shards.
+            size_t getShardCount() const;
+
+            //! Get the current cache size in bytes. This does not lock the
+            //! cache.
             size_t getSize() const;
 
-            //! Get the current cache size as a percentage.
+            //! Get the current cache size as a percentage. This does not lock
+            //! the cache.
             float getPercentage() const;
 
             //! Add video to the cache.
-            void addVideo(const std::string& key, const VideoData&);
+            void addVideo(const CacheKey& key, const VideoData&);
 
             //! Get whether the cache contains video.
-            bool containsVideo(const std::string& key) const;
+            bool containsVideo(const CacheKey& key) const;
 
             //! Get video from the cache.
-            bool getVideo(const std::string& key, VideoData&) const;
+            bool getVideo(const CacheKey& key, VideoData&) const;
 
             //! Remove video from the cache.
-            void removeVideo(const std::string& key);
+            void removeVideo(const CacheKey& key);
 
             //! Add audio to the cache.
-            void addAudio(const std::string& key, const AudioData&);
+            void addAudio(const CacheKey& key, const AudioData&);
 
             //! Get whether the cache contains audio.
-            bool containsAudio(const std::string& key) const;
+            bool containsAudio(const CacheKey& key) const;
 
             //! Get audio from the cache.
-            bool getAudio(const std::string& key, AudioData&) const;
+            bool getAudio(const CacheKey& key, AudioData&) const;
 
             //! Clear the cache.
             void clear();
@@ -84,3 +127,5 @@ namespace tl
         };
     } // namespace io
 } // namespace tl
+
+#include <tlIO/CacheInline.h>
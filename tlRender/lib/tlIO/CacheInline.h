@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlCore/Memory.h>
+
+#include <tuple>
+
+namespace tl
+{
+    namespace io
+    {
+        inline bool CacheKey::operator==(const CacheKey& other) const
+        {
+            return path == other.path && value == other.value &&
+                   duration == other.duration && rate == other.rate &&
+                   options == other.options;
+        }
+
+        inline bool CacheKey::operator!=(const CacheKey& other) const
+        {
+            return !(*this == other);
+        }
+
+        inline bool CacheKey::operator<(const CacheKey& other) const
+        {
+            return std::tie(path, value, duration, rate, options) <
+                   std::tie(
+                       other.path, other.value, other.duration, other.rate,
+                       other.options);
+        }
+    } // namespace io
+} // namespace tl
+
+namespace std
+{
+    template <> struct hash<tl::io::CacheKey>
+    {
+        inline std::size_t
+        operator()(const tl::io::CacheKey& value) const noexcept
+        {
+            std::size_t out = 0;
+            tl::memory::hashCombine(out, value.path);
+            tl::memory::hashCombine(out, value.value);
+            tl::memory::hashCombine(out, value.duration);
+            tl::memory::hashCombine(out, value.rate);
+            tl::memory::hashCombine(out, value.options);
+            return out;
+        }
+    };
+} // namespace std
@@ -81,11 +81,9 @@ namespace tl
             io::Info info;
             read(io, info);
 
-            out.image = image::Image::create(info.video[0]);
+            out.image = _readImage(io, info.video[0], memory);
             _addOtioTags(info.tags, fileName, time);
             out.image->setTags(info.tags);
-            io->read(
-                out.image->getData(), image::getDataByteCount(info.video[0]));
             return out;
         }
     } // namespace cineon
@@ -92,7 +92,7 @@ namespace tl
 
         io::VideoData Read::_readVideo(
             const std::string& fileName, const file::MemoryRead* memory,
-            const otime::RationalTime& time, const io::Options&)
+            const otime::RationalTime& time, const io::Options& options)
         {
             io::VideoData out;
             out.time = time;
@@ -103,16 +103,57 @@ namespace tl
             Transfer transfer = Transfer::User;
             read(io, info, transfer);
 
-            out.image = image::Image::create(info.video[0]);
-            io->read(
-                out.image->getData(), image::getDataByteCount(info.video[0]));
+            const int step = io::getFrameRequest(options).getSubsampleStep();
+            if (step > 1 && info.video[0].size.h > 0)
+            {
+                // Read every n'th scanline and pixel for a lower resolution
+                // frame request.
+                const image::Info& fullInfo = info.video[0];
+                image::Info subsampleInfo = fullInfo;
+                subsampleInfo.size.w = (fullInfo.size.w + step - 1) / step;
+                subsampleInfo.size.h = (fullInfo.size.h + step - 1) / step;
+                out.image = image::Image::create(subsampleInfo);
+                const size_t scanlineByteCount =
+                    image::getDataByteCount(fullInfo) / fullInfo.size.h;
+                const size_t subsampleScanlineByteCount =
+                    image::getDataByteCount(subsampleInfo) /
+                    subsampleInfo.size.h;
+                const size_t pixelByteCount = image::getDataByteCount(
+                    image::Info(1, 1, fullInfo.pixelType));
+                std::vector<uint8_t> scanline(scanlineByteCount);
+                const size_t pos = io->getPos();
+                uint8_t* p = out.image->getData();
+                for (int y = 0; y < subsampleInfo.size.h;
+                     ++y, p += subsampleScanlineByteCount)
+                {
+                    io->setPos(pos + y * step * scanlineByteCount);
+                    io->read(scanline.data(), scanlineByteCount);
+                    io::subsampleScanline(
+                        scanline.data(), p, subsampleInfo.size.w,
+                        pixelByteCount, step);
+                }
+                info.video[0] = subsampleInfo;
+            }
+            else if (_autoNormalize)
+            {
+                // The image is normalized in place, so it needs a copy of
+                // the data.
+                out.image = image::Image::create(info.video[0]);
+                io->read(
+                    out.image->getData(),
+                    image::getDataByteCount(info.video[0]));
+            }
+            else
+            {
+                out.image = _readImage(io, info.video[0], memory);
+            }
 
             if (_autoNormalize)
             {
                 math::Vector4f minimum, maximum;
                 io::normalizeImage(
                     minimum, maximum, out.image, info.video[0], 0,
-                    info.video[0].size.w, 0, info.video[0].size.h);
+                    info.video[0].size.w - 1, 0, info.video[0].size.h - 1);
                 info.tags["Autonormalize Minimum"] = io::serialize(minimum);
                 info.tags["Autonormalize Maximum"] = io::serialize(maximum);
             }
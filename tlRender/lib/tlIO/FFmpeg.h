@@ -154,12 +154,17 @@ namespace tl
                 const otime::TimeRange&,
                 const io::Options& = io::Options()) override;
             void cancelRequests() override;
+            size_t getByteCount() const override;
+            void releaseMemory() override;
 
         private:
             void _addToCache(
                 io::VideoData& data, const otime::RationalTime&,
-                const io::Options&);
+                const io::Options&, bool gop = false);
             void _videoThread();
+            void _startIntraThreads();
+            void _stopIntraThreads();
+            void _intraThread();
             void _audioThread();
             void _cancelVideoRequests();
             void _cancelAudioRequests();
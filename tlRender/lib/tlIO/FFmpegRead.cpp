@@ -3,9 +3,12 @@
 // Copyright (c) 2024-Present Gonzalo Garramuño
 // All rights reserved.
 
+#include <algorithm>
+
 #include <tlIO/FFmpegReadPrivate.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/Memory.h>
 #include <tlCore/StringFormat.h>
 
 extern "C"
@@ -18,6 +21,49 @@ namespace tl
 {
     namespace ffmpeg
     {
+        namespace
+        {
+            size_t getIntraDecoderCount(const Options& options)
+            {
+                size_t out = options.intraDecoderCount;
+                if (0 == out)
+                {
+                    out = 2;
+                }
+                return out;
+            }
+
+            //! Number of additional intra decoders running in the process.
+            std::atomic<size_t> intraDecoderThreads{0};
+
+            //! Reserve up to the given number of additional intra decoders,
+            //! returning the number that were reserved.
+            size_t reserveIntraDecoderThreads(size_t count)
+            {
+                const size_t max = getIntraDecoderThreadsMax();
+                size_t current = intraDecoderThreads;
+                size_t out = 0;
+                do
+                {
+                    out = current < max ? std::min(count, max - current) : 0;
+                } while (out > 0 && !intraDecoderThreads.compare_exchange_weak(
+                                        current, current + out));
+                return out;
+            }
+        } // namespace
+
+        size_t getIntraDecoderThreads()
+        {
+            return intraDecoderThreads;
+        }
+
+        size_t getIntraDecoderThreadsMax()
+        {
+            // Leave half of the hardware threads for the other readers,
+            // rendering and the user interface.
+            return std::thread::hardware_concurrency() / 2;
+        }
+
         AVIOBufferData::AVIOBufferData() {}
 
         AVIOBufferData::AVIOBufferData(const uint8_t* p, size_t size) :
@@ -130,6 +176,30 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> p.options.audioBufferSize;
             }
+            i = options.find("FFmpeg/KeyframeIndex");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.keyframeIndex;
+            }
+            i = options.find("FFmpeg/KeyframeIndexDir");
+            if (i != options.end())
+            {
+                p.options.keyframeIndexDir = i->second;
+            }
+            i = options.find("FFmpeg/GOPBufferSize");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.gopBufferSize;
+            }
+            i = options.find("FFmpeg/IntraDecoderCount");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss >> p.options.intraDecoderCount;
+            }
+            p.gopBuffer.setMax(p.options.gopBufferSize * memory::megabyte);
 
             p.videoThread.running = true;
             p.audioThread.running = true;
@@ -259,11 +329,12 @@ namespace tl
                 std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
                 p.videoThread.running = false;
             }
-            p.videoThread.cv.notify_one();
+            p.videoThread.cv.notify_all();
             if (p.videoThread.thread.joinable())
             {
                 p.videoThread.thread.join();
             }
+            _stopIntraThreads();
 
             // Stop the audio thread
             {
@@ -313,7 +384,7 @@ namespace tl
             }
             if (valid)
             {
-                p.videoThread.cv.notify_one();
+                p.videoThread.cv.notify_all();
             }
             else
             {
@@ -341,7 +412,7 @@ namespace tl
             }
             if (valid)
             {
-                p.videoThread.cv.notify_one();
+                p.videoThread.cv.notify_all();
             }
             else
             {
@@ -384,9 +455,55 @@ namespace tl
             _cancelAudioRequests();
         }
 
+        size_t Read::getByteCount() const
+        {
+            return _p->gopBufferByteCount;
+        }
+
+        void Read::releaseMemory()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                p.videoMutex.releaseMemory = true;
+            }
+            p.videoThread.cv.notify_all();
+        }
+
+        void Read::_startIntraThreads()
+        {
+            TLRENDER_P();
+            const size_t count =
+                reserveIntraDecoderThreads(getIntraDecoderCount(p.options) - 1);
+            p.intraRunning = true;
+            for (size_t i = 0; i < count; ++i)
+            {
+                p.intraThreads.emplace_back([this] { _intraThread(); });
+            }
+        }
+
+        void Read::_stopIntraThreads()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                p.intraRunning = false;
+            }
+            p.videoThread.cv.notify_all();
+            for (auto& thread : p.intraThreads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            intraDecoderThreads -= p.intraThreads.size();
+            p.intraThreads.clear();
+        }
+
         void Read::_addToCache(
             io::VideoData& data, const otime::RationalTime& time,
-            const io::Options& options)
+            const io::Options& options, bool gop)
         {
             TLRENDER_P();
             data.time = time;
@@ -395,9 +512,18 @@ namespace tl
                 data.image = p.readVideo->popBuffer();
             }
 
-            const std::string cacheKey =
+            const io::CacheKey cacheKey =
                 io::getVideoCacheKey(_path, time, _options, options);
-            _cache->addVideo(cacheKey, data);
+            if (_cache)
+            {
+                _cache->addVideo(cacheKey, data);
+            }
+            if (gop && data.image && p.gopBuffer.getMax() > 0)
+            {
+                p.gopBuffer.add(
+                    cacheKey, data, data.image->getDataByteCount());
+                p.gopBufferByteCount = p.gopBuffer.getSize();
+            }
         }
 
         void Read::_videoThread()
@@ -406,11 +532,14 @@ namespace tl
             p.videoThread.currentTime = p.info.videoTime.start_time();
             p.readVideo->start();
             p.videoThread.logTimer = std::chrono::steady_clock::now();
+            bool intraStarted = false;
             while (p.videoThread.running)
             {
                 // Check requests.
                 std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
                 std::shared_ptr<Private::VideoRequest> videoRequest;
+                bool queued = false;
+                bool releaseMemory = false;
                 {
                     std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
                     p.videoThread.cv.wait(
@@ -418,6 +547,7 @@ namespace tl
                             {
                                 return (!_p->videoMutex.infoRequests.empty() ||
                                         !_p->videoMutex.videoRequests.empty() ||
+                                        _p->videoMutex.releaseMemory ||
                                         !_p->videoThread.running);
                             });
 
@@ -425,12 +555,38 @@ namespace tl
                     if (!p.videoThread.running)
                         return;
                     
+                    releaseMemory = p.videoMutex.releaseMemory;
+                    p.videoMutex.releaseMemory = false;
                     infoRequests = std::move(p.videoMutex.infoRequests);
                     if (!p.videoMutex.videoRequests.empty())
                     {
                         videoRequest = p.videoMutex.videoRequests.front();
                         p.videoMutex.videoRequests.pop_front();
                     }
+                    queued = !p.videoMutex.videoRequests.empty();
+                }
+
+                // Start the additional decoders for intra-only codecs the
+                // first time requests are queued.
+                if (queued && !intraStarted)
+                {
+                    intraStarted = true;
+                    if (p.readVideo->isIntraOnly())
+                    {
+                        _startIntraThreads();
+                    }
+                }
+
+                // Release the GOP buffer and the additional decoders. The
+                // main decoder and the file stay open so the next request
+                // does not need to open them again, and the additional
+                // decoders are started again when requests are queued.
+                if (releaseMemory)
+                {
+                    p.gopBuffer.clear();
+                    p.gopBufferByteCount = 0;
+                    _stopIntraThreads();
+                    intraStarted = false;
                 }
 
                 // Information requests.
@@ -443,7 +599,7 @@ namespace tl
                 io::VideoData videoData;
                 if (videoRequest && _cache)
                 {
-                    const std::string cacheKey = io::getVideoCacheKey(
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
                         _path, videoRequest->time, _options,
                         videoRequest->options);
                     if (_cache->getVideo(cacheKey, videoData))
@@ -453,6 +609,34 @@ namespace tl
                     }
                 }
 
+                // Check the GOP buffer.
+                if (videoRequest && p.gopBuffer.getCount() > 0)
+                {
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
+                        _path, videoRequest->time, _options,
+                        videoRequest->options);
+                    if (p.gopBuffer.get(cacheKey, videoData))
+                    {
+                        videoRequest->promise.set_value(videoData);
+                        videoRequest.reset();
+                    }
+                }
+
+                // Change the decode scale for the frame request. Frames in
+                // the buffer were decoded at the previous scale, so seek to
+                // flush them.
+                if (videoRequest)
+                {
+                    const float scale =
+                        io::getFrameRequest(videoRequest->options).scale;
+                    if (scale != p.readVideo->getScale())
+                    {
+                        p.readVideo->setScale(scale);
+                        p.readVideo->seek(videoRequest->time);
+                        p.videoThread.currentTime = videoRequest->time;
+                    }
+                }
+
                 // Seek.
                 //
                 // \@note: Seeking on some large movies with inter-frame
@@ -462,16 +646,36 @@ namespace tl
                 //         actual request time, we cache all previous 'F' and
                 //         'I' frames which allows us to play 4K movies
                 //         backwards with no issues.
+                //
+                //         The previous frames are also kept in the GOP
+                //         buffer, so playing backwards decodes each GOP
+                //         once. With the keyframe index the seek goes
+                //         directly to the keyframe of the GOP, and requests
+                //         further on in the current GOP are decoded without
+                //         seeking.
                 bool backwards = false;
                 if (videoRequest && !videoRequest->time.strictly_equal(
                                         p.videoThread.currentTime))
                 {
-                    if (_cache &&
+                    if ((_cache || p.gopBuffer.getMax() > 0) &&
                         videoRequest->time < p.videoThread.currentTime)
+                    {
                         backwards = true;
+                        p.readVideo->seek(videoRequest->time);
+                    }
+                    else if (
+                        videoRequest->time > p.videoThread.currentTime &&
+                        p.readVideo->isBufferEmpty() &&
+                        p.readVideo->isSameGOP(
+                            p.videoThread.currentTime, videoRequest->time))
+                    {
+                        p.videoThread.currentTime = videoRequest->time;
+                    }
                     else
+                    {
                         p.videoThread.currentTime = videoRequest->time;
-                    p.readVideo->seek(videoRequest->time);
+                        p.readVideo->seek(videoRequest->time);
+                    }
                 }
 
                 // Process.
@@ -489,7 +693,7 @@ namespace tl
                         io::VideoData data;
                         _addToCache(
                             data, p.videoThread.currentTime,
-                            videoRequest->options);
+                            videoRequest->options, true);
                     }
                 }
 
@@ -536,6 +740,109 @@ namespace tl
             }
         }
 
+        void Read::_intraThread()
+        {
+            TLRENDER_P();
+            std::shared_ptr<ReadVideo> readVideo;
+            try
+            {
+                // Each decoder is single threaded, the decoders themselves
+                // provide the parallelism.
+                Options options = p.options;
+                options.threadCount = 1;
+                options.keyframeIndex = false;
+                readVideo = std::make_shared<ReadVideo>(
+                    _path.hasProtocol() ? _path.get()
+                                        : _path.getFileName(true),
+                    _memory, _logSystem, options);
+                readVideo->start();
+            }
+            catch (const std::exception& e)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    const std::string id =
+                        string::Format("tl::io::ffmpeg::Read ({0}: {1})")
+                            .arg(__FILE__)
+                            .arg(__LINE__);
+                    logSystem->print(
+                        id,
+                        string::Format("{0}: {1}")
+                            .arg(_path.get())
+                            .arg(e.what()),
+                        log::Type::Error);
+                }
+                return;
+            }
+
+            otime::RationalTime currentTime = time::invalidTime;
+            while (p.videoThread.running && p.intraRunning)
+            {
+                // Check requests.
+                std::shared_ptr<Private::VideoRequest> videoRequest;
+                {
+                    std::unique_lock<std::mutex> lock(p.videoMutex.mutex);
+                    p.videoThread.cv.wait(
+                        lock, [this]
+                        {
+                            return (!_p->videoMutex.videoRequests.empty() ||
+                                    !_p->videoThread.running ||
+                                    !_p->intraRunning);
+                        });
+                    if (!p.videoThread.running || !p.intraRunning)
+                        return;
+                    videoRequest = p.videoMutex.videoRequests.front();
+                    p.videoMutex.videoRequests.pop_front();
+                }
+
+                // Check the cache.
+                const io::CacheKey cacheKey = io::getVideoCacheKey(
+                    _path, videoRequest->time, _options,
+                    videoRequest->options);
+                io::VideoData data;
+                if (_cache && _cache->getVideo(cacheKey, data))
+                {
+                    videoRequest->promise.set_value(data);
+                    continue;
+                }
+
+                // Every frame is a keyframe, so seeking is cheap.
+                const float scale =
+                    io::getFrameRequest(videoRequest->options).scale;
+                if (scale != readVideo->getScale())
+                {
+                    readVideo->setScale(scale);
+                    currentTime = time::invalidTime;
+                }
+                if (!videoRequest->time.strictly_equal(currentTime))
+                {
+                    currentTime = videoRequest->time;
+                    readVideo->seek(videoRequest->time);
+                }
+
+                // Process.
+                while (readVideo->isBufferEmpty() && readVideo->isValid() &&
+                       readVideo->process(
+                           false, videoRequest->time, currentTime))
+                    ;
+
+                // Handle request.
+                data.time = videoRequest->time;
+                if (!readVideo->isBufferEmpty())
+                {
+                    data.image = readVideo->popBuffer();
+                }
+                if (_cache)
+                {
+                    _cache->addVideo(cacheKey, data);
+                }
+                videoRequest->promise.set_value(data);
+                currentTime = videoRequest->time +
+                              otime::RationalTime(
+                                  1.0, p.info.videoTime.duration().rate());
+            }
+        }
+
         void Read::_audioThread()
         {
             TLRENDER_P();
@@ -582,7 +889,7 @@ namespace tl
                 io::AudioData audioData;
                 if (request && _cache)
                 {
-                    const std::string cacheKey = io::getAudioCacheKey(
+                    const io::CacheKey cacheKey = io::getAudioCacheKey(
                         _path, request->timeRange, _options, request->options);
                     if (_cache->getAudio(cacheKey, audioData))
                     {
@@ -645,7 +952,7 @@ namespace tl
 
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getAudioCacheKey(
+                        const io::CacheKey cacheKey = io::getAudioCacheKey(
                             _path, request->timeRange, _options,
                             request->options);
                         _cache->addAudio(cacheKey, audioData);
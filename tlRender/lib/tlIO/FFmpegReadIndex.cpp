@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// Copyright (c) 2024-Present Gonzalo Garramuño
+// All rights reserved.
+
+#include <tlIO/FFmpegReadPrivate.h>
+
+#include <tlCore/File.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+} // extern "C"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace ffmpeg
+    {
+        namespace
+        {
+            const std::string indexHeader = "tlRender FFmpeg keyframe index 2";
+
+            fs::path toPath(const std::string& fileName)
+            {
+#if defined(__cpp_lib_char8_t)
+                return fs::path(
+                    reinterpret_cast<const char8_t*>(fileName.data()),
+                    reinterpret_cast<const char8_t*>(
+                        fileName.data() + fileName.size()));
+#else
+                return fs::u8path(fileName);
+#endif
+            }
+
+            // The index file name is a hash of the media file name, size
+            // and modification time, so that a modified file is indexed
+            // again.
+            std::string getIndexFileName(
+                const std::string& fileName, int stream,
+                const std::string& indexDir)
+            {
+                std::string out;
+                std::error_code ec;
+                const fs::path path = toPath(fileName);
+                const auto size = fs::file_size(path, ec);
+                if (ec)
+                    return out;
+                const auto time = fs::last_write_time(path, ec);
+                if (ec)
+                    return out;
+                std::stringstream ss;
+                ss << fileName << '|' << size << '|'
+                   << time.time_since_epoch().count() << '|' << stream;
+                std::stringstream ss2;
+                ss2 << indexDir << '/' << std::hex << std::setfill('0')
+                    << std::setw(16) << std::hash<std::string>()(ss.str())
+                    << ".idx";
+                out = ss2.str();
+                return out;
+            }
+        } // namespace
+
+        std::string getKeyframeIndexDir()
+        {
+            const std::string dir = file::getTemp() + "/tlRender";
+            file::mkdir(dir);
+            const std::string out = dir + "/FFmpegIndex";
+            file::mkdir(out);
+            return out;
+        }
+
+        KeyframeIndex::KeyframeIndex(
+            const std::string& fileName, int stream,
+            const std::string& indexDir) :
+            _fileName(fileName),
+            _stream(stream),
+            _indexFileName(getIndexFileName(fileName, stream, indexDir))
+        {
+            _ready = false;
+            _running = true;
+            _thread = std::thread(
+                [this]
+                {
+                    try
+                    {
+                        if (!_load())
+                        {
+                            _build();
+                            if (_running)
+                            {
+                                _save();
+                            }
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        _entries.clear();
+                    }
+                    if (_running && !_entries.empty())
+                    {
+                        _ready.store(true, std::memory_order_release);
+                    }
+                });
+        }
+
+        KeyframeIndex::~KeyframeIndex()
+        {
+            _running = false;
+            if (_thread.joinable())
+            {
+                _thread.join();
+            }
+        }
+
+        bool KeyframeIndex::isReady() const
+        {
+            return _ready.load(std::memory_order_acquire);
+        }
+
+        bool KeyframeIndex::getKeyframe(int64_t pts, Entry& out) const
+        {
+            // The entries are not modified after the index is ready.
+            if (!isReady())
+                return false;
+            auto i = std::upper_bound(
+                _entries.begin(), _entries.end(), pts,
+                [](int64_t value, const Entry& entry)
+                { return value < entry.pts; });
+            if (i == _entries.begin())
+                return false;
+            out = *(i - 1);
+            return true;
+        }
+
+        void KeyframeIndex::_build()
+        {
+            AVFormatContext* avFormatContext = nullptr;
+            if (avformat_open_input(
+                    &avFormatContext, _fileName.c_str(), nullptr, nullptr) <
+                0)
+            {
+                return;
+            }
+            if (avformat_find_stream_info(avFormatContext, nullptr) >= 0 &&
+                _stream >= 0 &&
+                _stream < static_cast<int>(avFormatContext->nb_streams))
+            {
+                AVStream* avStream = avFormatContext->streams[_stream];
+                for (unsigned i = 0; i < avFormatContext->nb_streams; ++i)
+                {
+                    if (static_cast<int>(i) != _stream)
+                    {
+                        avFormatContext->streams[i]->discard = AVDISCARD_ALL;
+                    }
+                }
+                AVPacket* avPacket = av_packet_alloc();
+
+                // The MOV demuxer reads the complete index from the header,
+                // so only the keyframe packets need to be read. The index
+                // timestamps are decode timestamps, the presentation
+                // timestamps come from the packets.
+                bool seeked = false;
+                if (avPacket && avFormatContext->iformat &&
+                    avFormatContext->iformat->name &&
+                    std::string(avFormatContext->iformat->name).find("mov") !=
+                        std::string::npos)
+                {
+                    std::vector<AVIndexEntry> keyframes;
+                    const int count = avformat_index_get_entries_count(avStream);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        const AVIndexEntry* avIndexEntry =
+                            avformat_index_get_entry(avStream, i);
+                        if (avIndexEntry &&
+                            (avIndexEntry->flags & AVINDEX_KEYFRAME))
+                        {
+                            keyframes.push_back(*avIndexEntry);
+                        }
+                    }
+                    for (const auto& keyframe : keyframes)
+                    {
+                        if (!_running)
+                            break;
+                        seeked = true;
+                        bool found = false;
+                        if (av_seek_frame(
+                                avFormatContext, _stream, keyframe.timestamp,
+                                AVSEEK_FLAG_BACKWARD) >= 0)
+                        {
+                            while (av_read_frame(avFormatContext, avPacket) >= 0)
+                            {
+                                const bool match =
+                                    avPacket->stream_index == _stream;
+                                if (match && avPacket->pts != AV_NOPTS_VALUE)
+                                {
+                                    Entry entry;
+                                    entry.pts = avPacket->pts;
+                                    entry.timestamp = keyframe.timestamp;
+                                    entry.pos = keyframe.pos;
+                                    _entries.push_back(entry);
+                                    found = true;
+                                }
+                                av_packet_unref(avPacket);
+                                if (match)
+                                    break;
+                            }
+                        }
+                        if (!found)
+                        {
+                            _entries.clear();
+                            break;
+                        }
+                    }
+                }
+
+                if (_entries.empty())
+                {
+                    if (seeked)
+                    {
+                        av_seek_frame(
+                            avFormatContext, _stream, INT64_MIN,
+                            AVSEEK_FLAG_BACKWARD);
+                    }
+                    while (_running && avPacket &&
+                           av_read_frame(avFormatContext, avPacket) >= 0)
+                    {
+                        if (avPacket->stream_index == _stream &&
+                            (avPacket->flags & AV_PKT_FLAG_KEY))
+                        {
+                            Entry entry;
+                            entry.pts = avPacket->pts != AV_NOPTS_VALUE
+                                            ? avPacket->pts
+                                            : avPacket->dts;
+                            entry.timestamp = avPacket->dts != AV_NOPTS_VALUE
+                                                  ? avPacket->dts
+                                                  : avPacket->pts;
+                            entry.pos = avPacket->pos;
+                            if (entry.pts != AV_NOPTS_VALUE)
+                            {
+                                _entries.push_back(entry);
+                            }
+                        }
+                        av_packet_unref(avPacket);
+                    }
+                }
+                av_packet_free(&avPacket);
+
+                std::sort(
+                    _entries.begin(), _entries.end(),
+                    [](const Entry& a, const Entry& b)
+                    { return a.pts < b.pts; });
+            }
+            avformat_close_input(&avFormatContext);
+        }
+
+        bool KeyframeIndex::_load()
+        {
+            if (_indexFileName.empty())
+                return false;
+            std::ifstream f(toPath(_indexFileName));
+            if (!f.is_open())
+                return false;
+            std::string header;
+            std::getline(f, header);
+            int stream = -1;
+            size_t count = 0;
+            f >> stream >> count;
+            if (header != indexHeader || stream != _stream || !f)
+                return false;
+            std::vector<Entry> entries(count);
+            for (auto& entry : entries)
+            {
+                f >> entry.pts >> entry.timestamp >> entry.pos;
+            }
+            if (!f)
+                return false;
+            _entries = std::move(entries);
+            return true;
+        }
+
+        void KeyframeIndex::_save() const
+        {
+            if (_indexFileName.empty() || _entries.empty())
+                return;
+
+            // The directory may come from the "FFmpeg/KeyframeIndexDir"
+            // option and not exist yet.
+            std::error_code ec;
+            fs::create_directories(toPath(_indexFileName).parent_path(), ec);
+
+            // Write to a temporary file first so that other processes
+            // never read a partial index.
+            std::stringstream ss;
+            ss << _indexFileName << "." << std::this_thread::get_id()
+               << ".tmp";
+            const std::string tmpFileName = ss.str();
+            {
+                std::ofstream f(toPath(tmpFileName));
+                if (!f.is_open())
+                    return;
+                f << indexHeader << '\n';
+                f << _stream << ' ' << _entries.size() << '\n';
+                for (const auto& entry : _entries)
+                {
+                    f << entry.pts << ' ' << entry.timestamp << ' '
+                      << entry.pos << '\n';
+                }
+                if (!f)
+                {
+                    f.close();
+                    fs::remove(toPath(tmpFileName), ec);
+                    return;
+                }
+            }
+            fs::rename(toPath(tmpFileName), toPath(_indexFileName), ec);
+            if (ec)
+            {
+                fs::remove(toPath(tmpFileName), ec);
+            }
+        }
+    } // namespace ffmpeg
+} // namespace tl
@@ -7,6 +7,8 @@
 
 #include <tlIO/FFmpeg.h>
 
+#include <tlCore/LRUCache.h>
+
 extern "C"
 {
 #include <libavcodec/avcodec.h>
@@ -50,6 +52,76 @@ namespace tl
             size_t requestTimeout = 5;
             size_t videoBufferSize = 4;
             otime::RationalTime audioBufferSize = otime::RationalTime(2.0, 1.0);
+            bool keyframeIndex = true;
+            std::string keyframeIndexDir;
+            //! Size of the GOP buffer in megabytes. The buffer is counted
+            //! by Read::getByteCount(), so it is also limited by the
+            //! timeline's reader memory budget.
+            size_t gopBufferSize = 128;
+            //! Number of decoders for intra-only codecs, including the
+            //! main decoder. Zero uses the default of two.
+            size_t intraDecoderCount = 0;
+        };
+
+        //! Get the number of additional intra decoders running in the
+        //! process.
+        size_t getIntraDecoderThreads();
+
+        //! Get the maximum number of additional intra decoders for all of
+        //! the readers in the process.
+        size_t getIntraDecoderThreadsMax();
+
+        //! Get the default directory for the keyframe index files, used when
+        //! the "FFmpeg/KeyframeIndexDir" option is not set.
+        std::string getKeyframeIndexDir();
+
+        //! Index of the keyframes of a video stream.
+        //!
+        //! The index is built in a background thread, from the demuxer's own
+        //! index when it is complete (MOV/MP4) by reading only the keyframe
+        //! packets, or otherwise by reading all of the packets without
+        //! decoding them. It is saved in the index directory
+        //! so that it is only built once per file.
+        class KeyframeIndex
+        {
+        public:
+            struct Entry
+            {
+                //! Presentation timestamp.
+                int64_t pts = 0;
+
+                //! Timestamp to pass to av_seek_frame().
+                int64_t timestamp = 0;
+
+                //! Byte position, or -1 if unknown.
+                int64_t pos = -1;
+            };
+
+            KeyframeIndex(
+                const std::string& fileName, int stream,
+                const std::string& indexDir);
+
+            ~KeyframeIndex();
+
+            //! Get whether the index is finished.
+            bool isReady() const;
+
+            //! Get the last keyframe at or before the presentation timestamp.
+            //! Returns false if the index is not finished.
+            bool getKeyframe(int64_t pts, Entry&) const;
+
+        private:
+            void _build();
+            bool _load();
+            void _save() const;
+
+            std::string _fileName;
+            int _stream = -1;
+            std::string _indexFileName;
+            std::vector<Entry> _entries;
+            std::atomic<bool> _ready;
+            std::atomic<bool> _running;
+            std::thread _thread;
         };
 
         class ReadVideo
@@ -68,6 +140,10 @@ namespace tl
             const otime::TimeRange& getTimeRange() const;
             const image::Tags& getTags() const;
 
+            //! Get whether every frame of the video is a keyframe (ProRes,
+            //! DNxHD/HR, HAP, Cineform, etc.).
+            bool isIntraOnly() const;
+
             void start();
             void seek(const otime::RationalTime&);
             bool process(
@@ -77,7 +153,23 @@ namespace tl
             bool isBufferEmpty() const;
             std::shared_ptr<image::Image> popBuffer();
 
+            //! Get the scale frames are decoded at.
+            float getScale() const;
+
+            //! Set the scale frames are decoded at. Frames that are already
+            //! in the buffer are not changed.
+            void setScale(float);
+
+            //! Get whether the keyframe index is finished.
+            bool hasKeyframeIndex() const;
+
+            //! Get whether two times are in the same GOP. Returns false if
+            //! the keyframe index is not finished.
+            bool isSameGOP(
+                const otime::RationalTime&, const otime::RationalTime&) const;
+
         private:
+            int64_t _getTimestamp(const otime::RationalTime&) const;
             int _decode(
                 const bool backwards, const otime::RationalTime& targetTime,
                 otime::RationalTime& currentTime);
@@ -95,6 +187,7 @@ namespace tl
             float _rotation = 0.F;
             std::weak_ptr<log::System> _logSystem;
             bool _useAudioOnly = false;
+            bool _intraOnly = false;
             std::shared_ptr<image::Image> _singleImage;
 
             //! FFmpeg variables
@@ -114,8 +207,11 @@ namespace tl
             AVPixelFormat _avOutputPixelFormat = AV_PIX_FMT_NONE;
             bool _fastYUV420PConversion = true;
             SwsContext* _swsContext = nullptr;
+            float _scale = 1.F;
+            SwsContext* _swsScaleContext = nullptr;
             std::list<std::shared_ptr<image::Image> > _buffer;
             bool _eof = false;
+            std::unique_ptr<KeyframeIndex> _keyframeIndex;
         };
 
         class ReadAudio
@@ -187,6 +283,9 @@ namespace tl
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 // std::shared_ptr<VideoRequest> videoRequest;
+                // Set by releaseMemory(), the GOP buffer is cleared by the
+                // video thread that owns it.
+                bool releaseMemory = false;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -201,6 +300,24 @@ namespace tl
             };
             VideoThread videoThread;
 
+            //! Additional decoders for intra-only codecs. They are started
+            //! when requests are queued, and each one takes the next
+            //! request from the queue so that frames decode in parallel.
+            //! The number of them is limited for the whole process by
+            //! getIntraDecoderThreadsMax(), and they are stopped by
+            //! releaseMemory().
+            std::vector<std::thread> intraThreads;
+            std::atomic<bool> intraRunning{false};
+
+            //! Frames decoded while seeking backwards, so that playing in
+            //! reverse decodes each GOP once even if the frames are evicted
+            //! from the I/O cache.
+            memory::LRUCache<io::CacheKey, io::VideoData> gopBuffer;
+
+            //! Size of the GOP buffer in bytes, updated by the video thread
+            //! so that it can be read from other threads.
+            std::atomic<size_t> gopBufferByteCount{0};
+
             struct AudioRequest
             {
                 otime::TimeRange timeRange = time::invalidTimeRange;
@@ -8,6 +8,7 @@
 #include <tlIO/FFmpegReadPrivate.h>
 #include <tlIO/FFmpegMacros.h>
 
+#include <tlCore/File.h>
 #include <tlCore/Path.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -968,6 +969,25 @@ namespace tl
                 _hdr.eotf = toEOTF(_avColorTRC);
                 setPrimariesFromAVColorPrimaries(params->color_primaries,
                                                  _hdr);
+
+                // Index the keyframes of long GOP files on disk, so that
+                // seeks land directly on the keyframe of the GOP.
+                const AVCodecDescriptor* avCodecDescriptor =
+                    avcodec_descriptor_get(params->codec_id);
+                _intraOnly =
+                    avCodecDescriptor &&
+                    (avCodecDescriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+                if (options.keyframeIndex && memory.empty() &&
+                    formatFileName == fileName && !_intraOnly &&
+                    !_useAudioOnly && file::exists(fileName))
+                {
+                    const std::string indexDir =
+                        !options.keyframeIndexDir.empty()
+                            ? options.keyframeIndexDir
+                            : getKeyframeIndexDir();
+                    _keyframeIndex = std::make_unique<KeyframeIndex>(
+                        fileName, _avStream, indexDir);
+                }
             }
         }
 
@@ -977,6 +997,10 @@ namespace tl
             {
                 sws_freeContext(_swsContext);
             }
+            if (_swsScaleContext)
+            {
+                sws_freeContext(_swsScaleContext);
+            }
             if (_avFrame)
             {
                 av_frame_free(&_avFrame);
@@ -1013,6 +1037,11 @@ namespace tl
             return _avStream != -1;
         }
 
+        bool ReadVideo::isIntraOnly() const
+        {
+            return _intraOnly && !_useAudioOnly;
+        }
+
         const image::Info& ReadVideo::getInfo() const
         {
             return _info;
@@ -1214,22 +1243,78 @@ namespace tl
             }
         }
 
+        bool ReadVideo::hasKeyframeIndex() const
+        {
+            return _keyframeIndex && _keyframeIndex->isReady();
+        }
+
+        bool ReadVideo::isSameGOP(
+            const otime::RationalTime& a, const otime::RationalTime& b) const
+        {
+            bool out = false;
+            KeyframeIndex::Entry aEntry;
+            KeyframeIndex::Entry bEntry;
+            if (_keyframeIndex &&
+                _keyframeIndex->getKeyframe(_getTimestamp(a), aEntry) &&
+                _keyframeIndex->getKeyframe(_getTimestamp(b), bEntry))
+            {
+                out = aEntry.pts == bEntry.pts;
+            }
+            return out;
+        }
+
+        int64_t ReadVideo::_getTimestamp(const otime::RationalTime& time) const
+        {
+            return av_rescale_q(
+                time.value() - _timeRange.start_time().value(), swap(_avSpeed),
+                _avFormatContext->streams[_avStream]->time_base);
+        }
+
         void ReadVideo::seek(const otime::RationalTime& time)
         {
             if (_avStream != -1 && !_useAudioOnly)
             {
                 avcodec_flush_buffers(_avCodecContext[_avStream]);
 
-                if (av_seek_frame(
-                        _avFormatContext, _avStream,
-                        av_rescale_q(
-                            time.value() - _timeRange.start_time().value(),
-                            swap(_avSpeed),
-                            _avFormatContext->streams[_avStream]->time_base),
+                const int64_t timestamp = _getTimestamp(time);
+                bool error = false;
+                KeyframeIndex::Entry entry;
+                if (_keyframeIndex &&
+                    _keyframeIndex->getKeyframe(timestamp, entry))
+                {
+                    // Seek directly to the keyframe of the GOP, falling back
+                    // to the byte position for demuxers that can't seek by
+                    // timestamp.
+                    if (av_seek_frame(
+                            _avFormatContext, _avStream, entry.timestamp,
+                            AVSEEK_FLAG_BACKWARD) < 0 &&
+                        (entry.pos < 0 ||
+                         av_seek_frame(
+                             _avFormatContext, _avStream, entry.pos,
+                             AVSEEK_FLAG_BYTE) < 0))
+                    {
+                        error = true;
+                    }
+                }
+                else if (
+                    av_seek_frame(
+                        _avFormatContext, _avStream, timestamp,
                         AVSEEK_FLAG_BACKWARD) < 0)
+                {
+                    error = true;
+                }
+                if (error)
                 {
                     //! \todo How should this be handled?
-                    std::cerr << "seeking error" << std::endl;
+                    if (auto logSystem = _logSystem.lock())
+                    {
+                        logSystem->print(
+                            "tl::io::ffmpeg::Read",
+                            string::Format("{0}: Cannot seek to frame {1}")
+                                .arg(_fileName)
+                                .arg(time.value()),
+                            log::Type::Error);
+                    }
                 }
             }
 
@@ -1338,6 +1423,16 @@ namespace tl
             return out;
         }
 
+        float ReadVideo::getScale() const
+        {
+            return _scale;
+        }
+
+        void ReadVideo::setScale(float value)
+        {
+            _scale = value;
+        }
+
         int ReadVideo::_decode(
             const bool backwards, const otime::RationalTime& targetTime,
             otime::RationalTime& currentTime)
@@ -1468,6 +1563,50 @@ namespace tl
             const std::size_t w = _info.size.w;
             const std::size_t h = _info.size.h;
 
+            if (_scale < 1.F)
+            {
+                // Scale down while converting for lower resolution frame
+                // requests. Keep the size even for the chroma planes.
+                image::Info info = _info;
+                info.size.w = std::max(static_cast<int>(w * _scale) & ~1, 2);
+                info.size.h = std::max(static_cast<int>(h * _scale) & ~1, 2);
+                _swsScaleContext = sws_getCachedContext(
+                    _swsScaleContext, avFrame->width, avFrame->height,
+                    _avInputPixelFormat, info.size.w, info.size.h,
+                    _avOutputPixelFormat, SWS_FAST_BILINEAR, nullptr, nullptr,
+                    nullptr);
+                if (_swsScaleContext)
+                {
+                    if (_swsContext)
+                    {
+                        int* invTable = nullptr;
+                        int* table = nullptr;
+                        int srcRange = 0;
+                        int dstRange = 0;
+                        int brightness = 0;
+                        int contrast = 0;
+                        int saturation = 0;
+                        sws_getColorspaceDetails(
+                            _swsContext, &invTable, &srcRange, &table,
+                            &dstRange, &brightness, &contrast, &saturation);
+                        sws_setColorspaceDetails(
+                            _swsScaleContext, invTable, srcRange, table,
+                            dstRange, brightness, contrast, saturation);
+                    }
+                    image = image::Image::create(info);
+                    uint8_t* scaleData[4];
+                    int scaleLinesize[4];
+                    av_image_fill_arrays(
+                        scaleData, scaleLinesize, image->getData(),
+                        _avOutputPixelFormat, info.size.w, info.size.h, 1);
+                    sws_scale(
+                        _swsScaleContext, (uint8_t const* const*)avFrame->data,
+                        avFrame->linesize, 0, avFrame->height, scaleData,
+                        scaleLinesize);
+                    return;
+                }
+            }
+
             uint8_t* data;
             if (canCopy(
                     _avInputPixelFormat, _avOutputPixelFormat,
@@ -4,6 +4,12 @@
 
 #include <tlIO/IO.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <locale>
+#include <sstream>
+
 namespace tl
 {
     namespace io
@@ -17,5 +23,93 @@ namespace tl
             }
             return out;
         }
+
+        int FrameRequest::getSubsampleStep() const
+        {
+            return scale > 0.F && scale < 1.F
+                       ? std::max(
+                             static_cast<int>(std::floor(1.F / scale)), 1)
+                       : 1;
+        }
+
+        void setFrameRequest(Options& options, const FrameRequest& value)
+        {
+            // Only add options that differ from the default, so that full
+            // resolution requests have the same cache key as before.
+            if (value.scale != 1.F)
+            {
+                std::stringstream ss;
+                ss.imbue(std::locale::classic());
+                ss << value.scale;
+                options["FrameRequest/Scale"] = ss.str();
+            }
+            else
+            {
+                options.erase("FrameRequest/Scale");
+            }
+            if (value.roi.isValid())
+            {
+                std::stringstream ss;
+                ss << value.roi.min.x << " " << value.roi.min.y << " "
+                   << value.roi.max.x << " " << value.roi.max.y;
+                options["FrameRequest/ROI"] = ss.str();
+            }
+            else
+            {
+                options.erase("FrameRequest/ROI");
+            }
+        }
+
+        FrameRequest getFrameRequest(const Options& options)
+        {
+            FrameRequest out;
+            auto i = options.find("FrameRequest/Scale");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                ss.imbue(std::locale::classic());
+                float scale = 1.F;
+                ss >> scale;
+                if (!ss.fail() && scale > 0.F)
+                {
+                    out.scale = scale;
+                }
+            }
+            i = options.find("FrameRequest/ROI");
+            if (i != options.end())
+            {
+                std::stringstream ss(i->second);
+                math::Box2i roi;
+                ss >> roi.min.x >> roi.min.y >> roi.max.x >> roi.max.y;
+                if (!ss.fail())
+                {
+                    out.roi = roi;
+                }
+            }
+            return out;
+        }
+
+        void subsampleScanline(
+            const uint8_t* in, uint8_t* out, size_t outWidth,
+            size_t pixelByteCount, int step)
+        {
+            const size_t inStep = pixelByteCount * step;
+            switch (pixelByteCount)
+            {
+            case 4:
+                for (size_t x = 0; x < outWidth; ++x, in += inStep, out += 4)
+                {
+                    std::memcpy(out, in, 4);
+                }
+                break;
+            default:
+                for (size_t x = 0; x < outWidth;
+                     ++x, in += inStep, out += pixelByteCount)
+                {
+                    std::memcpy(out, in, pixelByteCount);
+                }
+                break;
+            }
+        }
     } // namespace io
 } // namespace tl
@@ -84,6 +84,48 @@ namespace tl
 
         //! Merge options.
         Options merge(const Options&, const Options&);
+
+        //! Video frame request.
+        //!
+        //! This describes how much of an image is needed so that readers can
+        //! decode less data. Readers are free to ignore it, smaller images
+        //! are drawn scaled up to the full resolution.
+        //!
+        //! The frame request is passed with the I/O options, see
+        //! setFrameRequest(). timeline::Timeline::getVideo() takes one for
+        //! a single frame. Setting it in the options given to
+        //! timeline::Player::setIOOptions() applies it to every frame the
+        //! player reads, and clears the player's cache when it changes.
+        struct FrameRequest
+        {
+            //! Scale relative to the full resolution, for example 0.5
+            //! requests half resolution.
+            float scale = 1.F;
+
+            //! Region of interest in full resolution pixels, relative to the
+            //! top left of the image. Pixels outside of the region may be
+            //! zero. An empty box requests the whole image.
+            math::Box2i roi = math::Box2i(0, 0, 0, 0);
+
+            //! Get the integer subsampling step for the scale.
+            int getSubsampleStep() const;
+
+            bool operator==(const FrameRequest&) const;
+            bool operator!=(const FrameRequest&) const;
+        };
+
+        //! Add a frame request to video request options. Because it is
+        //! passed with the options the frame request is part of the cache
+        //! key.
+        void setFrameRequest(Options&, const FrameRequest&);
+
+        //! Get a frame request from video request options.
+        FrameRequest getFrameRequest(const Options&);
+
+        //! Copy every n'th pixel of a scanline.
+        void subsampleScanline(
+            const uint8_t* in, uint8_t* out, size_t outWidth,
+            size_t pixelByteCount, int step);
     } // namespace io
 } // namespace tl
 
@@ -20,6 +20,16 @@ namespace tl
             return !(*this == other);
         }
 
+        inline bool FrameRequest::operator==(const FrameRequest& other) const
+        {
+            return scale == other.scale && roi == other.roi;
+        }
+
+        inline bool FrameRequest::operator!=(const FrameRequest& other) const
+        {
+            return !(*this == other);
+        }
+
         inline VideoData::VideoData() {}
 
         inline VideoData::VideoData(
@@ -392,7 +392,7 @@ namespace tl
                 io::VideoData videoData;
                 if (videoRequest && _cache)
                 {
-                    const std::string cacheKey = io::getVideoCacheKey(
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
                         _path, videoRequest->time, _options,
                         videoRequest->options);
                     if (_cache->getVideo(cacheKey, videoData))
@@ -429,7 +429,7 @@ namespace tl
 
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getVideoCacheKey(
+                        const io::CacheKey cacheKey = io::getVideoCacheKey(
                             _path, videoRequest->time, _options,
                             videoRequest->options);
                         _cache->addVideo(cacheKey, data);
@@ -514,7 +514,7 @@ namespace tl
                 io::AudioData audioData;
                 if (request && _cache)
                 {
-                    const std::string cacheKey = io::getAudioCacheKey(
+                    const io::CacheKey cacheKey = io::getAudioCacheKey(
                         _path, request->timeRange, _options, request->options);
                     if (_cache->getAudio(cacheKey, audioData))
                     {
@@ -579,7 +579,7 @@ namespace tl
 
                     if (_cache)
                     {
-                        const std::string cacheKey = io::getAudioCacheKey(
+                        const io::CacheKey cacheKey = io::getAudioCacheKey(
                             _path, request->timeRange, _options,
                             request->options);
                         _cache->addAudio(cacheKey, audioData);
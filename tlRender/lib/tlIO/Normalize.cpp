@@ -4,8 +4,21 @@
 
 #include <tlIO/Normalize.h>
 
+#include <tlIO/ThreadPool.h>
+
 #include <Imath/half.h>
 
+#if defined(__AVX2__) && defined(__F16C__)
+#    include <immintrin.h>
+#    define TLRENDER_NORMALIZE_AVX2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#    include <arm_neon.h>
+#    define TLRENDER_NORMALIZE_NEON
+#endif
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
 #include <sstream>
 
 namespace tl
@@ -19,106 +32,237 @@ namespace tl
             return ss.str();
         }
 
-        void normalizeImage(
-            math::Vector4f& minValue, math::Vector4f& maxValue,
-            const std::shared_ptr<image::Image> in, const image::Info& info,
-            const int minX, const int maxX, const int minY, const int maxY)
+        namespace
         {
-            const size_t channels = image::getChannelCount(info.pixelType);
-            const size_t channelByteCount =
-                image::getBitDepth(info.pixelType) / 8;
-            const size_t cb = channels * channelByteCount;
-
-            uint8_t* p = in->getData();
-
-            for (short i = 0; i < 4; ++i)
+#if defined(TLRENDER_NORMALIZE_AVX2)
+            typedef __m256 Vec;
+            constexpr size_t vecSize = 8;
+            inline Vec vecSet(float value) { return _mm256_set1_ps(value); }
+            inline Vec vecLoad(const float* p) { return _mm256_loadu_ps(p); }
+            inline Vec vecLoad(const half* p)
             {
-                minValue[i] = std::numeric_limits<float>::max();
-                maxValue[i] = std::numeric_limits<float>::min();
+                return _mm256_cvtph_ps(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+            }
+            // The new value is the first argument so NaNs are ignored.
+            inline Vec vecMin(Vec value, Vec min)
+            {
+                return _mm256_min_ps(value, min);
+            }
+            inline Vec vecMax(Vec value, Vec max)
+            {
+                return _mm256_max_ps(value, max);
+            }
+            inline void vecStore(float* p, Vec value)
+            {
+                _mm256_storeu_ps(p, value);
             }
+#elif defined(TLRENDER_NORMALIZE_NEON)
+            typedef float32x4_t Vec;
+            constexpr size_t vecSize = 4;
+            inline Vec vecSet(float value) { return vdupq_n_f32(value); }
+            inline Vec vecLoad(const float* p) { return vld1q_f32(p); }
+            inline Vec vecLoad(const half* p)
+            {
+                return vcvt_f32_f16(vreinterpret_f16_u16(
+                    vld1_u16(reinterpret_cast<const uint16_t*>(p))));
+            }
+            // These return the number when one of the values is a NaN.
+            inline Vec vecMin(Vec value, Vec min)
+            {
+                return vminnmq_f32(value, min);
+            }
+            inline Vec vecMax(Vec value, Vec max)
+            {
+                return vmaxnmq_f32(value, max);
+            }
+            inline void vecStore(float* p, Vec value) { vst1q_f32(p, value); }
+#endif
 
-            for (int y = minY; y <= maxY; ++y)
+            // Get the minimum and maximum of C interleaved channels in a
+            // scanline of type T.
+            template <typename T, size_t C>
+            void minMaxScanline(
+                const T* p, size_t width, float* minValue, float* maxValue)
             {
-                for (int x = minX; x <= maxX; ++x)
+                const size_t count = width * C;
+                size_t i = 0;
+#if defined(TLRENDER_NORMALIZE_AVX2) || defined(TLRENDER_NORMALIZE_NEON)
+                // Process C vectors at a time, so each vector lane always
+                // holds the same channel.
+                constexpr size_t blockSize = C * vecSize;
+                if (count >= blockSize)
                 {
-                    switch (info.pixelType)
+                    Vec vMin[C];
+                    Vec vMax[C];
+                    for (size_t k = 0; k < C; ++k)
                     {
-                    case image::PixelType::L_F16:
+                        vMin[k] = vecSet(std::numeric_limits<float>::max());
+                        vMax[k] = vecSet(std::numeric_limits<float>::lowest());
+                    }
+                    for (; i + blockSize <= count; i += blockSize)
                     {
-                        float value = static_cast<float>(static_cast<half>(*p));
-                        if (value < minValue[0])
-                            minValue[0] = value;
-                        if (value > maxValue[0])
-                            maxValue[0] = value;
-                        break;
+                        for (size_t k = 0; k < C; ++k)
+                        {
+                            const Vec v = vecLoad(p + i + k * vecSize);
+                            vMin[k] = vecMin(v, vMin[k]);
+                            vMax[k] = vecMax(v, vMax[k]);
+                        }
                     }
-                    case image::PixelType::L_F32:
+                    float lanesMin[blockSize];
+                    float lanesMax[blockSize];
+                    for (size_t k = 0; k < C; ++k)
                     {
-                        float value = static_cast<float>(*p);
-                        if (value < minValue[0])
-                            minValue[0] = value;
-                        if (value > maxValue[0])
-                            maxValue[0] = value;
-                        break;
+                        vecStore(lanesMin + k * vecSize, vMin[k]);
+                        vecStore(lanesMax + k * vecSize, vMax[k]);
                     }
-                    case image::PixelType::RGB_F16:
+                    for (size_t j = 0; j < blockSize; ++j)
                     {
-                        half* values = reinterpret_cast<half*>(p);
-                        for (short i = 0; i < 3; ++i)
-                        {
-                            if (values[i] < minValue[i])
-                                minValue[i] = values[i];
-                            if (values[i] > maxValue[i])
-                                maxValue[i] = values[i];
-                        }
-                        break;
+                        const size_t c = j % C;
+                        minValue[c] = std::min(minValue[c], lanesMin[j]);
+                        maxValue[c] = std::max(maxValue[c], lanesMax[j]);
                     }
-                    case image::PixelType::RGB_F32:
+                }
+#endif
+                // The remaining values. The index is a multiple of C here.
+                for (; i < count; i += C)
+                {
+                    for (size_t c = 0; c < C; ++c)
                     {
-                        float* values = reinterpret_cast<float*>(p);
-                        for (short i = 0; i < 3; ++i)
-                        {
-                            if (values[i] < minValue[i])
-                                minValue[i] = values[i];
-                            if (values[i] > maxValue[i])
-                                maxValue[i] = values[i];
-                        }
-                        break;
+                        const float value = static_cast<float>(p[i + c]);
+                        if (value < minValue[c])
+                            minValue[c] = value;
+                        if (value > maxValue[c])
+                            maxValue[c] = value;
                     }
-                    case image::PixelType::RGBA_F16:
+                }
+            }
+
+            template <typename T, size_t C>
+            void minMax(
+                math::Vector4f& minValue, math::Vector4f& maxValue,
+                const uint8_t* data, size_t scanlineByteCount, size_t width,
+                size_t height)
+            {
+                std::mutex mutex;
+                auto rows = [&](size_t begin, size_t end)
+                {
+                    float rowsMin[C];
+                    float rowsMax[C];
+                    for (size_t c = 0; c < C; ++c)
                     {
-                        half* values = reinterpret_cast<half*>(p);
-                        for (short i = 0; i < 4; ++i)
-                        {
-                            if (values[i] < minValue[i])
-                                minValue[i] = values[i];
-                            if (values[i] > maxValue[i])
-                                maxValue[i] = values[i];
-                        }
-                        break;
+                        rowsMin[c] = std::numeric_limits<float>::max();
+                        rowsMax[c] = std::numeric_limits<float>::lowest();
                     }
-                    case image::PixelType::RGBA_F32:
+                    for (size_t y = begin; y < end; ++y)
                     {
-                        float* values = reinterpret_cast<float*>(p);
-                        for (short i = 0; i < 4; ++i)
-                        {
-                            if (values[i] < minValue[i])
-                                minValue[i] = values[i];
-                            if (values[i] > maxValue[i])
-                                maxValue[i] = values[i];
-                        }
-                        break;
+                        minMaxScanline<T, C>(
+                            reinterpret_cast<const T*>(
+                                data + y * scanlineByteCount),
+                            width, rowsMin, rowsMax);
+                    }
+                    std::unique_lock<std::mutex> lock(mutex);
+                    for (size_t c = 0; c < C; ++c)
+                    {
+                        minValue[c] = std::min(minValue[c], rowsMin[c]);
+                        maxValue[c] = std::max(maxValue[c], rowsMax[c]);
                     }
-                    default:
-                        break;
+                };
+
+                // Split the rows between threads for large images.
+                const size_t pixelsPerChunk = 256 * 1024;
+                const size_t rowsPerChunk =
+                    std::max(pixelsPerChunk / std::max(width, size_t(1)),
+                             size_t(1));
+                if (height > rowsPerChunk)
+                {
+                    ThreadPool::getGlobal()->parallelFor(
+                        height, rowsPerChunk, rows);
+                }
+                else
+                {
+                    rows(0, height);
+                }
+            }
+        } // namespace
+
+        void normalizeImage(
+            math::Vector4f& minValue, math::Vector4f& maxValue,
+            const std::shared_ptr<image::Image> in, const image::Info& info,
+            const int minX, const int maxX, const int minY, const int maxY)
+        {
+            for (short i = 0; i < 4; ++i)
+            {
+                minValue[i] = std::numeric_limits<float>::max();
+                maxValue[i] = std::numeric_limits<float>::lowest();
+            }
+
+            // Use the image for the memory layout, the information may have
+            // fewer channels than the image (for example RGB data in an RGBA
+            // image).
+            const image::Info& imageInfo = in->getInfo();
+            const size_t width = std::min(
+                std::max(maxX - minX + 1, 0), imageInfo.size.w);
+            const size_t height = std::min(
+                std::max(maxY - minY + 1, 0), imageInfo.size.h);
+            const size_t scanlineByteCount =
+                imageInfo.size.h > 0 ? image::getDataByteCount(imageInfo) /
+                                           imageInfo.size.h
+                                     : 0;
+            const uint8_t* data = in->getData();
+            if (width > 0 && height > 0)
+            {
+                switch (imageInfo.pixelType)
+                {
+                case image::PixelType::L_F16:
+                    minMax<half, 1>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                case image::PixelType::L_F32:
+                    minMax<float, 1>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                case image::PixelType::RGB_F16:
+                    minMax<half, 3>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                case image::PixelType::RGB_F32:
+                    minMax<float, 3>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                case image::PixelType::RGBA_F16:
+                    minMax<half, 4>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                case image::PixelType::RGBA_F32:
+                    minMax<float, 4>(
+                        minValue, maxValue, data, scanlineByteCount, width,
+                        height);
+                    break;
+                default:
+                    break;
+                }
+
+                // Ignore the alpha channel that was added to the image.
+                const size_t channels = image::getChannelCount(info.pixelType);
+                if (channels < image::getChannelCount(imageInfo.pixelType))
+                {
+                    for (size_t i = channels; i < 4; ++i)
+                    {
+                        minValue[i] = std::numeric_limits<float>::max();
+                        maxValue[i] = std::numeric_limits<float>::lowest();
                     }
-                    p += cb;
                 }
             }
 
             for (short i = 0; i < 4; ++i)
             {
-                if (minValue[i] == maxValue[i])
+                if (minValue[i] >= maxValue[i])
                 {
                     minValue[i] = 0.F;
                     maxValue[i] = 1.F;
@@ -27,6 +27,15 @@ namespace tl
         TLRENDER_ENUM_SERIALIZE(ChannelGrouping);
 
         //! OpenEXR reader.
+        //!
+        //! Video request options:
+        //! - "OpenEXR/Zoom": when no mipmap level is set, tiled mipmapped
+        //!   images are read from the level that matches the zoom factor.
+        //!   Defaults to the io::FrameRequest scale.
+        //! - "OpenEXR/ROI": region of interest in level zero pixels
+        //!   ("minX minY maxX maxY"). Only the tiles or scanlines that
+        //!   intersect it are read, the rest of the image is zero. Defaults
+        //!   to the io::FrameRequest region of interest.
         class Read : public io::ISequenceRead
         {
         protected:
@@ -14,6 +14,7 @@
 
 #include <ImfInputPart.h>
 #include <ImfChannelList.h>
+#include <ImfCompression.h>
 #include <ImfStandardAttributes.h>
 #include <ImfRgbaFile.h>
 #include <ImfTiledInputPart.h>
@@ -22,7 +23,9 @@
 #include <ImathVec.h>
 using namespace Imath;
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstring>
 #include <sstream>
 
@@ -368,7 +371,7 @@ namespace tl
                     const bool ignoreDisplayWindow,
                     const bool ignoreChromaticities, const bool autoNormalize,
                     const bool useRGBOnly,
-                    const int xLevel, const int yLevel,
+                    const int xLevel, const int yLevel, const float zoom,
                     const std::weak_ptr<log::System>& logSystem) :
                     _fileName(fileName),
                     _channelGrouping(channelGrouping),
@@ -417,6 +420,22 @@ namespace tl
                         return;
                     }
 
+                    // Pick the mipmap level that matches the zoom when no
+                    // level was requested explicitly.
+                    if (0 == _xLevel && 0 == _yLevel && zoom > 0.F &&
+                        zoom < 1.F)
+                    {
+                        const Imf::Header& header = _f->header(0);
+                        if (header.hasTileDescription() &&
+                            header.tileDescription().mode != Imf::ONE_LEVEL)
+                        {
+                            const int level = static_cast<int>(
+                                std::floor(std::log2(1.F / zoom)));
+                            _xLevel = level;
+                            _yLevel = level;
+                        }
+                    }
+
                     // 3. Now check logic based on mipmap request
                     if (_xLevel > 0 || _yLevel > 0)
                     {
@@ -632,12 +651,165 @@ namespace tl
                     }
                 }
 
+                // Add the layer channels to a frame buffer. The base pointer
+                // addresses pixel (0, 0), which may be outside of the memory
+                // that is actually written.
+                void insertSlices(
+                    Imf::FrameBuffer& frameBuffer, const int layer,
+                    char* base, const size_t channels,
+                    const size_t channelByteCount, const size_t cb,
+                    const size_t scb)
+                {
+                    for (size_t c = 0; c < channels; ++c)
+                    {
+                        frameBuffer.insert(
+                            _layers[layer].channels[c].name.c_str(),
+                            Imf::Slice(
+                                _layers[layer].channels[c].pixelType,
+                                base + (c * channelByteCount), cb, scb, 1, 1,
+                                0.F));
+                    }
+#ifdef VULKAN_BACKEND
+                    if (!_useRGBOnly && channels == 3)
+                    {
+                        frameBuffer.insert(
+                            "fakeA",
+                            Imf::Slice(
+                                _layers[layer].channels[0].pixelType,
+                                base + (3 * channelByteCount), cb, scb, 1, 1,
+                                1.F));
+                    }
+#endif
+                }
+
+                // Read the scanlines of a layer when the data window is
+                // different from the display window.
+                //
+                // When the data window fits horizontally in the image the
+                // frame buffer points straight at the image and the whole
+                // range is read with a single call, which lets OpenEXR
+                // decompress the chunks in parallel. Otherwise the lines are
+                // read in chunk aligned batches into a temporary buffer and
+                // the visible part is copied to the image.
+                void readScanlines(
+                    Imf::InputPart& in, const int layer, uint8_t* data,
+                    const size_t channels, const size_t channelByteCount,
+                    const size_t cb, const size_t scb,
+                    const int chunkScanlines)
+                {
+                    if (_ignoreDisplayWindow &&
+                        !(_dataWindow.min.x >= _displayWindow.min.x ||
+                          _dataWindow.max.x <= _displayWindow.max.x ||
+                          _dataWindow.min.y >= _displayWindow.min.y ||
+                          _dataWindow.max.y <= _displayWindow.max.y))
+                    {
+                        // The image is at least as large as the data window,
+                        // read all of it.
+                        Imf::FrameBuffer frameBuffer;
+                        insertSlices(
+                            frameBuffer, layer,
+                            reinterpret_cast<char*>(data) -
+                                (_dataWindow.min.y * scb) -
+                                (_dataWindow.min.x * cb),
+                            channels, channelByteCount, cb, scb);
+                        in.setFrameBuffer(frameBuffer);
+                        in.readPixels(_dataWindow.min.y, _dataWindow.max.y);
+                        return;
+                    }
+
+                    // Zero the padding around the data window.
+                    const bool intersects =
+                        _intersectedWindow.w() > 0 &&
+                        _intersectedWindow.h() > 0;
+                    const size_t leftSize =
+                        intersects
+                            ? (_intersectedWindow.min.x - _displayWindow.min.x) *
+                                  cb
+                            : 0;
+                    const size_t copySize =
+                        intersects ? _intersectedWindow.w() * cb : 0;
+                    for (int y = _displayWindow.min.y; y <= _displayWindow.max.y;
+                         ++y)
+                    {
+                        uint8_t* p = data + (y - _displayWindow.min.y) * scb;
+                        if (intersects && y >= _intersectedWindow.min.y &&
+                            y <= _intersectedWindow.max.y)
+                        {
+                            std::memset(p, 0, leftSize);
+                            std::memset(
+                                p + leftSize + copySize, 0,
+                                scb - leftSize - copySize);
+                        }
+                        else
+                        {
+                            std::memset(p, 0, scb);
+                        }
+                    }
+                    if (!intersects)
+                        return;
+
+                    const size_t imageWidth = scb / cb;
+                    if (_dataWindow.min.x >= _displayWindow.min.x &&
+                        _dataWindow.max.x - _displayWindow.min.x <
+                            static_cast<int>(imageWidth))
+                    {
+                        Imf::FrameBuffer frameBuffer;
+                        insertSlices(
+                            frameBuffer, layer,
+                            reinterpret_cast<char*>(data) -
+                                (_displayWindow.min.y * scb) -
+                                (_displayWindow.min.x * cb),
+                            channels, channelByteCount, cb, scb);
+                        in.setFrameBuffer(frameBuffer);
+                        in.readPixels(
+                            _intersectedWindow.min.y, _intersectedWindow.max.y);
+                        return;
+                    }
+
+                    // Batch size, a multiple of the lines per chunk.
+                    const int chunk = std::max(chunkScanlines, 1);
+                    const int batch = std::max(64 / chunk, 1) * chunk;
+                    const size_t bufScb = _dataWindow.w() * cb;
+                    std::vector<uint8_t> buf(bufScb * batch);
+                    const size_t copyOffset =
+                        (_intersectedWindow.min.x - _dataWindow.min.x) * cb;
+                    int y0 = _intersectedWindow.min.y;
+                    while (y0 <= _intersectedWindow.max.y)
+                    {
+                        // End the batch on a chunk boundary.
+                        const int y1 = std::min(
+                            _intersectedWindow.max.y,
+                            _dataWindow.min.y +
+                                ((y0 - _dataWindow.min.y) / batch + 1) * batch -
+                                1);
+                        Imf::FrameBuffer frameBuffer;
+                        insertSlices(
+                            frameBuffer, layer,
+                            reinterpret_cast<char*>(buf.data()) -
+                                (y0 * bufScb) - (_dataWindow.min.x * cb),
+                            channels, channelByteCount, cb, bufScb);
+                        in.setFrameBuffer(frameBuffer);
+                        in.readPixels(y0, y1);
+                        for (int y = y0; y <= y1; ++y)
+                        {
+                            std::memcpy(
+                                data + (y - _displayWindow.min.y) * scb +
+                                    leftSize,
+                                buf.data() + (y - y0) * bufScb + copyOffset,
+                                copySize);
+                        }
+                        y0 = y1 + 1;
+                    }
+                }
+
                 bool readTiled(
                     io::VideoData& out, const int layer, const int minX,
                     const int maxX, const int minY, const int maxY,
                     Imf::TiledInputPart& tiledInputPart)
                 {
                     Imf::Header header = tiledInputPart.header();
+                    const math::Box2i baseDataWindow =
+                        fromImath(header.dataWindow());
 
                     if (_xLevel > 0 || _yLevel > 0)
                     {
@@ -647,8 +819,6 @@ namespace tl
                         parseHeader(header);
                     }
     
-                    Imf::LineOrder lineOrder = header.lineOrder();
-
                     const image::Info& imageInfo = _info.video[layer];
                     
                     image::Info vulkanInfo = imageInfo;
@@ -741,23 +911,74 @@ namespace tl
 #endif
                     tiledInputPart.setFrameBuffer(frameBuffer);
 
-                    int tx = tiledInputPart.numXTiles(_xLevel);
-                    int ty = tiledInputPart.numYTiles(_yLevel);
-
-                    // Read tiles in order for most efficiency.
-                    if (lineOrder == Imf::INCREASING_Y)
+                    // Find the range of tiles to read.
+                    int tx0 = 0;
+                    int ty0 = 0;
+                    int tx1 = tiledInputPart.numXTiles(_xLevel) - 1;
+                    int ty1 = tiledInputPart.numYTiles(_yLevel) - 1;
+                    if (_hasROI)
                     {
-                        for (int y = 0; y < ty; ++y)
-                            for (int x = 0; x < tx; ++x)
-                                tiledInputPart.readTile(x, y, _xLevel, _yLevel);
+                        // Scale the region of interest to the level.
+                        const math::Box2i levelDataWindow = fromImath(
+                            tiledInputPart.dataWindowForLevel(
+                                _xLevel, _yLevel));
+                        const math::Box2i roi(
+                            math::Vector2i(
+                                levelDataWindow.min.x +
+                                    ((_roi.min.x - baseDataWindow.min.x) >>
+                                     _xLevel),
+                                levelDataWindow.min.y +
+                                    ((_roi.min.y - baseDataWindow.min.y) >>
+                                     _yLevel)),
+                            math::Vector2i(
+                                levelDataWindow.min.x +
+                                    ((_roi.max.x - baseDataWindow.min.x) >>
+                                     _xLevel),
+                                levelDataWindow.min.y +
+                                    ((_roi.max.y - baseDataWindow.min.y) >>
+                                     _yLevel)));
+                        if (!math::intersects(roi, levelDataWindow))
+                        {
+                            tx1 = -1;
+                            ty1 = -1;
+                        }
+                        else
+                        {
+                            const math::Box2i tiles =
+                                math::intersect(roi, levelDataWindow);
+                            const Imf::TileDescription& tileDescription =
+                                tiledInputPart.header().tileDescription();
+                            const int tileW = tileDescription.xSize;
+                            const int tileH = tileDescription.ySize;
+                            tx0 = (tiles.min.x - levelDataWindow.min.x) / tileW;
+                            ty0 = (tiles.min.y - levelDataWindow.min.y) / tileH;
+                            tx1 = std::min(
+                                (tiles.max.x - levelDataWindow.min.x) / tileW,
+                                tx1);
+                            ty1 = std::min(
+                                (tiles.max.y - levelDataWindow.min.y) / tileH,
+                                ty1);
+                        }
+                        if (tx0 > 0 || ty0 > 0 ||
+                            tx1 < tiledInputPart.numXTiles(_xLevel) - 1 ||
+                            ty1 < tiledInputPart.numYTiles(_yLevel) - 1)
+                        {
+                            // Zero the pixels of the tiles that are skipped.
+                            if (tempImage)
+                                tempImage->zero();
+                            else
+                                out.image->zero();
+                        }
                     }
-                    else
+
+                    // Read the tiles with a single call, OpenEXR reads them
+                    // in file order and decompresses them in parallel.
+                    if (tx1 >= tx0 && ty1 >= ty0)
                     {
-                        for (int y = ty - 1; y >= 0; --y)
-                            for (int x = 0; x < tx; ++x)
-                                tiledInputPart.readTile(x, y, _xLevel, _yLevel);
+                        tiledInputPart.readTiles(
+                            tx0, tx1, ty0, ty1, _xLevel, _yLevel);
                     }
-                    
+
                     if (needTemp)
                     {
                         if (YBYRY)
@@ -954,10 +1175,35 @@ namespace tl
                             static_cast<int>(_info.video.size()) - 1);
                     }
 
+                    // The region of interest, tiles outside of it are not
+                    // read.
+                    i = options.find("OpenEXR/ROI");
+                    if (i != options.end())
+                    {
+                        std::stringstream ss(i->second);
+                        ss >> _roi.min.x >> _roi.min.y >> _roi.max.x >>
+                            _roi.max.y;
+                        _hasROI = !ss.fail() && _roi.isValid();
+                    }
+
                     // 1. Get header for the current part.
                     const Imf::Header& header =
                         _f->header(_layers[layer].partNumber);
 
+                    // Use the region of interest from the frame request,
+                    // which is relative to the display window.
+                    if (!_hasROI)
+                    {
+                        const io::FrameRequest frameRequest =
+                            io::getFrameRequest(options);
+                        if (frameRequest.roi.isValid())
+                        {
+                            _roi = frameRequest.roi +
+                                   fromImath(header.displayWindow()).min;
+                            _hasROI = true;
+                        }
+                    }
+
                     // 2. Update window info if not a mipmap read (it was set for mipmap in constructor).
                     if (!_t_part)
                     {
@@ -1036,7 +1282,15 @@ namespace tl
                         const size_t cb = vulkanChannels * channelByteCount;
                         const size_t scb =
                             vulkanInfo.size.w * vulkanChannels * channelByteCount;
-                        
+
+                        bool subsampled = false;
+                        for (size_t c = 0; c < channels; ++c)
+                        {
+                            const math::Vector2i& sampling =
+                                _layers[layer].channels[c].sampling;
+                            if (sampling.x != 1 || sampling.y != 1)
+                                subsampled = true;
+                        }
                         if (_fast)
                         {
                             Imf::FrameBuffer frameBuffer;
@@ -1077,11 +1331,67 @@ namespace tl
                             Imf::InputPart in(
                                 *_f.get(), _layers[layer].partNumber);
                             in.setFrameBuffer(frameBuffer);
-                            in.readPixels(
-                                _displayWindow.min.y, _displayWindow.max.y);
+
+                            // Only read the scanlines in the region of
+                            // interest.
+                            int y0 = _displayWindow.min.y;
+                            int y1 = _displayWindow.max.y;
+                            if (_hasROI)
+                            {
+                                y0 = std::max(y0, _roi.min.y);
+                                y1 = std::min(y1, _roi.max.y);
+                                if (y0 > _displayWindow.min.y ||
+                                    y1 < _displayWindow.max.y)
+                                {
+                                    out.image->zero();
+                                }
+                            }
+                            if (y0 <= y1)
+                            {
+                                in.readPixels(y0, y1);
+                            }
+                        }
+                        else if (!subsampled)
+                        {
+                            for (size_t c = 0; c < channels; ++c)
+                            {
+                                const std::string& name =
+                                    _layers[layer].channels[c].name;
+                                if (name == "RY" || name == "BY")
+                                    YBYRY = true;
+                            }
+
+                            Imf::InputPart in(
+                                *_f.get(), _layers[layer].partNumber);
+                            readScanlines(
+                                in, layer, out.image->getData(), channels,
+                                channelByteCount, cb, scb,
+                                Imf::getCompressionNumScanlines(
+                                    header.compression()));
+                            if (!_ignoreDisplayWindow ||
+                                _dataWindow.min.x >= _displayWindow.min.x ||
+                                _dataWindow.max.x <= _displayWindow.max.x ||
+                                _dataWindow.min.y >= _displayWindow.min.y ||
+                                _dataWindow.max.y <= _displayWindow.max.y)
+                            {
+                                minY = _displayWindow.min.y;
+                                maxY = _displayWindow.max.y;
+                                minX = _intersectedWindow.min.x;
+                                maxX = _intersectedWindow.max.x;
+                            }
+                            else
+                            {
+                                minY = _dataWindow.min.y;
+                                maxY = _dataWindow.max.y;
+                                minX = _dataWindow.min.x;
+                                maxX = _dataWindow.max.x;
+                            }
                         }
                         else
                         {
+                            // Subsampled channels are read a line at a
+                            // time so that upscaleRYBY() sees the layout
+                            // it expects.
                             Imf::FrameBuffer frameBuffer;
                             std::vector<char> buf(_dataWindow.w() * cb);
                             for (int c = 0; c < channels; ++c)
@@ -1310,6 +1620,8 @@ namespace tl
                 bool _useRGBOnly = false;
                 int _xLevel;
                 int _yLevel;
+                math::Box2i _roi;
+                bool _hasROI = false;
                 std::weak_ptr<log::System> logSystemWeak;
                 Imf::Chromaticities _chromaticities;
                 std::unique_ptr<Imf::IStream> _s;
@@ -1416,7 +1728,7 @@ namespace tl
             io::Info out =
                 File(
                     fileName, memory, _channelGrouping, _ignoreDisplayWindow,
-                    false, false, false, 0, 0, _logSystem.lock())
+                    false, false, false, 0, 0, 1.F, _logSystem.lock())
                     .getInfo();
             float speed = _defaultSpeed;
             auto i = out.tags.find("Frame Per Second");
@@ -1445,10 +1757,17 @@ namespace tl
             const std::string& fileName, const file::MemoryRead* memory,
             const otime::RationalTime& time, const io::Options& options)
         {
+            float zoom = io::getFrameRequest(options).scale;
+            auto i = options.find("OpenEXR/Zoom");
+            if (i != options.end())
+            {
+                locale::SetAndRestore saved;
+                zoom = std::stof(i->second);
+            }
             return File(
                        fileName, memory, _channelGrouping, _ignoreDisplayWindow,
                        _ignoreChromaticities, _autoNormalize, _useRGBOnly,
-                       _xLevel, _yLevel, _logSystem)
+                       _xLevel, _yLevel, zoom, _logSystem)
                 .read(fileName, time, options);
         }
     } // namespace exr
@@ -105,13 +105,19 @@ namespace tl
 
                 const image::Info& getInfo() const { return _info; }
 
+                const std::shared_ptr<file::FileIO>& getIO() const
+                {
+                    return _io;
+                }
+
                 io::VideoData read(
                     const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time,
+                    const std::shared_ptr<image::Image>& image)
                 {
                     io::VideoData out;
                     out.time = time;
-                    out.image = image::Image::create(_info);
+                    out.image = image;
 
                     uint8_t* p = out.image->getData();
                     switch (_data)
@@ -132,11 +138,6 @@ namespace tl
                         }
                         break;
                     }
-                    case Data::Binary:
-                    {
-                        _io->read(p, out.image->getDataByteCount());
-                        break;
-                    }
                     default:
                         break;
                     }
@@ -211,7 +212,14 @@ namespace tl
             const std::string& fileName, const file::MemoryRead* memory,
             const otime::RationalTime& time, const io::Options&)
         {
-            return File(fileName, memory).read(fileName, time);
+            File file(fileName, memory);
+            // Binary data may reference the memory-mapped file instead of
+            // being copied.
+            const auto image = Data::Binary == file.getData()
+                                   ? _readImage(
+                                         file.getIO(), file.getInfo(), memory)
+                                   : image::Image::create(file.getInfo());
+            return file.read(fileName, time, image);
         }
     } // namespace ppm
 } // namespace tl
@@ -50,6 +50,18 @@ namespace tl
             return 0;
         }
 
+        size_t IRead::getByteCount() const
+        {
+            return 0;
+        }
+
+        void IRead::releaseMemory() {}
+
+        void IRead::setRequestCallback(const std::function<void(void)>& value)
+        {
+            _requestCallback = value;
+        }
+
         std::future<VideoData>
         IRead::readVideo(const otime::RationalTime&, const Options&)
         {
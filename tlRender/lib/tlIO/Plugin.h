@@ -8,6 +8,7 @@
 
 #include <tlCore/FileIO.h>
 
+#include <functional>
 #include <future>
 #include <set>
 
@@ -89,8 +90,25 @@ namespace tl
             //! default implementation returns zero.
             virtual size_t getErrorCount() const;
 
+            //! Get an estimate of the memory held by the reader in bytes,
+            //! not counting the I/O cache. The default implementation
+            //! returns zero.
+            virtual size_t getByteCount() const;
+
+            //! Release memory that is only kept to speed up reading, such
+            //! as buffered frames, while keeping the file open. The default
+            //! implementation does nothing.
+            virtual void releaseMemory();
+
+            //! Set a callback that is called when a request has finished,
+            //! so the owner of the reader can wake up without polling.
+            //! Readers that run their requests on the I/O thread pool call
+            //! it from the pool thread. Set it before making any requests.
+            void setRequestCallback(const std::function<void(void)>&);
+
         protected:
             std::vector<file::MemoryRead> _memory;
+            std::function<void(void)> _requestCallback;
         };
 
         //! Base class for writers.
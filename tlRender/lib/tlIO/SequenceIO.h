@@ -16,8 +16,17 @@ namespace tl
         //! Number of threads.
         const size_t sequenceThreadCount = 16;
 
-        //! Timeout for requests.
-        const std::chrono::milliseconds sequenceRequestTimeout(5);
+        //! Whether uncompressed images reference memory-mapped files instead
+        //! of being copied. This is off by default since the files must not
+        //! be truncated or rendered again while the images are in use (see
+        //! image::Image::create()), enable it with the "SequenceIO/ZeroCopy"
+        //! option.
+        const bool sequenceZeroCopy = false;
+
+        //! Timeout for requests. Finished requests wake the sequence thread
+        //! immediately, this only bounds how long it sleeps between log
+        //! updates.
+        const std::chrono::milliseconds sequenceRequestTimeout(100);
 
         //! Base class for image sequence readers.
         class ISequenceRead : public IRead
@@ -50,12 +59,20 @@ namespace tl
                 image::Tags& tags, const std::string&,
                 const otime::RationalTime&);
 
+            //! Read uncompressed image data from the current file position.
+            //! If zero copy is enabled and the file is memory-mapped, the
+            //! image references the mapped memory instead of a copy.
+            std::shared_ptr<image::Image> _readImage(
+                const std::shared_ptr<file::FileIO>&, const image::Info&,
+                const file::MemoryRead*);
+
             //! \bug This must be called in the sub-class destructor.
             void _finish();
 
             int64_t _startFrame = 0;
             int64_t _endFrame = 0;
             float _defaultSpeed = sequenceDefaultSpeed;
+            bool _zeroCopy = sequenceZeroCopy;
 
         private:
             void _thread();
@@ -47,12 +47,18 @@ namespace tl
                 std::stringstream ss(i->second);
                 ss >> p.threadCount;
             }
+            p.threadPool = ThreadPool::getGlobal();
             i = options.find("SequenceIO/DefaultSpeed");
             if (i != options.end())
             {
                 std::stringstream ss(i->second);
                 ss >> _defaultSpeed;
             }
+            i = options.find("SequenceIO/ZeroCopy");
+            if (i != options.end())
+            {
+                _zeroCopy = static_cast<bool>(std::atoi(i->second.c_str()));
+            }
 
             p.thread.running = true;
             p.thread.thread = std::thread(
@@ -168,6 +174,28 @@ namespace tl
             }
         }
 
+        std::shared_ptr<image::Image> ISequenceRead::_readImage(
+            const std::shared_ptr<file::FileIO>& io, const image::Info& info,
+            const file::MemoryRead* memory)
+        {
+            std::shared_ptr<image::Image> out;
+            const size_t byteCount = image::getDataByteCount(info);
+            // Memory reads are owned by the caller and may not outlive the
+            // image, so they are always copied.
+            if (_zeroCopy && !memory && io->getMemoryStart() &&
+                io->getPos() + byteCount <= io->getSize())
+            {
+                out = image::Image::create(info, io, io->getPos());
+                io->seek(byteCount);
+            }
+            else
+            {
+                out = image::Image::create(info);
+                io->read(out->getData(), byteCount);
+            }
+            return out;
+        }
+
         void ISequenceRead::cancelRequests()
         {
             _cancelRequests();
@@ -199,29 +227,33 @@ namespace tl
                 std::list<std::shared_ptr<Private::InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<Private::VideoRequest> >
                     videoRequests;
+                size_t videoRequestsInProgress = 0;
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                    p.thread.cv.wait(
-                            lock, [this]
-                            {
-                                return (!_p->mutex.infoRequests.empty() ||
-                                        !_p->mutex.videoRequests.empty() ||
-                                        !_p->thread.videoRequestsInProgress.empty() ||
-                                        !_p->thread.running);
-                            });
+                    p.thread.cv.wait_for(
+                        lock, sequenceRequestTimeout,
+                        [this]
+                        {
+                            return (!_p->mutex.infoRequests.empty() ||
+                                    (!_p->mutex.videoRequests.empty() &&
+                                     _p->mutex.videoRequestsInProgress <
+                                         _p->threadCount) ||
+                                    !_p->thread.running);
+                        });
 
                     if (!p.thread.running)
                         return;
-                    
+
                     infoRequests = std::move(p.mutex.infoRequests);
                     while (!p.mutex.videoRequests.empty() &&
-                           (p.thread.videoRequestsInProgress.size() +
-                            videoRequests.size()) < p.threadCount)
+                           p.mutex.videoRequestsInProgress < p.threadCount)
                     {
                         videoRequests.push_back(
                             p.mutex.videoRequests.front());
                         p.mutex.videoRequests.pop_front();
-                    }                    
+                        ++p.mutex.videoRequestsInProgress;
+                    }
+                    videoRequestsInProgress = p.mutex.videoRequestsInProgress;
                 }
 
                 // Information rquests.
@@ -230,7 +262,9 @@ namespace tl
                     request->promise.set_value(p.info);
                 }
 
-                // Initialize video requests.
+                // Submit video requests to the thread pool. The promise is
+                // fulfilled by the pool thread as soon as the frame is read,
+                // there is no polling for finished requests.
                 while (!videoRequests.empty())
                 {
                     auto request = videoRequests.front();
@@ -248,75 +282,40 @@ namespace tl
                     {
                         fileName = _path.getFileName(true);
                     }
-                    const otio::RationalTime time = request->time;
-                    const Options options = request->options;
-                    request->future = std::async(
-                        std::launch::async,
-                        [this, seq, fileName, time, options]
+                    p.threadPool->submit(
+                        [this, seq, fileName, request]
                         {
                             VideoData out;
                             try
                             {
-                                const int64_t frame = time.value();
+                                const int64_t frame = request->time.value();
                                 const int64_t memoryIndex = seq ? (frame - _startFrame) : 0;
                                 out = _readVideo(
                                     fileName,
                                     memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr,
-                                    time,
-                                    options);
+                                    request->time,
+                                    request->options);
                             }
                             catch (const std::exception&)
                             {
                                 //! \todo How should this be handled?
                             }
-                            return out;
-                        });
-                    p.thread.videoRequestsInProgress.push_back(request);
-                }
-
-//                    bool readSequence = true;
-//                    if (_cache)
-//                    {
-//                        const std::string cacheKey = getVideoCacheKey(
-//                            _path, request->time, _options, request->options);
-//
-//                        const auto i = request->options.find("ClearFrame");
-//                        if (i != request->options.end())
-//                        {
-//                            _cache->removeVideo(cacheKey);
-//                        }
-//                        else
-//                        {
-//                            VideoData videoData;
-//
-//                            if (_cache->getVideo(cacheKey, videoData))
-//                            {
-//                                readSequence = false;
-//                                request->promise.set_value(videoData);
-//                            }
-//                        }
-//                    }
-
+                            request->promise.set_value(out);
+                        },
+                        [this]
+                        {
+                            if (_requestCallback)
+                            {
+                                _requestCallback();
+                            }
 
-                // Check for finished video requests.
-                // if (!p.thread.videoRequestsInProgress.empty())
-                //{
-                //    std::cout << "in progress: " <<
-                //    p.thread.videoRequestsInProgress.size() << std::endl;
-                //}
-                auto requestIt = p.thread.videoRequestsInProgress.begin();
-                while (requestIt != p.thread.videoRequestsInProgress.end())
-                {
-                    if ((*requestIt)->future.valid() &&
-                        (*requestIt)->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-                    {
-                        //std::cout << "finished: " << requestIt->time << std::endl;
-                        auto videoData = (*requestIt)->future.get();
-                        (*requestIt)->promise.set_value(videoData);
-                        requestIt = p.thread.videoRequestsInProgress.erase(requestIt);
-                        continue;
-                    }
-                    ++requestIt;
+                            // Notify while holding the lock, the reader may
+                            // be destroyed as soon as the count reaches zero.
+                            TLRENDER_P();
+                            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                            --p.mutex.videoRequestsInProgress;
+                            p.thread.cv.notify_one();
+                        });
                 }
 
                 // Logging.
@@ -336,17 +335,31 @@ namespace tl
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             requestsSize = p.mutex.videoRequests.size();
                         }
+                        const ThreadPoolStats stats =
+                            p.threadPool->getStats();
                         logSystem->print(
                             id,
                             string::Format(
                                 "\n"
                                 "    Path: {0}\n"
                                 "    Requests: {1}, {2} in progress\n"
-                                "    Thread count: {3}")
+                                "    Thread count: {3}\n"
+                                "    Pool: {4} threads, {5} queued ({6} max), "
+                                "{7} stolen\n"
+                                "    Pool latency: {8}us wait, {9}us run "
+                                "({10}us/{11}us max)")
                                 .arg(_path.get())
                                 .arg(requestsSize)
-                                .arg(p.thread.videoRequestsInProgress.size())
-                                .arg(p.threadCount));
+                                .arg(videoRequestsInProgress)
+                                .arg(p.threadCount)
+                                .arg(stats.threadCount)
+                                .arg(stats.queueDepth)
+                                .arg(stats.queueDepthMax)
+                                .arg(stats.stolen)
+                                .arg(stats.waitAverage.count())
+                                .arg(stats.runAverage.count())
+                                .arg(stats.waitMax.count())
+                                .arg(stats.runMax.count()));
                     }
                 }
             }
@@ -355,17 +368,13 @@ namespace tl
         void ISequenceRead::_finishRequests()
         {
             TLRENDER_P();
-            for (auto& request : p.thread.videoRequestsInProgress)
-            {
-                VideoData data;
-                data.time = request->time;
-                if (request->future.valid())
-                {
-                    data = request->future.get();
-                }
-                request->promise.set_value(data);
-            }
-            p.thread.videoRequestsInProgress.clear();
+
+            // Wait for the requests in the thread pool, they reference this
+            // object.
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.thread.cv.wait(
+                lock,
+                [this] { return 0 == _p->mutex.videoRequestsInProgress; });
         }
 
         void ISequenceRead::_cancelRequests()
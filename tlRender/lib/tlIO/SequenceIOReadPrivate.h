@@ -5,6 +5,7 @@
 #pragma once
 
 #include <tlIO/SequenceIO.h>
+#include <tlIO/ThreadPool.h>
 
 #include <atomic>
 #include <condition_variable>
@@ -21,6 +22,7 @@ namespace tl
             void addTags(Info&);
 
             size_t threadCount = sequenceThreadCount;
+            std::shared_ptr<ThreadPool> threadPool;
 
             Info info;
 
@@ -40,13 +42,16 @@ namespace tl
                 otime::RationalTime time = time::invalidTime;
                 Options options;
                 std::promise<VideoData> promise;
-                std::future<VideoData> future;
             };
 
             struct Mutex
             {
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                // Number of video requests submitted to the thread pool that
+                // have not finished yet. The pool tasks decrement this and
+                // notify the condition variable when they are done.
+                size_t videoRequestsInProgress = 0;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -54,8 +59,6 @@ namespace tl
 
             struct Thread
             {
-                std::list<std::shared_ptr<VideoRequest> >
-                    videoRequestsInProgress;
                 std::chrono::steady_clock::time_point logTimer;
                 std::condition_variable cv;
                 std::thread thread;
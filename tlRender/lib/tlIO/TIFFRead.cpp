@@ -9,6 +9,7 @@
 
 #include <tiffio.h>
 
+#include <algorithm>
 #include <sstream>
 
 namespace tl
@@ -211,11 +212,20 @@ namespace tl
 
                 io::VideoData read(
                     const std::string& fileName,
-                    const otime::RationalTime& time)
+                    const otime::RationalTime& time, int step)
                 {
                     io::VideoData out;
                     out.time = time;
-                    const auto& info = _info.video[0];
+
+                    // Read every n'th scanline and pixel for lower resolution
+                    // frame requests.
+                    const auto& fullInfo = _info.video[0];
+                    step = std::max(step, 1);
+                    image::Info info = fullInfo;
+                    info.size.w = (fullInfo.size.w + step - 1) / step;
+                    info.size.h = (fullInfo.size.h + step - 1) / step;
+                    const size_t scanlineSize =
+                        info.size.w * _samples * _sampleDepth / 8;
                     out.image = image::Image::create(info);
 
                     _info.tags["otioClipName"] = fileName;
@@ -229,16 +239,16 @@ namespace tl
                     if (_planar)
                     {
                         std::vector<uint8_t> scanline;
-                        scanline.resize(info.size.w * _sampleDepth / 8);
+                        scanline.resize(fullInfo.size.w * _sampleDepth / 8);
                         for (size_t sample = 0; sample < _samples; ++sample)
                         {
                             uint8_t* p = out.image->getData();
-                            for (uint16_t y = 0; y < info.size.h;
-                                 ++y, p += _scanlineSize)
+                            for (uint32_t y = 0; y < info.size.h;
+                                 ++y, p += scanlineSize)
                             {
                                 if (TIFFReadScanline(
-                                        _tiff.p, (tdata_t*)scanline.data(), y,
-                                        sample) == -1)
+                                        _tiff.p, (tdata_t*)scanline.data(),
+                                        y * step, sample) == -1)
                                 {
                                     break;
                                 }
@@ -249,7 +259,7 @@ namespace tl
                                     const uint8_t* inP = scanline.data();
                                     uint8_t* outP = p + sample;
                                     for (uint16_t x = 0; x < info.size.w;
-                                         ++x, ++inP, outP += _samples)
+                                         ++x, inP += step, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -263,7 +273,7 @@ namespace tl
                                     uint16_t* outP =
                                         reinterpret_cast<uint16_t*>(p) + sample;
                                     for (uint16_t x = 0; x < info.size.w;
-                                         ++x, ++inP, outP += _samples)
+                                         ++x, inP += step, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -276,7 +286,7 @@ namespace tl
                                     float* outP =
                                         reinterpret_cast<float*>(p) + sample;
                                     for (uint16_t x = 0; x < info.size.w;
-                                         ++x, ++inP, outP += _samples)
+                                         ++x, inP += step, outP += _samples)
                                     {
                                         *outP = *inP;
                                     }
@@ -291,10 +301,28 @@ namespace tl
                     else
                     {
                         uint8_t* p = out.image->getData();
-                        for (uint16_t y = 0; y < info.size.h;
-                             ++y, p += _scanlineSize)
+                        std::vector<uint8_t> scanline;
+                        if (step > 1)
                         {
-                            if (TIFFReadScanline(_tiff.p, (tdata_t*)p, y) == -1)
+                            scanline.resize(_scanlineSize);
+                        }
+                        for (uint32_t y = 0; y < info.size.h;
+                             ++y, p += scanlineSize)
+                        {
+                            if (step > 1)
+                            {
+                                if (TIFFReadScanline(
+                                        _tiff.p, (tdata_t*)scanline.data(),
+                                        y * step) == -1)
+                                {
+                                    break;
+                                }
+                                io::subsampleScanline(
+                                    scanline.data(), p, info.size.w,
+                                    _samples * _sampleDepth / 8, step);
+                            }
+                            else if (
+                                TIFFReadScanline(_tiff.p, (tdata_t*)p, y) == -1)
                             {
                                 break;
                             }
@@ -375,9 +403,12 @@ namespace tl
 
         io::VideoData Read::_readVideo(
             const std::string& fileName, const file::MemoryRead* memory,
-            const otime::RationalTime& time, const io::Options&)
+            const otime::RationalTime& time, const io::Options& options)
         {
-            return File(fileName, memory).read(fileName, time);
+            return File(fileName, memory)
+                .read(
+                    fileName, time,
+                    io::getFrameRequest(options).getSubsampleStep());
         }
     } // namespace tiff
 } // namespace tl
@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIO/ThreadPool.h>
+
+#include <tlIO/SequenceIO.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            struct Task
+            {
+                std::function<void(void)> task;
+                std::function<void(void)> completion;
+                std::chrono::steady_clock::time_point queued;
+            };
+
+            struct Queue
+            {
+                std::deque<Task> tasks;
+                std::mutex mutex;
+            };
+
+            // The pool and queue index of the current worker thread, so that
+            // tasks submitted from a worker stay on that worker's queue.
+            thread_local const void* currentPool = nullptr;
+            thread_local size_t currentIndex = 0;
+
+            void updateMax(std::atomic<int64_t>& max, int64_t value)
+            {
+                int64_t prev = max.load();
+                while (prev < value && !max.compare_exchange_weak(prev, value))
+                    ;
+            }
+        } // namespace
+
+        struct ThreadPool::Private
+        {
+            bool pop(size_t index, Task&, bool& stolen);
+
+            std::vector<std::unique_ptr<Queue> > queues;
+            Queue priorityQueue;
+            std::vector<std::thread> threads;
+            std::atomic<size_t> next = 0;
+
+            // Number of queued tasks. Workers sleep on the condition
+            // variable when this is zero. It is changed under the lock of the
+            // queue the task is pushed to or popped from, so it never counts
+            // a task that is not in a queue.
+            std::atomic<int64_t> pending = 0;
+            std::atomic<bool> running = false;
+            std::mutex mutex;
+            std::condition_variable cv;
+
+            struct Stats
+            {
+                std::atomic<int64_t> queueDepthMax = 0;
+                std::atomic<size_t> active = 0;
+                std::atomic<size_t> submitted = 0;
+                std::atomic<size_t> completed = 0;
+                std::atomic<size_t> stolen = 0;
+                std::atomic<int64_t> waitTotal = 0;
+                std::atomic<int64_t> waitMax = 0;
+                std::atomic<int64_t> runTotal = 0;
+                std::atomic<int64_t> runMax = 0;
+            };
+            Stats stats;
+        };
+
+        void ThreadPool::_init(size_t threadCount)
+        {
+            TLRENDER_P();
+            threadCount = std::max(threadCount, static_cast<size_t>(1));
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.queues.push_back(std::make_unique<Queue>());
+            }
+            p.running = true;
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                p.threads.push_back(std::thread([this, i] { _run(i); }));
+            }
+        }
+
+        ThreadPool::ThreadPool() :
+            _p(new Private)
+        {
+        }
+
+        ThreadPool::~ThreadPool()
+        {
+            TLRENDER_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.running = false;
+            }
+            p.cv.notify_all();
+            for (auto& thread : p.threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::create(size_t threadCount)
+        {
+            auto out = std::shared_ptr<ThreadPool>(new ThreadPool);
+            out->_init(threadCount);
+            return out;
+        }
+
+        std::shared_ptr<ThreadPool> ThreadPool::getGlobal()
+        {
+            // I/O tasks spend much of their time blocked on the file system,
+            // so use at least as many threads as a single sequence reader
+            // keeps in flight.
+            static std::shared_ptr<ThreadPool> pool = create(std::max(
+                sequenceThreadCount,
+                static_cast<size_t>(std::thread::hardware_concurrency())));
+            return pool;
+        }
+
+        size_t ThreadPool::getThreadCount() const
+        {
+            return _p->threads.size();
+        }
+
+        void ThreadPool::submit(
+            const std::function<void(void)>& task,
+            const std::function<void(void)>& completion,
+            ThreadPoolPriority priority)
+        {
+            TLRENDER_P();
+            size_t index = 0;
+            if (currentPool == this)
+            {
+                index = currentIndex;
+            }
+            else
+            {
+                index = p.next++ % p.queues.size();
+            }
+            {
+                Queue& queue = ThreadPoolPriority::High == priority
+                                   ? p.priorityQueue
+                                   : *p.queues[index];
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(
+                    {task, completion, std::chrono::steady_clock::now()});
+                std::unique_lock<std::mutex> poolLock(p.mutex);
+                updateMax(p.stats.queueDepthMax, ++p.pending);
+            }
+            ++p.stats.submitted;
+            p.cv.notify_one();
+        }
+
+        void ThreadPool::parallelFor(
+            size_t count, size_t chunkSize,
+            const std::function<void(size_t, size_t)>& fn)
+        {
+            TLRENDER_P();
+            chunkSize = std::max(chunkSize, static_cast<size_t>(1));
+            const size_t chunks = (count + chunkSize - 1) / chunkSize;
+            if (chunks <= 1)
+            {
+                if (count > 0)
+                {
+                    fn(0, count);
+                }
+                return;
+            }
+
+            // The state is shared with the helper tasks, which may still be
+            // queued after all of the chunks are finished.
+            struct State
+            {
+                std::function<void(size_t, size_t)> fn;
+                size_t count = 0;
+                size_t chunkSize = 0;
+                size_t chunks = 0;
+                std::atomic<size_t> next = 0;
+                size_t finished = 0;
+                std::mutex mutex;
+                std::condition_variable cv;
+
+                void run()
+                {
+                    size_t chunk = 0;
+                    while ((chunk = next++) < chunks)
+                    {
+                        const size_t begin = chunk * chunkSize;
+                        try
+                        {
+                            fn(begin, std::min(begin + chunkSize, count));
+                        }
+                        catch (const std::exception&)
+                        {
+                            //! \todo How should this be handled?
+                        }
+                        std::unique_lock<std::mutex> lock(mutex);
+                        if (++finished == chunks)
+                        {
+                            cv.notify_all();
+                        }
+                    }
+                }
+            };
+            auto state = std::make_shared<State>();
+            state->fn = fn;
+            state->count = count;
+            state->chunkSize = chunkSize;
+            state->chunks = chunks;
+
+            const size_t helpers = std::min(chunks - 1, p.threads.size());
+            for (size_t i = 0; i < helpers; ++i)
+            {
+                submit([state] { state->run(); });
+            }
+            state->run();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->cv.wait(
+                lock, [state] { return state->finished == state->chunks; });
+        }
+
+        ThreadPoolStats ThreadPool::getStats() const
+        {
+            TLRENDER_P();
+            ThreadPoolStats out;
+            out.threadCount = p.threads.size();
+            out.queueDepth = std::max(p.pending.load(), int64_t(0));
+            out.queueDepthMax = p.stats.queueDepthMax;
+            out.active = p.stats.active;
+            out.submitted = p.stats.submitted;
+            out.completed = p.stats.completed;
+            out.stolen = p.stats.stolen;
+            if (out.completed > 0)
+            {
+                out.waitAverage = std::chrono::microseconds(
+                    p.stats.waitTotal / static_cast<int64_t>(out.completed));
+                out.runAverage = std::chrono::microseconds(
+                    p.stats.runTotal / static_cast<int64_t>(out.completed));
+            }
+            out.waitMax = std::chrono::microseconds(p.stats.waitMax);
+            out.runMax = std::chrono::microseconds(p.stats.runMax);
+            return out;
+        }
+
+        void ThreadPool::resetStats()
+        {
+            TLRENDER_P();
+            p.stats.queueDepthMax = p.pending.load();
+            p.stats.submitted = 0;
+            p.stats.completed = 0;
+            p.stats.stolen = 0;
+            p.stats.waitTotal = 0;
+            p.stats.waitMax = 0;
+            p.stats.runTotal = 0;
+            p.stats.runMax = 0;
+        }
+
+        bool ThreadPool::Private::pop(size_t index, Task& task, bool& stolen)
+        {
+            // Take the oldest high priority task first.
+            {
+                std::unique_lock<std::mutex> lock(priorityQueue.mutex);
+                if (!priorityQueue.tasks.empty())
+                {
+                    task = std::move(priorityQueue.tasks.front());
+                    priorityQueue.tasks.pop_front();
+                    --pending;
+                    stolen = false;
+                    return true;
+                }
+            }
+
+            // Take the oldest task from our own queue, so requests are
+            // started in the order they were made.
+            {
+                Queue& queue = *queues[index];
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    --pending;
+                    stolen = false;
+                    return true;
+                }
+            }
+
+            // Steal the newest task from another queue.
+            for (size_t i = 1; i < queues.size(); ++i)
+            {
+                Queue& queue = *queues[(index + i) % queues.size()];
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                    --pending;
+                    stolen = true;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void ThreadPool::_run(size_t index)
+        {
+            TLRENDER_P();
+            currentPool = this;
+            currentIndex = index;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        { return _p->pending > 0 || !_p->running; });
+                    if (!p.running && 0 == p.pending)
+                        break;
+                }
+
+                Task task;
+                bool stolen = false;
+                if (!p.pop(index, task, stolen))
+                {
+                    // Another worker took the task.
+                    continue;
+                }
+                if (stolen)
+                {
+                    ++p.stats.stolen;
+                }
+
+                const auto t0 = std::chrono::steady_clock::now();
+                ++p.stats.active;
+                try
+                {
+                    if (task.task)
+                    {
+                        task.task();
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    //! \todo How should this be handled?
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                --p.stats.active;
+
+                const int64_t wait =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        t0 - task.queued)
+                        .count();
+                const int64_t run =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        t1 - t0)
+                        .count();
+                p.stats.waitTotal += wait;
+                p.stats.runTotal += run;
+                updateMax(p.stats.waitMax, wait);
+                updateMax(p.stats.runMax, run);
+                ++p.stats.completed;
+
+                if (task.completion)
+                {
+                    task.completion();
+                }
+            }
+            currentPool = nullptr;
+        }
+    } // namespace io
+} // namespace tl
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Util.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace tl
+{
+    namespace io
+    {
+        //! I/O thread pool statistics.
+        struct ThreadPoolStats
+        {
+            size_t threadCount = 0;
+
+            //! Number of tasks waiting to be run.
+            size_t queueDepth = 0;
+
+            //! Largest queue depth seen.
+            size_t queueDepthMax = 0;
+
+            //! Number of tasks currently running.
+            size_t active = 0;
+
+            size_t submitted = 0;
+            size_t completed = 0;
+
+            //! Number of tasks taken from another thread's queue.
+            size_t stolen = 0;
+
+            //! Time spent by tasks waiting in the queue.
+            std::chrono::microseconds waitAverage = std::chrono::microseconds(0);
+            std::chrono::microseconds waitMax = std::chrono::microseconds(0);
+
+            //! Time spent by tasks running.
+            std::chrono::microseconds runAverage = std::chrono::microseconds(0);
+            std::chrono::microseconds runMax = std::chrono::microseconds(0);
+        };
+
+        //! I/O thread pool task priority.
+        enum class ThreadPoolPriority
+        {
+            Normal,
+
+            //! High priority tasks run before any of the normal tasks that
+            //! are waiting, for short tasks that requests wait on, like
+            //! opening files.
+            High
+        };
+
+        //! Work stealing thread pool for I/O tasks.
+        //!
+        //! Each worker thread owns a queue. Tasks submitted from a worker go
+        //! to that worker's queue, other tasks are distributed round robin.
+        //! Idle workers steal from the back of the other queues. High
+        //! priority tasks share a separate queue that workers check first.
+        class ThreadPool : public std::enable_shared_from_this<ThreadPool>
+        {
+            TLRENDER_NON_COPYABLE(ThreadPool);
+
+        protected:
+            void _init(size_t threadCount);
+
+            ThreadPool();
+
+        public:
+            ~ThreadPool();
+
+            //! Create a new thread pool.
+            static std::shared_ptr<ThreadPool> create(size_t threadCount);
+
+            //! Get the process wide I/O thread pool shared by all of the
+            //! readers.
+            static std::shared_ptr<ThreadPool> getGlobal();
+
+            //! Get the number of threads.
+            size_t getThreadCount() const;
+
+            //! Submit a task. The completion callback is called from the
+            //! worker thread after the task has finished.
+            void submit(
+                const std::function<void(void)>& task,
+                const std::function<void(void)>& completion = nullptr,
+                ThreadPoolPriority = ThreadPoolPriority::Normal);
+
+            //! Run a function over the range [0, count) split into chunks.
+            //! The calling thread runs chunks as well and this returns when
+            //! all of them are finished, so it is safe to call from a task.
+            void parallelFor(
+                size_t count, size_t chunkSize,
+                const std::function<void(size_t begin, size_t end)>&);
+
+            //! Get the statistics.
+            ThreadPoolStats getStats() const;
+
+            //! Reset the statistics.
+            void resetStats();
+
+        private:
+            void _run(size_t index);
+
+            TLRENDER_PRIVATE();
+        };
+    } // namespace io
+} // namespace tl
@@ -87,7 +87,7 @@ namespace tl
             struct Thread
             {
                 memory::LRUCache<std::string, StageCacheItem> stageCache;
-                memory::LRUCache<std::string, std::shared_ptr<DiskCacheItem> >
+                memory::LRUCache<io::CacheKey, std::shared_ptr<DiskCacheItem> >
                     diskCache;
                 std::string tempDir;
                 std::chrono::steady_clock::time_point logTimer;
@@ -587,7 +587,7 @@ namespace tl
                 io::VideoData videoData;
                 if (request && p.cache)
                 {
-                    const std::string cacheKey = io::getVideoCacheKey(
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
                         request->path, request->time, ioOptions, {});
                     if (p.cache->getVideo(cacheKey, videoData))
                     {
@@ -609,7 +609,7 @@ namespace tl
                 if (request)
                 {
                     std::shared_ptr<Private::DiskCacheItem> diskCacheItem;
-                    const std::string cacheKey = io::getVideoCacheKey(
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
                         request->path, request->time, ioOptions, {});
                     if (diskCacheByteCount > 0 &&
                         p.thread.diskCache.get(cacheKey, diskCacheItem))
@@ -673,7 +673,7 @@ namespace tl
                 if (request)
                 {
                     std::shared_ptr<image::Image> image;
-                    const std::string cacheKey = io::getVideoCacheKey(
+                    const io::CacheKey cacheKey = io::getVideoCacheKey(
                         request->path, request->time, ioOptions, {});
                     try
                     {
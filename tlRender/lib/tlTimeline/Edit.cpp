@@ -249,11 +249,14 @@ namespace tl
         otio::SerializableObject::Retainer<otio::Timeline>
         copy(const otio::SerializableObject::Retainer<otio::Timeline>& timeline)
         {
-            //! \todo Since we are copying the timeline by serializing it to
-            //! JSON, we need to keep track of in-memory media references and
-            //! copy them to the new timeline. Would it be better to make a
-            //! deep copy of the timeline to avoid this?
+            // The timeline is cloned through the OTIO object graph, which
+            // avoids writing and parsing JSON text. Cloning goes through the
+            // schema serialization though, and the in-memory media references
+            // only serialize their URLs, so their data is copied to the new
+            // timeline separately. The references are tagged with an index
+            // into the copied data while the timeline is cloned.
             std::vector<std::shared_ptr<IMemoryData> > memoryData;
+            std::vector<otio::MediaReference*> memoryReferences;
             for (const auto& clip : timeline->find_clips())
             {
                 if (auto ref = dynamic_cast<ZipMemoryReference*>(
@@ -261,6 +264,7 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(ZipMemoryData::create(ref));
                 }
                 else if (
@@ -269,6 +273,7 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(RawMemoryData::create(ref));
                 }
                 else if (
@@ -277,6 +282,7 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(SharedMemoryData::create(ref));
                 }
                 else if (
@@ -285,6 +291,7 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(ZipMemorySequenceData::create(ref));
                 }
                 else if (
@@ -293,6 +300,7 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(RawMemorySequenceData::create(ref));
                 }
                 else if (
@@ -301,14 +309,25 @@ namespace tl
                 {
                     ref->metadata()["tlRender"] =
                         static_cast<int64_t>(memoryData.size());
+                    memoryReferences.push_back(ref);
                     memoryData.push_back(SharedMemorySequenceData::create(ref));
                 }
             }
 
-            const std::string s = timeline->to_json_string();
+            otio::ErrorStatus errorStatus;
             otio::SerializableObject::Retainer<otio::Timeline> out(
                 dynamic_cast<otio::Timeline*>(
-                    otio::Timeline::from_json_string(s)));
+                    timeline->clone(&errorStatus)));
+            for (const auto ref : memoryReferences)
+            {
+                ref->metadata().erase("tlRender");
+            }
+            if (!out)
+            {
+                throw std::runtime_error(
+                    string::Format("Cannot copy the timeline: {0}")
+                        .arg(errorStatus.full_description));
+            }
 
             for (const auto& clip : out->find_clips())
             {
@@ -228,6 +228,7 @@ namespace tl
                                         p.rtAudioCallback,
                                         _p.get());
                                     checkRtError(rterror);
+                                    p.audioThreadStart(rtBufferFrames);
                                     rterror = p.thread.rtAudio->startStream();
                                     checkRtError(rterror);
 #else
@@ -238,6 +239,7 @@ namespace tl
                                         &rtBufferFrames, p.rtAudioCallback,
                                         _p.get(), nullptr,
                                         p.rtAudioErrorCallback);
+                                    p.audioThreadStart(rtBufferFrames);
                                     p.thread.rtAudio->startStream();
 #endif
                                 }
@@ -257,6 +259,7 @@ namespace tl
 
                     p.thread.cacheTimer = std::chrono::steady_clock::now();
                     p.thread.logTimer = std::chrono::steady_clock::now();
+                    p.thread.decodeTimer = std::chrono::steady_clock::now();
                     while (p.thread.running)
                     {
                         const auto t0 = std::chrono::steady_clock::now();
@@ -284,6 +287,11 @@ namespace tl
                             p.thread.cacheDirection = p.mutex.cacheDirection;
                             p.thread.cacheOptions = p.mutex.cacheOptions;
                         }
+                        {
+                            std::unique_lock<std::mutex> lock(
+                                p.audioMutex.mutex);
+                            p.thread.speed = p.audioMutex.speed;
+                        }
 
                         // Clear requests.
                         if (clearRequests)
@@ -371,6 +379,11 @@ namespace tl
                 p.thread.thread.join();
             }
 #if defined(TLRENDER_AUDIO)
+            p.audioThread.running = false;
+            if (p.audioThread.thread.joinable())
+            {
+                p.audioThread.thread.join();
+            }
             if (p.thread.rtAudio && p.thread.rtAudio->isStreamOpen())
             {
                 try
@@ -407,8 +420,9 @@ namespace tl
             const auto& timeRange = p.timeline->getTimeRange();
             if (!p.ioInfo.video.empty())
             {
-                const auto i = p.thread.videoCache.find(p.thread.currentTime);
-                if (i != p.thread.videoCache.end())
+                const auto& videoCache = p.thread.videoCache.getFrames();
+                const auto i = videoCache.find(p.thread.currentTime);
+                if (i != videoCache.end())
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
                     p.mutex.currentVideoFrame = i->second;
@@ -1042,7 +1056,7 @@ namespace tl
             TLRENDER_P();
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                p.thread.videoCache.erase(time);
+                p.thread.videoCache.remove(time);
                 p.forwardRequests(
                     time, time, otime::RationalTime(1.0, time.rate()), true);
             }
@@ -1141,6 +1155,8 @@ namespace tl
                 currentAudioFrame = p.mutex.currentAudioFrame;
                 cacheInfo = p.mutex.cacheInfo;
             }
+            cacheInfo.audioUnderrunCount =
+                p.audioCallback.underrunCount.load(std::memory_order_relaxed);
             p.currentVideoFrame->setIfChanged(currentVideoFrame);
             p.currentAudioFrame->setIfChanged(currentAudioFrame);
             p.cacheInfo->setIfChanged(cacheInfo);
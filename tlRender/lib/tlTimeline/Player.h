@@ -29,6 +29,27 @@ namespace tl
             //! Cached audio frames.
             std::vector<otime::TimeRange> audioFrames;
 
+            //! Number of bytes used by the cached video.
+            size_t videoByteCount = 0;
+
+            //! Maximum number of bytes for the cached video.
+            size_t videoByteMax = 0;
+
+            //! Number of times the audio device ran out of samples.
+            size_t audioUnderrunCount = 0;
+
+            //! Current video read ahead. This is smaller than the read ahead
+            //! option when the adaptive cache has shrunk it.
+            otime::RationalTime readAhead = time::invalidTime;
+
+            //! Measured video decode throughput in frames per second, or zero
+            //! when it has not been measured yet.
+            double decodeFPS = 0.0;
+
+            //! Predicted number of seconds until playback runs out of cached
+            //! video, or a negative value when no underrun is predicted.
+            double underrunSeconds = -1.0;
+
             bool operator==(const PlayerCacheInfo&) const;
             bool operator!=(const PlayerCacheInfo&) const;
         };
@@ -10,6 +10,8 @@
 
 #include <tlCore/StringFormat.h>
 
+#include <cstring>
+
 namespace
 {
     inline float fadeValue(double sample, double in, double out)
@@ -65,21 +67,48 @@ namespace tl
         }
 
 #if defined(TLRENDER_AUDIO)
-        int Player::Private::rtAudioCallback(
-            void* outputBuffer, void* inputBuffer, unsigned int outSamples,
-            double streamTime, RtAudioStreamStatus status, void* userData)
+        void Player::Private::audioThreadStart(size_t bufferFrameCount)
         {
-            auto p = reinterpret_cast<Player::Private*>(userData);
+            // Keep two device buffers queued, and check the queue four
+            // times per device buffer.
+            audioThread.ringBuffer = audio::RingBuffer::create(
+                audioThread.info, bufferFrameCount * 4);
+            audioThread.moveBuffer.resize(
+                audioThread.ringBuffer->getCapacity() *
+                audioThread.info.getByteCount());
+            audioThread.sleepTimeout = std::max(
+                std::chrono::microseconds(500),
+                std::chrono::microseconds(
+                    bufferFrameCount * 1000000 /
+                    audioThread.info.sampleRate / 4));
+            audioThread.running = true;
+            audioThread.thread = std::thread(
+                [this]
+                {
+                    while (audioThread.running)
+                    {
+                        const auto t0 = std::chrono::steady_clock::now();
+                        audioMix();
+                        const auto t1 = std::chrono::steady_clock::now();
+                        time::sleep(audioThread.sleepTimeout, t0, t1);
+                    }
+                });
+        }
+
+        void Player::Private::audioMix()
+        {
+            if (!audioThread.ringBuffer)
+                return;
 
             // Get mutex protected values.
             Playback playback = Playback::Stop;
             otime::RationalTime playbackStartTime = time::invalidTime;
             double audioOffset = 0.0;
             {
-                std::unique_lock<std::mutex> lock(p->mutex.mutex);
-                playback = p->mutex.playback;
-                playbackStartTime = p->mutex.playbackStartTime;
-                audioOffset = p->mutex.audioOffset;
+                std::unique_lock<std::mutex> lock(mutex.mutex);
+                playback = mutex.playback;
+                playbackStartTime = mutex.playbackStartTime;
+                audioOffset = mutex.audioOffset;
             }
             double speed = 0.0;
             double defaultSpeed = 0.0;
@@ -90,16 +119,16 @@ namespace tl
             std::chrono::steady_clock::time_point muteTimeout;
             bool reset = false;
             {
-                std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                speed = p->audioMutex.speed;
-                defaultSpeed = p->timeline->getTimeRange().duration().rate();
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                speed = audioMutex.speed;
+                defaultSpeed = timeline->getTimeRange().duration().rate();
                 speedMultiplier = defaultSpeed / speed;
-                volume = p->audioMutex.volume;
-                mute = p->audioMutex.mute;
-                channelMute = p->audioMutex.channelMute;
-                muteTimeout = p->audioMutex.muteTimeout;
-                reset = p->audioMutex.reset;
-                p->audioMutex.reset = false;
+                volume = audioMutex.volume;
+                mute = audioMutex.mute;
+                channelMute = audioMutex.channelMute;
+                muteTimeout = audioMutex.muteTimeout;
+                reset = audioMutex.reset;
+                audioMutex.reset = false;
             }
 #if CHECK_AUDIO
             std::cout << "playback: " << playback << std::endl;
@@ -107,33 +136,40 @@ namespace tl
             std::endl;
 #endif
 
-            auto& thread = p->audioThread;
+            // Publish the values for the audio callback.
+            audioCallback.playback.store(playback, std::memory_order_relaxed);
+            audioCallback.mute.store(mute, std::memory_order_relaxed);
+            audioCallback.muteTimeout.store(
+                muteTimeout.time_since_epoch().count(),
+                std::memory_order_relaxed);
 
-            // Zero output audio data.
-            std::memset(
-                outputBuffer, 0, outSamples * thread.info.getByteCount());
+            auto& thread = audioThread;
+
+            // Flush the audio resampler and buffers when the playback is
+            // reset. The audio callback discards the samples in the ring
+            // buffer, and nothing more is written until it has done so.
+            if (reset)
+            {
+                if (thread.resample)
+                {
+                    thread.resample->flush();
+                }
+                thread.silence.reset();
+                thread.buffer.clear();
+                thread.outputFrame = 0;
+                thread.backwardsSamples = std::numeric_limits<size_t>::max();
+                audioCallback.reset.fetch_add(1, std::memory_order_release);
+            }
+            if (audioCallback.resetAck.load(std::memory_order_acquire) !=
+                audioCallback.reset.load(std::memory_order_relaxed))
+                return;
 
             switch (playback)
             {
             case Playback::Forward:
             case Playback::Reverse:
             {
-                // Flush the audio resampler and buffer when the RtAudio
-                // playback is reset.
-                if (reset)
-                {
-                    if (thread.resample)
-                    {
-                        thread.resample->flush();
-                    }
-                    thread.silence.reset();
-                    thread.buffer.clear();
-                    thread.rtAudioCurrentFrame = 0;
-                    thread.backwardsSamples =
-                        std::numeric_limits<size_t>::max();
-                }
-
-                const auto& inputInfo = p->ioInfo.audio;
+                const auto& inputInfo = ioInfo.audio;
                 const size_t inSampleRate = inputInfo.sampleRate;
                 const size_t outSampleRate =
                     thread.info.sampleRate * speedMultiplier;
@@ -154,7 +190,7 @@ namespace tl
                 // Fill the audio buffer.
                 if (inputInfo.sampleRate <= 0 ||
                     playbackStartTime == time::invalidTime)
-                    return 0;
+                    return;
 
                 const bool backwards = playback == Playback::Reverse;
                 if (!thread.silence)
@@ -164,9 +200,26 @@ namespace tl
                     thread.silence->zero();
                 }
 
+                // Skip the samples the audio callback was short, so the
+                // audio does not fall behind the video after an underrun
+                // or while the ring buffer is first being filled.
+                if (const size_t underrun = thread.ringBuffer->takeUnderrun())
+                {
+                    audio::discard(thread.buffer, underrun);
+                    thread.outputFrame += underrun;
+                }
+
+                // Keep half of the ring buffer filled.
+                const size_t targetSampleCount =
+                    thread.ringBuffer->getCapacity() / 2;
+                if (thread.ringBuffer->getReadAvailable() +
+                        audio::getSampleCount(thread.buffer) >=
+                    targetSampleCount)
+                    return;
+
                 const int64_t playbackStartFrame =
                     playbackStartTime.rescaled_to(inSampleRate).value() -
-                    p->timeline->getTimeRange()
+                    timeline->getTimeRange()
                         .start_time()
                         .rescaled_to(inSampleRate)
                         .value() -
@@ -177,7 +230,7 @@ namespace tl
                     audio::getSampleCount(thread.buffer);
                 const auto& timeOffset =
                     otime::RationalTime(
-                        thread.rtAudioCurrentFrame + bufferSampleCount,
+                        thread.outputFrame + bufferSampleCount,
                         outSampleRate)
                         .rescaled_to(inSampleRate);
 
@@ -198,8 +251,8 @@ namespace tl
 
 #if CHECK_AUDIO
                 std::cerr << "TIM seconds:     " << seconds << std::endl;
-                std::cerr << "TIM rtAudioCurrentFrame: "
-                          << thread.rtAudioCurrentFrame << std::endl;
+                std::cerr << "TIM outputFrame: " << thread.outputFrame
+                          << std::endl;
                 std::cerr << "TIM playbackStartTime: " << playbackStartTime
                           << std::endl;
                 std::cerr << "TIM playbackStartFrame: " << playbackStartFrame
@@ -215,7 +268,9 @@ namespace tl
                 std::cerr << "TIM frame:       " << frame   << std::endl;
 #endif
 
-                while (audio::getSampleCount(thread.buffer) < outSamples)
+                while (thread.ringBuffer->getReadAvailable() +
+                           audio::getSampleCount(thread.buffer) <
+                       targetSampleCount)
                 {
 #if CHECK_AUDIO
                     std::cout << "\tseconds: " << seconds << std::endl;
@@ -223,9 +278,9 @@ namespace tl
 #endif
                     AudioFrame audioFrame;
                     {
-                        std::unique_lock<std::mutex> lock(p->audioMutex.mutex);
-                        const auto j = p->audioMutex.cache.find(seconds);
-                        if (j != p->audioMutex.cache.end())
+                        std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                        const auto j = audioMutex.cache.find(seconds);
+                        if (j != audioMutex.cache.end())
                         {
                             audioFrame = j->second;
                         }
@@ -355,7 +410,7 @@ namespace tl
                     }
 
                     size_t inSamples = std::min(
-                        p->playerOptions.audioBufferFrameCount,
+                        playerOptions.audioBufferFrameCount,
                         static_cast<size_t>(inSampleRate - inOffsetSamples));
 
                     if (backwards)
@@ -413,30 +468,104 @@ namespace tl
                     }
                 }
 
-                // Send audio data to RtAudio.
-                const auto now = std::chrono::steady_clock::now();
-                if (defaultSpeed ==
-                        p->timeline->getTimeRange().duration().rate() &&
-                    !mute && now >= muteTimeout &&
-                    outSamples <= getSampleCount(thread.buffer))
+                // Write the audio data to the ring buffer.
+                const size_t sampleCount = std::min(
+                    thread.ringBuffer->getWriteAvailable(),
+                    audio::getSampleCount(thread.buffer));
+                if (sampleCount > 0)
                 {
-#    if CHECK_AUDIO
-                    std::cerr << "\t\t\tMOVE audio" << std::endl;
-#    endif
+                    const size_t byteCount =
+                        sampleCount * thread.info.getByteCount();
+                    if (thread.moveBuffer.size() < byteCount)
+                    {
+                        thread.moveBuffer.resize(byteCount);
+                    }
                     audio::move(
-                        thread.buffer, reinterpret_cast<uint8_t*>(outputBuffer),
-                        outSamples);
+                        thread.buffer, thread.moveBuffer.data(), sampleCount);
+                    thread.ringBuffer->write(
+                        thread.moveBuffer.data(), sampleCount);
+                    thread.outputFrame += sampleCount;
                 }
 
-                // Update the audio frame.
-                thread.rtAudioCurrentFrame += outSamples;
-
 #    if CHECK_AUDIO
                 std::cerr << "\t\t\tSEND seconds=" << seconds << std::endl
                           << "\t\t\tSEND inOffsetSamples " << inOffsetSamples
-                          << " outSamples=" << outSamples << std::endl;
+                          << " samples=" << sampleCount << std::endl;
 #    endif
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        int Player::Private::rtAudioCallback(
+            void* outputBuffer, void* inputBuffer, unsigned int outSamples,
+            double streamTime, RtAudioStreamStatus status, void* userData)
+        {
+            // This runs on the audio device thread, so it only reads atomic
+            // values and the ring buffer; it does not lock or allocate.
+            auto p = reinterpret_cast<Player::Private*>(userData);
+            auto& callback = p->audioCallback;
+            const size_t byteCount =
+                outSamples * p->audioThread.info.getByteCount();
+
+            // Zero output audio data.
+            std::memset(outputBuffer, 0, byteCount);
+
+            audio::RingBuffer* ringBuffer = p->audioThread.ringBuffer.get();
+            if (!ringBuffer)
+                return 0;
 
+            // Discard the samples written before the playback was reset.
+            const size_t reset = callback.reset.load(std::memory_order_acquire);
+            if (reset != callback.resetAck.load(std::memory_order_relaxed))
+            {
+                ringBuffer->discard();
+                callback.primed = false;
+                callback.resetAck.store(reset, std::memory_order_release);
+            }
+
+            if (status & RTAUDIO_OUTPUT_UNDERFLOW)
+            {
+                callback.underrunCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            switch (callback.playback.load(std::memory_order_relaxed))
+            {
+            case Playback::Forward:
+            case Playback::Reverse:
+            {
+                // Read the samples even when muted so the audio keeps in
+                // sync with the playback.
+                const size_t sampleCount = ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(outputBuffer), outSamples);
+                if (sampleCount < outSamples)
+                {
+                    // The audio thread skips the samples that were output
+                    // as silence.
+                    ringBuffer->addUnderrun(outSamples - sampleCount);
+
+                    // Only count underruns once the audio has started.
+                    if (callback.primed)
+                    {
+                        callback.underrunCount.fetch_add(
+                            1, std::memory_order_relaxed);
+                    }
+                }
+                else
+                {
+                    callback.primed = true;
+                }
+
+                const int64_t now =
+                    std::chrono::steady_clock::now().time_since_epoch().count();
+                if (callback.mute.load(std::memory_order_relaxed) ||
+                    now <
+                        callback.muteTimeout.load(std::memory_order_relaxed))
+                {
+                    std::memset(outputBuffer, 0, byteCount);
+                }
                 break;
             }
             default:
@@ -11,7 +11,13 @@ namespace tl
         {
             return videoPercentage == other.videoPercentage &&
                    videoFrames == other.videoFrames &&
-                   audioFrames == other.audioFrames;
+                   audioFrames == other.audioFrames &&
+                   videoByteCount == other.videoByteCount &&
+                   videoByteMax == other.videoByteMax &&
+                   audioUnderrunCount == other.audioUnderrunCount &&
+                   readAhead == other.readAhead &&
+                   decodeFPS == other.decodeFPS &&
+                   underrunSeconds == other.underrunSeconds;
         }
 
         inline bool
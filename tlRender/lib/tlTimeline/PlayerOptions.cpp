@@ -7,6 +7,9 @@
 #include <tlCore/Error.h>
 #include <tlCore/String.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace tl
 {
     namespace timeline
@@ -16,5 +19,66 @@ namespace tl
 
         TLRENDER_ENUM_IMPL(TimerMode, "System", "Audio");
         TLRENDER_ENUM_SERIALIZE_IMPL(TimerMode);
+
+        otime::RationalTime getAdaptiveReadAhead(
+            const otime::RationalTime& readAhead,
+            const otime::RationalTime& readBehind,
+            const otime::RationalTime& adaptiveMinimum,
+            const AdaptiveReadAheadState& state)
+        {
+            const double rate = state.inOutRange.duration().rate();
+            const double behindFrames = readBehind.rescaled_to(rate).value();
+            double frames = readAhead.rescaled_to(rate).value();
+
+            // Don't read ahead more than fits in the cache.
+            if (state.videoCacheMax > 0)
+            {
+                frames = std::min(
+                    frames,
+                    std::max(
+                        static_cast<double>(state.videoCacheMax) -
+                            behindFrames,
+                        1.0));
+            }
+
+            // Use the full read ahead when stopped, before the throughput
+            // has been measured, or when the whole in/out range fits so
+            // that looping plays from the cache.
+            const double inOutFrames = state.inOutRange.duration().value();
+            const double playbackFPS = Playback::Stop != state.playback
+                                           ? std::fabs(state.speed)
+                                           : 0.0;
+            if (playbackFPS <= 0.0 || state.decodeFPS <= 0.0 ||
+                inOutFrames <= frames + behindFrames)
+            {
+                return otime::RationalTime(std::floor(frames), rate);
+            }
+
+            // When the I/O keeps up only a small buffer is needed to absorb
+            // jitter. When it falls behind, buffer enough that the frames
+            // decoded during playback make up the rest of the way to the
+            // end of the in/out range.
+            double needed =
+                adaptiveMinimum.rescaled_to(1.0).value() * playbackFPS;
+            if (state.decodeFPS < playbackFPS)
+            {
+                double remaining = inOutFrames;
+                if (!state.loop)
+                {
+                    const double current =
+                        state.currentTime.rescaled_to(rate).value();
+                    remaining =
+                        Playback::Reverse == state.playback
+                            ? current - state.inOutRange.start_time().value()
+                            : state.inOutRange.end_time_inclusive().value() -
+                                  current;
+                }
+                needed = std::max(
+                    needed,
+                    remaining * (1.0 - state.decodeFPS / playbackFPS));
+            }
+            return otime::RationalTime(
+                std::max(std::floor(std::min(frames, needed)), 1.0), rate);
+        }
     } // namespace timeline
 } // namespace tl
@@ -48,10 +48,54 @@ namespace tl
             //! Cache read behind.
             otime::RationalTime readBehind = otime::RationalTime(0.5, 1.0);
 
+            //! Size the read ahead to the measured decode throughput and
+            //! playback speed. The read ahead above is used as the maximum,
+            //! and frames nearest to the current time are requested first.
+            bool adaptive = false;
+
+            //! Minimum adaptive read ahead.
+            otime::RationalTime adaptiveMinimum = otime::RationalTime(1.0, 1.0);
+
             bool operator==(const PlayerCacheOptions&) const;
             bool operator!=(const PlayerCacheOptions&) const;
         };
 
+        //! Player state used to size the adaptive read ahead.
+        struct AdaptiveReadAheadState
+        {
+            //! In/out range, in the timeline rate.
+            otime::TimeRange inOutRange = time::invalidTimeRange;
+
+            //! Current time.
+            otime::RationalTime currentTime = time::invalidTime;
+
+            //! Playback direction.
+            Playback playback = Playback::Stop;
+
+            //! Playback speed in frames per second.
+            double speed = 0.0;
+
+            //! Whether playback loops.
+            bool loop = false;
+
+            //! Measured decode throughput in frames per second, or zero if
+            //! it has not been measured.
+            double decodeFPS = 0.0;
+
+            //! Number of frames that fit in the video cache, or zero if it
+            //! is not known.
+            size_t videoCacheMax = 0;
+        };
+
+        //! Get the adaptive read ahead (see PlayerCacheOptions::adaptive),
+        //! in the rate of the in/out range. The result is never more than
+        //! the given read ahead.
+        otime::RationalTime getAdaptiveReadAhead(
+            const otime::RationalTime& readAhead,
+            const otime::RationalTime& readBehind,
+            const otime::RationalTime& adaptiveMinimum,
+            const AdaptiveReadAheadState&);
+
         //! Timeline player options.
         struct PlayerOptions
         {
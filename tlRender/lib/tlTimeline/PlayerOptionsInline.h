@@ -12,7 +12,9 @@ namespace tl
             return videoGB == other.videoGB &&
                    audioGB == other.audioGB &&
                    readAhead == other.readAhead &&
-                   readBehind == other.readBehind;
+                   readBehind == other.readBehind &&
+                   adaptive == other.adaptive &&
+                   adaptiveMinimum == other.adaptiveMinimum;
         }
 
         inline bool
@@ -8,6 +8,10 @@
 
 #include <tlCore/StringFormat.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace tl
 {
     namespace timeline
@@ -140,6 +144,11 @@ namespace tl
             }
             thread.videoRequests.clear();
             thread.audioRequests.clear();
+
+            // Cancelled requests never finish, so start a new measurement.
+            thread.decodeCount = 0;
+            thread.decodeBusy = std::chrono::duration<double>::zero();
+            thread.decodeTimer = std::chrono::steady_clock::now();
         }
 
         void Player::Private::clearCache()
@@ -155,17 +164,34 @@ namespace tl
             }
         }
 
-        size_t Player::Private::getVideoCacheMax() const
+        VideoCachePriority
+        Player::Private::getVideoCachePriorityOptions() const
         {
-            // This function returns the approximate number of video frames
-            // that can fit in the cache. Note that this doesn't take into
-            // account clips with different sizes or multiple tracks.
-            size_t byteCount = 0;
+            VideoCachePriority out;
+            out.currentTime = thread.currentTime;
+            out.inOutRange = thread.inOutRange;
+            out.readBehind = thread.readBehind;
+            out.reverse = CacheDirection::Reverse == thread.cacheDirection;
+            return out;
+        }
+
+        size_t Player::Private::getVideoFrameByteCount() const
+        {
+            // Use the average size of the cached frames, which accounts for
+            // clips with different sizes, multiple tracks, and planar
+            // images. Before anything is cached, estimate it from the I/O
+            // information.
+            if (thread.videoCache.getCount() > 0)
+            {
+                return thread.videoCache.getByteCount() /
+                       thread.videoCache.getCount();
+            }
+            size_t out = 0;
             const io::Info& videoInfo = timeline->getIOInfo();
             if (thread.videoLayer >= 0 &&
                 thread.videoLayer < static_cast<int>(videoInfo.video.size()))
             {
-                byteCount += videoInfo.video[thread.videoLayer].getByteCount();
+                out += videoInfo.video[thread.videoLayer].getByteCount();
 
                 // Add byte counts from timelines that are being compared.
                 for (size_t i = 0; i < thread.compare.size(); ++i)
@@ -177,11 +203,41 @@ namespace tl
                     if (compareLayer >= 0 &&
                         compareLayer < static_cast<int>(compareInfo.video.size()))
                     {
-                        byteCount += compareInfo.video[compareLayer].getByteCount();
+                        out += compareInfo.video[compareLayer].getByteCount();
                     }
                 }
             }
+            return out;
+        }
 
+        bool Player::Private::reserveVideoCache(const otime::RationalTime& time)
+        {
+            // The current frame is always allowed, even if it does not fit.
+            const size_t max = thread.cacheOptions.videoGB * memory::gigabyte;
+            if (0 == max || time == thread.currentTime)
+                return true;
+
+            // Make room by removing the cached frames that playback reaches
+            // after this one.
+            const size_t byteCount = getVideoFrameByteCount();
+            const VideoCachePriority priority =
+                getVideoCachePriorityOptions();
+            const double timePriority = getVideoCachePriority(time, priority);
+            while (thread.videoCache.getByteCount() +
+                       (thread.videoRequests.size() + 1) * byteCount >
+                   max)
+            {
+                if (!thread.videoCache.evict(timePriority, priority))
+                    return false;
+            }
+            return true;
+        }
+
+        size_t Player::Private::getVideoCacheMax() const
+        {
+            // This function returns the approximate number of video frames
+            // that can fit in the cache.
+            const size_t byteCount = getVideoFrameByteCount();
             return byteCount > 0 ?
                 ((thread.cacheOptions.videoGB * memory::gigabyte) / byteCount) :
                 0;
@@ -200,82 +256,168 @@ namespace tl
                 0;
         }
 
-        void Player::Private::reverseRequests(
-            const otime::RationalTime& start, const otime::RationalTime& end,
-            const otime::RationalTime& inc)
+        otime::RationalTime Player::Private::getAdaptiveReadAhead(
+            const otime::RationalTime& readAhead,
+            const otime::RationalTime& readBehind) const
         {
-            const otime::TimeRange& timeRange = timeline->getTimeRange();
-            for (auto time = start; time >= end; time -= inc)
+            const double rate = timeline->getTimeRange().duration().rate();
+            AdaptiveReadAheadState state;
+            state.inOutRange = otime::TimeRange(
+                thread.inOutRange.start_time().rescaled_to(rate),
+                thread.inOutRange.duration().rescaled_to(rate));
+            state.currentTime = thread.currentTime;
+            state.playback = thread.playback;
+            state.speed = thread.speed;
+            state.loop = loop->get() == Loop::Loop;
+            state.decodeFPS = thread.decodeFPS;
+            state.videoCacheMax = getVideoCacheMax();
+            return timeline::getAdaptiveReadAhead(
+                readAhead, readBehind, thread.cacheOptions.adaptiveMinimum,
+                state);
+        }
+
+        double Player::Private::getUnderrunSeconds() const
+        {
+            const double playbackFPS = Playback::Stop != thread.playback
+                                           ? std::fabs(thread.speed)
+                                           : 0.0;
+            if (playbackFPS <= 0.0 || thread.decodeFPS <= 0.0 ||
+                thread.decodeFPS >= playbackFPS)
+                return -1.0;
+
+            // Count the cached frames ahead of the current time.
+            const double rate = timeline->getTimeRange().duration().rate();
+            const size_t inOutFrames = static_cast<size_t>(
+                thread.inOutRange.duration().rescaled_to(rate).value());
+            const otime::RationalTime inc(
+                Playback::Reverse == thread.playback ? -1.0 : 1.0, rate);
+            const bool looping = loop->get() == Loop::Loop;
+            otime::RationalTime time = thread.currentTime.rescaled_to(rate);
+            size_t cached = 0;
+            while (cached < inOutFrames &&
+                   thread.videoCache.contains(time))
             {
-                const auto i = thread.videoCache.find(time);
-                if (i == thread.videoCache.end())
+                ++cached;
+                time += inc;
+                if (!thread.inOutRange.contains(time))
                 {
-                    const auto j = thread.videoRequests.find(time);
-                    if (j == thread.videoRequests.end())
+                    if (!looping)
                     {
-                        auto& request = thread.videoRequests[time];
-                        request.clear();
-                        io::Options ioOptions2 = thread.ioOptions;
-                        ioOptions2["Layer"] =
-                            string::Format("{0}").arg(thread.videoLayer);
-                        request.push_back(timeline->getVideo(time, ioOptions2));
-                        for (size_t i = 0; i < thread.compare.size(); ++i)
-                        {
-                            const otime::RationalTime time2 =
-                                timeline::getCompareTime(
-                                    time, timeRange,
-                                    thread.compare[i]->getTimeRange(),
-                                    thread.compareTime);
-                            ioOptions2["Layer"] = string::Format("{0}").arg(
-                                i < thread.compareVideoLayers.size()
-                                    ? thread.compareVideoLayers[i]
-                                    : thread.videoLayer);
-                            request.push_back(
-                                thread.compare[i]->getVideo(time2, ioOptions2));
-                        }
+                        // Everything up to the end of playback is cached.
+                        return -1.0;
                     }
+                    time = timeline::loop(time, thread.inOutRange);
                 }
             }
+            if (cached >= inOutFrames)
+                return -1.0;
+            return cached / (playbackFPS - thread.decodeFPS);
+        }
+
+        bool Player::Private::requestVideo(
+            const otime::RationalTime& time, const bool clearFrame)
+        {
+            if (thread.videoCache.contains(time) ||
+                thread.videoRequests.find(time) != thread.videoRequests.end())
+                return true;
+            if (!reserveVideoCache(time))
+                return false;
+            const otime::TimeRange& timeRange = timeline->getTimeRange();
+            auto& request = thread.videoRequests[time];
+            request.clear();
+            io::Options ioOptions2 = thread.ioOptions;
+            ioOptions2["Layer"] = string::Format("{0}").arg(thread.videoLayer);
+            if (clearFrame)
+                ioOptions2["ClearFrame"] = "1";
+            request.push_back(timeline->getVideo(time, ioOptions2));
+            for (size_t i = 0; i < thread.compare.size(); ++i)
+            {
+                const otime::RationalTime time2 = timeline::getCompareTime(
+                    time, timeRange, thread.compare[i]->getTimeRange(),
+                    thread.compareTime);
+                ioOptions2["Layer"] = string::Format("{0}").arg(
+                    i < thread.compareVideoLayers.size()
+                        ? thread.compareVideoLayers[i]
+                        : thread.videoLayer);
+                request.push_back(
+                    thread.compare[i]->getVideo(time2, ioOptions2));
+            }
+            return true;
+        }
+
+        void Player::Private::reverseRequests(
+            const otime::RationalTime& start, const otime::RationalTime& end,
+            const otime::RationalTime& inc)
+        {
+            for (auto time = start; time >= end; time -= inc)
+            {
+                requestVideo(time);
+            }
         }
 
         void Player::Private::forwardRequests(
             const otime::RationalTime& start, const otime::RationalTime& end,
             const otime::RationalTime& inc, const bool clearFrame)
         {
-            const otime::TimeRange& timeRange = timeline->getTimeRange();
             for (otime::RationalTime time = start; time <= end; time += inc)
             {
-                const auto i = thread.videoCache.find(time);
-                if (i == thread.videoCache.end())
+                requestVideo(time, clearFrame);
+            }
+        }
+
+        void Player::Private::priorityRequests(
+            const std::vector<otime::TimeRange>& ranges)
+        {
+            const VideoCachePriority priority =
+                getVideoCachePriorityOptions();
+            std::vector<std::pair<double, otime::RationalTime> > times;
+            for (const auto& range : ranges)
+            {
+                const otime::RationalTime inc(1.0, range.duration().rate());
+                for (auto time = range.start_time();
+                     time <= range.end_time_inclusive(); time += inc)
                 {
-                    const auto j = thread.videoRequests.find(time);
-                    if (j == thread.videoRequests.end())
+                    if (!thread.videoCache.contains(time) &&
+                        thread.videoRequests.find(time) ==
+                            thread.videoRequests.end())
                     {
-                        auto& request = thread.videoRequests[time];
-                        request.clear();
-                        io::Options ioOptions2 = thread.ioOptions;
-                        ioOptions2["Layer"] =
-                            string::Format("{0}").arg(thread.videoLayer);
-                        if (clearFrame)
-                            ioOptions2["ClearFrame"] = "1";
-                        request.push_back(timeline->getVideo(time, ioOptions2));
-                        for (size_t i = 0; i < thread.compare.size(); ++i)
-                        {
-                            const otime::RationalTime time2 =
-                                timeline::getCompareTime(
-                                    time, timeRange,
-                                    thread.compare[i]->getTimeRange(),
-                                    thread.compareTime);
-                            ioOptions2["Layer"] = string::Format("{0}").arg(
-                                i < thread.compareVideoLayers.size()
-                                    ? thread.compareVideoLayers[i]
-                                    : thread.videoLayer);
-                            request.push_back(
-                                thread.compare[i]->getVideo(time2, ioOptions2));
-                        }
+                        times.push_back(std::make_pair(
+                            getVideoCachePriority(time, priority), time));
                     }
                 }
             }
+            std::stable_sort(
+                times.begin(), times.end(),
+                [](const std::pair<double, otime::RationalTime>& a,
+                   const std::pair<double, otime::RationalTime>& b)
+                { return a.first < b.first; });
+            for (const auto& i : times)
+            {
+                // The frames are sorted, so if one does not fit in the cache
+                // the rest will not either.
+                if (!requestVideo(i.second))
+                    break;
+            }
+        }
+
+        void Player::Private::measureDecode()
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (!thread.videoRequests.empty())
+            {
+                thread.decodeBusy += now - thread.decodeTimer;
+            }
+            thread.decodeTimer = now;
+            if (thread.decodeBusy.count() >= .5)
+            {
+                const double fps =
+                    thread.decodeCount / thread.decodeBusy.count();
+                thread.decodeFPS = thread.decodeFPS > 0.0
+                                       ? thread.decodeFPS * .7 + fps * .3
+                                       : fps;
+                thread.decodeCount = 0;
+                thread.decodeBusy = std::chrono::duration<double>::zero();
+            }
         }
 
         void Player::Private::finishedVideoRequests()
@@ -298,8 +440,7 @@ namespace tl
                 if (ready)
                 {
                     const otime::RationalTime time = videoRequestsIt->first;
-                    auto& videoCache = thread.videoCache[time];
-                    videoCache.clear();
+                    std::vector<VideoFrame> videoFrames;
                     for (auto videoRequestIt =
                              videoRequestsIt->second.begin();
                          videoRequestIt !=
@@ -308,8 +449,10 @@ namespace tl
                     {
                         auto videoFrame = videoRequestIt->future.get();
                         videoFrame.time = time;
-                        videoCache.push_back(videoFrame);
+                        videoFrames.push_back(videoFrame);
                     }
+                    thread.videoCache.add(time, videoFrames);
+                    ++thread.decodeCount;
                     videoRequestsIt =
                         thread.videoRequests.erase(videoRequestsIt);
                 }
@@ -318,6 +461,16 @@ namespace tl
                     ++videoRequestsIt;
                 }
             }
+
+            // The requests were made with an estimate of the frame size, so
+            // the finished frames may not fit. Only the current frame is
+            // kept when nothing else does.
+            const size_t max = thread.cacheOptions.videoGB * memory::gigabyte;
+            const VideoCachePriority priority =
+                getVideoCachePriorityOptions();
+            while (max > 0 && thread.videoCache.getByteCount() > max &&
+                   thread.videoCache.evict(0.0, priority))
+                ;
         }
 
 
@@ -352,20 +505,27 @@ namespace tl
         {
             // Get the video ranges to be cached.
             const otime::TimeRange& timeRange = timeline->getTimeRange();
-            const otime::RationalTime readAheadDivided(
+            const otime::RationalTime readBehindDivided(
+                thread.cacheOptions.readBehind.value() /
+                    static_cast<double>(1 + thread.compare.size()),
+                thread.cacheOptions.readBehind.rate());
+            otime::RationalTime readAheadDivided(
                 thread.cacheOptions.readAhead.value() /
                     static_cast<double>(1 + thread.compare.size()),
                 thread.cacheOptions.readAhead.rate());
+            if (thread.cacheOptions.adaptive)
+            {
+                readAheadDivided =
+                    getAdaptiveReadAhead(readAheadDivided, readBehindDivided);
+            }
+            thread.readAhead = readAheadDivided;
             const otime::RationalTime readAheadRescaled =
                 readAheadDivided.rescaled_to(timeRange.duration().rate())
                     .floor();
-            const otime::RationalTime readBehindDivided(
-                thread.cacheOptions.readBehind.value() /
-                    static_cast<double>(1 + thread.compare.size()),
-                thread.cacheOptions.readBehind.rate());
             const otime::RationalTime readBehindRescaled =
                 readBehindDivided.rescaled_to(timeRange.duration().rate())
                     .floor();
+            thread.readBehind = readBehindRescaled;
             otime::TimeRange videoRange = time::invalidTimeRange;
             switch (thread.cacheDirection)
             {
@@ -469,23 +629,23 @@ namespace tl
                 audioRange, inOutAudioRange, thread.cacheDirection);
 
             // Remove old video from the cache.
-            auto videoCacheIt = thread.videoCache.begin();
-            while (videoCacheIt != thread.videoCache.end())
+            std::vector<otime::RationalTime> oldVideo;
+            for (const auto& i : thread.videoCache.getFrames())
             {
-                const otime::RationalTime t = videoCacheIt->first;
+                const otime::RationalTime t = i.first;
                 const auto j = std::find_if(
                     videoRanges.begin(), videoRanges.end(),
                     [t](const otime::TimeRange& value)
                     { return value.contains(t); });
                 if (j == videoRanges.end())
                 {
-                    videoCacheIt = thread.videoCache.erase(videoCacheIt);
-                }
-                else
-                {
-                    ++videoCacheIt;
+                    oldVideo.push_back(t);
                 }
             }
+            for (const auto& t : oldVideo)
+            {
+                thread.videoCache.remove(t);
+            }
 
             // Remove old audio from the cache.
             {
@@ -515,7 +675,11 @@ namespace tl
             }
 
             // Get uncached video.
-            if (!ioInfo.video.empty())
+            if (!ioInfo.video.empty() && thread.cacheOptions.adaptive)
+            {
+                priorityRequests(videoRanges);
+            }
+            else if (!ioInfo.video.empty())
             {
                 for (const auto& range : videoRanges)
                 {
@@ -632,6 +796,7 @@ namespace tl
                 }*/
             }
 
+            measureDecode();
             finishedVideoRequests();
             finishedAudioRequests();
 
@@ -646,7 +811,7 @@ namespace tl
                 const size_t audioCacheMax = getAudioCacheMax();
 
                 std::vector<otime::RationalTime> videoCacheFrames;
-                for (const auto& i : thread.videoCache)
+                for (const auto& i : thread.videoCache.getFrames())
                 {
                     videoCacheFrames.push_back(i.first);
                 }
@@ -695,6 +860,13 @@ namespace tl
                     mutex.cacheInfo.audioPercentage = audioCachePercentage;
                     mutex.cacheInfo.videoFrames = cachedVideoRanges;
                     mutex.cacheInfo.audioFrames = cachedAudioRanges;
+                    mutex.cacheInfo.videoByteCount =
+                        thread.videoCache.getByteCount();
+                    mutex.cacheInfo.videoByteMax =
+                        thread.cacheOptions.videoGB * memory::gigabyte;
+                    mutex.cacheInfo.readAhead = thread.readAhead;
+                    mutex.cacheInfo.decodeFPS = thread.decodeFPS;
+                    mutex.cacheInfo.underrunSeconds = getUnderrunSeconds();
                 }
             }
         }
@@ -789,25 +961,30 @@ namespace tl
                         "    In/out range: {2}\n"
                         "    I/O options: {3}\n"
                         "    Cache: {4} read ahead, {5} read behind\n"
-                        "    Video: {6} requests, {7} cached\n"
-                        "    Audio: {8} requests, {9} cached\n"
-                        "    {10}\n"
+                        "    Video: {6} requests, {7} cached, {8} decode FPS, {14}MB\n"
+                        "    Audio: {9} requests, {10} cached\n"
                         "    {11}\n"
                         "    {12}\n"
+                        "    {13}\n"
                         "    (T=current time, V=cached video, A=cached audio)")
                         .arg(timeline->getPath().get())
                         .arg(currentTime)
                         .arg(inOutRange)
                         .arg(string::join(ioOptionStrings, ", "))
-                        .arg(cacheOptions->get().readAhead)
+                        .arg(
+                            time::isValid(cacheInfo.readAhead)
+                                ? cacheInfo.readAhead
+                                : cacheOptions->get().readAhead)
                         .arg(cacheOptions->get().readBehind)
                         .arg(thread.videoRequests.size())
-                        .arg(thread.videoCache.size())
+                        .arg(thread.videoCache.getCount())
+                        .arg(cacheInfo.decodeFPS, 2)
                         .arg(thread.audioRequests.size())
                         .arg(audioFrameCacheSize)
                         .arg(currentTimeDisplay)
                         .arg(videoCacheFramesDisplay)
-                        .arg(audioCacheFramesDisplay));
+                        .arg(audioCacheFramesDisplay)
+                        .arg(cacheInfo.videoByteCount / memory::megabyte));
         }
     } // namespace timeline
 } // namespace tl
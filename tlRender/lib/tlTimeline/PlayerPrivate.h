@@ -7,8 +7,10 @@
 #include <tlTimeline/Player.h>
 
 #include <tlTimeline/Util.h>
+#include <tlTimeline/VideoCache.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 #include <tlCore/LRUCache.h>
 
 #if defined(TLRENDER_AUDIO)
@@ -27,6 +29,8 @@ namespace tl
         {
             otime::RationalTime loopPlayback(const otime::RationalTime&);
 
+            bool requestVideo(
+                const otime::RationalTime&, const bool clearFrame = false);
             void reverseRequests(
                 const otime::RationalTime& start,
                 const otime::RationalTime& end, const otime::RationalTime& inc);
@@ -34,17 +38,28 @@ namespace tl
                 const otime::RationalTime& start,
                 const otime::RationalTime& end, const otime::RationalTime& inc,
                 const bool clearFrame = false);
+            void priorityRequests(const std::vector<otime::TimeRange>&);
             void clearRequests();
             void clearCache();
+            VideoCachePriority getVideoCachePriorityOptions() const;
+            size_t getVideoFrameByteCount() const;
+            bool reserveVideoCache(const otime::RationalTime&);
             size_t getVideoCacheMax() const;
             size_t getAudioCacheMax() const;
+            otime::RationalTime getAdaptiveReadAhead(
+                const otime::RationalTime& readAhead,
+                const otime::RationalTime& readBehind) const;
+            double getUnderrunSeconds() const;
             void cacheUpdate();
 
+            void measureDecode();
             void finishedVideoRequests();
             void finishedAudioRequests();
 
             void resetAudioTime();
 #if defined(TLRENDER_AUDIO)
+            void audioThreadStart(size_t bufferFrameCount);
+            void audioMix();
             static int rtAudioCallback(
                 void* outputBuffer, void* inputBuffer, unsigned int nFrames,
                 double streamTime, RtAudioStreamStatus status, void* userData);
@@ -144,11 +159,22 @@ namespace tl
                 double audioOffset = 0.0;
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 PlayerCacheOptions cacheOptions;
+                double speed = 0.0;
+
+                // Video decode throughput, measured only while there are
+                // requests in flight so that a full cache does not look like
+                // slow I/O.
+                size_t decodeCount = 0;
+                std::chrono::duration<double> decodeBusy =
+                    std::chrono::duration<double>::zero();
+                std::chrono::steady_clock::time_point decodeTimer;
+                double decodeFPS = 0.0;
+                otime::RationalTime readAhead = time::invalidTime;
+                otime::RationalTime readBehind = time::invalidTime;
 
                 std::map<otime::RationalTime, std::vector<VideoRequest> >
                     videoRequests;
-                std::map<otime::RationalTime, std::vector<VideoFrame> >
-                    videoCache;
+                VideoCache videoCache;
 #if defined(TLRENDER_AUDIO)
                 std::unique_ptr<RtAudio> rtAudio;
 #endif // TLRENDER_AUDIO
@@ -160,16 +186,46 @@ namespace tl
             };
             Thread thread;
 
+            // Mixes and resamples the audio ahead of the audio callback into
+            // the ring buffer.
             struct AudioThread
             {
                 audio::Info info;
                 std::shared_ptr<audio::AudioResample> resample;
                 std::list<std::shared_ptr<audio::Audio> > buffer;
                 std::shared_ptr<audio::Audio> silence;
-                size_t rtAudioCurrentFrame = 0;
+                std::shared_ptr<audio::RingBuffer> ringBuffer;
+                std::vector<uint8_t> moveBuffer;
+                size_t outputFrame = 0;
                 size_t backwardsSamples = std::numeric_limits<size_t>::max();
+                std::chrono::microseconds sleepTimeout =
+                    std::chrono::microseconds(1000);
+                std::atomic<bool> running;
+                std::thread thread;
             };
             AudioThread audioThread;
+
+            // Values shared with the audio callback. The callback does not
+            // lock or allocate, so the player state is published with
+            // atomics.
+            struct AudioCallback
+            {
+                std::atomic<Playback> playback{Playback::Stop};
+                std::atomic<bool> mute{false};
+                std::atomic<int64_t> muteTimeout{0};
+
+                // Incremented by the audio thread when the playback is
+                // reset, and acknowledged by the callback once it has
+                // discarded the samples in the ring buffer.
+                std::atomic<size_t> reset{0};
+                std::atomic<size_t> resetAck{0};
+
+                std::atomic<size_t> underrunCount{0};
+
+                // Only used by the callback.
+                bool primed = false;
+            };
+            AudioCallback audioCallback;
         };
     } // namespace timeline
 } // namespace tl
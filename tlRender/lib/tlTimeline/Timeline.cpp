@@ -19,7 +19,14 @@ namespace tl
     {
         namespace
         {
-            const size_t readCacheMax = 10;
+            //! Readers that have not been used for this long release their
+            //! buffers.
+            const std::chrono::seconds readIdleTimeout(10);
+
+            //! Readers used within this time are not asked to release their
+            //! buffers when the memory budget is exceeded, since they are
+            //! likely being played.
+            const std::chrono::seconds readActiveTime(1);
         }
 
         TLRENDER_ENUM_IMPL(
@@ -187,6 +194,9 @@ namespace tl
                    videoRequestCount == other.videoRequestCount &&
                    audioRequestCount == other.audioRequestCount &&
                    requestTimeout == other.requestTimeout &&
+                   readerCount == other.readerCount &&
+                   readerByteCount == other.readerByteCount &&
+                   readAheadClipCount == other.readAheadClipCount &&
                    ioOptions == other.ioOptions &&
                    pathOptions == other.pathOptions;
         }
@@ -264,7 +274,7 @@ namespace tl
                 }
             }
             p.options = options;
-            p.readCache.setMax(readCacheMax);
+            p.readCache.setMax(std::max(p.options.readerCount, size_t(1)));
 
             // Get information about the timeline.
             for (const auto& i : p.otioTimeline.value->tracks()->children())
@@ -324,6 +334,20 @@ namespace tl
                 .arg(p.ioInfo.audio.dataType)
                 .arg(p.ioInfo.audio.sampleRate));
 
+            // Wake the request thread when one of our readers finishes a
+            // request.
+            p.ioThreadPool = io::ThreadPool::getGlobal();
+            p.ioRequestCallback =
+                [this]
+                {
+                    TLRENDER_P();
+                    {
+                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                        p.mutex.ioCompleted = true;
+                    }
+                    p.thread.cv.notify_one();
+                };
+
             // Create a new thread.
             p.mutex.otioTimeline = p.otioTimeline;
             p.thread.running = true;
@@ -337,6 +361,21 @@ namespace tl
                             _tick();
                         }
                         _finishRequests();
+
+                        // Wait for the readers being opened in the
+                        // background, since they may reference memory owned
+                        // by the timeline.
+                        std::unique_lock<std::mutex> lock(p.readMutex);
+                        for (const auto& i : p.readOpens)
+                        {
+                            i.second.wait();
+                        }
+                        p.readOpens.clear();
+
+                        // Destroy the readers while the timeline is still
+                        // valid, they wait for their requests to finish and
+                        // those call the request callback.
+                        p.readCache.clear();
                     });
         }
 
@@ -551,6 +590,15 @@ namespace tl
             return out;
         }
 
+        VideoRequest Timeline::getVideo(
+            const otime::RationalTime& time,
+            const io::FrameRequest& frameRequest, const io::Options& options)
+        {
+            io::Options options2 = options;
+            io::setFrameRequest(options2, frameRequest);
+            return getVideo(time, options2);
+        }
+
         AudioRequest
         Timeline::getAudio(double seconds, const io::Options& options)
         {
@@ -642,6 +690,9 @@ namespace tl
             std::list<std::shared_ptr<Private::PendingAudioRequest> > newAudioRequests;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                // Sequence readers wake us through the request callback as
+                // soon as a frame is read. The timeout covers readers that
+                // have their own threads.
                 p.thread.cv.wait_for(
                     lock, p.options.requestTimeout,
                     [this]
@@ -649,14 +700,19 @@ namespace tl
                         TLRENDER_P();
 
                         return p.mutex.otioTimeline.value ||
-                               !p.mutex.videoRequests.empty() ||
-                               !p.thread.videoRequestsInProgress.empty() ||
-                               !p.mutex.audioRequests.empty() ||
-                               !p.thread.audioRequestsInProgress.empty();
+                               (!p.mutex.videoRequests.empty() &&
+                                p.thread.videoRequestsInProgress.size() <
+                                    p.options.videoRequestCount) ||
+                               (!p.mutex.audioRequests.empty() &&
+                                p.thread.audioRequestsInProgress.size() <
+                                    p.options.audioRequestCount) ||
+                               p.mutex.ioCompleted;
                     });
+                p.mutex.ioCompleted = false;
                 if (p.mutex.otioTimeline.value)
                 {
                     p.thread.otioTimeline = p.mutex.otioTimeline;
+                    p.thread.readAheadTracksValid = false;
                     p.mutex.otioTimeline = nullptr;
                     p.mutex.otioTimelineChanged = true;
                 }
@@ -1012,6 +1068,19 @@ namespace tl
                 p.thread.audioRequestsInProgress.push_back(request);
             }
 
+            // Open the readers for the clips past the new requests.
+            if (!newVideoRequests.empty())
+            {
+                _readAhead(newVideoRequests.back()->time);
+            }
+            else if (!newAudioRequests.empty())
+            {
+                _readAhead(
+                    otime::RationalTime(newAudioRequests.back()->seconds, 1.0)
+                        .rescaled_to(p.timeRange.duration().rate()));
+            }
+            _readCacheUpdate();
+
             // Check for finished video requests.
             auto videoRequestIt = p.thread.videoRequestsInProgress.begin();
             while (videoRequestIt != p.thread.videoRequestsInProgress.end())
@@ -1091,8 +1160,68 @@ namespace tl
                 p.path.getDirectory(),
                 p.options.pathOptions);
             const std::string key = getKey(path);
-            if (!p.readCache.get(key, out))
+            std::shared_ptr<Private::ReadItem> item;
+            std::shared_future<std::shared_ptr<io::IRead> > open;
+            {
+                std::unique_lock<std::mutex> lock(p.readMutex);
+                if (!p.readCache.get(key, item))
+                {
+                    const auto i = p.readOpens.find(key);
+                    if (i != p.readOpens.end())
+                    {
+                        open = i->second;
+                    }
+                }
+                if (item)
+                {
+                    item->used = std::chrono::steady_clock::now();
+                    item->released = false;
+                    out = item->read;
+                }
+            }
+            if (!item && open.valid())
+            {
+                // Wait for the reader being opened in the background. It is
+                // a high priority task, so it does not wait behind the
+                // decoding tasks in the I/O thread pool. The lock is not
+                // held while waiting, so the other threads using the cache
+                // are not blocked.
+                std::shared_ptr<io::IRead> read;
+                try
+                {
+                    read = open.get();
+                }
+                catch (const std::exception&)
+                {
+                    // The reader is opened again below, which reports the
+                    // error.
+                }
+                if (read)
+                {
+                    std::unique_lock<std::mutex> lock(p.readMutex);
+                    const auto i = p.readOpens.find(key);
+                    if (i != p.readOpens.end() &&
+                        i->second.wait_for(std::chrono::seconds(0)) ==
+                        std::future_status::ready)
+                    {
+                        p.readOpens.erase(i);
+                    }
+                    if (!p.readCache.get(key, item))
+                    {
+                        item = std::make_shared<Private::ReadItem>();
+                        item->read = read;
+                        p.readCache.add(key, item);
+                    }
+                    item->used = std::chrono::steady_clock::now();
+                    item->released = false;
+                    out = item->read;
+                }
+            }
+            if (!item)
             {
+                // Open the reader here when it is not being opened in the
+                // background. The lock is not held while opening, so the
+                // other threads using the cache are not blocked by the I/O.
                 if (auto context = p.context.lock())
                 {
                     const auto memoryRead = getMemoryRead(mediaReference);
@@ -1100,13 +1229,243 @@ namespace tl
                     options["SequenceIO/DefaultSpeed"] =
                         string::Format("{0}").arg(p.timeRange.duration().rate());
                     const auto ioSystem = context->getSystem<io::System>();
-                    out = ioSystem->read(path, memoryRead, options);
-                    p.readCache.add(key, out);
+                    auto read = ioSystem->read(path, memoryRead, options);
+                    if (read)
+                    {
+                        read->setRequestCallback(p.ioRequestCallback);
+                    }
+                    std::unique_lock<std::mutex> lock(p.readMutex);
+                    if (!p.readCache.get(key, item))
+                    {
+                        item = std::make_shared<Private::ReadItem>();
+                        item->read = read;
+                        p.readCache.add(key, item);
+                    }
+                    item->used = std::chrono::steady_clock::now();
+                    item->released = false;
+                    out = item->read;
                 }
             }
             return out;
         }
 
+        void Timeline::_openRead(
+            const otio::MediaReference* mediaReference,
+            const io::Options& ioOptions)
+        {
+            TLRENDER_P();
+            if (p.unavailableMediaReferences.find(mediaReference) !=
+                p.unavailableMediaReferences.end())
+            {
+                return;
+            }
+            auto context = p.context.lock();
+            if (!context)
+            {
+                return;
+            }
+            const auto path = timeline::getPath(
+                mediaReference,
+                p.path.getDirectory(),
+                p.options.pathOptions);
+            const std::string key = getKey(path);
+            std::unique_lock<std::mutex> lock(p.readMutex);
+            if (p.readCache.contains(key) ||
+                p.readOpens.find(key) != p.readOpens.end())
+            {
+                return;
+            }
+
+            // Readers open their files in their own threads or when data is
+            // first requested, so the cost here is the plugin lookup and
+            // creating the reader, and this keeps both off the request
+            // thread.
+            const auto memoryRead = getMemoryRead(mediaReference);
+            io::Options options = ioOptions;
+            options["SequenceIO/DefaultSpeed"] =
+                string::Format("{0}").arg(p.timeRange.duration().rate());
+            const auto ioSystem = context->getSystem<io::System>();
+            auto promise =
+                std::make_shared<std::promise<std::shared_ptr<io::IRead> > >();
+            p.readOpens[key] = promise->get_future().share();
+            const auto requestCallback = p.ioRequestCallback;
+            p.ioThreadPool->submit(
+                [promise, ioSystem, path, memoryRead, options, requestCallback]
+                {
+                    try
+                    {
+                        auto read = ioSystem->read(path, memoryRead, options);
+                        if (read)
+                        {
+                            read->setRequestCallback(requestCallback);
+                        }
+                        promise->set_value(read);
+                    }
+                    catch (...)
+                    {
+                        promise->set_exception(std::current_exception());
+                    }
+                },
+                nullptr, io::ThreadPoolPriority::High);
+        }
+
+        void Timeline::_readAhead(const otime::RationalTime& time)
+        {
+            TLRENDER_P();
+
+            // Follow the direction of the requests, so that playing in
+            // reverse opens the previous clips.
+            const bool forward =
+                !time::isValid(p.thread.readAheadTime) ||
+                time >= p.thread.readAheadTime;
+            p.thread.readAheadTime = time;
+            if (0 == p.options.readAheadClipCount)
+                return;
+
+            if (!p.thread.readAheadTracksValid)
+            {
+                // The ranges of all of the children are computed together,
+                // since computing them one at a time is quadratic in the
+                // number of children.
+                p.thread.readAheadTracks.clear();
+                for (const auto& i :
+                     p.thread.otioTimeline->tracks()->children())
+                {
+                    auto otioTrack = dynamic_cast<const otio::Track*>(i.value);
+                    if (!otioTrack || !otioTrack->enabled())
+                        continue;
+                    otio::ErrorStatus errorStatus;
+                    const auto ranges =
+                        otioTrack->range_of_all_children(&errorStatus);
+                    std::vector<otime::TimeRange> childRanges;
+                    for (const auto& child : otioTrack->children())
+                    {
+                        // A child without a range gets an empty one, which
+                        // keeps the indices of the children.
+                        otime::TimeRange range;
+                        const auto j = ranges.find(child.value);
+                        if (j != ranges.end())
+                        {
+                            range = j->second;
+                        }
+                        else if (!childRanges.empty())
+                        {
+                            range = otime::TimeRange(
+                                childRanges.back().start_time(),
+                                otime::RationalTime());
+                        }
+                        childRanges.push_back(range);
+                    }
+                    Private::Thread::ReadAheadTrack track;
+                    track.track = otioTrack;
+                    track.index = TrackIndex(childRanges);
+                    p.thread.readAheadTracks.push_back(track);
+                }
+                p.thread.readAheadTracksValid = true;
+            }
+
+            const auto requestTime = time - p.timeRange.start_time();
+            for (const auto& track : p.thread.readAheadTracks)
+            {
+                const otio::Track* otioTrack = track.track;
+                const bool video =
+                    otio::Track::Kind::video == otioTrack->kind();
+                const auto& children = otioTrack->children();
+                const int64_t size = static_cast<int64_t>(children.size());
+                const int64_t index = track.index.find(requestTime);
+                if (index < 0)
+                    continue;
+
+                size_t count = 0;
+                const int64_t step = forward ? 1 : -1;
+                for (int64_t j = index + step;
+                     j >= 0 && j < size && count < p.options.readAheadClipCount;
+                     j += step)
+                {
+                    if (auto otioClip =
+                        dynamic_cast<const otio::Clip*>(children[j].value))
+                    {
+                        io::Options options = p.options.ioOptions;
+                        if (video)
+                        {
+                            options["USD/cameraName"] = otioClip->name();
+                        }
+                        _openRead(p.mediaReference(otioClip), options);
+                        ++count;
+                    }
+                }
+            }
+        }
+
+        void Timeline::_readCacheUpdate()
+        {
+            TLRENDER_P();
+            const auto now = std::chrono::steady_clock::now();
+            std::unique_lock<std::mutex> lock(p.readMutex);
+
+            // Move the readers that have been opened in the background into
+            // the cache.
+            auto i = p.readOpens.begin();
+            while (i != p.readOpens.end())
+            {
+                if (i->second.wait_for(std::chrono::seconds(0)) !=
+                    std::future_status::ready)
+                {
+                    ++i;
+                    continue;
+                }
+                try
+                {
+                    auto read = i->second.get();
+                    if (!p.readCache.contains(i->first))
+                    {
+                        auto item = std::make_shared<Private::ReadItem>();
+                        item->read = read;
+                        item->used = now;
+                        p.readCache.add(i->first, item);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // The reader is opened again, and the error reported,
+                    // when the clip is read.
+                }
+                i = p.readOpens.erase(i);
+            }
+
+            // Readers that have not been used recently release their
+            // buffers, as do the least recently used readers while the
+            // memory budget is exceeded. They stay open, so that reading
+            // from them again does not need to open the file and probe the
+            // streams.
+            const auto items = p.readCache.getValues();
+            std::vector<size_t> byteCounts;
+            size_t byteCount = 0;
+            for (const auto& item : items)
+            {
+                const size_t itemByteCount =
+                    item->read ? item->read->getByteCount() : 0;
+                byteCounts.push_back(itemByteCount);
+                byteCount += itemByteCount;
+            }
+            for (size_t j = 0; j < items.size(); ++j)
+            {
+                const auto& item = items[j];
+                if (!item->read || item->released)
+                    continue;
+                const auto unused = now - item->used;
+                if (unused > readIdleTimeout ||
+                    (byteCount > p.options.readerByteCount &&
+                     unused > readActiveTime))
+                {
+                    item->read->releaseMemory();
+                    item->released = true;
+                    byteCount -= byteCounts[j];
+                }
+            }
+            p.readByteCount = byteCount;
+        }
+
         std::future<io::VideoData> Timeline::_readVideo(
             const otio::Clip* clip, const otime::RationalTime& time,
             const io::Options& options)
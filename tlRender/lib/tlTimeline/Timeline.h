@@ -8,6 +8,7 @@
 #include <tlTimeline/Video.h>
 
 #include <tlCore/Context.h>
+#include <tlCore/Memory.h>
 #include <tlCore/Path.h>
 #include <tlCore/ValueObserver.h>
 
@@ -82,6 +83,19 @@ namespace tl
             std::chrono::milliseconds requestTimeout =
                 std::chrono::milliseconds(5);
 
+            //! Maximum number of open readers.
+            size_t readerCount = 32;
+
+            //! Memory budget for the open readers in bytes. When it is
+            //! exceeded the least recently used readers release their
+            //! buffers. Readers that have not been used recently always
+            //! release them, but stay open.
+            size_t readerByteCount = memory::gigabyte;
+
+            //! Number of clips past the requested time, in the direction of
+            //! the requests, to open readers for in the background.
+            size_t readAheadClipCount = 2;
+
             //! I/O options.
             io::Options ioOptions;
 
@@ -264,6 +278,12 @@ namespace tl
             VideoRequest getVideo(
                 const otime::RationalTime&, const io::Options& = io::Options());
 
+            //! Get video data at a lower resolution or for a region of
+            //! interest. The frame request is added to the I/O options.
+            VideoRequest getVideo(
+                const otime::RationalTime&, const io::FrameRequest&,
+                const io::Options& = io::Options());
+
             //! Get audio data.
             AudioRequest
             getAudio(double seconds, const io::Options& = io::Options());
@@ -292,6 +312,11 @@ namespace tl
             std::shared_ptr<io::IRead> _getRead(
                 const otio::MediaReference*,
                 const io::Options&);
+            void _openRead(
+                const otio::MediaReference*,
+                const io::Options&);
+            void _readAhead(const otime::RationalTime&);
+            void _readCacheUpdate();
             bool _getVideoInfo(const otio::Composable*);
             bool _getAudioInfo(const otio::Composable*);
             void _getCanvas();
@@ -85,6 +85,7 @@ namespace tl
                         pathOptions);
                     file::ListOptions listOptions;
                     listOptions.maxNumberDigits = pathOptions.seqMaxDigits;
+                    listOptions.stat = false;
                     std::vector<file::FileInfo> list;
                     file::list(directoryPath.get(), list, listOptions);
                     for (const auto& fileInfo : list)
@@ -441,6 +442,7 @@ namespace tl
                         listOptions.sequenceExtensions = {path.getExtension()};
                         listOptions.maxNumberDigits =
                             options.pathOptions.seqMaxDigits;
+                        listOptions.stat = false;
                         file::list(path.getDirectory(), list, listOptions);
                         const auto i = std::find_if(
                             list.begin(), list.end(),
@@ -20,17 +20,10 @@ namespace tl
 {
     namespace timeline
     {
-        namespace
-        {
-            const std::chrono::milliseconds timeout(5);
-        }
-
         void Timeline::_tick()
         {
             TLRENDER_P();
 
-            const auto t0 = std::chrono::steady_clock::now();
-
             _requests();
 
             // Logging.
@@ -48,6 +41,17 @@ namespace tl
                         videoRequestsSize = p.mutex.videoRequests.size();
                         audioRequestsSize = p.mutex.audioRequests.size();
                     }
+                    size_t readCount = 0;
+                    size_t readOpensCount = 0;
+                    size_t readMax = 0;
+                    size_t readByteCount = 0;
+                    {
+                        std::unique_lock<std::mutex> lock(p.readMutex);
+                        readCount = p.readCache.getCount();
+                        readOpensCount = p.readOpens.size();
+                        readMax = p.readCache.getMax();
+                        readByteCount = p.readByteCount;
+                    }
                     auto logSystem = context->getLogSystem();
                     logSystem->print(
                         string::Format("tl::timeline::Timeline {0}").arg(this),
@@ -56,20 +60,21 @@ namespace tl
                             "    Path: {0}\n"
                             "    Video requests: {1}, {2} in-progress, {3} "
                             "max\n"
-                            "    Audio requests: {4}, {5} in-progress, {6} max")
+                            "    Audio requests: {4}, {5} in-progress, {6} max\n"
+                            "    Readers: {7}, {8} opening, {9} max, {10}MB")
                             .arg(p.path.get())
                             .arg(videoRequestsSize)
                             .arg(p.thread.videoRequestsInProgress.size())
                             .arg(p.options.videoRequestCount)
                             .arg(audioRequestsSize)
                             .arg(p.thread.audioRequestsInProgress.size())
-                            .arg(p.options.audioRequestCount));
+                            .arg(p.options.audioRequestCount)
+                            .arg(readCount)
+                            .arg(readOpensCount)
+                            .arg(readMax)
+                            .arg(readByteCount / memory::megabyte));
                 }
-                t1 = std::chrono::steady_clock::now();
             }
-
-            // Sleep for a bit.
-            time::sleep(timeout, t0, t1);
         }
 
 
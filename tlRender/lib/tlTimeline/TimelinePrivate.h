@@ -5,15 +5,20 @@
 #pragma once
 
 #include <tlTimeline/Timeline.h>
+#include <tlTimeline/TrackIndex.h>
 
 #include <tlIO/Plugin.h>
+#include <tlIO/ThreadPool.h>
 
 #include <tlCore/LRUCache.h>
 
 #include <opentimelineio/clip.h>
 
 #include <atomic>
+#include <chrono>
+#include <future>
 #include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -43,9 +48,27 @@ namespace tl
             file::Path path;
             file::Path audioPath;
             Options options;
-            // Owned by the request thread, like the Thread struct below.
-            memory::LRUCache<std::string, std::shared_ptr<io::IRead> >
+            // The open readers, by path, limited to Options::readerCount
+            // readers in least recently used order. A reader that has
+            // released its buffers stays open until it is evicted. The
+            // readers being opened in the background by the I/O thread pool
+            // are moved into the cache by the request thread when they are
+            // ready, or when a request waits for them. Guarded by readMutex,
+            // since setTimeline() reads the information for a new timeline
+            // from the main thread.
+            struct ReadItem
+            {
+                std::shared_ptr<io::IRead> read;
+                std::chrono::steady_clock::time_point used;
+                bool released = false;
+            };
+            memory::LRUCache<std::string, std::shared_ptr<ReadItem> >
                 readCache;
+            std::map<
+                std::string, std::shared_future<std::shared_ptr<io::IRead> > >
+                readOpens;
+            size_t readByteCount = 0;
+            std::mutex readMutex;
             // Errors observed while building frames (broken promises caught
             // in videoFrame()/audioFrame()). Owned by the request thread.
             size_t frameErrorCount = 0;
@@ -166,9 +189,17 @@ namespace tl
                 std::string mediaReferenceKey;
                 std::map<const otio::Clip*, std::string> clipMediaReferenceKeys;
                 bool mediaReferenceKeysChanged = false;
+                // Set by the request callback when a reader finishes a
+                // request, so the request thread can check the in-progress
+                // requests.
+                bool ioCompleted = false;
                 std::mutex mutex;
             };
             Mutex mutex;
+            std::shared_ptr<io::ThreadPool> ioThreadPool;
+            // Given to each reader the timeline opens, see
+            // io::IRead::setRequestCallback().
+            std::function<void(void)> ioRequestCallback;
             // Owned by the request thread; no locking. The in-progress lists
             // hold requests whose IO futures are outstanding. thread and
             // running are the exceptions: the main thread starts the thread
@@ -189,6 +220,18 @@ namespace tl
                 // when the main thread changes them.
                 std::string mediaReferenceKey;
                 std::map<const OTIO_NS::Clip*, std::string> clipMediaReferenceKeys;
+                // The time of the last read ahead, which gives the direction
+                // of the requests.
+                otime::RationalTime readAheadTime = time::invalidTime;
+                // The tracks and the lookup of their children for the read
+                // ahead, rebuilt when the timeline changes.
+                struct ReadAheadTrack
+                {
+                    const otio::Track* track = nullptr;
+                    TrackIndex index;
+                };
+                std::vector<ReadAheadTrack> readAheadTracks;
+                bool readAheadTracksValid = false;
             };
             Thread thread;
 
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/TrackIndex.h>
+
+#include <algorithm>
+
+namespace tl
+{
+    namespace timeline
+    {
+        TrackIndex::TrackIndex() {}
+
+        TrackIndex::TrackIndex(const std::vector<otime::TimeRange>& ranges)
+        {
+            _startTimes.reserve(ranges.size());
+            _endTimes.reserve(ranges.size());
+            for (const auto& range : ranges)
+            {
+                _startTimes.push_back(range.start_time());
+                const otime::RationalTime endTime = range.end_time_exclusive();
+                _endTimes.push_back(
+                    !_endTimes.empty() && _endTimes.back() > endTime
+                        ? _endTimes.back()
+                        : endTime);
+            }
+        }
+
+        size_t TrackIndex::getSize() const
+        {
+            return _startTimes.size();
+        }
+
+        int64_t TrackIndex::find(const otime::RationalTime& time) const
+        {
+            // The first range that ends after the time is the only one that
+            // can contain it, the ranges before it end too soon and the
+            // ranges after it start later.
+            const auto i =
+                std::upper_bound(_endTimes.begin(), _endTimes.end(), time);
+            if (i == _endTimes.end())
+                return -1;
+            const size_t index = i - _endTimes.begin();
+            return _startTimes[index] <= time ? static_cast<int64_t>(index)
+                                              : -1;
+        }
+    } // namespace timeline
+} // namespace tl
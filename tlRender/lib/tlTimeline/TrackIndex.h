@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Time.h>
+
+#include <vector>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Find the children of a track by time.
+        //!
+        //! The ranges of the children are ordered by their start times and
+        //! may overlap where there are transitions. Keeping the largest end
+        //! time up to each child makes the lookup a binary search instead of
+        //! a search through all of the children.
+        class TrackIndex
+        {
+        public:
+            TrackIndex();
+            explicit TrackIndex(const std::vector<otime::TimeRange>&);
+
+            //! Get the number of ranges.
+            size_t getSize() const;
+
+            //! Get the index of the first range that contains the given
+            //! time, or -1 if there is none.
+            int64_t find(const otime::RationalTime&) const;
+
+        private:
+            std::vector<otime::RationalTime> _startTimes;
+            std::vector<otime::RationalTime> _endTimes;
+        };
+    } // namespace timeline
+} // namespace tl
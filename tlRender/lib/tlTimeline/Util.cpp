@@ -282,6 +282,7 @@ namespace tl
                 auto ioSystem = context->getSystem<io::System>();
                 file::ListOptions listOptions;
                 listOptions.maxNumberDigits = pathOptions.seqMaxDigits;
+                listOptions.stat = false;
                 std::vector<file::FileInfo> list;
                 file::list(path.getFileName(true), list, listOptions);
                 for (const auto& fileInfo : list)
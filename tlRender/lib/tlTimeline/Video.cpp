@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/Video.h>
+
+#include <algorithm>
+#include <set>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            size_t getImageByteCount(const std::shared_ptr<image::Image>& image)
+            {
+                size_t out = image->getDataByteCount();
+                if (image->getPlaneCount() > 1)
+                {
+                    // The planes come from the decoder and may have padding
+                    // at the end of each line.
+                    int chromaHeight = image->getHeight();
+                    switch (image->getPixelType())
+                    {
+                    case image::PixelType::YUV_420P_U8:
+                    case image::PixelType::YUV_420P_U10:
+                    case image::PixelType::YUV_420P_U12:
+                    case image::PixelType::YUV_420P_U16:
+                        chromaHeight = (chromaHeight + 1) / 2;
+                        break;
+                    default:
+                        break;
+                    }
+                    const size_t planes =
+                        static_cast<size_t>(image->getLineSize(0)) *
+                            image->getHeight() +
+                        static_cast<size_t>(
+                            image->getLineSize(1) + image->getLineSize(2)) *
+                            chromaHeight;
+                    out = std::max(out, planes);
+                }
+                return out;
+            }
+        } // namespace
+
+        size_t getByteCount(const VideoFrame& value)
+        {
+            size_t out = 0;
+            std::set<const image::Image*> images;
+            for (const auto& layer : value.layers)
+            {
+                for (const auto& image : {layer.image, layer.imageB})
+                {
+                    if (image && images.insert(image.get()).second)
+                    {
+                        out += getImageByteCount(image);
+                    }
+                }
+            }
+            return out;
+        }
+    } // namespace timeline
+} // namespace tl
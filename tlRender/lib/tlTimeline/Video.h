@@ -68,6 +68,12 @@ namespace tl
 
         //! Compare the time values of video data.
         bool isTimeEqual(const VideoFrame&, const VideoFrame&);
+
+        //! Get the number of bytes used by the images in video data,
+        //! including the transition images. Images shared by more than one
+        //! layer are only counted once, and planar images are counted with
+        //! their line padding.
+        size_t getByteCount(const VideoFrame&);
     } // namespace timeline
 } // namespace tl
 
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimeline/VideoCache.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace tl
+{
+    namespace timeline
+    {
+        double getVideoCachePriority(
+            const otime::RationalTime& time, const VideoCachePriority& options)
+        {
+            if (!options.inOutRange.contains(time))
+                return std::numeric_limits<double>::max();
+            const double rate = options.inOutRange.duration().rate();
+            const double value = time.rescaled_to(rate).value();
+            const double current =
+                options.currentTime.rescaled_to(rate).value();
+            const double duration = options.inOutRange.duration().value();
+            const double behind =
+                time::isValid(options.readBehind)
+                    ? options.readBehind.rescaled_to(rate).value()
+                    : 0.0;
+            double out = options.reverse ? current - value : value - current;
+            if (out < 0.0)
+            {
+                out = -out <= behind ? duration - out : duration + out;
+            }
+            return out;
+        }
+
+        size_t VideoCache::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        size_t VideoCache::getCount() const
+        {
+            return _frames.size();
+        }
+
+        const std::map<otime::RationalTime, std::vector<VideoFrame> >&
+        VideoCache::getFrames() const
+        {
+            return _frames;
+        }
+
+        bool VideoCache::contains(const otime::RationalTime& time) const
+        {
+            return _frames.find(time) != _frames.end();
+        }
+
+        bool VideoCache::get(
+            const otime::RationalTime& time,
+            std::vector<VideoFrame>& value) const
+        {
+            const auto i = _frames.find(time);
+            if (i != _frames.end())
+            {
+                value = i->second;
+                return true;
+            }
+            return false;
+        }
+
+        void VideoCache::add(
+            const otime::RationalTime& time,
+            const std::vector<VideoFrame>& value)
+        {
+            remove(time);
+            for (const auto& videoFrame : value)
+            {
+                _byteCount += timeline::getByteCount(videoFrame);
+            }
+            _frames[time] = value;
+        }
+
+        void VideoCache::remove(const otime::RationalTime& time)
+        {
+            const auto i = _frames.find(time);
+            if (i != _frames.end())
+            {
+                for (const auto& videoFrame : i->second)
+                {
+                    _byteCount -= std::min(
+                        _byteCount, timeline::getByteCount(videoFrame));
+                }
+                _frames.erase(i);
+            }
+        }
+
+        void VideoCache::clear()
+        {
+            _frames.clear();
+            _byteCount = 0;
+        }
+
+        bool VideoCache::evict(
+            double priority, const VideoCachePriority& options)
+        {
+            if (_frames.empty())
+                return false;
+
+            // The priority is linear in between the in/out points, the
+            // current time, and the read behind, so the highest priority is
+            // at the first or last frame, or next to one of those times.
+            std::vector<otime::RationalTime> times = {
+                _frames.begin()->first, _frames.rbegin()->first};
+            if (time::isValid(options.inOutRange) &&
+                time::isValid(options.currentTime))
+            {
+                const otime::RationalTime behind =
+                    time::isValid(options.readBehind)
+                        ? options.readBehind
+                        : otime::RationalTime(0.0, options.currentTime.rate());
+                for (const auto& t :
+                     {options.inOutRange.start_time(),
+                      options.inOutRange.end_time_exclusive(),
+                      options.currentTime, options.currentTime - behind,
+                      options.currentTime + behind})
+                {
+                    auto i = _frames.lower_bound(t);
+                    if (i != _frames.begin())
+                    {
+                        times.push_back(std::prev(i)->first);
+                    }
+                    if (i != _frames.end())
+                    {
+                        times.push_back(i->first);
+                        if (++i != _frames.end())
+                        {
+                            times.push_back(i->first);
+                        }
+                    }
+                }
+            }
+
+            bool out = false;
+            otime::RationalTime evict = time::invalidTime;
+            for (const auto& t : times)
+            {
+                const double p = getVideoCachePriority(t, options);
+                if (p > priority)
+                {
+                    evict = t;
+                    priority = p;
+                    out = true;
+                }
+            }
+            if (out)
+            {
+                remove(evict);
+            }
+            return out;
+        }
+    } // namespace timeline
+} // namespace tl
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/Video.h>
+
+#include <map>
+
+namespace tl
+{
+    namespace timeline
+    {
+        //! Video cache priority options.
+        struct VideoCachePriority
+        {
+            otime::RationalTime currentTime = time::invalidTime;
+            otime::TimeRange inOutRange = time::invalidTimeRange;
+            otime::RationalTime readBehind = time::invalidTime;
+            bool reverse = false;
+        };
+
+        //! Get the priority of a video frame. Lower values are reached
+        //! sooner by playback: first the frames ahead of the current time
+        //! (including the ones that are reached by looping), then the read
+        //! behind frames. Frames outside of the in/out range come last.
+        double getVideoCachePriority(
+            const otime::RationalTime&, const VideoCachePriority&);
+
+        //! Video frame cache.
+        //!
+        //! The frames are kept in time order with a running byte count.
+        //! The priority only changes direction at the in/out points, the
+        //! current time, and the read behind, so the frame to evict is found
+        //! by looking up the frames next to those times instead of visiting
+        //! the whole cache.
+        class VideoCache
+        {
+        public:
+            //! \name Size
+            ///@{
+
+            //! Get the number of bytes used by the cached frames.
+            size_t getByteCount() const;
+
+            //! Get the number of cached times.
+            size_t getCount() const;
+
+            ///@}
+
+            //! \name Contents
+            ///@{
+
+            //! Get the cached frames.
+            const std::map<otime::RationalTime, std::vector<VideoFrame> >&
+            getFrames() const;
+
+            bool contains(const otime::RationalTime&) const;
+            bool get(
+                const otime::RationalTime&, std::vector<VideoFrame>&) const;
+
+            //! Add frames, replacing any that are cached at the same time.
+            void add(
+                const otime::RationalTime&, const std::vector<VideoFrame>&);
+            void remove(const otime::RationalTime&);
+            void clear();
+
+            //! Remove the frame with the highest priority if it is higher
+            //! than the given priority. Returns false if there is no such
+            //! frame.
+            bool evict(double priority, const VideoCachePriority&);
+
+            ///@}
+
+        private:
+            std::map<otime::RationalTime, std::vector<VideoFrame> > _frames;
+            size_t _byteCount = 0;
+        };
+    } // namespace timeline
+} // namespace tl
@@ -0,0 +1,511 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Context.h>
+
+#include <algorithm>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        void Render::_init(
+            const std::shared_ptr<system::Context>& context,
+            const std::shared_ptr<TextureCache>& textureCache)
+        {
+            IRender::_init(context);
+            TLRENDER_P();
+
+            p.textureCache = textureCache;
+            if (!p.textureCache)
+            {
+                p.textureCache = std::make_shared<TextureCache>();
+            }
+        }
+
+        Render::Render() :
+            _p(new Private)
+        {
+        }
+
+        Render::~Render() {}
+
+        std::shared_ptr<Render> Render::create(
+            const std::shared_ptr<system::Context>& context,
+            const std::shared_ptr<TextureCache>& textureCache)
+        {
+            auto out = std::shared_ptr<Render>(new Render);
+            out->_init(context, textureCache);
+            return out;
+        }
+
+        const std::shared_ptr<TextureCache>& Render::getTextureCache() const
+        {
+            return _p->textureCache;
+        }
+
+        const std::shared_ptr<image::Image>& Render::getImage() const
+        {
+            return _p->image;
+        }
+
+        void Render::begin(
+            const math::Size2i& renderSize,
+            const timeline::RenderOptions& renderOptions)
+        {
+            TLRENDER_P();
+
+            p.renderSize = renderSize;
+            p.renderOptions = renderOptions;
+            p.textureCache->setMax(renderOptions.textureCacheByteCount);
+
+            if (!p.image || p.image->getWidth() != renderSize.w ||
+                p.image->getHeight() != renderSize.h)
+            {
+                image::Info info(
+                    renderSize.w, renderSize.h, image::PixelType::RGBA_F32);
+                info.layout.mirror.y = true;
+                p.image = image::Image::create(info);
+                p.stencil.clear();
+            }
+            p.target.data = reinterpret_cast<float*>(p.image->getData());
+            p.target.w = renderSize.w;
+            p.target.h = renderSize.h;
+            p.target.stencil = nullptr;
+            p.targetStack.clear();
+
+            setViewport(math::Box2i(0, 0, renderSize.w, renderSize.h));
+            if (renderOptions.clear)
+            {
+                clearViewport(renderOptions.clearColor);
+            }
+            setTransform(math::ortho(
+                0.F, static_cast<float>(renderSize.w),
+                static_cast<float>(renderSize.h), 0.F, -1.F, 1.F));
+        }
+
+        void Render::end()
+        {
+            TLRENDER_P();
+            p.target.stencil = nullptr;
+        }
+
+        math::Size2i Render::getRenderSize() const
+        {
+            return _p->renderSize;
+        }
+
+        void Render::setRenderSize(const math::Size2i& value)
+        {
+            _p->renderSize = value;
+        }
+
+        math::Box2i Render::getViewport() const
+        {
+            return _p->viewport;
+        }
+
+        void Render::setViewport(const math::Box2i& value)
+        {
+            _p->viewport = value;
+        }
+
+        void Render::clearViewport(const image::Color4f& value)
+        {
+            TLRENDER_P();
+            // Like glClear() this is only limited by the clipping rectangle.
+            math::Box2i box(0, 0, p.target.w, p.target.h);
+            if (p.clipRectEnabled)
+            {
+                box = math::intersect(box, p.clipRect);
+            }
+            const int w = box.w();
+            const int h = box.h();
+            if (!p.target.data || w <= 0 || h <= 0)
+                return;
+            const float color[4] = {value.r, value.g, value.b, value.a};
+            parallelRows(
+                h, 64,
+                [&p, &box, &color, w](int begin, int end)
+                {
+                    for (int y = begin; y < end; ++y)
+                    {
+                        float* d = p.target.data +
+                                   (static_cast<size_t>(box.min.y + y) *
+                                        p.target.w +
+                                    box.min.x) *
+                                       4;
+                        for (int x = 0; x < w; ++x, d += 4)
+                        {
+                            d[0] = color[0];
+                            d[1] = color[1];
+                            d[2] = color[2];
+                            d[3] = color[3];
+                        }
+                    }
+                });
+        }
+
+        bool Render::getClipRectEnabled() const
+        {
+            return _p->clipRectEnabled;
+        }
+
+        void Render::setClipRectEnabled(bool value)
+        {
+            _p->clipRectEnabled = value;
+        }
+
+        math::Box2i Render::getClipRect() const
+        {
+            return _p->clipRect;
+        }
+
+        void Render::setClipRect(const math::Box2i& value)
+        {
+            _p->clipRect = value;
+        }
+
+        math::Matrix4x4f Render::getTransform() const
+        {
+            return _p->transform;
+        }
+
+        void Render::setTransform(const math::Matrix4x4f& value)
+        {
+            _p->transform = value;
+        }
+
+        void Render::setOCIOOptions(const timeline::OCIOOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.ocioOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.ocioData.reset();
+#endif // TLRENDER_OCIO
+
+            p.ocioOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.ocioOptions.enabled)
+            {
+                p.ocioData.reset(new OCIOData);
+
+                if (!p.ocioOptions.fileName.empty())
+                {
+                    p.ocioData->config = OCIO::Config::CreateFromFile(
+                        p.ocioOptions.fileName.c_str());
+                }
+                else
+                {
+                    p.ocioData->config = OCIO::GetCurrentConfig();
+                }
+                if (!p.ocioData->config)
+                {
+                    p.ocioData.reset();
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+
+                if (!p.ocioOptions.input.empty())
+                {
+                    OCIO::ConstColorSpaceRcPtr srcCS =
+                        p.ocioData->config->getColorSpace(
+                            p.ocioOptions.input.c_str());
+                    OCIO::ConstColorSpaceRcPtr dstCS =
+                        p.ocioData->config->getColorSpace(
+                            OCIO::ROLE_SCENE_LINEAR);
+                    OCIO::ConstProcessorRcPtr processor =
+                        p.ocioData->config->getProcessor(
+                            p.ocioData->config->getCurrentContext(), srcCS,
+                            dstCS);
+                    if (!processor)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+                    p.ocioData->ics = processor->getOptimizedCPUProcessor(
+                        OCIO::OPTIMIZATION_DEFAULT);
+                    if (!p.ocioData->ics)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error(
+                            "Cannot get OCIO CPU processor for ICS");
+                    }
+                }
+                if (!p.ocioOptions.display.empty() &&
+                    !p.ocioOptions.view.empty())
+                {
+                    OCIO::DisplayViewTransformRcPtr transform =
+                        OCIO::DisplayViewTransform::Create();
+                    if (!transform)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error(
+                            "Cannot create OCIO transform");
+                    }
+                    transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
+                    transform->setDisplay(p.ocioOptions.display.c_str());
+                    transform->setView(p.ocioOptions.view.c_str());
+
+                    OCIO::LegacyViewingPipelineRcPtr lvp =
+                        OCIO::LegacyViewingPipeline::Create();
+                    if (!lvp)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error(
+                            "Cannot create OCIO viewing pipeline");
+                    }
+                    lvp->setDisplayViewTransform(transform);
+                    const bool hasLooks = !p.ocioOptions.look.empty();
+                    lvp->setLooksOverrideEnabled(hasLooks);
+                    lvp->setLooksOverride(p.ocioOptions.look.c_str());
+                    OCIO::ConstProcessorRcPtr processor = lvp->getProcessor(
+                        p.ocioData->config,
+                        p.ocioData->config->getCurrentContext());
+                    if (!processor)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error("Cannot get OCIO processor");
+                    }
+                    p.ocioData->display = processor->getOptimizedCPUProcessor(
+                        OCIO::OPTIMIZATION_DEFAULT);
+                    if (!p.ocioData->display)
+                    {
+                        p.ocioData.reset();
+                        throw std::runtime_error(
+                            "Cannot get OCIO CPU processor");
+                    }
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setLUTOptions(const timeline::LUTOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.lutOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.lutData.reset();
+#endif // TLRENDER_OCIO
+
+            p.lutOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
+            {
+                p.lutData.reset(new OCIOLUTData);
+
+                p.lutData->config = OCIO::Config::CreateRaw();
+                if (!p.lutData->config)
+                {
+                    p.lutData.reset();
+                    throw std::runtime_error(
+                        "Cannot create OCIO configuration");
+                }
+
+                OCIO::FileTransformRcPtr transform =
+                    OCIO::FileTransform::Create();
+                if (!transform)
+                {
+                    p.lutData.reset();
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                transform->setSrc(p.lutOptions.fileName.c_str());
+                transform->validate();
+
+                OCIO::ConstProcessorRcPtr processor =
+                    p.lutData->config->getProcessor(transform);
+                if (!processor)
+                {
+                    p.lutData.reset();
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                p.lutData->processor = processor->getDefaultCPUProcessor();
+                if (!p.lutData->processor)
+                {
+                    p.lutData.reset();
+                    throw std::runtime_error("Cannot get OCIO CPU processor");
+                }
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setHDROptions(const timeline::HDROptions& value)
+        {
+            _p->hdrOptions = value;
+        }
+
+        math::Box2i Render::Private::getBounds() const
+        {
+            math::Box2i out = math::intersect(
+                viewport, math::Box2i(0, 0, target.w, target.h));
+            if (clipRectEnabled)
+            {
+                out = math::intersect(out, clipRect);
+            }
+            return out;
+        }
+
+        math::Vector2f Render::Private::toScreen(
+            const math::Vector2f& value,
+            const math::Matrix4x4f& transform) const
+        {
+            const math::Vector3f v =
+                transform * math::Vector3f(value.x, value.y, 0.F);
+            return math::Vector2f(
+                viewport.min.x + (v.x + 1.F) / 2.F * viewport.w(),
+                viewport.min.y + (1.F - v.y) / 2.F * viewport.h());
+        }
+
+        std::shared_ptr<Texture>& Render::Private::getBuffer(
+            const std::string& name, const math::Size2i& size)
+        {
+            auto& out = buffers[name];
+            if (!out || out->size != size)
+            {
+                out = std::make_shared<Texture>();
+                out->size = size;
+                out->data.resize(
+                    static_cast<size_t>(std::max(size.w, 0)) *
+                    std::max(size.h, 0) * 4);
+            }
+            return out;
+        }
+
+        void Render::Private::pushTarget(
+            const std::shared_ptr<Texture>& buffer)
+        {
+            TargetState state;
+            state.target = target;
+            state.viewport = viewport;
+            state.transform = transform;
+            state.clipRectEnabled = clipRectEnabled;
+            targetStack.push_back(state);
+
+            target.data = buffer->data.data();
+            target.w = buffer->size.w;
+            target.h = buffer->size.h;
+            target.stencil = nullptr;
+            viewport = math::Box2i(0, 0, buffer->size.w, buffer->size.h);
+            transform = math::ortho(
+                0.F, static_cast<float>(buffer->size.w),
+                static_cast<float>(buffer->size.h), 0.F, -1.F, 1.F);
+            clipRectEnabled = false;
+        }
+
+        void Render::Private::popTarget()
+        {
+            if (!targetStack.empty())
+            {
+                const auto& state = targetStack.back();
+                target = state.target;
+                viewport = state.viewport;
+                transform = state.transform;
+                clipRectEnabled = state.clipRectEnabled;
+                targetStack.pop_back();
+            }
+        }
+
+        std::shared_ptr<Texture> Render::Private::getTexture(
+            const std::shared_ptr<image::Image>& image,
+            const timeline::ImageOptions& imageOptions)
+        {
+            image::VideoLevels videoLevels = image->getInfo().videoLevels;
+            switch (imageOptions.videoLevels)
+            {
+            case timeline::InputVideoLevels::FullRange:
+                videoLevels = image::VideoLevels::FullRange;
+                break;
+            case timeline::InputVideoLevels::LegalRange:
+                videoLevels = image::VideoLevels::LegalRange;
+                break;
+            default:
+                break;
+            }
+
+            std::shared_ptr<Texture> out;
+            if (imageOptions.cache && textureCache->get(image, out) &&
+                out->videoLevels == videoLevels)
+            {
+                return out;
+            }
+            out = std::make_shared<Texture>();
+            convertImage(image, videoLevels, *out);
+            if (imageOptions.cache)
+            {
+                textureCache->add(
+                    image, out, out->data.size() * sizeof(float));
+            }
+            return out;
+        }
+
+        bool Render::Private::addGlyph(
+            const std::shared_ptr<image::Glyph>& glyph, GlyphItem& item)
+        {
+            const auto& info = glyph->image->getInfo();
+            const int w = info.size.w;
+            const int h = info.size.h;
+            if (w + 1 > glyphPageSize || h + 1 > glyphPageSize)
+                return false;
+
+            // Glyphs are packed into rows with a pixel of padding so that
+            // linear filtering does not bleed between them.
+            std::shared_ptr<GlyphPage> page =
+                !glyphPages.empty() ? glyphPages.back() : nullptr;
+            if (page && page->x + w + 1 > glyphPageSize)
+            {
+                page->x = 0;
+                page->y += page->rowHeight;
+                page->rowHeight = 0;
+            }
+            if (!page || page->y + h + 1 > glyphPageSize)
+            {
+                if (glyphPages.size() >= glyphPageMax)
+                {
+                    glyphPages.clear();
+                    glyphItems.clear();
+                }
+                page = std::make_shared<GlyphPage>();
+                page->texture.size =
+                    math::Size2i(glyphPageSize, glyphPageSize);
+                page->texture.data.resize(
+                    static_cast<size_t>(glyphPageSize) * glyphPageSize * 4,
+                    0.F);
+                glyphPages.push_back(page);
+            }
+
+            const uint8_t* data = glyph->image->getData();
+            const size_t rowByteCount =
+                image::getAlignedByteCount(w, info.layout.alignment);
+            for (int y = 0; y < h; ++y)
+            {
+                const uint8_t* in = data + y * rowByteCount;
+                float* out = page->texture.data.data() +
+                             (static_cast<size_t>(page->y + y) * glyphPageSize +
+                              page->x) *
+                                 4;
+                for (int x = 0; x < w; ++x, out += 4)
+                {
+                    const float v = in[x] / 255.F;
+                    out[0] = v;
+                    out[1] = v;
+                    out[2] = v;
+                    out[3] = v;
+                }
+            }
+
+            item.page = static_cast<uint8_t>(glyphPages.size() - 1);
+            item.box = math::Box2i(page->x, page->y, w, h);
+            page->x += w + 1;
+            page->rowHeight = std::max(page->rowHeight, h + 1);
+            return true;
+        }
+    } // namespace timeline_cpu
+} // namespace tl
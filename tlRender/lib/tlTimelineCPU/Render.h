@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimeline/IRender.h>
+
+#include <tlCore/LRUCache.h>
+
+namespace tl
+{
+    //! Timeline software rendering support
+    namespace timeline_cpu
+    {
+        //! Floating point RGBA pixels, used for image textures and
+        //! offscreen buffers. The first row is the top of the image.
+        struct Texture
+        {
+            math::Size2i size;
+            std::vector<float> data;
+
+            //! The video levels the image was converted with.
+            image::VideoLevels videoLevels = image::VideoLevels::FullRange;
+        };
+
+        //! Texture cache.
+        typedef memory::LRUCache<
+            std::shared_ptr<image::Image>, std::shared_ptr<Texture> >
+            TextureCache;
+
+        //! Software renderer.
+        //!
+        //! The renderer draws into a floating point RGBA image without a
+        //! GPU, so frames can be rendered in headless processes. Images are
+        //! converted and cached as floating point textures, and the pixels
+        //! are shaded in parallel using the I/O thread pool.
+        //!
+        //! The GL texture IDs passed to drawTexture() have no meaning for
+        //! this renderer and are ignored, and the HDR options do not apply
+        //! tone mapping.
+        class Render : public timeline::IRender
+        {
+            TLRENDER_NON_COPYABLE(Render);
+
+        protected:
+            void _init(
+                const std::shared_ptr<system::Context>&,
+                const std::shared_ptr<TextureCache>&);
+
+            Render();
+
+        public:
+            virtual ~Render();
+
+            //! Create a new renderer.
+            static std::shared_ptr<Render> create(
+                const std::shared_ptr<system::Context>&,
+                const std::shared_ptr<TextureCache>& = nullptr);
+
+            //! Get the texture cache.
+            const std::shared_ptr<TextureCache>& getTextureCache() const;
+
+            //! Get the rendered image. The image is RGBA_F32 and is
+            //! re-allocated when the render size changes.
+            const std::shared_ptr<image::Image>& getImage() const;
+
+            void begin(
+                const math::Size2i&, const timeline::RenderOptions& =
+                                         timeline::RenderOptions()) override;
+            void end() override;
+
+            math::Size2i getRenderSize() const override;
+            void setRenderSize(const math::Size2i&) override;
+            math::Box2i getViewport() const override;
+            void setViewport(const math::Box2i&) override;
+            void clearViewport(const image::Color4f&) override;
+            bool getClipRectEnabled() const override;
+            void setClipRectEnabled(bool) override;
+            math::Box2i getClipRect() const override;
+            void setClipRect(const math::Box2i&) override;
+            math::Matrix4x4f getTransform() const override;
+            void setTransform(const math::Matrix4x4f&) override;
+            void setOCIOOptions(const timeline::OCIOOptions&) override;
+            void setLUTOptions(const timeline::LUTOptions&) override;
+            void setHDROptions(const timeline::HDROptions&) override;
+
+            void drawRect(const math::Box2i&, const image::Color4f&,
+                          const std::string& shaderName = "") override;
+            void drawMesh(
+                const geom::TriangleMesh2&, const math::Vector2i& position,
+                const image::Color4f&, const std::string& shaderName = "") override;
+            void drawColorMesh(
+                const geom::TriangleMesh2&, const math::Vector2i& position,
+                const image::Color4f&) override;
+            void appendText(
+                std::vector<timeline::TextInfo>& textInfos,
+                const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+                const math::Vector2i& pos) override;
+            void drawText(
+                const timeline::TextInfo&, const math::Vector2i& position,
+                const image::Color4f&) override;
+            void drawTexture(
+                unsigned int, const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F)) override;
+            void drawImage(
+                const std::shared_ptr<image::Image>&, const math::Box2i&,
+                const image::Color4f& = image::Color4f(1.F, 1.F, 1.F),
+                const timeline::ImageOptions& =
+                    timeline::ImageOptions()) override;
+            void drawVideo(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>& = {},
+                const std::vector<timeline::DisplayOptions>& = {},
+                const timeline::CompareOptions& = timeline::CompareOptions(),
+                const timeline::BackgroundOptions& =
+                    timeline::BackgroundOptions()) override;
+            void beginRenderPass() override {};
+            void beginLoadRenderPass() override {};
+            void endRenderPass() override {};
+            void setupViewportAndScissor() override {};
+
+        private:
+            void _drawBackground(
+                const std::vector<math::Box2i>&,
+                const timeline::BackgroundOptions&);
+            void _drawVideoA(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoB(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoWipe(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoOverlay(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoCompare(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideoTile(
+                const std::vector<timeline::VideoFrame>&,
+                const std::vector<math::Box2i>&,
+                const std::vector<timeline::ImageOptions>&,
+                const std::vector<timeline::DisplayOptions>&,
+                const timeline::CompareOptions&);
+            void _drawVideo(
+                const timeline::VideoFrame&, const math::Box2i&,
+                const std::shared_ptr<timeline::ImageOptions>&,
+                const timeline::DisplayOptions&);
+
+            TLRENDER_PRIVATE();
+        };
+    } // namespace timeline_cpu
+} // namespace tl
@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            Blend getMeshBlend(const std::string& name)
+            {
+                // The "erase" shader draws without setting a blend
+                // function, which is used to cut holes in annotations.
+                return name != "erase"
+                           ? Blend(
+                                 BlendFactor::SrcAlpha,
+                                 BlendFactor::OneMinusSrcAlpha)
+                           : Blend(
+                                 BlendFactor::Zero,
+                                 BlendFactor::OneMinusSrcAlpha);
+            }
+
+            FragmentFunc colorFragment(const image::Color4f& color)
+            {
+                return [color](
+                           int, int, int count, const float*, const float*,
+                           float* out)
+                {
+                    for (int i = 0; i < count; ++i, out += 4)
+                    {
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a;
+                    }
+                };
+            }
+        } // namespace
+
+        void
+        Render::drawRect(const math::Box2i& box, const image::Color4f& color,
+                         const std::string& name)
+        {
+            TLRENDER_P();
+            p.drawMesh(
+                geom::box(box), math::Vector2i(), getMeshBlend(name),
+                colorFragment(color));
+        }
+
+        void Render::drawMesh(
+            const geom::TriangleMesh2& mesh, const math::Vector2i& position,
+            const image::Color4f& color, const std::string& meshName)
+        {
+            TLRENDER_P();
+            p.drawMesh(
+                mesh, position, getMeshBlend(meshName), colorFragment(color));
+        }
+
+        void Render::drawColorMesh(
+            const geom::TriangleMesh2& mesh, const math::Vector2i& position,
+            const image::Color4f& color)
+        {
+            TLRENDER_P();
+            p.drawMesh(
+                mesh, position, Blend(),
+                [color](
+                    int, int, int count, const float* attr,
+                    const float* dAttr, float* out)
+                {
+                    for (int i = 0; i < count; ++i, out += 4)
+                    {
+                        out[0] = (attr[2] + dAttr[2] * i) * color.r;
+                        out[1] = (attr[3] + dAttr[3] * i) * color.g;
+                        out[2] = (attr[4] + dAttr[4] * i) * color.b;
+                        out[3] = (attr[5] + dAttr[5] * i) * color.a;
+                    }
+                });
+        }
+
+        void Render::appendText(
+            std::vector<timeline::TextInfo>& textInfos,
+            const std::vector<std::shared_ptr<image::Glyph> >& glyphs,
+            const math::Vector2i& pos)
+        {
+            TLRENDER_P();
+
+            if (textInfos.empty())
+            {
+                textInfos.emplace_back(timeline::TextInfo(0));
+            }
+            size_t textInfoIndex = textInfos.size() - 1;
+
+            int x = 0;
+            int32_t rsbDeltaPrev = 0;
+            for (const auto& glyph : glyphs)
+            {
+                if (glyph)
+                {
+                    if (rsbDeltaPrev - glyph->lsbDelta > 32)
+                    {
+                        x -= 1;
+                    }
+                    else if (rsbDeltaPrev - glyph->lsbDelta < -31)
+                    {
+                        x += 1;
+                    }
+                    rsbDeltaPrev = glyph->rsbDelta;
+
+                    if (glyph->image && glyph->image->isValid())
+                    {
+                        GlyphItem item;
+                        const auto i = p.glyphItems.find(glyph->info);
+                        if (i != p.glyphItems.end())
+                        {
+                            item = i->second;
+                        }
+                        else if (p.addGlyph(glyph, item))
+                        {
+                            p.glyphItems[glyph->info] = item;
+                        }
+                        else
+                        {
+                            x += glyph->advance;
+                            continue;
+                        }
+                        if (item.page != textInfos[textInfoIndex].textureId)
+                        {
+                            textInfos.emplace_back(
+                                timeline::TextInfo(item.page));
+                            textInfoIndex = textInfos.size() - 1;
+                        }
+                        auto& mesh = textInfos[textInfoIndex].mesh;
+                        auto& meshIndex = textInfos[textInfoIndex].meshIndex;
+
+                        const math::Vector2i& offset = glyph->offset;
+                        const math::Box2i box(
+                            pos.x + x + offset.x, pos.y - offset.y,
+                            glyph->image->getWidth(),
+                            glyph->image->getHeight());
+                        const auto& min = box.min;
+                        const auto& max = box.max;
+                        mesh.v.push_back(math::Vector2f(min.x, min.y));
+                        mesh.v.push_back(math::Vector2f(max.x + 1, min.y));
+                        mesh.v.push_back(math::Vector2f(max.x + 1, max.y + 1));
+                        mesh.v.push_back(math::Vector2f(min.x, max.y + 1));
+
+                        const float size = static_cast<float>(glyphPageSize);
+                        const float u0 = item.box.min.x / size;
+                        const float u1 = (item.box.max.x + 1) / size;
+                        const float v0 = item.box.min.y / size;
+                        const float v1 = (item.box.max.y + 1) / size;
+                        mesh.t.push_back(math::Vector2f(u0, v0));
+                        mesh.t.push_back(math::Vector2f(u1, v0));
+                        mesh.t.push_back(math::Vector2f(u1, v1));
+                        mesh.t.push_back(math::Vector2f(u0, v1));
+
+                        geom::Triangle2 triangle;
+                        triangle.v[0].v = meshIndex + 1;
+                        triangle.v[1].v = meshIndex + 2;
+                        triangle.v[2].v = meshIndex + 3;
+                        triangle.v[0].t = meshIndex + 1;
+                        triangle.v[1].t = meshIndex + 2;
+                        triangle.v[2].t = meshIndex + 3;
+                        mesh.triangles.push_back(triangle);
+                        triangle.v[0].v = meshIndex + 3;
+                        triangle.v[1].v = meshIndex + 4;
+                        triangle.v[2].v = meshIndex + 1;
+                        triangle.v[0].t = meshIndex + 3;
+                        triangle.v[1].t = meshIndex + 4;
+                        triangle.v[2].t = meshIndex + 1;
+                        mesh.triangles.push_back(triangle);
+
+                        meshIndex += 4;
+                    }
+
+                    x += glyph->advance;
+                }
+            }
+        }
+
+        void Render::drawText(
+            const timeline::TextInfo& textInfo,
+            const math::Vector2i& position, const image::Color4f& color)
+        {
+            TLRENDER_P();
+            if (textInfo.textureId >= p.glyphPages.size())
+                return;
+            const auto page = p.glyphPages[textInfo.textureId];
+            p.drawMesh(
+                textInfo.mesh, position, Blend(),
+                [&page, color](
+                    int, int, int count, const float* attr,
+                    const float* dAttr, float* out)
+                {
+                    float c[4];
+                    for (int i = 0; i < count; ++i, out += 4)
+                    {
+                        sampleLinear(
+                            page->texture, attr[0] + dAttr[0] * i,
+                            attr[1] + dAttr[1] * i, c);
+                        out[0] = color.r;
+                        out[1] = color.g;
+                        out[2] = color.b;
+                        out[3] = color.a * c[0];
+                    }
+                });
+        }
+
+        void Render::drawTexture(
+            unsigned int, const math::Box2i&, const image::Color4f&)
+        {
+            // There are no GPU textures to draw.
+        }
+
+        void Render::drawImage(
+            const std::shared_ptr<image::Image>& image, const math::Box2i& box,
+            const image::Color4f& color,
+            const timeline::ImageOptions& imageOptions)
+        {
+            TLRENDER_P();
+            const auto texture = p.getTexture(image, imageOptions);
+            p.drawTexture(
+                *texture, box, color, imageOptions.imageFilters,
+                getBlend(imageOptions.alphaBlend));
+        }
+
+        void Render::Private::drawMesh(
+            const geom::TriangleMesh2& mesh, const math::Vector2i& position,
+            const Blend& blend, const FragmentFunc& fragment)
+        {
+            const math::Box2i bounds = getBounds();
+            if (!target.data || bounds.w() <= 0 || bounds.h() <= 0)
+                return;
+            const math::Matrix4x4f m =
+                transform *
+                math::translate(math::Vector3f(position.x, position.y, 0.F));
+            for (const auto& triangle : mesh.triangles)
+            {
+                RasterVertex v[3];
+                bool valid = true;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    const auto& vertex = triangle.v[i];
+                    if (vertex.v < 1 || vertex.v > mesh.v.size())
+                    {
+                        valid = false;
+                        break;
+                    }
+                    v[i].pos = toScreen(mesh.v[vertex.v - 1], m);
+                    if (vertex.t > 0 && vertex.t <= mesh.t.size())
+                    {
+                        v[i].t = mesh.t[vertex.t - 1];
+                    }
+                    if (vertex.c > 0 && vertex.c <= mesh.c.size())
+                    {
+                        v[i].c = mesh.c[vertex.c - 1];
+                    }
+                }
+                if (valid)
+                {
+                    drawTriangle(
+                        target, bounds, v[0], v[1], v[2], blend, fragment);
+                }
+            }
+        }
+
+        void Render::Private::drawBox(
+            const math::Box2i& box, const Blend& blend,
+            const FragmentFunc& fragment, bool flipU, bool flipV)
+        {
+            auto mesh = geom::box(box);
+            for (auto& t : mesh.t)
+            {
+                if (flipU)
+                {
+                    t.x = 1.F - t.x;
+                }
+                if (flipV)
+                {
+                    t.y = 1.F - t.y;
+                }
+            }
+            drawMesh(mesh, math::Vector2i(), blend, fragment);
+        }
+
+        bool Render::Private::isLinear(
+            const Texture& texture, const math::Box2i& box,
+            const timeline::ImageFilters& imageFilters) const
+        {
+            const math::Vector2f a = toScreen(
+                math::Vector2f(box.min.x, box.min.y), transform);
+            const math::Vector2f b = toScreen(
+                math::Vector2f(box.max.x + 1, box.max.y + 1), transform);
+            const float scale =
+                texture.size.w > 0 ? std::fabs(b.x - a.x) / texture.size.w
+                                   : 1.F;
+            return timeline::ImageFilter::Linear ==
+                   (scale < 1.F ? imageFilters.minify : imageFilters.magnify);
+        }
+
+        void Render::Private::drawTexture(
+            const Texture& texture, const math::Box2i& box,
+            const image::Color4f& color,
+            const timeline::ImageFilters& imageFilters, const Blend& blend,
+            const image::Mirror& mirror)
+        {
+            const bool linear = isLinear(texture, box, imageFilters);
+            drawBox(
+                box, blend,
+                [&texture, color, linear](
+                    int, int, int count, const float* attr,
+                    const float* dAttr, float* out)
+                {
+                    for (int i = 0; i < count; ++i, out += 4)
+                    {
+                        const float u = attr[0] + dAttr[0] * i;
+                        const float v = attr[1] + dAttr[1] * i;
+                        if (linear)
+                        {
+                            sampleLinear(texture, u, v, out);
+                        }
+                        else
+                        {
+                            sampleNearest(texture, u, v, out);
+                        }
+                        out[0] *= color.r;
+                        out[1] *= color.g;
+                        out[2] *= color.b;
+                        out[3] *= color.a;
+                    }
+                },
+                mirror.x, mirror.y);
+        }
+    } // namespace timeline_cpu
+} // namespace tl
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTimelineCPU/Render.h>
+
+#if defined(TLRENDER_OCIO)
+#    include <OpenColorIO/OpenColorIO.h>
+#endif // TLRENDER_OCIO
+
+#include <functional>
+#include <list>
+
+#if defined(TLRENDER_OCIO)
+namespace OCIO = OCIO_NAMESPACE;
+#endif // TLRENDER_OCIO
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        //! Render target.
+        struct Target
+        {
+            float* data = nullptr;
+            int w = 0;
+            int h = 0;
+
+            //! Optional stencil, pixels are only written where it is set.
+            const uint8_t* stencil = nullptr;
+        };
+
+        //! Blending factors, these follow the OpenGL blend functions.
+        enum class BlendFactor { Zero, One, SrcAlpha, OneMinusSrcAlpha };
+
+        //! Blending.
+        struct Blend
+        {
+            Blend() = default;
+            Blend(BlendFactor src, BlendFactor dst);
+            Blend(
+                BlendFactor srcRGB, BlendFactor dstRGB, BlendFactor srcAlpha,
+                BlendFactor dstAlpha);
+
+            bool enabled = true;
+            BlendFactor srcRGB = BlendFactor::SrcAlpha;
+            BlendFactor dstRGB = BlendFactor::OneMinusSrcAlpha;
+            BlendFactor srcAlpha = BlendFactor::SrcAlpha;
+            BlendFactor dstAlpha = BlendFactor::OneMinusSrcAlpha;
+        };
+
+        //! Get blending for the alpha blend options.
+        Blend getBlend(timeline::AlphaBlend);
+
+        //! Blend a span of pixels. Pixels where the stencil is zero are not
+        //! written.
+        void blendSpan(
+            const Blend&, const float* src, float* dst, size_t count,
+            const uint8_t* stencil = nullptr);
+
+        //! Number of attributes interpolated across triangles: the texture
+        //! coordinates and the color.
+        const size_t rasterAttrCount = 6;
+
+        //! Screen space vertex.
+        struct RasterVertex
+        {
+            math::Vector2f pos;
+            math::Vector2f t;
+            math::Vector4f c = math::Vector4f(1.F, 1.F, 1.F, 1.F);
+        };
+
+        //! Span function. The arguments are the row, the first column, the
+        //! number of pixels, and the attributes at the first pixel center
+        //! and their change for each pixel.
+        typedef std::function<void(
+            int y, int x, int count, const float* attr, const float* dAttr)>
+            SpanFunc;
+
+        //! Call a function for each span of pixels covered by a triangle.
+        //! Spans are only generated within the bounds, and large triangles
+        //! are split into groups of rows that run in parallel.
+        void rasterize(
+            const math::Box2i& bounds, const RasterVertex&,
+            const RasterVertex&, const RasterVertex&, const SpanFunc&);
+
+        //! Fragment function. The arguments are the same as for spans,
+        //! the colors for the span are written to the last argument.
+        typedef std::function<void(
+            int y, int x, int count, const float* attr, const float* dAttr,
+            float* out)>
+            FragmentFunc;
+
+        //! Draw a triangle.
+        void drawTriangle(
+            const Target&, const math::Box2i& bounds, const RasterVertex&,
+            const RasterVertex&, const RasterVertex&, const Blend&,
+            const FragmentFunc&);
+
+        //! Sample a texture with nearest filtering.
+        void sampleNearest(const Texture&, float u, float v, float* out);
+
+        //! Sample a texture with linear filtering.
+        void sampleLinear(const Texture&, float u, float v, float* out);
+
+        //! Convert an image to a texture.
+        void convertImage(
+            const std::shared_ptr<image::Image>&, image::VideoLevels,
+            Texture&);
+
+        //! Run a function over groups of rows in parallel.
+        void parallelRows(
+            int rows, size_t rowsPerChunk,
+            const std::function<void(int begin, int end)>&);
+
+#if defined(TLRENDER_OCIO)
+        struct OCIOData
+        {
+            OCIO::ConstConfigRcPtr config;
+            OCIO::ConstCPUProcessorRcPtr ics;
+            OCIO::ConstCPUProcessorRcPtr display;
+        };
+
+        struct OCIOLUTData
+        {
+            OCIO::ConstConfigRcPtr config;
+            OCIO::ConstCPUProcessorRcPtr processor;
+        };
+#endif // TLRENDER_OCIO
+
+        //! Glyph page size.
+        const int glyphPageSize = 1024;
+
+        //! Maximum number of glyph pages.
+        const size_t glyphPageMax = 16;
+
+        //! Glyph page, glyphs are packed into rows.
+        struct GlyphPage
+        {
+            Texture texture;
+            int x = 0;
+            int y = 0;
+            int rowHeight = 0;
+        };
+
+        struct GlyphItem
+        {
+            uint8_t page = 0;
+            math::Box2i box;
+        };
+
+        struct Render::Private
+        {
+            math::Size2i renderSize;
+            timeline::OCIOOptions ocioOptions;
+            timeline::LUTOptions lutOptions;
+            timeline::HDROptions hdrOptions;
+            timeline::RenderOptions renderOptions;
+
+#if defined(TLRENDER_OCIO)
+            std::unique_ptr<OCIOData> ocioData;
+            std::unique_ptr<OCIOLUTData> lutData;
+#endif // TLRENDER_OCIO
+
+            std::shared_ptr<image::Image> image;
+            std::vector<uint8_t> stencil;
+            Target target;
+
+            math::Box2i viewport;
+            math::Matrix4x4f transform;
+            bool clipRectEnabled = false;
+            math::Box2i clipRect;
+
+            struct TargetState
+            {
+                Target target;
+                math::Box2i viewport;
+                math::Matrix4x4f transform;
+                bool clipRectEnabled = false;
+            };
+            std::list<TargetState> targetStack;
+
+            std::map<std::string, std::shared_ptr<Texture> > buffers;
+            std::shared_ptr<TextureCache> textureCache;
+            std::vector<std::shared_ptr<GlyphPage> > glyphPages;
+            std::map<image::GlyphInfo, GlyphItem> glyphItems;
+
+            //! Get the bounds for drawing on the current target.
+            math::Box2i getBounds() const;
+
+            //! Convert a position to screen space.
+            math::Vector2f toScreen(
+                const math::Vector2f&, const math::Matrix4x4f&) const;
+
+            //! Get an offscreen buffer, re-allocated if the size has changed.
+            std::shared_ptr<Texture>& getBuffer(
+                const std::string&, const math::Size2i&);
+
+            //! Bind an offscreen buffer as the render target, with a
+            //! viewport and transform that cover it.
+            void pushTarget(const std::shared_ptr<Texture>&);
+
+            //! Restore the previous render target.
+            void popTarget();
+
+            //! Get the texture for an image.
+            std::shared_ptr<Texture> getTexture(
+                const std::shared_ptr<image::Image>&,
+                const timeline::ImageOptions&);
+
+            //! Add a glyph to the glyph pages.
+            bool addGlyph(const std::shared_ptr<image::Glyph>&, GlyphItem&);
+
+            //! Draw a mesh with the current transform.
+            void drawMesh(
+                const geom::TriangleMesh2&, const math::Vector2i& position,
+                const Blend&, const FragmentFunc&);
+
+            //! Get whether a texture drawn in a box should use linear
+            //! filtering, by comparing the size on screen to the size of the
+            //! texture.
+            bool isLinear(
+                const Texture&, const math::Box2i&,
+                const timeline::ImageFilters&) const;
+
+            //! Draw a box with texture coordinates covering the box.
+            void drawBox(
+                const math::Box2i&, const Blend&, const FragmentFunc&,
+                bool flipU = false, bool flipV = false);
+
+            //! Draw a texture in a box.
+            void drawTexture(
+                const Texture&, const math::Box2i&, const image::Color4f&,
+                const timeline::ImageFilters&, const Blend&,
+                const image::Mirror& = image::Mirror());
+
+            //! Apply the display options to an offscreen buffer.
+            void display(Texture&, const timeline::DisplayOptions&);
+        };
+    } // namespace timeline_cpu
+} // namespace tl
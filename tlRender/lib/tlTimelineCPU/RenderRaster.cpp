@@ -0,0 +1,391 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlIO/ThreadPool.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        Blend::Blend(BlendFactor src, BlendFactor dst) :
+            srcRGB(src),
+            dstRGB(dst),
+            srcAlpha(src),
+            dstAlpha(dst)
+        {
+        }
+
+        Blend::Blend(
+            BlendFactor srcRGB, BlendFactor dstRGB, BlendFactor srcAlpha,
+            BlendFactor dstAlpha) :
+            srcRGB(srcRGB),
+            dstRGB(dstRGB),
+            srcAlpha(srcAlpha),
+            dstAlpha(dstAlpha)
+        {
+        }
+
+        Blend getBlend(timeline::AlphaBlend value)
+        {
+            Blend out;
+            switch (value)
+            {
+            case timeline::AlphaBlend::kNone:
+                out = Blend(BlendFactor::One, BlendFactor::Zero);
+                break;
+            case timeline::AlphaBlend::Straight:
+                out = Blend(
+                    BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha,
+                    BlendFactor::One, BlendFactor::OneMinusSrcAlpha);
+                break;
+            case timeline::AlphaBlend::Premultiplied:
+                out = Blend(
+                    BlendFactor::One, BlendFactor::OneMinusSrcAlpha,
+                    BlendFactor::One, BlendFactor::OneMinusSrcAlpha);
+                break;
+            default:
+                break;
+            }
+            return out;
+        }
+
+        namespace
+        {
+            // The blend factors are written as "a + b * srcAlpha" so that
+            // the blending loop has no branches and can be vectorized.
+            void getFactor(BlendFactor value, float& a, float& b)
+            {
+                switch (value)
+                {
+                case BlendFactor::Zero:
+                    a = 0.F;
+                    b = 0.F;
+                    break;
+                case BlendFactor::One:
+                    a = 1.F;
+                    b = 0.F;
+                    break;
+                case BlendFactor::SrcAlpha:
+                    a = 0.F;
+                    b = 1.F;
+                    break;
+                case BlendFactor::OneMinusSrcAlpha:
+                    a = 1.F;
+                    b = -1.F;
+                    break;
+                }
+            }
+        } // namespace
+
+        void blendSpan(
+            const Blend& blend, const float* src, float* dst, size_t count,
+            const uint8_t* stencil)
+        {
+            if (!blend.enabled)
+            {
+                if (!stencil)
+                {
+                    std::memcpy(dst, src, count * 4 * sizeof(float));
+                }
+                else
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        if (stencil[i])
+                        {
+                            std::memcpy(
+                                dst + i * 4, src + i * 4, 4 * sizeof(float));
+                        }
+                    }
+                }
+                return;
+            }
+
+            float srcRGB[2];
+            float dstRGB[2];
+            float srcAlpha[2];
+            float dstAlpha[2];
+            getFactor(blend.srcRGB, srcRGB[0], srcRGB[1]);
+            getFactor(blend.dstRGB, dstRGB[0], dstRGB[1]);
+            getFactor(blend.srcAlpha, srcAlpha[0], srcAlpha[1]);
+            getFactor(blend.dstAlpha, dstAlpha[0], dstAlpha[1]);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float* s = src + i * 4;
+                float* d = dst + i * 4;
+                const float a = s[3];
+                const float sc = srcRGB[0] + srcRGB[1] * a;
+                const float dc = dstRGB[0] + dstRGB[1] * a;
+                const float sa = srcAlpha[0] + srcAlpha[1] * a;
+                const float da = dstAlpha[0] + dstAlpha[1] * a;
+                const float m = stencil ? (stencil[i] ? 1.F : 0.F) : 1.F;
+                d[0] += m * (s[0] * sc + d[0] * dc - d[0]);
+                d[1] += m * (s[1] * sc + d[1] * dc - d[1]);
+                d[2] += m * (s[2] * sc + d[2] * dc - d[2]);
+                d[3] += m * (a * sa + d[3] * da - d[3]);
+            }
+        }
+
+        void parallelRows(
+            int rows, size_t rowsPerChunk,
+            const std::function<void(int begin, int end)>& func)
+        {
+            if (rows <= 0)
+                return;
+            if (static_cast<size_t>(rows) <= rowsPerChunk)
+            {
+                func(0, rows);
+                return;
+            }
+            io::ThreadPool::getGlobal()->parallelFor(
+                rows, rowsPerChunk, [&func](size_t begin, size_t end)
+                { func(static_cast<int>(begin), static_cast<int>(end)); });
+        }
+
+        void rasterize(
+            const math::Box2i& bounds, const RasterVertex& a,
+            const RasterVertex& b, const RasterVertex& c,
+            const SpanFunc& func)
+        {
+            const RasterVertex* v[3] = {&a, &b, &c};
+            float area = (v[1]->pos.x - v[0]->pos.x) *
+                             (v[2]->pos.y - v[0]->pos.y) -
+                         (v[1]->pos.y - v[0]->pos.y) *
+                             (v[2]->pos.x - v[0]->pos.x);
+            if (!std::isfinite(area) || 0.F == area)
+                return;
+            if (area < 0.F)
+            {
+                std::swap(v[1], v[2]);
+                area = -area;
+            }
+
+            // Edge equations, "w = A * x + B * y + C", are positive inside
+            // the triangle. Pixels that fall exactly on an edge are only
+            // drawn for top and left edges, so triangles that share an edge
+            // do not blend it twice.
+            float A[3];
+            float B[3];
+            float C[3];
+            bool topLeft[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                const math::Vector2f& p0 = v[(i + 1) % 3]->pos;
+                const math::Vector2f& p1 = v[(i + 2) % 3]->pos;
+                A[i] = -(p1.y - p0.y);
+                B[i] = p1.x - p0.x;
+                C[i] = -A[i] * p0.x - B[i] * p0.y;
+                topLeft[i] = A[i] > 0.F || (0.F == A[i] && B[i] > 0.F);
+            }
+
+            // Attribute plane equations.
+            float attrX[rasterAttrCount];
+            float attrY[rasterAttrCount];
+            float attrC[rasterAttrCount];
+            for (size_t k = 0; k < rasterAttrCount; ++k)
+            {
+                attrX[k] = 0.F;
+                attrY[k] = 0.F;
+                attrC[k] = 0.F;
+                for (int i = 0; i < 3; ++i)
+                {
+                    const float value =
+                        k < 2 ? v[i]->t[k] : v[i]->c[k - 2];
+                    attrX[k] += A[i] / area * value;
+                    attrY[k] += B[i] / area * value;
+                    attrC[k] += C[i] / area * value;
+                }
+            }
+
+            const float minX =
+                std::min(std::min(v[0]->pos.x, v[1]->pos.x), v[2]->pos.x);
+            const float maxX =
+                std::max(std::max(v[0]->pos.x, v[1]->pos.x), v[2]->pos.x);
+            const float minY =
+                std::min(std::min(v[0]->pos.y, v[1]->pos.y), v[2]->pos.y);
+            const float maxY =
+                std::max(std::max(v[0]->pos.y, v[1]->pos.y), v[2]->pos.y);
+            const int x0 = std::max(
+                bounds.min.x,
+                static_cast<int>(std::max(std::floor(minX), -1.E9F)));
+            const int x1 = std::min(
+                bounds.max.x,
+                static_cast<int>(std::min(std::ceil(maxX), 1.E9F)));
+            const int y0 = std::max(
+                bounds.min.y,
+                static_cast<int>(std::max(std::floor(minY), -1.E9F)));
+            const int y1 = std::min(
+                bounds.max.y,
+                static_cast<int>(std::min(std::ceil(maxY), 1.E9F)));
+            if (x0 > x1 || y0 > y1)
+                return;
+
+            const auto rows = [&](int begin, int end)
+            {
+                float attr[rasterAttrCount];
+                for (int y = y0 + begin; y < y0 + end; ++y)
+                {
+                    const float py = y + .5F;
+                    float r[3];
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        r[i] = B[i] * py + C[i];
+                    }
+                    const auto inside = [&A, &r, &topLeft](int x)
+                    {
+                        const float px = x + .5F;
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            const float w = A[i] * px + r[i];
+                            if (w < 0.F || (0.F == w && !topLeft[i]))
+                                return false;
+                        }
+                        return true;
+                    };
+
+                    // Estimate the span from the edge equations, then
+                    // adjust the ends with the exact test.
+                    float spanMin = static_cast<float>(x0);
+                    float spanMax = static_cast<float>(x1);
+                    bool empty = false;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        if (A[i] > 0.F)
+                        {
+                            spanMin = std::max(spanMin, -r[i] / A[i] - .5F);
+                        }
+                        else if (A[i] < 0.F)
+                        {
+                            spanMax = std::min(spanMax, -r[i] / A[i] - .5F);
+                        }
+                        else if (r[i] < 0.F || (0.F == r[i] && !topLeft[i]))
+                        {
+                            empty = true;
+                        }
+                    }
+                    if (empty || spanMin > spanMax + 1.F)
+                        continue;
+                    int xs = std::max(
+                        x0, static_cast<int>(std::floor(spanMin)) - 1);
+                    int xe = std::min(
+                        x1, static_cast<int>(std::ceil(spanMax)) + 1);
+                    while (xs <= xe && !inside(xs))
+                    {
+                        ++xs;
+                    }
+                    while (xe >= xs && !inside(xe))
+                    {
+                        --xe;
+                    }
+                    if (xs > xe)
+                        continue;
+
+                    const float px = xs + .5F;
+                    for (size_t k = 0; k < rasterAttrCount; ++k)
+                    {
+                        attr[k] = attrX[k] * px + attrY[k] * py + attrC[k];
+                    }
+                    func(y, xs, xe - xs + 1, attr, attrX);
+                }
+            };
+
+            const int rowCount = y1 - y0 + 1;
+            if (static_cast<int64_t>(rowCount) * (x1 - x0 + 1) < 65536)
+            {
+                rows(0, rowCount);
+            }
+            else
+            {
+                parallelRows(rowCount, 16, rows);
+            }
+        }
+
+        void drawTriangle(
+            const Target& target, const math::Box2i& bounds,
+            const RasterVertex& a, const RasterVertex& b,
+            const RasterVertex& c, const Blend& blend,
+            const FragmentFunc& fragment)
+        {
+            rasterize(
+                bounds, a, b, c,
+                [&target, &blend, &fragment](
+                    int y, int x, int count, const float* attr,
+                    const float* dAttr)
+                {
+                    thread_local std::vector<float> span;
+                    if (span.size() < static_cast<size_t>(count) * 4)
+                    {
+                        span.resize(static_cast<size_t>(count) * 4);
+                    }
+                    fragment(y, x, count, attr, dAttr, span.data());
+                    const size_t offset =
+                        static_cast<size_t>(y) * target.w + x;
+                    blendSpan(
+                        blend, span.data(), target.data + offset * 4, count,
+                        target.stencil ? target.stencil + offset : nullptr);
+                });
+        }
+
+        void sampleNearest(const Texture& texture, float u, float v, float* out)
+        {
+            const int w = texture.size.w;
+            const int h = texture.size.h;
+            if (w <= 0 || h <= 0)
+            {
+                out[0] = out[1] = out[2] = out[3] = 0.F;
+                return;
+            }
+            const int x = math::clamp(
+                static_cast<int>(std::floor(u * w)), 0, w - 1);
+            const int y = math::clamp(
+                static_cast<int>(std::floor(v * h)), 0, h - 1);
+            const float* p =
+                texture.data.data() + (static_cast<size_t>(y) * w + x) * 4;
+            out[0] = p[0];
+            out[1] = p[1];
+            out[2] = p[2];
+            out[3] = p[3];
+        }
+
+        void sampleLinear(const Texture& texture, float u, float v, float* out)
+        {
+            const int w = texture.size.w;
+            const int h = texture.size.h;
+            if (w <= 0 || h <= 0)
+            {
+                out[0] = out[1] = out[2] = out[3] = 0.F;
+                return;
+            }
+            const float fx = u * w - .5F;
+            const float fy = v * h - .5F;
+            const float floorX = std::floor(fx);
+            const float floorY = std::floor(fy);
+            const float ax = fx - floorX;
+            const float ay = fy - floorY;
+            const int x0 = math::clamp(static_cast<int>(floorX), 0, w - 1);
+            const int x1 = math::clamp(static_cast<int>(floorX) + 1, 0, w - 1);
+            const int y0 = math::clamp(static_cast<int>(floorY), 0, h - 1);
+            const int y1 = math::clamp(static_cast<int>(floorY) + 1, 0, h - 1);
+            const float* data = texture.data.data();
+            const float* p00 = data + (static_cast<size_t>(y0) * w + x0) * 4;
+            const float* p10 = data + (static_cast<size_t>(y0) * w + x1) * 4;
+            const float* p01 = data + (static_cast<size_t>(y1) * w + x0) * 4;
+            const float* p11 = data + (static_cast<size_t>(y1) * w + x1) * 4;
+            for (int i = 0; i < 4; ++i)
+            {
+                const float top = p00[i] + (p10[i] - p00[i]) * ax;
+                const float bottom = p01[i] + (p11[i] - p01[i]) * ax;
+                out[i] = top + (bottom - top) * ay;
+            }
+        }
+    } // namespace timeline_cpu
+} // namespace tl
@@ -0,0 +1,485 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Math.h>
+#include <tlCore/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        namespace
+        {
+            template <typename T> float toFloat(T value);
+
+            template <> inline float toFloat(uint8_t value)
+            {
+                return value / 255.F;
+            }
+
+            template <> inline float toFloat(uint16_t value)
+            {
+                return value / 65535.F;
+            }
+
+            template <> inline float toFloat(uint32_t value)
+            {
+                return static_cast<float>(value / 4294967295.0);
+            }
+
+            template <> inline float toFloat(half value)
+            {
+                return static_cast<float>(value);
+            }
+
+            template <> inline float toFloat(float value)
+            {
+                return value;
+            }
+
+            template <typename T, int C>
+            void readRow(const uint8_t* in, int w, float* out)
+            {
+                const T* p = reinterpret_cast<const T*>(in);
+                for (int x = 0; x < w; ++x, p += C, out += 4)
+                {
+                    out[0] = toFloat<T>(p[0]);
+                    if constexpr (C > 1)
+                        out[1] = toFloat<T>(p[1]);
+                    else
+                        out[1] = 0.F;
+                    if constexpr (C > 2)
+                        out[2] = toFloat<T>(p[2]);
+                    else
+                        out[2] = 0.F;
+                    if constexpr (C > 3)
+                        out[3] = toFloat<T>(p[3]);
+                    else
+                        out[3] = 1.F;
+                }
+            }
+
+            // Packed the same as GL_UNSIGNED_INT_10_10_10_2.
+            void readRowU10(const uint8_t* in, int w, float* out)
+            {
+                const uint32_t* p = reinterpret_cast<const uint32_t*>(in);
+                for (int x = 0; x < w; ++x, ++p, out += 4)
+                {
+                    out[0] = ((*p >> 22) & 1023) / 1023.F;
+                    out[1] = ((*p >> 12) & 1023) / 1023.F;
+                    out[2] = ((*p >> 2) & 1023) / 1023.F;
+                    out[3] = 1.F;
+                }
+            }
+
+            // Packed the same as GL_BGRA and
+            // GL_UNSIGNED_SHORT_4_4_4_4_REV.
+            void readRowARGB4444(const uint8_t* in, int w, float* out)
+            {
+                const uint16_t* p = reinterpret_cast<const uint16_t*>(in);
+                for (int x = 0; x < w; ++x, ++p, out += 4)
+                {
+                    out[0] = ((*p >> 8) & 15) / 15.F;
+                    out[1] = ((*p >> 4) & 15) / 15.F;
+                    out[2] = (*p & 15) / 15.F;
+                    out[3] = ((*p >> 12) & 15) / 15.F;
+                }
+            }
+
+            void readRow(
+                image::PixelType pixelType, const uint8_t* in, int w,
+                float* out)
+            {
+                switch (pixelType)
+                {
+                case image::PixelType::L_U8:
+                    readRow<uint8_t, 1>(in, w, out);
+                    break;
+                case image::PixelType::L_U16:
+                    readRow<uint16_t, 1>(in, w, out);
+                    break;
+                case image::PixelType::L_U32:
+                    readRow<uint32_t, 1>(in, w, out);
+                    break;
+                case image::PixelType::L_F16:
+                    readRow<half, 1>(in, w, out);
+                    break;
+                case image::PixelType::L_F32:
+                    readRow<float, 1>(in, w, out);
+                    break;
+                case image::PixelType::LA_U8:
+                    readRow<uint8_t, 2>(in, w, out);
+                    break;
+                case image::PixelType::LA_U16:
+                    readRow<uint16_t, 2>(in, w, out);
+                    break;
+                case image::PixelType::LA_U32:
+                    readRow<uint32_t, 2>(in, w, out);
+                    break;
+                case image::PixelType::LA_F16:
+                    readRow<half, 2>(in, w, out);
+                    break;
+                case image::PixelType::LA_F32:
+                    readRow<float, 2>(in, w, out);
+                    break;
+                case image::PixelType::RGB_U8:
+                    readRow<uint8_t, 3>(in, w, out);
+                    break;
+                case image::PixelType::RGB_U10:
+                    readRowU10(in, w, out);
+                    break;
+                case image::PixelType::RGB_U16:
+                    readRow<uint16_t, 3>(in, w, out);
+                    break;
+                case image::PixelType::RGB_U32:
+                    readRow<uint32_t, 3>(in, w, out);
+                    break;
+                case image::PixelType::RGB_F16:
+                    readRow<half, 3>(in, w, out);
+                    break;
+                case image::PixelType::RGB_F32:
+                    readRow<float, 3>(in, w, out);
+                    break;
+                case image::PixelType::RGBA_U8:
+                    readRow<uint8_t, 4>(in, w, out);
+                    break;
+                case image::PixelType::RGBA_U16:
+                    readRow<uint16_t, 4>(in, w, out);
+                    break;
+                case image::PixelType::RGBA_U32:
+                    readRow<uint32_t, 4>(in, w, out);
+                    break;
+                case image::PixelType::RGBA_F16:
+                    readRow<half, 4>(in, w, out);
+                    break;
+                case image::PixelType::RGBA_F32:
+                    readRow<float, 4>(in, w, out);
+                    break;
+                case image::PixelType::ARGB_4444_Premult:
+                    readRowARGB4444(in, w, out);
+                    break;
+                default:
+                    std::fill(out, out + static_cast<size_t>(w) * 4, 0.F);
+                    break;
+                }
+            }
+
+            size_t getWordSize(image::PixelType pixelType)
+            {
+                size_t out = 0;
+                switch (pixelType)
+                {
+                case image::PixelType::RGB_U10:
+                    out = 4;
+                    break;
+                case image::PixelType::ARGB_4444_Premult:
+                    out = 2;
+                    break;
+                default:
+                    out = image::getBitDepth(pixelType) / 8;
+                    break;
+                }
+                return out;
+            }
+
+            size_t getPixelByteCount(image::PixelType pixelType)
+            {
+                size_t out = 0;
+                switch (pixelType)
+                {
+                case image::PixelType::RGB_U10:
+                case image::PixelType::ARGB_4444_Premult:
+                    out = getWordSize(pixelType);
+                    break;
+                default:
+                    out = image::getChannelCount(pixelType) *
+                          getWordSize(pixelType);
+                    break;
+                }
+                return out;
+            }
+
+            void convertPacked(
+                const std::shared_ptr<image::Image>& image,
+                image::VideoLevels videoLevels, Texture& out)
+            {
+                const auto& info = image->getInfo();
+                const int w = info.size.w;
+                const int h = info.size.h;
+                const size_t wordSize = getWordSize(info.pixelType);
+                const size_t pixelByteCount =
+                    getPixelByteCount(info.pixelType);
+                const size_t rowByteCount = image::getAlignedByteCount(
+                    w * pixelByteCount, info.layout.alignment);
+                const bool swap =
+                    wordSize > 1 && info.layout.endian != memory::getEndian();
+                const int channels = image::getChannelCount(info.pixelType);
+                const uint8_t* data = image->getData();
+                parallelRows(
+                    h, 16,
+                    [&](int begin, int end)
+                    {
+                        std::vector<uint8_t> tmp(swap ? rowByteCount : 0);
+                        for (int y = begin; y < end; ++y)
+                        {
+                            // The rows are stored from the bottom up unless
+                            // the image is mirrored.
+                            const int sy = info.layout.mirror.y ? y : (h - 1 - y);
+                            const uint8_t* row = data + sy * rowByteCount;
+                            if (swap)
+                            {
+                                memory::endian(
+                                    row, tmp.data(),
+                                    w * pixelByteCount / wordSize, wordSize);
+                                row = tmp.data();
+                            }
+                            float* outRow =
+                                out.data.data() + static_cast<size_t>(y) * w * 4;
+                            readRow(info.pixelType, row, w, outRow);
+                            for (int x = 0; x < w; ++x)
+                            {
+                                float* c = outRow + x * 4;
+                                if (image::VideoLevels::LegalRange ==
+                                    videoLevels)
+                                {
+                                    c[0] = (c[0] - (16.F / 255.F)) *
+                                           (255.F / (235.F - 16.F));
+                                    c[1] = (c[1] - (16.F / 255.F)) *
+                                           (255.F / (240.F - 16.F));
+                                    c[2] = (c[2] - (16.F / 255.F)) *
+                                           (255.F / (240.F - 16.F));
+                                }
+                                if (1 == channels)
+                                {
+                                    c[1] = c[2] = c[0];
+                                    c[3] = 1.F;
+                                }
+                                else if (2 == channels)
+                                {
+                                    c[3] = c[1];
+                                    c[1] = c[2] = c[0];
+                                }
+                                else if (3 == channels)
+                                {
+                                    c[3] = 1.F;
+                                }
+                            }
+                            if (info.layout.mirror.x)
+                            {
+                                for (int x = 0; x < w / 2; ++x)
+                                {
+                                    std::swap_ranges(
+                                        outRow + x * 4, outRow + x * 4 + 4,
+                                        outRow + (w - 1 - x) * 4);
+                                }
+                            }
+                        }
+                    });
+            }
+
+            void convertYUV(
+                const std::shared_ptr<image::Image>& image,
+                image::VideoLevels videoLevels, Texture& out)
+            {
+                const auto& info = image->getInfo();
+                const int w = info.size.w;
+                const int h = info.size.h;
+                int bitDepth = 8;
+                int shiftX = 0;
+                int shiftY = 0;
+                switch (info.pixelType)
+                {
+                case image::PixelType::YUV_420P_U8:
+                    shiftX = shiftY = 1;
+                    break;
+                case image::PixelType::YUV_422P_U8:
+                    shiftX = 1;
+                    break;
+                case image::PixelType::YUV_420P_U10:
+                    bitDepth = 10;
+                    shiftX = shiftY = 1;
+                    break;
+                case image::PixelType::YUV_422P_U10:
+                    bitDepth = 10;
+                    shiftX = 1;
+                    break;
+                case image::PixelType::YUV_444P_U10:
+                    bitDepth = 10;
+                    break;
+                case image::PixelType::YUV_420P_U12:
+                    bitDepth = 12;
+                    shiftX = shiftY = 1;
+                    break;
+                case image::PixelType::YUV_422P_U12:
+                    bitDepth = 12;
+                    shiftX = 1;
+                    break;
+                case image::PixelType::YUV_444P_U12:
+                    bitDepth = 12;
+                    break;
+                case image::PixelType::YUV_420P_U16:
+                    bitDepth = 16;
+                    shiftX = shiftY = 1;
+                    break;
+                case image::PixelType::YUV_422P_U16:
+                    bitDepth = 16;
+                    shiftX = 1;
+                    break;
+                case image::PixelType::YUV_444P_U16:
+                    bitDepth = 16;
+                    break;
+                default:
+                    break;
+                }
+                const size_t byteCount = bitDepth > 8 ? 2 : 1;
+
+                // Images that own their data store the planes one after the
+                // other, images that reference decoder frames have separate
+                // planes and line sizes.
+                const int cw = shiftX ? (w >> shiftX) : w;
+                const int ch = shiftY ? (h >> shiftY) : h;
+                const uint8_t* planes[3] = {nullptr, nullptr, nullptr};
+                size_t lineSizes[3] = {0, 0, 0};
+                int planeWidths[3] = {w, cw, cw};
+                int planeHeights[3] = {h, ch, ch};
+                if (1 == image->getPlaneCount())
+                {
+                    const uint8_t* data = image->getData();
+                    planes[0] = data;
+                    planes[1] = data + w * h * byteCount;
+                    planes[2] = planes[1] + cw * ch * byteCount;
+                    lineSizes[0] = w * byteCount;
+                    lineSizes[1] = lineSizes[2] = cw * byteCount;
+                }
+                else
+                {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        planes[i] = image->getPlaneData(i);
+                        lineSizes[i] = image->getLineSize(i);
+                        if (i > 0)
+                        {
+                            planeWidths[i] = (w + (1 << shiftX) - 1) >> shiftX;
+                            planeHeights[i] = (h + (1 << shiftY) - 1) >> shiftY;
+                        }
+                    }
+                }
+                if (!planes[0] || !planes[1] || !planes[2])
+                {
+                    std::fill(out.data.begin(), out.data.end(), 0.F);
+                    return;
+                }
+
+                const math::Vector4f coefficients =
+                    image::getYUVCoefficients(info.yuvCoefficients);
+                const float maxValue = std::pow(2.F, bitDepth) - 1.F;
+                const float range = std::pow(2.F, bitDepth - 8);
+                const auto read = [byteCount](const uint8_t* row, int x)
+                {
+                    return byteCount > 1
+                               ? static_cast<float>(
+                                     reinterpret_cast<const uint16_t*>(row)[x])
+                               : static_cast<float>(row[x]);
+                };
+                parallelRows(
+                    h, 16,
+                    [&](int begin, int end)
+                    {
+                        for (int y = begin; y < end; ++y)
+                        {
+                            const int sy = info.layout.mirror.y ? y : (h - 1 - y);
+                            const uint8_t* rows[3];
+                            for (int i = 0; i < 3; ++i)
+                            {
+                                const int py = std::min(
+                                    i > 0 ? (sy >> shiftY) : sy,
+                                    planeHeights[i] - 1);
+                                rows[i] = planes[i] + py * lineSizes[i];
+                            }
+                            float* c =
+                                out.data.data() + static_cast<size_t>(y) * w * 4;
+                            for (int x = 0; x < w; ++x, c += 4)
+                            {
+                                const int sx =
+                                    info.layout.mirror.x ? (w - 1 - x) : x;
+                                const int cx =
+                                    std::min(sx >> shiftX, planeWidths[1] - 1);
+                                float yv = read(rows[0], sx);
+                                float cb = read(rows[1], cx);
+                                float cr = read(rows[2], cx);
+                                if (image::VideoLevels::LegalRange ==
+                                    videoLevels)
+                                {
+                                    yv = math::clamp(
+                                        (yv - 16.F * range) /
+                                            ((235.F - 16.F) * range),
+                                        0.F, 1.F);
+                                    cb = math::clamp(
+                                             (cb - 16.F * range) /
+                                                 ((240.F - 16.F) * range),
+                                             0.F, 1.F) -
+                                         .5F;
+                                    cr = math::clamp(
+                                             (cr - 16.F * range) /
+                                                 ((240.F - 16.F) * range),
+                                             0.F, 1.F) -
+                                         .5F;
+                                }
+                                else
+                                {
+                                    yv /= maxValue;
+                                    cb = cb / maxValue - .5F;
+                                    cr = cr / maxValue - .5F;
+                                }
+                                c[0] = yv + coefficients.x * cr;
+                                c[1] = yv - coefficients.y * cr -
+                                       coefficients.z * cb;
+                                c[2] = yv + coefficients.w * cb;
+                                c[3] = 1.F;
+                            }
+                        }
+                    });
+            }
+        } // namespace
+
+        void convertImage(
+            const std::shared_ptr<image::Image>& image,
+            image::VideoLevels videoLevels, Texture& out)
+        {
+            const auto& info = image->getInfo();
+            out.size = math::Size2i(info.size.w, info.size.h);
+            out.videoLevels = videoLevels;
+            out.data.resize(
+                static_cast<size_t>(std::max(info.size.w, 0)) *
+                std::max(info.size.h, 0) * 4);
+            if (out.data.empty())
+                return;
+            switch (info.pixelType)
+            {
+            case image::PixelType::YUV_420P_U8:
+            case image::PixelType::YUV_422P_U8:
+            case image::PixelType::YUV_444P_U8:
+            case image::PixelType::YUV_420P_U10:
+            case image::PixelType::YUV_422P_U10:
+            case image::PixelType::YUV_444P_U10:
+            case image::PixelType::YUV_420P_U12:
+            case image::PixelType::YUV_422P_U12:
+            case image::PixelType::YUV_444P_U12:
+            case image::PixelType::YUV_420P_U16:
+            case image::PixelType::YUV_422P_U16:
+            case image::PixelType::YUV_444P_U16:
+                convertYUV(image, videoLevels, out);
+                break;
+            default:
+                convertPacked(image, videoLevels, out);
+                break;
+            }
+        }
+    } // namespace timeline_cpu
+} // namespace tl
@@ -0,0 +1,832 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPU/RenderPrivate.h>
+
+#include <tlCore/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace tl
+{
+    namespace timeline_cpu
+    {
+        void Render::drawVideo(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions,
+            const timeline::BackgroundOptions& backgroundOptions)
+        {
+            if (!videoFrame.empty() && !videoFrame.front().layers.empty())
+            {
+                _drawBackground(boxes, backgroundOptions);
+            }
+            switch (compareOptions.mode)
+            {
+            case timeline::CompareMode::A:
+                _drawVideoA(
+                    videoFrame, boxes, imageOptions, displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::B:
+                _drawVideoB(
+                    videoFrame, boxes, imageOptions, displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Wipe:
+                _drawVideoWipe(
+                    videoFrame, boxes, imageOptions, displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Overlay:
+                _drawVideoOverlay(
+                    videoFrame, boxes, imageOptions, displayOptions,
+                    compareOptions);
+                break;
+            case timeline::CompareMode::Difference:
+            case timeline::CompareMode::Multiply:
+            case timeline::CompareMode::Add:
+                if (videoFrame.size() > 1)
+                {
+                    _drawVideoCompare(
+                        videoFrame, boxes, imageOptions, displayOptions,
+                        compareOptions);
+                }
+                else
+                {
+                    _drawVideoA(
+                        videoFrame, boxes, imageOptions, displayOptions,
+                        compareOptions);
+                }
+                break;
+            case timeline::CompareMode::Horizontal:
+            case timeline::CompareMode::Vertical:
+            case timeline::CompareMode::Tile:
+                _drawVideoTile(
+                    videoFrame, boxes, imageOptions, displayOptions,
+                    compareOptions);
+                break;
+            default:
+                break;
+            }
+        }
+
+        void Render::_drawBackground(
+            const std::vector<math::Box2i>& boxes,
+            const timeline::BackgroundOptions& options)
+        {
+            for (const auto& box : boxes)
+            {
+                switch (options.type)
+                {
+                case timeline::Background::Solid:
+                    drawRect(box, options.color0);
+                    break;
+                case timeline::Background::Checkers:
+                    drawColorMesh(
+                        geom::checkers(
+                            box, options.color0, options.color1,
+                            options.checkersSize),
+                        math::Vector2i(), image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                case timeline::Background::Gradient:
+                {
+                    geom::TriangleMesh2 mesh;
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.min.y));
+                    mesh.v.push_back(math::Vector2f(box.max.x, box.max.y));
+                    mesh.v.push_back(math::Vector2f(box.min.x, box.max.y));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color0.r, options.color0.g, options.color0.b,
+                        options.color0.a));
+                    mesh.c.push_back(math::Vector4f(
+                        options.color1.r, options.color1.g, options.color1.b,
+                        options.color1.a));
+                    mesh.triangles.push_back({
+                        geom::Vertex2(1, 0, 1),
+                        geom::Vertex2(2, 0, 1),
+                        geom::Vertex2(3, 0, 2),
+                    });
+                    mesh.triangles.push_back({
+                        geom::Vertex2(3, 0, 2),
+                        geom::Vertex2(4, 0, 2),
+                        geom::Vertex2(1, 0, 1),
+                    });
+                    drawColorMesh(
+                        mesh, math::Vector2i(), image::Color4f(1.F, 1.F, 1.F));
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+        }
+
+        void Render::_drawVideoA(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (!videoFrame.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoFrame[0], boxes[0],
+                    !imageOptions.empty()
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[0])
+                        : nullptr,
+                    !displayOptions.empty() ? displayOptions[0]
+                                            : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoB(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            if (videoFrame.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoFrame[1], boxes[1],
+                    imageOptions.size() > 1
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[1])
+                        : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1]
+                                              : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideoWipe(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            float radius = 0.F;
+            float x = 0.F;
+            float y = 0.F;
+            if (!boxes.empty())
+            {
+                radius = std::max(boxes[0].w(), boxes[0].h()) * 2.5F;
+                x = boxes[0].w() * compareOptions.wipeCenter.x;
+                y = boxes[0].h() * compareOptions.wipeCenter.y;
+            }
+            const float rotation = compareOptions.wipeRotation;
+            math::Vector2f pts[4];
+            for (size_t i = 0; i < 4; ++i)
+            {
+                float rad = math::deg2rad(rotation + 90.F * i + 90.F);
+                pts[i].x = cos(rad) * radius + x;
+                pts[i].y = sin(rad) * radius + y;
+            }
+
+            // The stencil takes the place of the GL stencil buffer, only
+            // the pixels covered by the wipe triangle are written.
+            const math::Box2i bounds = p.getBounds();
+            const auto setStencil = [&p, &bounds](
+                                        const math::Vector2f& a,
+                                        const math::Vector2f& b,
+                                        const math::Vector2f& c)
+            {
+                p.stencil.assign(
+                    static_cast<size_t>(p.target.w) * p.target.h, 0);
+                RasterVertex v[3];
+                v[0].pos = p.toScreen(a, p.transform);
+                v[1].pos = p.toScreen(b, p.transform);
+                v[2].pos = p.toScreen(c, p.transform);
+                rasterize(
+                    bounds, v[0], v[1], v[2],
+                    [&p](int y, int x, int count, const float*, const float*)
+                    {
+                        std::fill_n(
+                            p.stencil.data() +
+                                static_cast<size_t>(y) * p.target.w + x,
+                            count, 1);
+                    });
+                p.target.stencil = p.stencil.data();
+            };
+
+            setStencil(pts[0], pts[1], pts[2]);
+            if (!videoFrame.empty() && !boxes.empty())
+            {
+                _drawVideo(
+                    videoFrame[0], boxes[0],
+                    !imageOptions.empty()
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[0])
+                        : nullptr,
+                    !displayOptions.empty() ? displayOptions[0]
+                                            : timeline::DisplayOptions());
+            }
+
+            setStencil(pts[2], pts[3], pts[0]);
+            if (videoFrame.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoFrame[1], boxes[1],
+                    imageOptions.size() > 1
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[1])
+                        : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1]
+                                              : timeline::DisplayOptions());
+            }
+
+            p.target.stencil = nullptr;
+        }
+
+        void Render::_drawVideoOverlay(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+
+            if (videoFrame.size() > 1 && boxes.size() > 1)
+            {
+                _drawVideo(
+                    videoFrame[1], boxes[1],
+                    imageOptions.size() > 1
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[1])
+                        : nullptr,
+                    displayOptions.size() > 1 ? displayOptions[1]
+                                              : timeline::DisplayOptions());
+            }
+            if (!videoFrame.empty() && !boxes.empty())
+            {
+                const math::Size2i bufferSize(boxes[0].w(), boxes[0].h());
+                const auto buffer = p.getBuffer("overlay", bufferSize);
+                std::fill(buffer->data.begin(), buffer->data.end(), 0.F);
+                p.pushTarget(buffer);
+                _drawVideo(
+                    videoFrame[0],
+                    math::Box2i(0, 0, bufferSize.w, bufferSize.h),
+                    !imageOptions.empty()
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[0])
+                        : nullptr,
+                    !displayOptions.empty() ? displayOptions[0]
+                                            : timeline::DisplayOptions());
+                p.popTarget();
+
+                p.drawTexture(
+                    *buffer, boxes[0],
+                    image::Color4f(1.F, 1.F, 1.F, compareOptions.overlay),
+                    !displayOptions.empty()
+                        ? displayOptions[0].imageFilters
+                        : timeline::ImageFilters(),
+                    Blend(
+                        BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha,
+                        BlendFactor::One, BlendFactor::One));
+            }
+        }
+
+        void Render::_drawVideoCompare(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            TLRENDER_P();
+            if (videoFrame.size() < 2 || boxes.empty())
+                return;
+
+            const math::Size2i bufferSize(boxes[0].w(), boxes[0].h());
+            std::shared_ptr<Texture> buffers[2];
+            for (size_t i = 0; i < 2; ++i)
+            {
+                buffers[i] = p.getBuffer(
+                    "compare" + std::to_string(i), bufferSize);
+                std::fill(
+                    buffers[i]->data.begin(), buffers[i]->data.end(), 0.F);
+                p.pushTarget(buffers[i]);
+                _drawVideo(
+                    videoFrame[i],
+                    math::Box2i(0, 0, bufferSize.w, bufferSize.h),
+                    i < imageOptions.size()
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[i])
+                        : nullptr,
+                    i < displayOptions.size() ? displayOptions[i]
+                                              : timeline::DisplayOptions());
+                p.popTarget();
+            }
+
+            // The result replaces the destination, the same as drawing with
+            // blending disabled.
+            Blend blend;
+            blend.enabled = false;
+            const bool linear = p.isLinear(
+                *buffers[0], boxes[0],
+                !displayOptions.empty() ? displayOptions[0].imageFilters
+                                        : timeline::ImageFilters());
+            const timeline::CompareMode mode = compareOptions.mode;
+            const Texture& a = *buffers[0];
+            const Texture& b = *buffers[1];
+            p.drawBox(
+                boxes[0], blend,
+                [&a, &b, mode, linear](
+                    int, int, int count, const float* attr,
+                    const float* dAttr, float* out)
+                {
+                    float c[4];
+                    for (int i = 0; i < count; ++i, out += 4)
+                    {
+                        const float u = attr[0] + dAttr[0] * i;
+                        const float v = attr[1] + dAttr[1] * i;
+                        if (linear)
+                        {
+                            sampleLinear(a, u, v, out);
+                            sampleLinear(b, u, v, c);
+                        }
+                        else
+                        {
+                            sampleNearest(a, u, v, out);
+                            sampleNearest(b, u, v, c);
+                        }
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            switch (mode)
+                            {
+                            case timeline::CompareMode::Difference:
+                                out[j] = std::fabs(out[j] - c[j]);
+                                break;
+                            case timeline::CompareMode::Add:
+                                out[j] = out[j] + c[j];
+                                break;
+                            case timeline::CompareMode::Multiply:
+                                out[j] = out[j] * c[j];
+                                break;
+                            default:
+                                break;
+                            }
+                        }
+                        out[3] = std::max(out[3], c[3]);
+                    }
+                });
+        }
+
+        void Render::_drawVideoTile(
+            const std::vector<timeline::VideoFrame>& videoFrame,
+            const std::vector<math::Box2i>& boxes,
+            const std::vector<timeline::ImageOptions>& imageOptions,
+            const std::vector<timeline::DisplayOptions>& displayOptions,
+            const timeline::CompareOptions& compareOptions)
+        {
+            for (size_t i = 0; i < videoFrame.size() && i < boxes.size(); ++i)
+            {
+                _drawVideo(
+                    videoFrame[i], boxes[i],
+                    i < imageOptions.size()
+                        ? std::make_shared<timeline::ImageOptions>(
+                              imageOptions[i])
+                        : nullptr,
+                    i < displayOptions.size() ? displayOptions[i]
+                                              : timeline::DisplayOptions());
+            }
+        }
+
+        void Render::_drawVideo(
+            const timeline::VideoFrame& videoFrame, const math::Box2i& box,
+            const std::shared_ptr<timeline::ImageOptions>& imageOptions,
+            const timeline::DisplayOptions& displayOptions)
+        {
+            TLRENDER_P();
+
+            const math::Size2i bufferSize = box.getSize();
+            if (bufferSize.w <= 0 || bufferSize.h <= 0)
+                return;
+
+            // The box a layer occupies within the offscreen buffer. Without
+            // OTIO spatial coordinates a layer fills the buffer; with them it
+            // keeps its place in the timeline canvas, scaled to the buffer.
+            const auto layerBox = [&videoFrame, &bufferSize](
+                const std::optional<math::Box2f>& bounds)
+            {
+                math::Box2i out(math::Vector2i(), bufferSize);
+                if (bounds.has_value() && videoFrame.canvasSize.isValid())
+                {
+                    const float sx = bufferSize.w /
+                        static_cast<float>(videoFrame.canvasSize.w);
+                    const float sy = bufferSize.h /
+                        static_cast<float>(videoFrame.canvasSize.h);
+                    out = math::Box2i(
+                        math::Vector2i(
+                            std::lround(bounds.value().min.x * sx),
+                            std::lround(bounds.value().min.y * sy)),
+                        math::Vector2i(
+                            std::lround(bounds.value().max.x * sx),
+                            std::lround(bounds.value().max.y * sy)));
+                }
+                return out;
+            };
+
+            const math::Box2i bufferBox(0, 0, bufferSize.w, bufferSize.h);
+            const auto video = p.getBuffer("video", bufferSize);
+            std::fill(video->data.begin(), video->data.end(), 0.F);
+            p.pushTarget(video);
+
+            bool clearRenderPass = true;
+            for (const auto& layer : videoFrame.layers)
+            {
+                switch (layer.transition)
+                {
+                case timeline::Transition::Dissolve:
+                {
+                    if (layer.image && layer.imageB)
+                    {
+                        const auto dissolve =
+                            p.getBuffer("dissolve", bufferSize);
+                        std::fill(
+                            dissolve->data.begin(), dissolve->data.end(), 0.F);
+                        p.pushTarget(dissolve);
+                        auto dissolveImageOptions =
+                            imageOptions.get() ? *imageOptions
+                                               : layer.imageOptions;
+                        dissolveImageOptions.alphaBlend =
+                            timeline::AlphaBlend::Straight;
+                        drawImage(
+                            layer.image,
+                            getBox(
+                                layerBox(layer.bounds), layer.image->getInfo(),
+                                displayOptions.aspect),
+                            image::Color4f(
+                                1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            dissolveImageOptions);
+                        p.popTarget();
+
+                        const auto dissolve2 =
+                            p.getBuffer("dissolve2", bufferSize);
+                        std::fill(
+                            dissolve2->data.begin(), dissolve2->data.end(),
+                            0.F);
+                        p.pushTarget(dissolve2);
+                        dissolveImageOptions =
+                            imageOptions.get() ? *imageOptions
+                                               : layer.imageOptionsB;
+                        dissolveImageOptions.alphaBlend =
+                            timeline::AlphaBlend::Straight;
+                        drawImage(
+                            layer.imageB,
+                            getBox(
+                                layerBox(layer.boundsB),
+                                layer.imageB->getInfo(),
+                                displayOptions.aspect),
+                            image::Color4f(
+                                1.F, 1.F, 1.F, layer.transitionValue),
+                            dissolveImageOptions);
+                        p.popTarget();
+
+                        Blend blend;
+                        Blend blend2;
+                        if (clearRenderPass)
+                        {
+                            blend.enabled = false;
+                            blend2 = Blend(BlendFactor::One, BlendFactor::One);
+                        }
+                        else
+                        {
+                            blend = Blend(
+                                BlendFactor::One, BlendFactor::OneMinusSrcAlpha,
+                                BlendFactor::One, BlendFactor::One);
+                            blend2 = Blend(
+                                BlendFactor::One,
+                                BlendFactor::OneMinusSrcAlpha);
+                        }
+                        p.drawTexture(
+                            *dissolve, bufferBox, image::Color4f(1.F, 1.F, 1.F),
+                            displayOptions.imageFilters, blend);
+                        p.drawTexture(
+                            *dissolve2, bufferBox,
+                            image::Color4f(1.F, 1.F, 1.F),
+                            displayOptions.imageFilters, blend2);
+                    }
+                    else if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            getBox(
+                                layerBox(layer.bounds), layer.image->getInfo(),
+                                displayOptions.aspect),
+                            image::Color4f(
+                                1.F, 1.F, 1.F, 1.F - layer.transitionValue),
+                            imageOptions.get() ? *imageOptions
+                                               : layer.imageOptions);
+                    }
+                    else if (layer.imageB)
+                    {
+                        drawImage(
+                            layer.imageB,
+                            getBox(
+                                layerBox(layer.boundsB),
+                                layer.imageB->getInfo(),
+                                displayOptions.aspect),
+                            image::Color4f(
+                                1.F, 1.F, 1.F, layer.transitionValue),
+                            imageOptions.get() ? *imageOptions
+                                               : layer.imageOptionsB);
+                    }
+                    break;
+                }
+                default:
+                    if (layer.image)
+                    {
+                        drawImage(
+                            layer.image,
+                            getBox(
+                                layerBox(layer.bounds), layer.image->getInfo(),
+                                displayOptions.aspect),
+                            image::Color4f(1.F, 1.F, 1.F),
+                            imageOptions.get() ? *imageOptions
+                                               : layer.imageOptions);
+                    }
+                    break;
+                }
+                clearRenderPass = false;
+            }
+
+            p.popTarget();
+
+            p.display(*video, displayOptions);
+            p.drawTexture(
+                *video, box, image::Color4f(1.F, 1.F, 1.F),
+                displayOptions.imageFilters,
+                Blend(BlendFactor::One, BlendFactor::OneMinusSrcAlpha),
+                displayOptions.mirror);
+        }
+
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return logf(x * f + 1.F) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.F;
+                float f1 = 1.F;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.F;
+                }
+                for (size_t i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.F;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.F;
+            }
+
+#if defined(TLRENDER_OCIO)
+            void apply(
+                const OCIO::ConstCPUProcessorRcPtr& processor, float* data,
+                int w, int h)
+            {
+                OCIO::PackedImageDesc desc(data, w, h, 4);
+                processor->apply(desc);
+            }
+#endif // TLRENDER_OCIO
+        } // namespace
+
+        void Render::Private::display(
+            Texture& buffer, const timeline::DisplayOptions& displayOptions)
+        {
+            // The same steps as the GL display shader, applied to groups of
+            // rows in place.
+            const bool legalRange =
+                image::VideoLevels::LegalRange == displayOptions.videoLevels;
+
+            const bool colorEnabled =
+                displayOptions.color != timeline::Color() &&
+                displayOptions.color.enabled;
+            const math::Vector3f& colorAdd = displayOptions.color.add;
+            const math::Matrix4x4f colorMatrix =
+                colorEnabled ? timeline::color(displayOptions.color)
+                             : math::Matrix4x4f();
+            const bool colorInvert =
+                displayOptions.color.enabled && displayOptions.color.invert;
+
+            const bool exrDisplayEnabled = displayOptions.exrDisplay.enabled;
+            const float levelsGamma = displayOptions.levels.gamma > 0.F
+                                          ? (1.F / displayOptions.levels.gamma)
+                                          : 1000000.F;
+            float exrV = 0.F;
+            float exrD = 0.F;
+            float exrK = 0.F;
+            float exrF = 0.F;
+            float exrS = 0.F;
+            if (exrDisplayEnabled)
+            {
+                exrV = powf(2.F, displayOptions.exrDisplay.exposure + 2.47393F);
+                exrD = displayOptions.exrDisplay.defog;
+                exrK = powf(2.F, displayOptions.exrDisplay.kneeLow);
+                exrF = knee2(
+                    powf(2.F, displayOptions.exrDisplay.kneeHigh) - exrK,
+                    powf(2.F, 3.5F) - exrK);
+                exrS = powf(2.F, -3.5F * levelsGamma);
+            }
+            const float softClip = displayOptions.softClip.enabled
+                                       ? displayOptions.softClip.value
+                                       : 0.F;
+            const timeline::Levels& levels = displayOptions.levels;
+            const timeline::Normalize& normalize = displayOptions.normalize;
+            const timeline::Channels channels = displayOptions.channels;
+            const bool invalidValues = displayOptions.invalidValues;
+
+#if defined(TLRENDER_OCIO)
+            OCIO::ConstCPUProcessorRcPtr ics;
+            OCIO::ConstCPUProcessorRcPtr ocioDisplay;
+            if (ocioData)
+            {
+                ics = ocioData->ics;
+                ocioDisplay = ocioData->display;
+            }
+            OCIO::ConstCPUProcessorRcPtr lut;
+            if (lutData)
+            {
+                lut = lutData->processor;
+            }
+            const bool lutFirst =
+                timeline::LUTOrder::PreColorConfig == lutOptions.order;
+#endif // TLRENDER_OCIO
+
+            const int w = buffer.size.w;
+            parallelRows(
+                buffer.size.h, 16,
+                [&](int begin, int end)
+                {
+                    float* data =
+                        buffer.data.data() + static_cast<size_t>(begin) * w * 4;
+                    const int rows = end - begin;
+                    const size_t count = static_cast<size_t>(rows) * w;
+
+                    if (legalRange)
+                    {
+                        const float scale = (940.F - 64.F) / 1023.F;
+                        const float offset = 64.F / 1023.F;
+                        float* c = data;
+                        for (size_t i = 0; i < count; ++i, c += 4)
+                        {
+                            c[0] = c[0] * scale + offset;
+                            c[1] = c[1] * scale + offset;
+                            c[2] = c[2] * scale + offset;
+                        }
+                    }
+
+#if defined(TLRENDER_OCIO)
+                    if (lut && lutFirst)
+                    {
+                        apply(lut, data, w, rows);
+                    }
+                    if (ics)
+                    {
+                        apply(ics, data, w, rows);
+                    }
+                    if (lut && !lutFirst)
+                    {
+                        apply(lut, data, w, rows);
+                    }
+#endif // TLRENDER_OCIO
+
+                    float* c = data;
+                    for (size_t i = 0; i < count; ++i, c += 4)
+                    {
+                        if (colorEnabled)
+                        {
+                            const float v[4] = {
+                                c[0] + colorAdd.x, c[1] + colorAdd.y,
+                                c[2] + colorAdd.z, 1.F};
+                            for (int j = 0; j < 3; ++j)
+                            {
+                                const float* e = colorMatrix.e + j * 4;
+                                c[j] = v[0] * e[0] + v[1] * e[1] +
+                                       v[2] * e[2] + v[3] * e[3];
+                            }
+                        }
+                        if (colorInvert)
+                        {
+                            c[0] = 1.F - c[0];
+                            c[1] = 1.F - c[1];
+                            c[2] = 1.F - c[2];
+                        }
+                        if (exrDisplayEnabled)
+                        {
+                            for (int j = 0; j < 3; ++j)
+                            {
+                                float x = std::max(0.F, c[j] - exrD) * exrV;
+                                if (x > exrK)
+                                {
+                                    x = exrK + knee(x - exrK, exrF);
+                                }
+                                if (x > 0.F)
+                                {
+                                    x = powf(x, levelsGamma);
+                                }
+                                c[j] = x * exrS;
+                            }
+                        }
+                        if (softClip > 0.F)
+                        {
+                            const float tmp = 1.F - softClip;
+                            for (int j = 0; j < 3; ++j)
+                            {
+                                if (c[j] > tmp)
+                                {
+                                    c[j] = tmp + (1.F - expf(-(c[j] - tmp) /
+                                                             softClip)) *
+                                                     softClip;
+                                }
+                            }
+                        }
+                    }
+
+#if defined(TLRENDER_OCIO)
+                    if (ocioDisplay)
+                    {
+                        apply(ocioDisplay, data, w, rows);
+                    }
+#endif // TLRENDER_OCIO
+
+                    c = data;
+                    for (size_t i = 0; i < count; ++i, c += 4)
+                    {
+                        if (levels.enabled)
+                        {
+                            const float range = levels.inHigh - levels.inLow;
+                            for (int j = 0; j < 3; ++j)
+                            {
+                                const float x = math::clamp(
+                                    (c[j] - levels.inLow) / range, 0.F, 1.F);
+                                c[j] = powf(x, levelsGamma) * levels.outHigh +
+                                       levels.outLow;
+                            }
+                        }
+                        if (normalize.enabled)
+                        {
+                            for (int j = 0; j < 4; ++j)
+                            {
+                                c[j] = (c[j] - normalize.minimum[j]) /
+                                       (normalize.maximum[j] -
+                                        normalize.minimum[j]);
+                            }
+                        }
+                        if (invalidValues &&
+                            (c[0] < 0.F || c[0] > 1.F || c[1] < 0.F ||
+                             c[1] > 1.F || c[2] < 0.F || c[2] > 1.F ||
+                             c[3] < 0.F || c[3] > 1.F))
+                        {
+                            c[0] = 1.F;
+                            c[1] *= .5F;
+                            c[2] *= .5F;
+                        }
+                        switch (channels)
+                        {
+                        case timeline::Channels::Red:
+                            c[1] = c[2] = c[0];
+                            break;
+                        case timeline::Channels::Green:
+                            c[0] = c[2] = c[1];
+                            break;
+                        case timeline::Channels::Blue:
+                            c[0] = c[1] = c[2];
+                            break;
+                        case timeline::Channels::Alpha:
+                            c[0] = c[1] = c[2] = c[3];
+                            break;
+                        case timeline::Channels::Lumma:
+                            c[0] = c[1] = c[2] = (c[0] + c[1] + c[2]) / 3.F;
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                });
+        }
+    } // namespace timeline_cpu
+} // namespace tl
@@ -15,6 +15,7 @@
 #include <tlCore/Assert.h>
 #include <tlCore/Context.h>
 #include <tlCore/Error.h>
+#include <tlCore/FileInfo.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
 
@@ -39,6 +40,11 @@ namespace tl
         namespace
         {
             const int pboSizeMin = 1024;
+            const size_t displayShaderCacheMax = 16;
+#if defined(TLRENDER_OCIO)
+            const size_t ocioCacheMax = 16;
+            const size_t lutCacheMax = 4;
+#endif // TLRENDER_OCIO
         }
 
         std::vector<std::shared_ptr<gl::Texture> > getTextures(
@@ -611,6 +617,12 @@ namespace tl
             p.glyphTextureAtlas = gl::TextureAtlas::create(
                 1, 4096, image::PixelType::L_U8, timeline::ImageFilter::Linear);
 
+#if defined(TLRENDER_OCIO)
+            p.ocioCache.setMax(ocioCacheMax);
+            p.lutCache.setMax(lutCacheMax);
+#endif // TLRENDER_OCIO
+            p.displayShaderCache.setMax(displayShaderCacheMax);
+
             p.logTimer = std::chrono::steady_clock::now();
         }
 
@@ -619,7 +631,10 @@ namespace tl
         {
         }
 
-        Render::~Render() {}
+        Render::~Render()
+        {
+            _ocioPrebuildStop();
+        }
 
         std::shared_ptr<Render> Render::create(
             const std::shared_ptr<system::Context>& context,
@@ -1371,158 +1386,265 @@ namespace tl
                 }
             }
 #endif
-        } // namespace
-
-        void Render::setOCIOOptions(const timeline::OCIOOptions& value)
-        {
-            TLRENDER_P();
-            if (value == p.ocioOptions)
-                return;
 
 #if defined(TLRENDER_OCIO)
-            p.ocioData.reset();
-#endif // TLRENDER_OCIO
-
-            p.ocioOptions = value;
-
-#if defined(TLRENDER_OCIO)
-            if (p.ocioOptions.enabled)
+            //! Get the size and modification time of a file, so that the
+            //! data for a file that has been edited is created again.
+            std::string getFileStamp(const std::string& fileName)
             {
-                p.ocioData.reset(new OCIOData);
+                const file::Path path(fileName);
+                const file::FileInfo info(path);
+                return std::to_string(info.getSize()) + ':' +
+                       std::to_string(info.getTime());
+            }
 
-                if (!p.ocioOptions.fileName.empty())
-                {
-                    p.ocioData->config = OCIO::Config::CreateFromFile(
-                        p.ocioOptions.fileName.c_str());
-                }
-                else
-                {
-                    p.ocioData->config = OCIO::GetCurrentConfig();
-                }
-                if (!p.ocioData->config)
-                {
-                    throw std::runtime_error("Cannot get OCIO configuration");
-                }
+            std::string getOCIOKey(
+                const OCIO::ConstConfigRcPtr& config,
+                const timeline::OCIOOptions& options)
+            {
+                // The configuration is kept alive by the data that uses the
+                // key, so its address cannot be reused while the key exists.
+                return std::to_string(
+                           reinterpret_cast<uintptr_t>(config.get())) +
+                       '\n' + options.input + '\n' + options.display + '\n' +
+                       options.view + '\n' + options.look;
+            }
 
-                p.ocioData->transform = OCIO::DisplayViewTransform::Create();
-                if (!p.ocioData->transform)
+            //! Create the OpenColorIO data. The textures are not created
+            //! since that requires the OpenGL context, so this can also be
+            //! called from a background thread.
+            std::shared_ptr<OCIOData> createOCIOData(
+                const OCIO::ConstConfigRcPtr& config,
+                const timeline::OCIOOptions& options)
+            {
+                auto out = std::make_shared<OCIOData>();
+                out->config = config;
+                out->transform = OCIO::DisplayViewTransform::Create();
+                if (!out->transform)
                 {
-                    p.ocioData.reset();
                     throw std::runtime_error("Cannot create OCIO transform");
                 }
-                if (!p.ocioOptions.input.empty())
+                if (!options.input.empty())
                 {
                     OCIO::ConstColorSpaceRcPtr srcCS =
-                        p.ocioData->config->getColorSpace(
-                            p.ocioOptions.input.c_str());
+                        config->getColorSpace(options.input.c_str());
                     OCIO::ConstColorSpaceRcPtr dstCS =
-                        p.ocioData->config->getColorSpace(
-                            OCIO::ROLE_SCENE_LINEAR);
-                    p.ocioData->processor = p.ocioData->config->getProcessor(
-                        p.ocioData->config->getCurrentContext(), srcCS, dstCS);
-                    if (!p.ocioData->processor)
+                        config->getColorSpace(OCIO::ROLE_SCENE_LINEAR);
+                    out->processor = config->getProcessor(
+                        config->getCurrentContext(), srcCS, dstCS);
+                    if (!out->processor)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error("Cannot get OCIO processor");
                     }
-
-                    p.ocioData->gpuProcessor =
-                        p.ocioData->processor->getOptimizedGPUProcessor(
+                    out->gpuProcessor =
+                        out->processor->getOptimizedGPUProcessor(
                             OCIO::OPTIMIZATION_DEFAULT);
-                    if (!p.ocioData->gpuProcessor)
+                    if (!out->gpuProcessor)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error(
                             "Cannot get OCIO GPU processor for ICS");
                     }
-                    p.ocioData->icsDesc =
-                        OCIO::GpuShaderDesc::CreateShaderDesc();
-                    if (!p.ocioData->icsDesc)
+                    out->icsDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                    if (!out->icsDesc)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error(
                             "Cannot create OCIO ICS shader description");
                     }
-
-                    p.ocioData->icsDesc->setLanguage(
-                        OCIO::GPU_LANGUAGE_GLSL_4_0);
-                    p.ocioData->icsDesc->setFunctionName("ocioICSFunc");
-                    p.ocioData->icsDesc->setResourcePrefix("ocioICS"); // ocio?
-                    p.ocioData->gpuProcessor->extractGpuShaderInfo(
-                        p.ocioData->icsDesc);
-                    try
-                    {
-                        addGPUTextures(
-                            p.ocioData->textures, p.ocioData->icsDesc);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        p.ocioData.reset();
-                        throw e;
-                    }
+                    out->icsDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                    out->icsDesc->setFunctionName("ocioICSFunc");
+                    out->icsDesc->setResourcePrefix("ocioICS");
+                    out->gpuProcessor->extractGpuShaderInfo(out->icsDesc);
                 }
-                if (!p.ocioOptions.display.empty() &&
-                    !p.ocioOptions.view.empty())
+                if (!options.display.empty() && !options.view.empty())
                 {
-                    p.ocioData->transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
-                    p.ocioData->transform->setDisplay(
-                        p.ocioOptions.display.c_str());
-                    p.ocioData->transform->setView(p.ocioOptions.view.c_str());
+                    out->transform->setSrc(OCIO::ROLE_SCENE_LINEAR);
+                    out->transform->setDisplay(options.display.c_str());
+                    out->transform->setView(options.view.c_str());
 
-                    p.ocioData->lvp = OCIO::LegacyViewingPipeline::Create();
-                    if (!p.ocioData->lvp)
+                    out->lvp = OCIO::LegacyViewingPipeline::Create();
+                    if (!out->lvp)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error(
                             "Cannot create OCIO viewing pipeline");
                     }
-                    p.ocioData->lvp->setDisplayViewTransform(
-                        p.ocioData->transform);
-                    const bool hasLooks = !p.ocioOptions.look.empty();
-                    p.ocioData->lvp->setLooksOverrideEnabled(hasLooks);
-                    p.ocioData->lvp->setLooksOverride(
-                        p.ocioOptions.look.c_str());
-                    p.ocioData->processor = p.ocioData->lvp->getProcessor(
-                        p.ocioData->config,
-                        p.ocioData->config->getCurrentContext());
-                    if (!p.ocioData->processor)
+                    out->lvp->setDisplayViewTransform(out->transform);
+                    const bool hasLooks = !options.look.empty();
+                    out->lvp->setLooksOverrideEnabled(hasLooks);
+                    out->lvp->setLooksOverride(options.look.c_str());
+                    out->processor = out->lvp->getProcessor(
+                        config, config->getCurrentContext());
+                    if (!out->processor)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error("Cannot get OCIO processor");
                     }
-                    p.ocioData->gpuProcessor =
-                        p.ocioData->processor->getOptimizedGPUProcessor(
+                    out->gpuProcessor =
+                        out->processor->getOptimizedGPUProcessor(
                             OCIO::OPTIMIZATION_DEFAULT);
-                    if (!p.ocioData->gpuProcessor)
+                    if (!out->gpuProcessor)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error(
                             "Cannot get OCIO GPU processor");
                     }
-                    p.ocioData->shaderDesc =
-                        OCIO::GpuShaderDesc::CreateShaderDesc();
-                    if (!p.ocioData->shaderDesc)
+                    out->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                    if (!out->shaderDesc)
                     {
-                        p.ocioData.reset();
                         throw std::runtime_error(
                             "Cannot create OCIO shader description");
                     }
-                    p.ocioData->shaderDesc->setLanguage(
-                        OCIO::GPU_LANGUAGE_GLSL_4_0);
-                    p.ocioData->shaderDesc->setFunctionName("ocioDisplayFunc");
-                    p.ocioData->shaderDesc->setResourcePrefix("ocio");
-                    p.ocioData->gpuProcessor->extractGpuShaderInfo(
-                        p.ocioData->shaderDesc);
-                    try
+                    out->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                    out->shaderDesc->setFunctionName("ocioDisplayFunc");
+                    out->shaderDesc->setResourcePrefix("ocio");
+                    out->gpuProcessor->extractGpuShaderInfo(out->shaderDesc);
+                }
+                return out;
+            }
+
+            void addGPUTextures(const std::shared_ptr<OCIOData>& data)
+            {
+                if (data->icsDesc)
+                {
+                    addGPUTextures(data->textures, data->icsDesc);
+                }
+                if (data->shaderDesc)
+                {
+                    addGPUTextures(data->textures, data->shaderDesc);
+                }
+            }
+
+            std::shared_ptr<OCIOLUTData>
+            createLUTData(const timeline::LUTOptions& options)
+            {
+                auto out = std::make_shared<OCIOLUTData>();
+                out->config = OCIO::Config::CreateRaw();
+                if (!out->config)
+                {
+                    throw std::runtime_error(
+                        "Cannot create OCIO configuration");
+                }
+                out->transform = OCIO::FileTransform::Create();
+                if (!out->transform)
+                {
+                    throw std::runtime_error("Cannot create OCIO transform");
+                }
+                out->transform->setSrc(options.fileName.c_str());
+                out->transform->validate();
+
+                out->processor = out->config->getProcessor(out->transform);
+                if (!out->processor)
+                {
+                    throw std::runtime_error("Cannot get OCIO processor");
+                }
+                out->gpuProcessor = out->processor->getDefaultGPUProcessor();
+                if (!out->gpuProcessor)
+                {
+                    throw std::runtime_error("Cannot get OCIO GPU processor");
+                }
+                out->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+                if (!out->shaderDesc)
+                {
+                    throw std::runtime_error(
+                        "Cannot create OCIO shader description");
+                }
+                out->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+                out->shaderDesc->setFunctionName("lutFunc");
+                out->shaderDesc->setResourcePrefix("lut");
+                out->gpuProcessor->extractGpuShaderInfo(out->shaderDesc);
+                addGPUTextures(out->textures, out->shaderDesc);
+                return out;
+            }
+#endif // TLRENDER_OCIO
+        } // namespace
+
+        void Render::setOCIOPrebuild(bool value)
+        {
+            TLRENDER_P();
+#if defined(TLRENDER_OCIO)
+            if (value == p.ocioPrebuild.enabled)
+                return;
+            p.ocioPrebuild.enabled = value;
+            if (p.ocioPrebuild.enabled && p.ocioData)
+            {
+                _ocioPrebuildStart();
+            }
+            else
+            {
+                _ocioPrebuildStop();
+            }
+#endif // TLRENDER_OCIO
+        }
+
+        void Render::setOCIOOptions(const timeline::OCIOOptions& value)
+        {
+            TLRENDER_P();
+            if (value == p.ocioOptions)
+                return;
+
+#if defined(TLRENDER_OCIO)
+            p.ocioData.reset();
+#endif // TLRENDER_OCIO
+
+            p.ocioOptions = value;
+
+#if defined(TLRENDER_OCIO)
+            if (p.ocioOptions.enabled)
+            {
+                // Re-use the configuration when only the transform
+                // options have changed and the file has not been edited.
+                OCIO::ConstConfigRcPtr config;
+                std::string fileStamp;
+                if (!p.ocioOptions.fileName.empty())
+                {
+                    fileStamp = getFileStamp(p.ocioOptions.fileName);
+                    if (p.ocioConfig &&
+                        p.ocioOptions.fileName == p.ocioConfigFileName &&
+                        fileStamp == p.ocioConfigFileStamp)
+                    {
+                        config = p.ocioConfig;
+                    }
+                    else
+                    {
+                        config = OCIO::Config::CreateFromFile(
+                            p.ocioOptions.fileName.c_str());
+                    }
+                }
+                else
+                {
+                    config = OCIO::GetCurrentConfig();
+                }
+                if (!config)
+                {
+                    throw std::runtime_error("Cannot get OCIO configuration");
+                }
+                p.ocioConfig = config;
+                p.ocioConfigFileName = p.ocioOptions.fileName;
+                p.ocioConfigFileStamp = fileStamp;
+
+                const std::string key = getOCIOKey(config, p.ocioOptions);
+                std::shared_ptr<OCIOData> ocioData;
+                if (!p.ocioCache.get(key, ocioData))
+                {
                     {
-                        addGPUTextures(
-                            p.ocioData->textures, p.ocioData->shaderDesc);
+                        std::unique_lock<std::mutex> lock(
+                            p.ocioPrebuild.mutex);
+                        const auto i = p.ocioPrebuild.data.find(key);
+                        if (i != p.ocioPrebuild.data.end())
+                        {
+                            ocioData = i->second;
+                            p.ocioPrebuild.data.erase(i);
+                        }
                     }
-                    catch (const std::exception& e)
+                    if (!ocioData)
                     {
-                        p.ocioData.reset();
-                        throw e;
+                        ocioData = createOCIOData(config, p.ocioOptions);
                     }
+                    addGPUTextures(ocioData);
+                    p.ocioCache.add(key, ocioData);
+                }
+                p.ocioData = ocioData;
+
+                if (p.ocioPrebuild.enabled)
+                {
+                    _ocioPrebuildStart();
                 }
             }
 #endif // TLRENDER_OCIO
@@ -1546,64 +1668,92 @@ namespace tl
 #if defined(TLRENDER_OCIO)
             if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
             {
-                p.lutData.reset(new OCIOLUTData);
-
-                p.lutData->config = OCIO::Config::CreateRaw();
-                if (!p.lutData->config)
+                const std::string key = p.lutOptions.fileName + '\n' +
+                                        getFileStamp(p.lutOptions.fileName);
+                std::shared_ptr<OCIOLUTData> lutData;
+                if (!p.lutCache.get(key, lutData))
                 {
-                    throw std::runtime_error(
-                        "Cannot create OCIO configuration");
+                    lutData = createLUTData(p.lutOptions);
+                    p.lutCache.add(key, lutData);
                 }
+                p.lutData = lutData;
+            }
+#endif // TLRENDER_OCIO
 
-                p.lutData->transform = OCIO::FileTransform::Create();
-                if (!p.lutData->transform)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot create OCIO transform");
-                }
-                p.lutData->transform->setSrc(p.lutOptions.fileName.c_str());
-                p.lutData->transform->validate();
+            p.shaders["display"].reset();
+            _displayShader();
+        }
 
-                p.lutData->processor =
-                    p.lutData->config->getProcessor(p.lutData->transform);
-                if (!p.lutData->processor)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot get OCIO processor");
-                }
-                p.lutData->gpuProcessor =
-                    p.lutData->processor->getDefaultGPUProcessor();
-                if (!p.lutData->gpuProcessor)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error("Cannot get OCIO GPU processor");
-                }
-                p.lutData->shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
-                if (!p.lutData->shaderDesc)
-                {
-                    p.lutData.reset();
-                    throw std::runtime_error(
-                        "Cannot create OCIO shader description");
-                }
-                p.lutData->shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
-                p.lutData->shaderDesc->setFunctionName("lutFunc");
-                p.lutData->shaderDesc->setResourcePrefix("lut");
-                p.lutData->gpuProcessor->extractGpuShaderInfo(
-                    p.lutData->shaderDesc);
-                try
-                {
-                    addGPUTextures(p.lutData->textures, p.lutData->shaderDesc);
-                }
-                catch (const std::exception& e)
+        void Render::_ocioPrebuildStart()
+        {
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            timeline::OCIOOptions options = p.ocioOptions;
+            options.view.clear();
+            const std::string key = getOCIOKey(p.ocioConfig, options);
+            if (key == p.ocioPrebuild.key)
+                return;
+            _ocioPrebuildStop();
+            p.ocioPrebuild.key = key;
+
+            // Get the views of the display that are not already cached.
+            std::vector<timeline::OCIOOptions> views;
+            if (!options.display.empty())
+            {
+                const char* display = options.display.c_str();
+                const int count = p.ocioConfig->getNumViews(display);
+                for (int i = 0; i < count && views.size() < ocioCacheMax; ++i)
                 {
-                    p.ocioData.reset();
-                    throw e;
+                    options.view = p.ocioConfig->getView(display, i);
+                    if (!p.ocioCache.contains(
+                            getOCIOKey(p.ocioConfig, options)))
+                    {
+                        views.push_back(options);
+                    }
                 }
             }
+            if (views.empty())
+                return;
+
+            p.ocioPrebuild.running = true;
+            p.ocioPrebuild.thread = std::thread(
+                [this, config = p.ocioConfig, views]
+                {
+                    TLRENDER_P();
+                    for (const auto& options : views)
+                    {
+                        if (!p.ocioPrebuild.running)
+                            break;
+                        try
+                        {
+                            auto data = createOCIOData(config, options);
+                            std::unique_lock<std::mutex> lock(
+                                p.ocioPrebuild.mutex);
+                            p.ocioPrebuild.data[getOCIOKey(config, options)] =
+                                data;
+                        }
+                        catch (const std::exception&)
+                        {
+                            // Errors are reported when the view is used.
+                        }
+                    }
+                });
 #endif // TLRENDER_OCIO
+        }
 
-            p.shaders["display"].reset();
-            _displayShader();
+        void Render::_ocioPrebuildStop()
+        {
+#if defined(TLRENDER_OCIO)
+            TLRENDER_P();
+            p.ocioPrebuild.running = false;
+            if (p.ocioPrebuild.thread.joinable())
+            {
+                p.ocioPrebuild.thread.join();
+            }
+            p.ocioPrebuild.key.clear();
+            std::unique_lock<std::mutex> lock(p.ocioPrebuild.mutex);
+            p.ocioPrebuild.data.clear();
+#endif // TLRENDER_OCIO
         }
 
         void Render::setHDROptions(const timeline::HDROptions& value)
@@ -2092,12 +2242,18 @@ namespace tl
 #if DEBUG_DISPLAY_SHADER
                 std::cerr << source << std::endl;
 #endif
-                if (auto context = _context.lock())
+                std::shared_ptr<gl::Shader> shader;
+                if (!p.displayShaderCache.get(source, shader))
                 {
-                    context->log("tl::gl::GLRender", "Creating display shader");
+                    if (auto context = _context.lock())
+                    {
+                        context->log(
+                            "tl::gl::GLRender", "Creating display shader");
+                    }
+                    shader = gl::Shader::create(vertexSource(), source);
+                    p.displayShaderCache.add(source, shader);
                 }
-                p.shaders["display"] =
-                    gl::Shader::create(vertexSource(), source);
+                p.shaders["display"] = shader;
             }
             p.shaders["display"]->bind();
             p.shaders["display"]->setUniform("transform.mvp", p.transform);
@@ -44,6 +44,12 @@ namespace tl
             //! Get the texture cache.
             const std::shared_ptr<TextureCache>& getTextureCache() const;
 
+            //! Set whether the OpenColorIO data for the other views of the
+            //! current display is built in a background thread, so that
+            //! switching views only needs to upload the textures and
+            //! compile the shader.
+            void setOCIOPrebuild(bool);
+
             void begin(
                 const math::Size2i&, const timeline::RenderOptions& =
                                          timeline::RenderOptions()) override;
@@ -102,6 +108,8 @@ namespace tl
 
         private:
             void _displayShader();
+            void _ocioPrebuildStart();
+            void _ocioPrebuildStop();
 
             void _drawBackground(
                 const std::vector<math::Box2i>&,
@@ -25,7 +25,10 @@ extern "C"
 #    include <OpenColorIO/OpenColorIO.h>
 #endif // TLRENDER_OCIO
 
+#include <atomic>
 #include <list>
+#include <mutex>
+#include <thread>
 
 #if defined(TLRENDER_OCIO)
 namespace OCIO = OCIO_NAMESPACE;
@@ -137,9 +140,31 @@ namespace tl
             float monitorMaxNits = 1000.F;
 
 #if defined(TLRENDER_OCIO)
-            //! \todo Add a cache for OpenColorIO data.
-            std::unique_ptr<OCIOData> ocioData;
-            std::unique_ptr<OCIOLUTData> lutData;
+            std::shared_ptr<OCIOData> ocioData;
+            std::shared_ptr<OCIOLUTData> lutData;
+
+            //! OpenColorIO data cache, keyed by the configuration and
+            //! transform options.
+            OCIO::ConstConfigRcPtr ocioConfig;
+            std::string ocioConfigFileName;
+            std::string ocioConfigFileStamp;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOData> >
+                ocioCache;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOLUTData> >
+                lutCache;
+
+            //! OpenColorIO data for the other views of the display, built
+            //! in a background thread without the textures.
+            struct OCIOPrebuild
+            {
+                bool enabled = false;
+                std::string key;
+                std::map<std::string, std::shared_ptr<OCIOData> > data;
+                std::mutex mutex;
+                std::atomic<bool> running = false;
+                std::thread thread;
+            };
+            OCIOPrebuild ocioPrebuild;
 #endif // TLRENDER_OCIO
 
 #if defined(TLRENDER_LIBPLACEBO)
@@ -152,6 +177,8 @@ namespace tl
             math::Box2i clipRect;
 
             std::map<std::string, std::shared_ptr<gl::Shader> > shaders;
+            memory::LRUCache<std::string, std::shared_ptr<gl::Shader> >
+                displayShaderCache;
             std::map<std::string, std::shared_ptr<gl::OffscreenBuffer> >
                 buffers;
             std::shared_ptr<TextureCache> textureCache;
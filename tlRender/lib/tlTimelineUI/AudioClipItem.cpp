@@ -157,7 +157,7 @@ namespace tl
                         std::future_status::ready)
                 {
                     const auto mesh = i->second.future.get();
-                    const std::string cacheKey = io::getAudioCacheKey(
+                    const io::CacheKey cacheKey = io::getAudioCacheKey(
                         p.path, i->second.timeRange, _data->options.ioOptions,
                         {});
                     _data->waveforms[cacheKey] = mesh;
@@ -287,7 +287,7 @@ namespace tl
                                 _timeRange, trimmedRange,
                                 p.ioInfo->audio.sampleRate);
 
-                        const std::string cacheKey = io::getAudioCacheKey(
+                        const io::CacheKey cacheKey = io::getAudioCacheKey(
                             p.path, mediaRange, _data->options.ioOptions, {});
                         const auto i = _data->waveforms.find(cacheKey);
                         if (i != _data->waveforms.end())
@@ -0,0 +1,522 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#include "ThumbnailDiskCache.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace TIMELINEUI
+    {
+        namespace
+        {
+            const std::string fileHeader = "tlRender thumbnail cache 1";
+            const std::string fileExtension = ".tlc";
+
+            const uint8_t thumbnailType = 0;
+            const uint8_t waveformType = 1;
+
+            const uint32_t maxKeySize = 65536;
+
+            fs::path toPath(const std::string& fileName)
+            {
+#if defined(__cpp_lib_char8_t)
+                return fs::path(
+                    reinterpret_cast<const char8_t*>(fileName.data()),
+                    reinterpret_cast<const char8_t*>(
+                        fileName.data() + fileName.size()));
+#else
+                return fs::u8path(fileName);
+#endif
+            }
+
+            template <typename T>
+            void append(std::vector<uint8_t>& out, const T& value)
+            {
+                const size_t size = out.size();
+                out.resize(size + sizeof(T));
+                std::memcpy(out.data() + size, &value, sizeof(T));
+            }
+
+            void append(
+                std::vector<uint8_t>& out, const uint8_t* data, size_t size)
+            {
+                out.insert(out.end(), data, data + size);
+            }
+
+            class Reader
+            {
+            public:
+                Reader(const std::vector<uint8_t>& data) :
+                    _data(data)
+                {
+                }
+
+                template <typename T> bool read(T& value)
+                {
+                    if (_pos + sizeof(T) > _data.size())
+                        return false;
+                    std::memcpy(&value, _data.data() + _pos, sizeof(T));
+                    _pos += sizeof(T);
+                    return true;
+                }
+
+                bool read(uint8_t* data, size_t size)
+                {
+                    if (_pos + size > _data.size())
+                        return false;
+                    std::memcpy(data, _data.data() + _pos, size);
+                    _pos += size;
+                    return true;
+                }
+
+                size_t getRemaining() const { return _data.size() - _pos; }
+
+            private:
+                const std::vector<uint8_t>& _data;
+                size_t _pos = 0;
+            };
+
+            template <typename T>
+            void appendVectors(
+                std::vector<uint8_t>& out, const std::vector<T>& values,
+                int components)
+            {
+                for (const auto& value : values)
+                {
+                    for (int i = 0; i < components; ++i)
+                    {
+                        append(out, value[i]);
+                    }
+                }
+            }
+
+            template <typename T>
+            bool readVectors(
+                Reader& reader, std::vector<T>& values, uint64_t count,
+                int components)
+            {
+                if (count >
+                    reader.getRemaining() / (components * sizeof(float)))
+                    return false;
+                values.resize(count);
+                for (auto& value : values)
+                {
+                    for (int i = 0; i < components; ++i)
+                    {
+                        if (!reader.read(value[i]))
+                            return false;
+                    }
+                }
+                return true;
+            }
+        } // namespace
+
+        ThumbnailDiskCache::ThumbnailDiskCache() {}
+
+        std::string ThumbnailDiskCache::getDir() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _dir;
+        }
+
+        void ThumbnailDiskCache::setDir(const std::string& value)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (value == _dir)
+                return;
+            _dir = value;
+            _byteCount = 0;
+            _lru.clear();
+            _entries.clear();
+            if (_dir.empty())
+                return;
+
+            // Index the existing files, most recently used first.
+            std::error_code ec;
+            fs::create_directories(toPath(_dir), ec);
+            std::vector<std::pair<fs::file_time_type, std::string> > files;
+            std::map<std::string, size_t> sizes;
+            for (const auto& entry : fs::directory_iterator(toPath(_dir), ec))
+            {
+                if (entry.path().extension() != fileExtension)
+                    continue;
+                std::error_code ec2;
+                const auto size = entry.file_size(ec2);
+                const auto time = entry.last_write_time(ec2);
+                if (ec2)
+                    continue;
+                const std::string fileName =
+                    _dir + '/' + entry.path().filename().string();
+                files.push_back(std::make_pair(time, fileName));
+                sizes[fileName] = size;
+            }
+            std::sort(
+                files.begin(), files.end(),
+                [](const auto& a, const auto& b) { return a.first > b.first; });
+            for (const auto& i : files)
+            {
+                _lru.push_back(i.second);
+                const size_t size = sizes[i.second];
+                _entries[i.second] = std::make_pair(size, --_lru.end());
+                _byteCount += size;
+            }
+            _evict();
+        }
+
+        size_t ThumbnailDiskCache::getMax() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _max;
+        }
+
+        void ThumbnailDiskCache::setMax(size_t value)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _max = value;
+            _evict();
+        }
+
+        size_t ThumbnailDiskCache::getByteCount() const
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            return _byteCount;
+        }
+
+        void ThumbnailDiskCache::addThumbnail(
+            const std::string& key,
+            const std::shared_ptr<image::Image>& image)
+        {
+            if (!image || !image->getData() || !_canAdd(key))
+                return;
+            std::vector<uint8_t> data;
+            const size_t byteCount = image->getDataByteCount();
+            data.reserve(sizeof(int32_t) * 3 + byteCount);
+            append(data, static_cast<int32_t>(image->getWidth()));
+            append(data, static_cast<int32_t>(image->getHeight()));
+            append(data, static_cast<int32_t>(image->getPixelType()));
+            append(data, image->getData(), byteCount);
+            _write(key, thumbnailType, data);
+        }
+
+        bool ThumbnailDiskCache::getThumbnail(
+            const std::string& key, std::shared_ptr<image::Image>& out)
+        {
+            std::vector<uint8_t> data;
+            if (!_read(key, thumbnailType, data))
+                return false;
+            Reader reader(data);
+            int32_t w = 0;
+            int32_t h = 0;
+            int32_t pixelType = 0;
+            if (!reader.read(w) || !reader.read(h) || !reader.read(pixelType))
+                return false;
+            if (w <= 0 || h <= 0 || pixelType <= 0 ||
+                pixelType >= static_cast<int32_t>(image::PixelType::Count))
+                return false;
+            const image::Info info(
+                w, h, static_cast<image::PixelType>(pixelType));
+            if (image::getDataByteCount(info) != reader.getRemaining())
+                return false;
+            auto image = image::Image::create(info);
+            reader.read(image->getData(), image->getDataByteCount());
+            out = image;
+            return true;
+        }
+
+        void ThumbnailDiskCache::addWaveform(
+            const std::string& key,
+            const std::shared_ptr<geom::TriangleMesh2>& mesh)
+        {
+            if (!mesh || !_canAdd(key))
+                return;
+            std::vector<uint8_t> data;
+            append(data, static_cast<uint64_t>(mesh->v.size()));
+            append(data, static_cast<uint64_t>(mesh->c.size()));
+            append(data, static_cast<uint64_t>(mesh->t.size()));
+            append(data, static_cast<uint64_t>(mesh->triangles.size()));
+            appendVectors(data, mesh->v, 2);
+            appendVectors(data, mesh->c, 4);
+            appendVectors(data, mesh->t, 2);
+            for (const auto& triangle : mesh->triangles)
+            {
+                for (const auto& vertex : triangle.v)
+                {
+                    append(data, static_cast<uint32_t>(vertex.v));
+                    append(data, static_cast<uint32_t>(vertex.t));
+                    append(data, static_cast<uint32_t>(vertex.c));
+                }
+            }
+            _write(key, waveformType, data);
+        }
+
+        bool ThumbnailDiskCache::getWaveform(
+            const std::string& key, std::shared_ptr<geom::TriangleMesh2>& out)
+        {
+            std::vector<uint8_t> data;
+            if (!_read(key, waveformType, data))
+                return false;
+            Reader reader(data);
+            uint64_t vCount = 0;
+            uint64_t cCount = 0;
+            uint64_t tCount = 0;
+            uint64_t triangleCount = 0;
+            if (!reader.read(vCount) || !reader.read(cCount) ||
+                !reader.read(tCount) || !reader.read(triangleCount))
+                return false;
+            auto mesh = std::make_shared<geom::TriangleMesh2>();
+            if (!readVectors(reader, mesh->v, vCount, 2) ||
+                !readVectors(reader, mesh->c, cCount, 4) ||
+                !readVectors(reader, mesh->t, tCount, 2))
+                return false;
+            if (triangleCount * 9 * sizeof(uint32_t) != reader.getRemaining())
+                return false;
+            mesh->triangles.resize(triangleCount);
+            for (auto& triangle : mesh->triangles)
+            {
+                for (auto& vertex : triangle.v)
+                {
+                    uint32_t v = 0;
+                    uint32_t t = 0;
+                    uint32_t c = 0;
+                    reader.read(v);
+                    reader.read(t);
+                    reader.read(c);
+                    vertex = geom::Vertex2(v, t, c);
+                }
+            }
+            out = mesh;
+            return true;
+        }
+
+        std::string
+        ThumbnailDiskCache::_getFileName(const std::string& key) const
+        {
+            std::stringstream ss;
+            ss << _dir << '/' << std::hex << std::setfill('0')
+               << std::setw(16) << std::hash<std::string>()(key)
+               << fileExtension;
+            return ss.str();
+        }
+
+        bool ThumbnailDiskCache::_canAdd(const std::string& key) const
+        {
+            // Keys include the file size and modification time, so an
+            // existing entry never needs to be written again.
+            std::unique_lock<std::mutex> lock(_mutex);
+            return !_dir.empty() && _max > 0 &&
+                   _entries.find(_getFileName(key)) == _entries.end();
+        }
+
+        bool ThumbnailDiskCache::_read(
+            const std::string& key, uint8_t type, std::vector<uint8_t>& out)
+        {
+            std::string fileName;
+            size_t byteCount = 0;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_dir.empty())
+                    return false;
+                fileName = _getFileName(key);
+                const auto i = _entries.find(fileName);
+                if (i == _entries.end())
+                    return false;
+                byteCount = i->second.first;
+            }
+
+            bool valid = false;
+            size_t fileSize = 0;
+            {
+                std::ifstream f(toPath(fileName), std::ios::binary);
+                if (!f.is_open())
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _remove(fileName);
+                    return false;
+                }
+                std::string header(fileHeader.size(), 0);
+                f.read(&header[0], header.size());
+                uint8_t fileType = 0;
+                uint32_t keySize = 0;
+                f.read(reinterpret_cast<char*>(&fileType), sizeof(fileType));
+                f.read(reinterpret_cast<char*>(&keySize), sizeof(keySize));
+                std::string fileKey;
+                if (f && header == fileHeader && keySize <= maxKeySize)
+                {
+                    fileKey.resize(keySize);
+                    f.read(&fileKey[0], keySize);
+                }
+                if (f && !fileKey.empty() &&
+                    (fileType != type || fileKey != key))
+                {
+                    // A hash collision with a different key, leave the file
+                    // for the other key.
+                    return false;
+                }
+                uint64_t size = 0;
+                uint64_t compressedSize = 0;
+                f.read(reinterpret_cast<char*>(&size), sizeof(size));
+                f.read(
+                    reinterpret_cast<char*>(&compressedSize),
+                    sizeof(compressedSize));
+                fileSize = fileHeader.size() + sizeof(fileType) +
+                           sizeof(keySize) + keySize + sizeof(size) +
+                           sizeof(compressedSize) + compressedSize;
+                // Check the sizes against the file before allocating, zlib
+                // can not compress by more than a factor of 1032.
+                if (f && fileKey == key && fileSize == byteCount &&
+                    size <= compressedSize * 1032)
+                {
+                    std::vector<uint8_t> compressed(compressedSize);
+                    f.read(
+                        reinterpret_cast<char*>(compressed.data()),
+                        compressedSize);
+                    if (f)
+                    {
+                        out.resize(size);
+                        uLongf outSize = static_cast<uLongf>(size);
+                        valid = uncompress(
+                                    out.data(), &outSize, compressed.data(),
+                                    static_cast<uLong>(compressedSize)) ==
+                                    Z_OK &&
+                                outSize == size;
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (valid)
+            {
+                // Update the modification time so the order is restored
+                // the next time the directory is indexed.
+                std::error_code ec;
+                fs::last_write_time(
+                    toPath(fileName), fs::file_time_type::clock::now(), ec);
+                _touch(fileName, fileSize);
+            }
+            else
+            {
+                _remove(fileName);
+            }
+            return valid;
+        }
+
+        void ThumbnailDiskCache::_write(
+            const std::string& key, uint8_t type,
+            const std::vector<uint8_t>& data)
+        {
+            std::string fileName;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_dir.empty() || 0 == _max)
+                    return;
+                fileName = _getFileName(key);
+            }
+
+            uLongf compressedSize = compressBound(data.size());
+            std::vector<uint8_t> compressed(compressedSize);
+            if (compress2(
+                    compressed.data(), &compressedSize, data.data(),
+                    static_cast<uLong>(data.size()),
+                    Z_DEFAULT_COMPRESSION) != Z_OK)
+                return;
+
+            // Write to a temporary file first so that other threads and
+            // processes never read a partial entry.
+            std::stringstream ss;
+            ss << fileName << "." << std::this_thread::get_id() << ".tmp";
+            const std::string tmpFileName = ss.str();
+            const uint32_t keySize = static_cast<uint32_t>(key.size());
+            const uint64_t size = data.size();
+            const uint64_t compressedSize64 = compressedSize;
+            {
+                std::ofstream f(toPath(tmpFileName), std::ios::binary);
+                if (!f.is_open())
+                    return;
+                f.write(fileHeader.data(), fileHeader.size());
+                f.write(reinterpret_cast<const char*>(&type), sizeof(type));
+                f.write(
+                    reinterpret_cast<const char*>(&keySize), sizeof(keySize));
+                f.write(key.data(), keySize);
+                f.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                f.write(
+                    reinterpret_cast<const char*>(&compressedSize64),
+                    sizeof(compressedSize64));
+                f.write(
+                    reinterpret_cast<const char*>(compressed.data()),
+                    compressedSize);
+                if (!f)
+                {
+                    f.close();
+                    std::error_code ec;
+                    fs::remove(toPath(tmpFileName), ec);
+                    return;
+                }
+            }
+            std::error_code ec;
+            fs::rename(toPath(tmpFileName), toPath(fileName), ec);
+            if (ec)
+            {
+                fs::remove(toPath(tmpFileName), ec);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _touch(
+                fileName, fileHeader.size() + sizeof(type) + sizeof(keySize) +
+                              keySize + sizeof(size) +
+                              sizeof(compressedSize64) + compressedSize);
+            _evict();
+        }
+
+        void ThumbnailDiskCache::_touch(
+            const std::string& fileName, size_t byteCount)
+        {
+            const auto i = _entries.find(fileName);
+            if (i != _entries.end())
+            {
+                _byteCount -= i->second.first;
+                _lru.erase(i->second.second);
+                _entries.erase(i);
+            }
+            _lru.push_front(fileName);
+            _entries[fileName] = std::make_pair(byteCount, _lru.begin());
+            _byteCount += byteCount;
+        }
+
+        void ThumbnailDiskCache::_remove(const std::string& fileName)
+        {
+            const auto i = _entries.find(fileName);
+            if (i != _entries.end())
+            {
+                _byteCount -= i->second.first;
+                _lru.erase(i->second.second);
+                _entries.erase(i);
+            }
+            std::error_code ec;
+            fs::remove(toPath(fileName), ec);
+        }
+
+        void ThumbnailDiskCache::_evict()
+        {
+            while (_byteCount > _max && !_lru.empty())
+            {
+                const std::string fileName = _lru.back();
+                _remove(fileName);
+            }
+        }
+    } // namespace TIMELINEUI
+} // namespace tl
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#pragma once
+
+#include "Namespace.h"
+
+#include <tlCore/Image.h>
+#include <tlCore/Mesh.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace tl
+{
+    namespace TIMELINEUI
+    {
+        //! Thumbnail disk cache.
+        //!
+        //! Each entry is stored in its own zlib compressed file named by a
+        //! hash of the cache key. The full key is stored in the file to
+        //! detect hash collisions. Entries are evicted in least recently
+        //! used order when the total size of the files exceeds the maximum,
+        //! and the file modification times are used to restore that order
+        //! when the directory is opened again.
+        class ThumbnailDiskCache
+        {
+        public:
+            ThumbnailDiskCache();
+
+            //! Get the cache directory.
+            std::string getDir() const;
+
+            //! Set the cache directory. An empty directory disables the
+            //! cache.
+            void setDir(const std::string&);
+
+            //! Get the maximum cache size in bytes.
+            size_t getMax() const;
+
+            //! Set the maximum cache size in bytes.
+            void setMax(size_t);
+
+            //! Get the current cache size in bytes.
+            size_t getByteCount() const;
+
+            //! Add a thumbnail to the cache.
+            void addThumbnail(
+                const std::string& key, const std::shared_ptr<image::Image>&);
+
+            //! Get a thumbnail from the cache.
+            bool getThumbnail(
+                const std::string& key, std::shared_ptr<image::Image>&);
+
+            //! Add a waveform to the cache.
+            void addWaveform(
+                const std::string& key,
+                const std::shared_ptr<geom::TriangleMesh2>&);
+
+            //! Get a waveform from the cache.
+            bool getWaveform(
+                const std::string& key, std::shared_ptr<geom::TriangleMesh2>&);
+
+        private:
+            std::string _getFileName(const std::string& key) const;
+            bool _canAdd(const std::string& key) const;
+            bool _read(
+                const std::string& key, uint8_t type, std::vector<uint8_t>&);
+            void _write(
+                const std::string& key, uint8_t type,
+                const std::vector<uint8_t>&);
+            void _touch(const std::string& fileName, size_t byteCount);
+            void _remove(const std::string& fileName);
+            void _evict();
+
+            std::string _dir;
+            size_t _max = 256 * 1024 * 1024;
+            size_t _byteCount = 0;
+            std::list<std::string> _lru;
+            std::map<
+                std::string,
+                std::pair<size_t, std::list<std::string>::iterator> >
+                _entries;
+            mutable std::mutex _mutex;
+        };
+    } // namespace TIMELINEUI
+} // namespace tl
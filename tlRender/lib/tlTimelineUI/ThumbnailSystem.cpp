@@ -5,6 +5,8 @@
 
 #include "ThumbnailSystem.h"
 
+#include "ThumbnailDiskCache.h"
+
 #include <tlTimeline/Timeline.h>
 
 #include <tlIO/System.h>
@@ -25,10 +27,11 @@
 #endif
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/File.h>
+#include <tlCore/FileInfo.h>
 #include <tlCore/LRUCache.h>
 #include <tlCore/StringFormat.h>
 
-
 #include <sstream>
 
 namespace tl
@@ -38,6 +41,45 @@ namespace tl
         namespace
         {
             const size_t ioCacheMax = 16;
+
+            // The stamp used in the keys of files whose size and
+            // modification time can not be read. Those keys are only kept
+            // in memory, since a modified file would not be noticed.
+            const std::string noFileStamp = "-";
+
+            // Get the file size and modification time with a single stat, so
+            // that the disk cache entries for a modified file are not used.
+            // For sequences the file of the given frame is used, since the
+            // sequence path itself does not exist.
+            std::string
+            getFileStamp(const file::Path& path, const otime::RationalTime& time)
+            {
+                const file::FileInfo fileInfo(
+                    path.hasNumber() && time::isValid(time)
+                        ? file::Path(path.getFrame(
+                              static_cast<int64_t>(time.value()), true))
+                        : path);
+                if (0 == fileInfo.getTime())
+                    return noFileStamp;
+                return string::Format("{0}:{1}")
+                    .arg(fileInfo.getSize())
+                    .arg(fileInfo.getTime());
+            }
+
+            bool hasFileStamp(const std::string& key)
+            {
+                const std::string prefix = noFileStamp + ';';
+                return key.compare(0, prefix.size(), prefix) != 0;
+            }
+        } // namespace
+
+        std::string getThumbnailDiskCacheDir()
+        {
+            const std::string dir = file::getTemp() + "/tlRender";
+            file::mkdir(dir);
+            const std::string out = dir + "/Thumbnails";
+            file::mkdir(out);
+            return out;
         }
 
         struct ThumbnailCache::Private
@@ -49,6 +91,7 @@ namespace tl
             memory::LRUCache<std::string, std::shared_ptr<geom::TriangleMesh2> >
                 waveforms;
             std::mutex mutex;
+            ThumbnailDiskCache disk;
         };
 
         void
@@ -106,6 +149,31 @@ namespace tl
                    100.F;
         }
 
+        std::string ThumbnailCache::getDiskCacheDir() const
+        {
+            return _p->disk.getDir();
+        }
+
+        void ThumbnailCache::setDiskCacheDir(const std::string& value)
+        {
+            _p->disk.setDir(value);
+        }
+
+        size_t ThumbnailCache::getDiskCacheMax() const
+        {
+            return _p->disk.getMax();
+        }
+
+        void ThumbnailCache::setDiskCacheMax(size_t value)
+        {
+            _p->disk.setMax(value);
+        }
+
+        size_t ThumbnailCache::getDiskCacheByteCount() const
+        {
+            return _p->disk.getByteCount();
+        }
+
         std::string ThumbnailCache::getInfoKey(
             const file::Path& path, const io::Options& options)
         {
@@ -147,6 +215,7 @@ namespace tl
             const io::Options& options)
         {
             std::vector<std::string> s;
+            s.push_back(getFileStamp(path, time));
             s.push_back(string::Format("{0}").arg(height));
             s.push_back(path.get());
             s.push_back(string::Format("{0}").arg(time));
@@ -163,8 +232,14 @@ namespace tl
             const std::shared_ptr<image::Image>& thumbnail)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.thumbnails.add(key, thumbnail);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.thumbnails.add(key, thumbnail);
+            }
+            if (hasFileStamp(key))
+            {
+                p.disk.addThumbnail(key, thumbnail);
+            }
         }
 
         bool ThumbnailCache::containsThumbnail(const std::string& key)
@@ -179,8 +254,18 @@ namespace tl
             std::shared_ptr<image::Image>& thumbnail) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.thumbnails.get(key, thumbnail);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.thumbnails.get(key, thumbnail))
+                    return true;
+            }
+            if (hasFileStamp(key) && p.disk.getThumbnail(key, thumbnail))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.thumbnails.add(key, thumbnail);
+                return true;
+            }
+            return false;
         }
 
         std::string ThumbnailCache::getWaveformKey(
@@ -188,6 +273,7 @@ namespace tl
             const otime::TimeRange& timeRange, const io::Options& options)
         {
             std::vector<std::string> s;
+            s.push_back(getFileStamp(path, timeRange.start_time()));
             s.push_back(string::Format("{0}").arg(size));
             s.push_back(path.get());
             s.push_back(string::Format("{0}").arg(timeRange));
@@ -204,8 +290,14 @@ namespace tl
             const std::shared_ptr<geom::TriangleMesh2>& waveform)
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            p.waveforms.add(key, waveform);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.waveforms.add(key, waveform);
+            }
+            if (hasFileStamp(key))
+            {
+                p.disk.addWaveform(key, waveform);
+            }
         }
 
         bool ThumbnailCache::containsWaveform(const std::string& key)
@@ -220,8 +312,18 @@ namespace tl
             std::shared_ptr<geom::TriangleMesh2>& waveform) const
         {
             TLRENDER_P();
-            std::unique_lock<std::mutex> lock(p.mutex);
-            return p.waveforms.get(key, waveform);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                if (p.waveforms.get(key, waveform))
+                    return true;
+            }
+            if (hasFileStamp(key) && p.disk.getWaveform(key, waveform))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.waveforms.add(key, waveform);
+                return true;
+            }
+            return false;
         }
 
         void ThumbnailCache::_maxUpdate()
@@ -54,7 +54,13 @@ namespace tl
             std::future<std::shared_ptr<geom::TriangleMesh2> > future;
         };
 
+        //! Get the default thumbnail disk cache directory.
+        std::string getThumbnailDiskCacheDir();
+
         //! Thumbnail cache.
+        //!
+        //! Thumbnails and waveforms can optionally be stored in a disk cache
+        //! so that they are available when the media is opened again.
         class ThumbnailCache
             : public std::enable_shared_from_this<ThumbnailCache>
         {
@@ -82,6 +88,22 @@ namespace tl
             //! Get the current cache size as a percentage.
             float getPercentage() const;
 
+            //! Get the disk cache directory.
+            std::string getDiskCacheDir() const;
+
+            //! Set the disk cache directory. An empty directory disables the
+            //! disk cache.
+            void setDiskCacheDir(const std::string&);
+
+            //! Get the maximum disk cache size in bytes.
+            size_t getDiskCacheMax() const;
+
+            //! Set the maximum disk cache size in bytes.
+            void setDiskCacheMax(size_t);
+
+            //! Get the current disk cache size in bytes.
+            size_t getDiskCacheByteCount() const;
+
             //! Get an I/O information cache key.
             static std::string
             getInfoKey(const file::Path&, const io::Options&);
@@ -95,7 +117,10 @@ namespace tl
             //! Get I/O information from the cache.
             bool getInfo(const std::string& key, io::Info&) const;
 
-            //! Get a thumbnail cache key.
+            //! Get a thumbnail cache key. The key includes the size and
+            //! modification time of the file, or of the frame's file for
+            //! sequences. Thumbnails for files that can not be found are
+            //! only cached in memory.
             static std::string getThumbnailKey(
                 int height, const file::Path&, const otime::RationalTime&,
                 const io::Options&);
@@ -111,7 +136,8 @@ namespace tl
             bool getThumbnail(
                 const std::string& key, std::shared_ptr<image::Image>&) const;
 
-            //! Get a waveform cache key.
+            //! Get a waveform cache key. The file is checked the same as for
+            //! the thumbnail keys.
             static std::string getWaveformKey(
                 const math::Size2i&, const file::Path&, const otime::TimeRange&,
                 const io::Options&);
@@ -168,7 +168,7 @@ namespace tl
                         std::future_status::ready)
                 {
                     const auto image = i->second.future.get();
-                    const std::string cacheKey =
+                    const io::CacheKey cacheKey =
                         io::getVideoCacheKey(p.path, i->first, p.ioOptions, {});
                     _data->thumbnails[cacheKey] = image;
                     i = p.thumbnailRequests.erase(i);
@@ -296,7 +296,7 @@ namespace tl
                                 time, _timeRange, _trimmedRange,
                                 p.ioInfo->videoTime.duration().rate());
 
-                        const std::string cacheKey = io::getVideoCacheKey(
+                        const io::CacheKey cacheKey = io::getVideoCacheKey(
                             p.path, mediaTime, p.ioOptions, {});
                         const auto i = _data->thumbnails.find(cacheKey);
                         if (i != _data->thumbnails.end())
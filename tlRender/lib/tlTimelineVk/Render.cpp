@@ -12,11 +12,13 @@
 #include <tlVk/Buffer.h>
 #include <tlVk/Vk.h>
 #include <tlVk/Mesh.h>
+#include <tlVk/StagingRing.h>
 #include <tlVk/Util.h>
 
 #include <tlCore/Assert.h>
 #include <tlCore/Context.h>
 #include <tlCore/Error.h>
+#include <tlCore/FileInfo.h>
 #include <tlCore/Monitor.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -49,55 +51,6 @@ namespace
             ((x << 24) & 0xFF000000);
     }
 
-    void computeRGBToRGBA(
-        VkCommandBuffer cmd,
-        const std::shared_ptr<tl::vlk::Shader> shader,
-        const uint8_t* data,
-        const std::size_t size,
-        std::shared_ptr<tl::vlk::Texture> outputRGBA)
-    {
-        uint32_t width = outputRGBA->getWidth();
-        uint32_t height = outputRGBA->getHeight();
-
-        // 1. Update Descriptor Set with the specific resources
-        shader->setStorageBuffer("inputBuffer", data, size);
-        shader->setStorageImage("outputImage", outputRGBA);
-
-        // 2. Barrier: Transition Output Image to GENERAL layout for writing
-        VkImageMemoryBarrier beginBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        beginBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        beginBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL; // Required for storage images
-        beginBarrier.srcAccessMask = 0;
-        beginBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        beginBarrier.image = outputRGBA->getImage();
-        beginBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-
-        vkCmdPipelineBarrier(cmd, 
-                             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 
-                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 
-                             0, 0, nullptr, 0, nullptr, 1, &beginBarrier);
-
-        // 3. Dispatch the Compute Shader
-        uint32_t groupCountX = (width + 15) / 16;
-        uint32_t groupCountY = (height + 15) / 16;
-            
-        shader->dispatch(cmd, groupCountX, groupCountY);
-
-        // 4. Barrier: Transition Output Image to SHADER_READ_ONLY for the Fragment Shader
-        VkImageMemoryBarrier endBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        endBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
-        endBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        endBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-        endBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        endBarrier.image = outputRGBA->getImage();
-        endBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-
-        vkCmdPipelineBarrier(cmd, 
-                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 
-                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 
-                             0, 0, nullptr, 0, nullptr, 1, &endBarrier);
-    }
-    
     // Convert from R10G10B10A2 to Vulkan A2R10G10B10 (ChatGPT)
     void convert_R10G10B10A2_to_A2R10G10B10(
         // DPX buffer (R10G10B10A2) - big endian
@@ -286,6 +239,36 @@ namespace tl
         namespace
         {
             const int pboSizeMin = 1024;
+#if defined(TLRENDER_OCIO)
+            const size_t ocioCacheMax = 16;
+            const size_t lutCacheMax = 4;
+
+            //! Get the size and modification time of a file, so that the
+            //! data for a file that has been edited is created again.
+            std::string getFileStamp(const std::string& fileName)
+            {
+                const file::Path path(fileName);
+                const file::FileInfo info(path);
+                return std::to_string(info.getSize()) + ':' +
+                       std::to_string(info.getTime());
+            }
+
+            std::string getOCIOKey(const timeline::OCIOOptions& options)
+            {
+                // The current configuration is kept alive by the data that
+                // uses the key, so its address cannot be reused while the
+                // key exists.
+                const std::string config =
+                    !options.fileName.empty()
+                        ? options.fileName + '\n' +
+                              getFileStamp(options.fileName)
+                        : std::to_string(reinterpret_cast<uintptr_t>(
+                              OCIO::GetCurrentConfig().get()));
+                return config + '\n' + options.input + '\n' +
+                       options.display + '\n' + options.view + '\n' +
+                       options.look;
+            }
+#endif // TLRENDER_OCIO
         }
 
         std::vector<std::shared_ptr<vlk::Texture> > getTextures(
@@ -596,104 +579,13 @@ namespace tl
                 break;
             }
             case image::PixelType::RGB_U8:
-            {
-                if (textures[0]->getInternalFormat() ==
-                    VK_FORMAT_R8G8B8A8_UNORM)
-                {
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const uint8_t* src = image->getData();
-                    std::vector<uint8_t> dst(w * h * 4);
-                    uint8_t* out = dst.data();
-                    for (std::size_t y = 0; y < h; ++y)
-                    {
-                        for (std::size_t x = 0; x < w; ++x)
-                        {
-                            *out++ = *src++;
-                            *out++ = *src++;
-                            *out++ = *src++;
-
-                            *out++ = 255;
-                        }
-                    }
-                    textures[0]->setRGBToRGBA(false);
-                    textures[0]->copy(dst.data(), dst.size());
-                }
-                else
-                {
-                    textures[0]->copy(image);
-                }
-                break;
-            }
             case image::PixelType::RGB_U16:
-            {
-                if (textures[0]->getInternalFormat() ==
-                    VK_FORMAT_R16G16B16A16_UNORM)
-                {
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    const uint16_t* src =
-                        reinterpret_cast<uint16_t*>(image->getData());
-                    std::vector<uint16_t> dst(w * h * 4);
-                    uint16_t* out = dst.data();
-                    for (std::size_t y = 0; y < h; ++y)
-                    {
-                        for (std::size_t x = 0; x < w; ++x)
-                        {
-                            *out++ = *src++;
-                            *out++ = *src++;
-                            *out++ = *src++;
-
-                            *out++ = 65535;
-                        }
-                    }
-                    textures[0]->setRGBToRGBA(false);
-                    textures[0]->copy(
-                        reinterpret_cast<uint8_t*>(dst.data()),
-                        dst.size() * sizeof(uint16_t));
-                }
-                else
-                {
-                    textures[0]->copy(image);
-                }
-                break;
-            }
             case image::PixelType::RGB_F16:
-            {
-                if (textures[0]->getInternalFormat() ==
-                    VK_FORMAT_R16G16B16A16_SFLOAT)
-                {
-                    const std::size_t w = info.size.w;
-                    const std::size_t h = info.size.h;
-                    _createBindingSet(p.compute["rgbf16_to_rgbaf16"]);
-                    computeRGBToRGBA(p.cmd, p.compute["rgbf16_to_rgbaf16"],
-                                     image->getData(), image->getDataByteCount(),
-                                     textures[0]);
-                    textures[0]->setRGBToRGBA(false);
-                }
-                else
-                {
-                    textures[0]->copy(image);
-                }
-                break;
-            }
             case image::PixelType::RGB_F32:
-            {
-                if (textures[0]->getInternalFormat() ==
-                    VK_FORMAT_R32G32B32A32_SFLOAT)
-                {
-                    _createBindingSet(p.compute["rgbf32_to_rgbaf32"]);
-                    computeRGBToRGBA(p.cmd, p.compute["rgbf32_to_rgbaf32"],
-                                     image->getData(), image->getDataByteCount(),
-                                     textures[0]);
-                    textures[0]->setRGBToRGBA(false);
-                }
-                else
-                {
-                    textures[0]->copy(image);
-                }
+                // The texture expands the data to RGBA when it is written
+                // to the staging buffer.
+                textures[0]->copy(image);
                 break;
-            }
             case image::PixelType::RGB_U10:
             {
                 const std::size_t w = info.size.w;
@@ -909,8 +801,30 @@ namespace tl
                                           [] {
                                               return vlk::Texture::getObjectCount();
                                           });
+                
+                p.statsSystem->addSampler("Vulkan Upload/Bytes: ",
+                                          [] {
+                                              return vlk::Texture::getUploadByteCount();
+                                          });
+                p.statsSystem->addSampler("Vulkan Upload/Blocking Microseconds: ",
+                                          [] {
+                                              return vlk::Texture::getUploadTime().count();
+                                          });
+                p.statsSystem->addSampler("Vulkan Upload/Staging: ",
+                                          [] {
+                                              return vlk::getStagingRingStats().byteCount;
+                                          });
+                p.statsSystem->addSampler("Vulkan Upload/Staging Fallbacks: ",
+                                          [] {
+                                              return vlk::getStagingRingStats().fallbackCount;
+                                          });
             }
             
+#if defined(TLRENDER_OCIO)
+            p.ocioCache.setMax(ocioCacheMax);
+            p.lutCache.setMax(lutCacheMax);
+#endif // TLRENDER_OCIO
+
             p.glyphTextureAtlas = vlk::TextureAtlas::create(
                 ctx, 1, 4096, image::PixelType::L_U8,
                 timeline::ImageFilter::Linear);
@@ -1377,41 +1291,6 @@ namespace tl
                 
                 _createBindingSet(p.shaders["pbr"]);
             }
-            if (!p.compute["rgbf16_to_rgbaf16"])
-            {
-#if USE_PRECOMPILED_SHADERS
-                p.compute["rgbf16_to_rgbaf16"] = vlk::Shader::create(ctx,
-                                                                     rgbf16_to_rgbaf16_Compute_spv,
-                                                                     rgbf16_to_rgbaf16_Compute_spv_len,
-                                                                     "rgbf16_to_rgbaf16");
-#else
-                p.compute["rgbf16_to_rgbaf16"] = vlk::Shader::create(ctx,
-                                                                     computeRGB_F16_To_RGBA_F16(),
-                                                                     "rgbf16_to_rgbaf16");
-#endif
-                p.compute["rgbf16_to_rgbaf16"]->addStorageBuffer("inputBuffer", vlk::kShaderCompute);
-                p.compute["rgbf16_to_rgbaf16"]->addStorageImage("outputImage", vlk::kShaderCompute);
-                _createBindingSet(p.compute["rgbf16_to_rgbaf16"]);
-                p.compute["rgbf16_to_rgbaf16"]->createComputePipeline();
-            }
-            if (!p.compute["rgbf32_to_rgbaf32"])
-            {
-#if USE_PRECOMPILED_SHADERS
-                p.compute["rgbf32_to_rgbaf32"] = vlk::Shader::create(ctx,
-                                                                     rgbf32_to_rgbaf32_Compute_spv,
-                                                                     rgbf32_to_rgbaf32_Compute_spv_len,
-                                                                     "rgbf32_to_rgbaf32");
-#else
-                p.compute["rgbf32_to_rgbaf32"] = vlk::Shader::create(ctx,
-                                                                     computeRGB_F32_To_RGBA_F32(),
-                                                                     "rgbf32_to_rgbaf32");
-#endif
-                p.compute["rgbf32_to_rgbaf32"]->addStorageBuffer("inputBuffer", vlk::kShaderCompute);
-                p.compute["rgbf32_to_rgbaf32"]->addStorageImage("outputImage", vlk::kShaderCompute);
-                _createBindingSet(p.compute["rgbf32_to_rgbaf32"]);
-                p.compute["rgbf32_to_rgbaf32"]->createComputePipeline();
-            }
-            
             if (!p.compute["hdr_peak_detection"])
             {
                 try
@@ -1527,6 +1406,8 @@ namespace tl
             TLRENDER_P();
 
             p.fbo->transitionToShaderRead(p.cmd);
+
+            vlk::trimStagingRing(ctx.allocator);
         }
 
         VkCommandBuffer Render::getCommandBuffer() const
@@ -2202,8 +2083,13 @@ namespace tl
             p.ocioOptions = value;
 
 #if defined(TLRENDER_OCIO)
-            
+            std::string ocioKey;
             if (p.ocioOptions.enabled)
+            {
+                ocioKey = getOCIOKey(p.ocioOptions);
+                p.ocioCache.get(ocioKey, p.ocioData);
+            }
+            if (p.ocioOptions.enabled && !p.ocioData)
             {
                 p.ocioData.reset(new OCIOData);
 
@@ -2355,6 +2241,7 @@ namespace tl
                         throw e;
                     }
                 }
+                p.ocioCache.add(ocioKey, p.ocioData);
             }
 #endif // TLRENDER_OCIO
 
@@ -2375,7 +2262,15 @@ namespace tl
             p.lutOptions = value;
 
 #if defined(TLRENDER_OCIO)
+            std::string lutKey;
             if (p.lutOptions.enabled && !p.lutOptions.fileName.empty())
+            {
+                lutKey = p.lutOptions.fileName + '\n' +
+                         getFileStamp(p.lutOptions.fileName);
+                p.lutCache.get(lutKey, p.lutData);
+            }
+            if (p.lutOptions.enabled && !p.lutOptions.fileName.empty() &&
+                !p.lutData)
             {
                 p.lutData.reset(new OCIOLUTData);
 
@@ -2430,9 +2325,10 @@ namespace tl
                 }
                 catch (const std::exception& e)
                 {
-                    p.ocioData.reset();
+                    p.lutData.reset();
                     throw e;
                 }
+                p.lutCache.add(lutKey, p.lutData);
             }
 #endif // TLRENDER_OCIO
 
@@ -194,8 +194,15 @@ namespace tl
             std::string oldSourceCode;
 
 #if defined(TLRENDER_OCIO)
-            std::unique_ptr<OCIOData> ocioData;
-            std::unique_ptr<OCIOLUTData> lutData;
+            std::shared_ptr<OCIOData> ocioData;
+            std::shared_ptr<OCIOLUTData> lutData;
+
+            //! OpenColorIO data cache, keyed by the configuration and
+            //! transform options.
+            memory::LRUCache<std::string, std::shared_ptr<OCIOData> >
+                ocioCache;
+            memory::LRUCache<std::string, std::shared_ptr<OCIOLUTData> >
+                lutCache;
 #endif // TLRENDER_OCIO
 
 #if defined(TLRENDER_LIBPLACEBO)
@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#include <tlVk/PipelineCache.h>
+
+#include <FL/Fl_Vk_Utils.H>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace vlk
+    {
+        namespace
+        {
+            const std::string fileHeader = "tlRender Vulkan pipeline cache 1";
+
+            //! Size of VkPipelineCacheHeaderVersionOne.
+            const size_t vkHeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+            //! Maximum size of the data in the file.
+            const uint64_t maxByteCount = 256 * 1024 * 1024;
+
+            fs::path toPath(const std::string& fileName)
+            {
+#if defined(__cpp_lib_char8_t)
+                return fs::path(
+                    reinterpret_cast<const char8_t*>(fileName.data()),
+                    reinterpret_cast<const char8_t*>(
+                        fileName.data() + fileName.size()));
+#else
+                return fs::u8path(fileName);
+#endif
+            }
+
+            struct Cache
+            {
+                VkPipelineCache cache = VK_NULL_HANDLE;
+                VkPhysicalDeviceProperties props;
+                std::string fileName;
+                size_t refCount = 0;
+                size_t savedPipelineCount = 0;
+                PipelineCacheStats stats;
+            };
+
+            struct Caches
+            {
+                std::mutex mutex;
+                std::map<VkDevice, Cache> caches;
+            };
+
+            Caches& getCaches()
+            {
+                static Caches caches;
+                return caches;
+            }
+
+            bool isValid(
+                const std::vector<uint8_t>& data,
+                const VkPhysicalDeviceProperties& props)
+            {
+                if (data.size() < vkHeaderSize)
+                    return false;
+                uint32_t header[4];
+                std::memcpy(header, data.data(), sizeof(header));
+                return header[0] >= vkHeaderSize && header[0] <= data.size() &&
+                       VK_PIPELINE_CACHE_HEADER_VERSION_ONE == header[1] &&
+                       props.vendorID == header[2] &&
+                       props.deviceID == header[3] &&
+                       0 == std::memcmp(
+                                data.data() + sizeof(header),
+                                props.pipelineCacheUUID, VK_UUID_SIZE);
+            }
+
+            VkPipelineCache
+            create(VkDevice device, const std::vector<uint8_t>& data)
+            {
+                VkPipelineCacheCreateInfo createInfo = {};
+                createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+                createInfo.initialDataSize = data.size();
+                createInfo.pInitialData = data.empty() ? nullptr : data.data();
+                VkPipelineCache out = VK_NULL_HANDLE;
+                if (vkCreatePipelineCache(device, &createInfo, nullptr, &out) !=
+                    VK_SUCCESS)
+                {
+                    out = VK_NULL_HANDLE;
+                }
+                return out;
+            }
+
+            void save(VkDevice device, Cache& cache)
+            {
+                // Merge the pipelines saved by other windows or sessions
+                // since the file was loaded, so they are not lost.
+                const auto fileData =
+                    readPipelineCache(cache.fileName, cache.props);
+                if (!fileData.empty())
+                {
+                    VkPipelineCache fileCache = create(device, fileData);
+                    if (fileCache != VK_NULL_HANDLE)
+                    {
+                        vkMergePipelineCaches(
+                            device, cache.cache, 1, &fileCache);
+                        vkDestroyPipelineCache(device, fileCache, nullptr);
+                    }
+                }
+
+                size_t size = 0;
+                if (vkGetPipelineCacheData(
+                        device, cache.cache, &size, nullptr) != VK_SUCCESS ||
+                    0 == size || size > maxByteCount)
+                    return;
+                std::vector<uint8_t> data(size);
+                if (vkGetPipelineCacheData(
+                        device, cache.cache, &size, data.data()) != VK_SUCCESS)
+                    return;
+                data.resize(size);
+                writePipelineCache(cache.fileName, cache.props, data);
+            }
+        } // namespace
+
+        std::vector<uint8_t> readPipelineCache(
+            const std::string& fileName,
+            const VkPhysicalDeviceProperties& props)
+        {
+            std::vector<uint8_t> out;
+            std::ifstream f(toPath(fileName), std::ios::binary);
+            if (!f.is_open())
+                return out;
+            std::string header(fileHeader.size(), 0);
+            uint32_t driverVersion = 0;
+            uint64_t size = 0;
+            f.read(header.data(), header.size());
+            f.read(
+                reinterpret_cast<char*>(&driverVersion), sizeof(driverVersion));
+            f.read(reinterpret_cast<char*>(&size), sizeof(size));
+            if (!f || header != fileHeader ||
+                driverVersion != props.driverVersion || size > maxByteCount)
+                return out;
+            out.resize(size);
+            f.read(reinterpret_cast<char*>(out.data()), size);
+            if (!f || !isValid(out, props))
+            {
+                out.clear();
+            }
+            return out;
+        }
+
+        bool writePipelineCache(
+            const std::string& fileName,
+            const VkPhysicalDeviceProperties& props,
+            const std::vector<uint8_t>& data)
+        {
+            std::error_code ec;
+            fs::create_directories(toPath(fileName).parent_path(), ec);
+
+            std::stringstream ss;
+            ss << fileName << "." << std::this_thread::get_id() << ".tmp";
+            const std::string tmpFileName = ss.str();
+            const uint32_t driverVersion = props.driverVersion;
+            const uint64_t size = data.size();
+            {
+                std::ofstream f(toPath(tmpFileName), std::ios::binary);
+                if (!f.is_open())
+                    return false;
+                f.write(fileHeader.data(), fileHeader.size());
+                f.write(
+                    reinterpret_cast<const char*>(&driverVersion),
+                    sizeof(driverVersion));
+                f.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                f.write(
+                    reinterpret_cast<const char*>(data.data()), data.size());
+                if (!f)
+                {
+                    f.close();
+                    fs::remove(toPath(tmpFileName), ec);
+                    return false;
+                }
+            }
+            fs::rename(toPath(tmpFileName), toPath(fileName), ec);
+            if (ec)
+            {
+                fs::remove(toPath(tmpFileName), ec);
+                return false;
+            }
+            return true;
+        }
+
+        void addPipelineCache(
+            VkDevice device, VkPhysicalDevice gpu, const std::string& fileName)
+        {
+            auto& caches = getCaches();
+            std::unique_lock<std::mutex> lock(caches.mutex);
+            auto& cache = caches.caches[device];
+            ++cache.refCount;
+            if (cache.cache != VK_NULL_HANDLE)
+                return;
+
+            const auto t0 = std::chrono::steady_clock::now();
+            vkGetPhysicalDeviceProperties(gpu, &cache.props);
+            cache.fileName = fileName;
+            std::vector<uint8_t> data;
+            if (!fileName.empty())
+            {
+                data = readPipelineCache(fileName, cache.props);
+            }
+            cache.cache = create(device, data);
+            if (cache.cache == VK_NULL_HANDLE && !data.empty())
+            {
+                data.clear();
+                cache.cache = create(device, data);
+            }
+            cache.stats = PipelineCacheStats();
+            cache.stats.loadByteCount = data.size();
+            cache.stats.loadTime =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - t0);
+            cache.savedPipelineCount = 0;
+        }
+
+        void removePipelineCache(VkDevice device)
+        {
+            auto& caches = getCaches();
+            std::unique_lock<std::mutex> lock(caches.mutex);
+            const auto i = caches.caches.find(device);
+            if (i == caches.caches.end())
+                return;
+            auto& cache = i->second;
+            if (cache.cache != VK_NULL_HANDLE && !cache.fileName.empty() &&
+                cache.stats.pipelineCount > cache.savedPipelineCount)
+            {
+                save(device, cache);
+                cache.savedPipelineCount = cache.stats.pipelineCount;
+            }
+            if (--cache.refCount > 0)
+                return;
+            if (cache.cache != VK_NULL_HANDLE)
+            {
+                vkDestroyPipelineCache(device, cache.cache, nullptr);
+            }
+            caches.caches.erase(i);
+        }
+
+        VkPipelineCache getPipelineCache(VkDevice device)
+        {
+            auto& caches = getCaches();
+            std::unique_lock<std::mutex> lock(caches.mutex);
+            const auto i = caches.caches.find(device);
+            return i != caches.caches.end() ? i->second.cache : VK_NULL_HANDLE;
+        }
+
+        PipelineCacheStats getPipelineCacheStats(VkDevice device)
+        {
+            auto& caches = getCaches();
+            std::unique_lock<std::mutex> lock(caches.mutex);
+            const auto i = caches.caches.find(device);
+            return i != caches.caches.end() ? i->second.stats
+                                            : PipelineCacheStats();
+        }
+
+        VkPipeline createGraphicsPipeline(
+            VkDevice device, const VkGraphicsPipelineCreateInfo& createInfo)
+        {
+            // Vulkan pipeline caches are internally synchronized, so the
+            // lock is not held while the pipeline is compiled.
+            const VkPipelineCache pipelineCache = getPipelineCache(device);
+
+            const auto t0 = std::chrono::steady_clock::now();
+            VkPipeline out = VK_NULL_HANDLE;
+            VkResult result = vkCreateGraphicsPipelines(
+                device, pipelineCache, 1, &createInfo, nullptr, &out);
+            VK_CHECK(result);
+            const auto t1 = std::chrono::steady_clock::now();
+
+            auto& caches = getCaches();
+            std::unique_lock<std::mutex> lock(caches.mutex);
+            const auto i = caches.caches.find(device);
+            if (i != caches.caches.end())
+            {
+                ++i->second.stats.pipelineCount;
+                i->second.stats.pipelineTime +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        t1 - t0);
+            }
+            return out;
+        }
+    } // namespace vlk
+} // namespace tl
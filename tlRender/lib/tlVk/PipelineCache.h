@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#pragma once
+
+#include <tlVk/Vk.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace vlk
+    {
+        //! Pipeline cache statistics.
+        struct PipelineCacheStats
+        {
+            //! Size of the data loaded from the file.
+            size_t loadByteCount = 0;
+            std::chrono::microseconds loadTime = std::chrono::microseconds(0);
+
+            //! Number of pipelines created and the time spent creating them.
+            size_t pipelineCount = 0;
+            std::chrono::microseconds pipelineTime =
+                std::chrono::microseconds(0);
+        };
+
+        //! Read pipeline cache data from a file. The data is empty if the
+        //! file can not be read or was not written by the same driver and
+        //! device.
+        //!
+        //! The file starts with a text header, the driver version, and the
+        //! size of the data, followed by the data returned by
+        //! vkGetPipelineCacheData().
+        std::vector<uint8_t> readPipelineCache(
+            const std::string& fileName, const VkPhysicalDeviceProperties&);
+
+        //! Write pipeline cache data to a file. The data is written to a
+        //! temporary file that is then renamed, so other processes never
+        //! read a partial file.
+        bool writePipelineCache(
+            const std::string& fileName, const VkPhysicalDeviceProperties&,
+            const std::vector<uint8_t>&);
+
+        //! Add a reference to the pipeline cache of a device.
+        //!
+        //! The cache is created with the first reference, and the data is
+        //! loaded from the file when it was written by the same driver and
+        //! device (the vendor, device and pipeline cache UUID of the
+        //! Vulkan cache header must match).
+        void addPipelineCache(
+            VkDevice, VkPhysicalDevice, const std::string& fileName);
+
+        //! Remove a reference to the pipeline cache of a device. The data is
+        //! saved to the file if pipelines were added, and the cache is
+        //! destroyed with the last reference.
+        void removePipelineCache(VkDevice);
+
+        //! Get the pipeline cache of a device, or VK_NULL_HANDLE if there
+        //! is none.
+        VkPipelineCache getPipelineCache(VkDevice);
+
+        //! Get the pipeline cache statistics of a device.
+        PipelineCacheStats getPipelineCacheStats(VkDevice);
+
+        //! Create a graphics pipeline with the pipeline cache of the device.
+        VkPipeline createGraphicsPipeline(
+            VkDevice, const VkGraphicsPipelineCreateInfo&);
+    } // namespace vlk
+} // namespace tl
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <tlVk/PipelineCache.h>
 #include <tlVk/Vk.h>
 
 #include <array>
@@ -687,25 +688,8 @@ namespace tl
                     throw std::runtime_error("Layout is null handle");
                 }
 
-                // Create a temporary pipeline cache
-                VkResult result;
-
-                VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
-                pipelineCacheCreateInfo.sType =
-                    VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-
-                VkPipelineCache pipelineCache;
-                result = vkCreatePipelineCache(
-                    device, &pipelineCacheCreateInfo, NULL, &pipelineCache);
-                VK_CHECK(result);
-
-                VkPipeline graphicsPipeline;
-                result = vkCreateGraphicsPipelines(
-                    device, pipelineCache, 1, &createInfo, NULL,
-                    &graphicsPipeline);
-                VK_CHECK(result);
-
-                vkDestroyPipelineCache(device, pipelineCache, nullptr);
+                VkPipeline graphicsPipeline =
+                    createGraphicsPipeline(device, createInfo);
 
                 return graphicsPipeline;
             }
@@ -5,6 +5,8 @@
 
 #include <tlVk/Shader.h>
 
+#include <tlVk/PipelineCache.h>
+
 #include <tlCore/Color.h>
 #include <tlCore/String.h>
 #include <tlCore/StringFormat.h>
@@ -706,7 +708,8 @@ namespace tl
 
             // 3. Create the pipeline
             if (vkCreateComputePipelines(
-                    device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &p.computePipeline) != VK_SUCCESS)
+                    device, getPipelineCache(device), 1, &pipelineInfo,
+                    nullptr, &p.computePipeline) != VK_SUCCESS)
             {
                 throw std::runtime_error("Failed to create compute pipeline!");
             }
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#include <tlVk/StagingRing.h>
+
+#include <FL/Fl_Vk_Utils.H>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace tl
+{
+    namespace vlk
+    {
+        namespace
+        {
+            //! Minimum size of a ring buffer.
+            const VkDeviceSize minRingByteCount = 16 * 1024 * 1024;
+
+            //! Maximum size of a ring buffer. Larger uploads use a
+            //! temporary buffer.
+            const VkDeviceSize maxRingByteCount = 512 * 1024 * 1024;
+
+            //! Alignment of the ranges. This is a multiple of every texel
+            //! size (1, 2, 3, 4, 6, 8, 12 and 16 bytes) and of the usual
+            //! optimal buffer copy offset alignment.
+            const VkDeviceSize rangeAlignment = 768;
+
+            //! Time over which the use of a ring is measured before it is
+            //! trimmed.
+            const std::chrono::seconds trimPeriod(5);
+
+            struct Ring
+            {
+                VkBuffer buffer = VK_NULL_HANDLE;
+                VmaAllocation allocation = VK_NULL_HANDLE;
+                uint8_t* data = nullptr;
+                VkDeviceSize byteCount = 0;
+                VkDeviceSize head = 0;
+                size_t liveCount = 0;
+                size_t refCount = 0;
+
+                //! Largest amount of the ring used since the last trim.
+                VkDeviceSize peak = 0;
+                std::chrono::steady_clock::time_point trimTime =
+                    std::chrono::steady_clock::now();
+            };
+
+            struct Rings
+            {
+                std::mutex mutex;
+                std::map<VmaAllocator, Ring> rings;
+                size_t fallbackCount = 0;
+            };
+
+            Rings& getRings()
+            {
+                static Rings rings;
+                return rings;
+            }
+
+            bool createBuffer(
+                VmaAllocator allocator, VkDeviceSize byteCount,
+                VkBuffer& buffer, VmaAllocation& allocation, uint8_t*& data)
+            {
+                VkBufferCreateInfo bufInfo = {};
+                bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+                bufInfo.size = byteCount;
+                bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+                VmaAllocationCreateInfo allocInfo = {};
+                allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+                allocInfo.flags =
+                    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                    VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+                VmaAllocationInfo info = {};
+                if (vmaCreateBuffer(
+                        allocator, &bufInfo, &allocInfo, &buffer, &allocation,
+                        &info) != VK_SUCCESS)
+                {
+                    buffer = VK_NULL_HANDLE;
+                    allocation = VK_NULL_HANDLE;
+                    return false;
+                }
+                data = static_cast<uint8_t*>(info.pMappedData);
+                return true;
+            }
+
+            void destroyBuffer(VmaAllocator allocator, Ring& ring)
+            {
+                if (ring.buffer != VK_NULL_HANDLE)
+                {
+                    vmaDestroyBuffer(allocator, ring.buffer, ring.allocation);
+                }
+                ring.buffer = VK_NULL_HANDLE;
+                ring.allocation = VK_NULL_HANDLE;
+                ring.data = nullptr;
+                ring.byteCount = 0;
+                ring.head = 0;
+            }
+        } // namespace
+
+        void addStagingRing(VmaAllocator allocator)
+        {
+            auto& rings = getRings();
+            std::unique_lock<std::mutex> lock(rings.mutex);
+            ++rings.rings[allocator].refCount;
+        }
+
+        void removeStagingRing(VmaAllocator allocator)
+        {
+            auto& rings = getRings();
+            std::unique_lock<std::mutex> lock(rings.mutex);
+            const auto i = rings.rings.find(allocator);
+            if (i == rings.rings.end() || --i->second.refCount > 0)
+                return;
+            destroyBuffer(allocator, i->second);
+            rings.rings.erase(i);
+        }
+
+        StagingMemory acquireStaging(VmaAllocator allocator, size_t byteCount)
+        {
+            StagingMemory out;
+            {
+                auto& rings = getRings();
+                std::unique_lock<std::mutex> lock(rings.mutex);
+                const auto i = rings.rings.find(allocator);
+                if (i != rings.rings.end() && byteCount <= maxRingByteCount)
+                {
+                    auto& ring = i->second;
+
+                    // Uploads wait for the transfer to complete before
+                    // releasing the memory, so the ring wraps whenever no
+                    // upload is using it.
+                    if (0 == ring.liveCount)
+                    {
+                        ring.head = 0;
+                        if (byteCount > ring.byteCount)
+                        {
+                            VkDeviceSize size = std::max(
+                                minRingByteCount, ring.byteCount * 2);
+                            while (size < byteCount)
+                            {
+                                size *= 2;
+                            }
+                            size = std::min(size, maxRingByteCount);
+                            destroyBuffer(allocator, ring);
+                            if (createBuffer(
+                                    allocator, size, ring.buffer,
+                                    ring.allocation, ring.data))
+                            {
+                                ring.byteCount = size;
+                            }
+                        }
+                    }
+
+                    const VkDeviceSize offset =
+                        (ring.head + rangeAlignment - 1) / rangeAlignment *
+                        rangeAlignment;
+                    if (ring.data && offset + byteCount <= ring.byteCount)
+                    {
+                        out.buffer = ring.buffer;
+                        out.offset = offset;
+                        out.data = ring.data + offset;
+                        out.allocation = ring.allocation;
+                        ring.head = offset + byteCount;
+                        ring.peak = std::max(ring.peak, ring.head);
+                        ++ring.liveCount;
+                        return out;
+                    }
+                }
+                ++rings.fallbackCount;
+            }
+
+            out.temporary = true;
+            if (!createBuffer(
+                    allocator, byteCount, out.buffer, out.allocation,
+                    out.data))
+            {
+                throw std::runtime_error("Cannot create staging buffer");
+            }
+            return out;
+        }
+
+        void flushStaging(
+            VmaAllocator allocator, const StagingMemory& memory,
+            size_t byteCount)
+        {
+            vmaFlushAllocation(
+                allocator, memory.allocation, memory.offset, byteCount);
+        }
+
+        void releaseStaging(VmaAllocator allocator, const StagingMemory& memory)
+        {
+            if (memory.temporary)
+            {
+                vmaDestroyBuffer(allocator, memory.buffer, memory.allocation);
+                return;
+            }
+            auto& rings = getRings();
+            std::unique_lock<std::mutex> lock(rings.mutex);
+            const auto i = rings.rings.find(allocator);
+            if (i != rings.rings.end() && i->second.liveCount > 0)
+            {
+                --i->second.liveCount;
+            }
+        }
+
+        void trimStagingRing(VmaAllocator allocator)
+        {
+            auto& rings = getRings();
+            std::unique_lock<std::mutex> lock(rings.mutex);
+            const auto i = rings.rings.find(allocator);
+            if (i == rings.rings.end())
+                return;
+            auto& ring = i->second;
+            const auto now = std::chrono::steady_clock::now();
+            if (ring.liveCount > 0 || now - ring.trimTime < trimPeriod)
+                return;
+            if (0 == ring.peak)
+            {
+                destroyBuffer(allocator, ring);
+            }
+            else if (
+                ring.byteCount > minRingByteCount &&
+                ring.peak <= ring.byteCount / 4)
+            {
+                VkDeviceSize size = minRingByteCount;
+                while (size < ring.peak)
+                {
+                    size *= 2;
+                }
+                destroyBuffer(allocator, ring);
+                if (createBuffer(
+                        allocator, size, ring.buffer, ring.allocation,
+                        ring.data))
+                {
+                    ring.byteCount = size;
+                }
+            }
+            ring.peak = 0;
+            ring.trimTime = now;
+        }
+
+        StagingRingStats getStagingRingStats()
+        {
+            StagingRingStats out;
+            auto& rings = getRings();
+            std::unique_lock<std::mutex> lock(rings.mutex);
+            for (const auto& i : rings.rings)
+            {
+                out.byteCount += i.second.byteCount;
+            }
+            out.fallbackCount = rings.fallbackCount;
+            return out;
+        }
+    } // namespace vlk
+} // namespace tl
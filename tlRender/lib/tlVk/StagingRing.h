@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#pragma once
+
+#include <tlVk/Vk.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tl
+{
+    namespace vlk
+    {
+        //! Staging memory for an upload.
+        struct StagingMemory
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceSize offset = 0;
+            uint8_t* data = nullptr;
+            VmaAllocation allocation = VK_NULL_HANDLE;
+
+            //! Whether a temporary buffer was created because the ring could
+            //! not provide the memory.
+            bool temporary = false;
+        };
+
+        //! Staging ring statistics.
+        //!
+        //! Uploads are synchronous, so these measure staging memory and not
+        //! uploads in flight.
+        struct StagingRingStats
+        {
+            //! Size of the ring buffers.
+            size_t byteCount = 0;
+
+            //! Number of uploads that needed a temporary buffer.
+            size_t fallbackCount = 0;
+        };
+
+        //! Add a reference to the staging ring of an allocator.
+        //!
+        //! The ring is a persistently mapped buffer that is shared by all
+        //! the textures of the allocator. Uploads take consecutive ranges
+        //! of it, and it wraps once the uploads using it have completed.
+        //!
+        //! Uploads still wait for the transfer to complete before returning,
+        //! so the ring is not indexed by frame and uploads do not overlap
+        //! rendering. It only saves creating a staging buffer per upload.
+        void addStagingRing(VmaAllocator);
+
+        //! Remove a reference to the staging ring of an allocator. The buffer
+        //! is destroyed with the last reference.
+        void removeStagingRing(VmaAllocator);
+
+        //! Acquire staging memory. The memory is taken from the ring when it
+        //! fits, otherwise a temporary buffer is created.
+        StagingMemory acquireStaging(VmaAllocator, size_t byteCount);
+
+        //! Flush the data written to the staging memory.
+        void flushStaging(VmaAllocator, const StagingMemory&, size_t byteCount);
+
+        //! Release staging memory once the upload has completed.
+        void releaseStaging(VmaAllocator, const StagingMemory&);
+
+        //! Shrink the staging ring of an allocator when it has been mostly
+        //! unused for a while, or destroy it when it has not been used at
+        //! all. It is created again by the next upload.
+        void trimStagingRing(VmaAllocator);
+
+        //! Get the staging ring statistics of all the allocators.
+        StagingRingStats getStagingRingStats();
+    } // namespace vlk
+} // namespace tl
@@ -4,6 +4,7 @@
 // All rights reserved.
 
 #include <tlVk/Texture.h>
+#include <tlVk/StagingRing.h>
 #include <tlVk/Vk.h>
 
 #include <tlCore/Assert.h>
@@ -20,8 +21,10 @@
 #include <vector>
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 
 namespace tl
@@ -251,6 +254,44 @@ namespace tl
         {
             std::atomic<size_t> objectCount = 0;
             std::atomic<size_t> totalByteCount = 0;
+            std::atomic<size_t> uploadByteCount = 0;
+            std::atomic<int64_t> uploadTime = 0;
+
+            void addUpload(
+                size_t byteCount,
+                const std::chrono::steady_clock::time_point& t0)
+            {
+                uploadByteCount += byteCount;
+                uploadTime +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - t0)
+                        .count();
+            }
+
+            //! Get the pixel type of the source data of a texture that
+            //! is padded from RGB to RGBA.
+            image::PixelType getRGBType(image::PixelType value)
+            {
+                image::PixelType out = image::PixelType::None;
+                switch (value)
+                {
+                case image::PixelType::RGBA_U8:
+                    out = image::PixelType::RGB_U8;
+                    break;
+                case image::PixelType::RGBA_U16:
+                    out = image::PixelType::RGB_U16;
+                    break;
+                case image::PixelType::RGBA_F16:
+                    out = image::PixelType::RGB_F16;
+                    break;
+                case image::PixelType::RGBA_F32:
+                    out = image::PixelType::RGB_F32;
+                    break;
+                default:
+                    break;
+                }
+                return out;
+            }
         }
         
         size_t Texture::getTotalByteCount()
@@ -262,6 +303,16 @@ namespace tl
         {
             return objectCount;
         }
+
+        size_t Texture::getUploadByteCount()
+        {
+            return uploadByteCount;
+        }
+
+        std::chrono::microseconds Texture::getUploadTime()
+        {
+            return std::chrono::microseconds(uploadTime);
+        }
         
         std::unique_ptr<SamplersCache> Texture::samplersCache;
         
@@ -397,6 +448,7 @@ namespace tl
             {
                 samplersCache = std::make_unique<SamplersCache>(ctx.device);
             }
+            addStagingRing(ctx.allocator);
         }
 
         Texture::~Texture()
@@ -420,6 +472,8 @@ namespace tl
             
             if (p.commandPool != VK_NULL_HANDLE)
                 vkDestroyCommandPool(device, p.commandPool, nullptr);
+
+            removeStagingRing(ctx.allocator);
             
 
             totalByteCount -= getDataByteCount(p.imageType,
@@ -637,6 +691,8 @@ namespace tl
         {
             TLRENDER_P();
 
+            const auto t0 = std::chrono::steady_clock::now();
+            
             const auto& info = data->getInfo();
             const uint8_t* srcData = data->getData();
             const std::size_t size = data->getDataByteCount();
@@ -644,126 +700,57 @@ namespace tl
             VkDevice device = ctx.device;
             VkQueue queue = ctx.queue();
 
-            // Create staging buffer
-            VkBuffer stagingBuffer;
-            VmaAllocation stagingAllocation;
-
-            // We may need a larger staging buffer if we are converting formats
-            size_t bufferSize = size;
+            // This MUST match the stride of the data we write into the
+            // staging buffer.
+            const size_t pixelSize = image::getBitDepth(info.pixelType) / 8 *
+                                     image::getChannelCount(info.pixelType);
+            const size_t srcRowBytes = info.size.w * pixelSize;
+                
+            // Use a standard 4-byte or pixel-size alignment if
+            // info.layout.alignment is unreliable
+            const size_t alignment = std::max((size_t)info.layout.alignment,
+                                              pixelSize);
+            const size_t dstRowBytes =
+                (srcRowBytes + alignment - 1) & ~(alignment - 1);
+
+            // We need a larger staging buffer if we are converting formats
+            const size_t pixelCount =
+                static_cast<size_t>(info.size.w) * info.size.h;
+            size_t bufferSize = std::max(size, dstRowBytes * info.size.h);
             if (p.needPadRgbToRgba)
             {
-                size_t pixelCount = static_cast<size_t>(p.info.size.w) * p.info.size.h;
-                size_t dstPixelBytes = getDataByteCount(p.imageType, p.info.size.w, p.info.size.h, p.depth, p.internalFormat) / pixelCount;
-                bufferSize = pixelCount * dstPixelBytes;
+                bufferSize = pixelCount * 4 *
+                             (image::getBitDepth(p.info.pixelType) / 8);
             }
-    
-            VkBufferCreateInfo bufInfo = {};
-            bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufInfo.size = bufferSize;
-            bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
             
-            VmaAllocationCreateInfo allocInfo = {};
-            allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
-            allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                              VMA_ALLOCATION_CREATE_MAPPED_BIT; // Map automatically
-
-            VK_CHECK(vmaCreateBuffer(ctx.allocator, &bufInfo, &allocInfo,
-                                     &stagingBuffer, &stagingAllocation, nullptr));
-
-            // Copy image data to buffer, respecting alignment AND
-            // format conversion
-            void* mapped;
-            VK_CHECK(vmaMapMemory(ctx.allocator, stagingAllocation, &mapped));
+            const StagingMemory staging =
+                acquireStaging(ctx.allocator, bufferSize);
 
-            // Check if we need to convert from 3-channel to 4-channel float
             if (p.needPadRgbToRgba)
             {
-                 // Compute new buffer size for RGBA
-                size_t pixelCount = static_cast<size_t>(p.info.size.w) * p.info.size.h;
-                size_t dstPixelBytes = 4 * (image::getBitDepth(p.info.pixelType)/8); // careful to pick dest bit depth
-                size_t bufferSize = pixelCount * dstPixelBytes;
-
-                
-                if (p.info.pixelType == image::PixelType::RGBA_U8)
-                {
-                    const uint8_t* s = reinterpret_cast<const uint8_t*>(srcData);
-                    uint8_t* d = reinterpret_cast<uint8_t*>(mapped);
-                    for (size_t i = 0; i < pixelCount; ++i)
-                    {
-                        *d++ = *s++; // R
-                        *d++ = *s++; // G
-                        *d++ = *s++; // B
-                        *d++ = 255;  // A
-                    }
-                }
-                if (p.info.pixelType == image::PixelType::RGBA_U16)
-                {
-                    const uint16_t* s = reinterpret_cast<const uint16_t*>(srcData);
-                    uint16_t* d = reinterpret_cast<uint16_t*>(mapped);
-                    for (size_t i = 0; i < pixelCount; ++i)
-                    {
-                        *d++ = *s++; // R
-                        *d++ = *s++; // G
-                        *d++ = *s++; // B
-                        *d++ = 65535;  // A
-                    }
-                }
-                else if (p.info.pixelType == image::PixelType::RGB_F16)
-                {
-                    const uint16_t* s = reinterpret_cast<const uint16_t*>(srcData);
-                    uint16_t* d = reinterpret_cast<uint16_t*>(mapped);
-                    for (size_t i = 0; i < pixelCount; ++i)
-                    {
-                        *d++ = *s++; // R
-                        *d++ = *s++; // G
-                        *d++ = *s++; // B
-                        *d++ = 0x3C00; // A = 1.0f in half (implement helper)
-                    }
-                }
-                else if (p.info.pixelType == image::PixelType::RGB_F32)
-                {
-                    const float* s = reinterpret_cast<const float*>(srcData);
-                    float* d = reinterpret_cast<float*>(mapped);
-                    for (size_t i = 0; i < pixelCount; ++i)
-                    {
-                        *d++ = *s++; // R
-                        *d++ = *s++; // G
-                        *d++ = *s++; // B
-                        *d++ = 1.0f; // A
-                    }
-                }
-                else
+                if (!image::copyRGBToRGBA(
+                        srcData, getRGBType(p.info.pixelType), pixelCount,
+                        staging.data))
                 {
+                    releaseStaging(ctx.allocator, staging);
                     throw std::runtime_error("Unsupported pixel type for RGB to RGBA conversion");
                 }
             }
+            else if (srcRowBytes == dstRowBytes)
+            {
+                std::memcpy(staging.data, srcData, size);
+            }
             else
             {
-                // 2. Fix the manual copy alignment
-                // We must ensure the destination buffer layout matches what we tell Vulkan later
-                size_t pixelSize = image::getBitDepth(info.pixelType) / 8 *
-                                   image::getChannelCount(info.pixelType);
-                size_t srcRowBytes = info.size.w * pixelSize;
-                
-                // Use a standard 4-byte or pixel-size alignment if
-                // info.layout.alignment is unreliable
-                size_t alignment = std::max((size_t)info.layout.alignment,
-                                            pixelSize);
-                size_t dstRowBytes = (srcRowBytes + alignment - 1) & ~(alignment - 1);
-                if (srcRowBytes == dstRowBytes) {
-                    std::memcpy(mapped, srcData, size);
-                } else {
-                    for (uint32_t y = 0; y < info.size.h; ++y) {
-                        std::memcpy(
-                            static_cast<uint8_t*>(mapped) + y * dstRowBytes,
-                            srcData + y * srcRowBytes,
-                            srcRowBytes);
-                    }
+                for (uint32_t row = 0; row < info.size.h; ++row)
+                {
+                    std::memcpy(
+                        staging.data + row * dstRowBytes,
+                        srcData + row * srcRowBytes,
+                        srcRowBytes);
                 }
             }
-            vmaUnmapMemory(ctx.allocator, stagingAllocation);
-            vmaFlushAllocation(ctx.allocator, stagingAllocation, 0,
-                               VK_WHOLE_SIZE);
+            flushStaging(ctx.allocator, staging, bufferSize);
             
             // Begin command buffer
             VkCommandBuffer cmd = beginSingleTimeCommands(device,
@@ -777,23 +764,15 @@ namespace tl
 
             // Prepare region copy
             VkBufferImageCopy region = {};
-            region.bufferOffset = 0;
-            
-            // This MUST match the stride of the data we just wrote into the
-            // buffer
-            size_t pixelSize = image::getBitDepth(info.pixelType) / 8 *
-                               image::getChannelCount(info.pixelType);
-            size_t alignment = std::max((size_t)info.layout.alignment,
-                                        pixelSize);
+            region.bufferOffset = staging.offset;
             
             // If the buffer is tightly packed, bufferRowLength should be 0 or
             // the width.
             // If it's padded, it MUST be the width in pixels (not bytes).
-            uint32_t strideInPixels = (uint32_t)(( (info.size.w * pixelSize) +
-                                                   alignment - 1) & ~(alignment - 1)) / pixelSize;
-            
-            region.bufferRowLength = (strideInPixels > (uint32_t)info.size.w) ?
-                                     strideInPixels : 0;
+            const uint32_t strideInPixels = dstRowBytes / pixelSize;
+            region.bufferRowLength =
+                (!p.needPadRgbToRgba && strideInPixels > (uint32_t)info.size.w) ?
+                strideInPixels : 0;
             region.bufferImageHeight = 0;
 
             region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -808,7 +787,7 @@ namespace tl
                 1};
 
             vkCmdCopyBufferToImage(
-                cmd, stagingBuffer, p.image,
+                cmd, staging.buffer, p.image,
                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                 1, &region);
 
@@ -825,9 +804,11 @@ namespace tl
                 endSingleTimeCommands(cmd, device, p.commandPool, queue);
             }
             
-            vmaDestroyBuffer(ctx.allocator, stagingBuffer, stagingAllocation);
+            releaseStaging(ctx.allocator, staging);
             
             p.currentLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            addUpload(bufferSize, t0);
         }
  
         void Texture::copy(const uint8_t* upload, const std::size_t size,
@@ -835,7 +816,9 @@ namespace tl
         {
             TLRENDER_P();
 
-            uint8_t* data = const_cast<uint8_t*>(upload);
+            const auto t0 = std::chrono::steady_clock::now();
+            
+            const uint8_t* data = upload;
             
             // Assuming 'data' is a pointer to your tightly packed
             // source pixel data
@@ -846,15 +829,17 @@ namespace tl
             {
                 pixel_size = sizeof(uint32_t);
             }
+
+            // When padding, the source has three channels and the texture
+            // four.
+            const image::PixelType rgbType =
+                p.needPadRgbToRgba ? getRGBType(p.info.pixelType)
+                                   : image::PixelType::None;
+            const size_t src_pixel_size =
+                p.needPadRgbToRgba ? pixel_size / 4 * 3 : pixel_size;
             
             VkDevice device = ctx.device;
-            VkPhysicalDevice gpu = ctx.gpu;
             VkQueue queue = ctx.queue();
-
-            // First, check if the memory is host visible
-            VkMemoryRequirements memReqs;
-            vkGetImageMemoryRequirements(device, p.image, &memReqs);
-
             
             // Fast-path condition: 
             // - Memory must be Host Visible
@@ -862,6 +847,7 @@ namespace tl
             bool canDirectMap = (p.memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && 
                                 (p.options.tiling == VK_IMAGE_TILING_LINEAR);
 
+            size_t uploadSize = size;
             if (canDirectMap)
             {
                 VkImageSubresource subresource = {};
@@ -875,7 +861,8 @@ namespace tl
                     device, p.image, &subresource, &subresourceLayout);
 
                 void* mapped;
-                if (rowPitch == 0 && size == subresourceLayout.size)
+                if (!p.needPadRgbToRgba && rowPitch == 0 &&
+                    size == subresourceLayout.size)
                 {
                     // Host-visible upload (like glTexSubImage2D)
                     VK_CHECK(vmaMapMemory(ctx.allocator, p.allocation, &mapped));
@@ -888,85 +875,32 @@ namespace tl
                 {
                     VK_CHECK(vmaMapMemory(ctx.allocator, p.allocation,
                                           &mapped));
-                    
 
-                    const uint32_t src_row_pitch = rowPitch > 0 ? rowPitch : (p.info.size.w * pixel_size);
+                    const uint32_t src_row_pitch = rowPitch > 0 ? rowPitch : (p.info.size.w * src_pixel_size);
                     const uint32_t dst_row_size = p.info.size.w * pixel_size;
                     
-                    if (p.needPadRgbToRgba)
+                    for (uint32_t y = 0; y < static_cast<uint32_t>(p.info.size.h); ++y)
                     {
-                        const size_t pixelCount = static_cast<size_t>(p.info.size.w) * p.info.size.h;
-
-                        switch(p.info.pixelType)
-                        {
-                        case image::PixelType::RGBA_F32:
-                        {
-                            const float* s = reinterpret_cast<const float*>(data);
-                            float* d = reinterpret_cast<float*>(mapped);
-                            for (size_t i = 0; i < pixelCount; ++i)
-                            {
-                                d[i * 4 + 0] = s[i * 3 + 0]; // R
-                                d[i * 4 + 1] = s[i * 3 + 1]; // G
-                                d[i * 4 + 2] = s[i * 3 + 2]; // B
-                                d[i * 4 + 3] = 1.0f;         // A
-                            }
-                            break;
-                        }
-                        case image::PixelType::RGBA_F16:
+                        const uint8_t* src_row = data + y * src_row_pitch;
+                        uint8_t* dst_row = static_cast<uint8_t*>(mapped) + y * subresourceLayout.rowPitch;
+                        if (p.needPadRgbToRgba)
                         {
-                            const uint16_t* s = reinterpret_cast<const uint16_t*>(data);
-                            uint16_t* d = reinterpret_cast<uint16_t*>(mapped);
-                            for (size_t i = 0; i < pixelCount; ++i)
+                            if (!image::copyRGBToRGBA(
+                                    src_row, rgbType, p.info.size.w, dst_row))
                             {
-                                d[i * 4 + 0] = s[i * 3 + 0]; // R
-                                d[i * 4 + 1] = s[i * 3 + 1]; // G
-                                d[i * 4 + 2] = s[i * 3 + 2]; // B
-                                d[i * 4 + 3] = 0x3C00;         // A
+                                vmaUnmapMemory(ctx.allocator, p.allocation);
+                                throw std::runtime_error("Unknown pixel type for RGB->RGBA conversion");
                             }
-                            break;
                         }
-                        case image::PixelType::RGBA_U16:
+                        else
                         {
-                            const uint16_t* s = reinterpret_cast<const uint16_t*>(data);
-                            uint16_t* d = reinterpret_cast<uint16_t*>(mapped);
-                            for (size_t i = 0; i < pixelCount; ++i)
-                            {
-                                d[i * 4 + 0] = s[i * 3 + 0]; // R
-                                d[i * 4 + 1] = s[i * 3 + 1]; // G
-                                d[i * 4 + 2] = s[i * 3 + 2]; // B
-                                d[i * 4 + 3] = 65535;         // A
-                            }
-                            break;
-                        }
-                        case image::PixelType::RGBA_U8:
-                        {
-                            const uint8_t* s = reinterpret_cast<const uint8_t*>(data);
-                            uint8_t* d = reinterpret_cast<uint8_t*>(mapped);
-                            for (size_t i = 0; i < pixelCount; ++i)
-                            {
-                                d[i * 4 + 0] = s[i * 3 + 0]; // R
-                                d[i * 4 + 1] = s[i * 3 + 1]; // G
-                                d[i * 4 + 2] = s[i * 3 + 2]; // B
-                                d[i * 4 + 3] = 255;          // A
-                            }
-                            break;
-                        }
-                        default:
-                            throw std::runtime_error("Unknown pixel type for RGB->RGBA conversion");
-                        }
-                    }
-                    else
-                    {
-                        for (uint32_t y = 0; y < static_cast<uint32_t>(p.info.size.h); ++y)
-                        {
-                            const void* src_row = static_cast<const uint8_t*>(data) + y * src_row_pitch;
-                            void* dst_row = static_cast<uint8_t*>(mapped) + y * subresourceLayout.rowPitch;
                             std::memcpy(dst_row, src_row, dst_row_size);
                         }
                     }
                     
                     vmaUnmapMemory(ctx.allocator, p.allocation);
                     vmaFlushAllocation(ctx.allocator, p.allocation, 0, VK_WHOLE_SIZE);
+                    uploadSize = dst_row_size * p.info.size.h;
                 }
                 
                 // We must transition the image layout so the shader can
@@ -993,60 +927,33 @@ namespace tl
             }
             else
             {
-                // Use a staging buffer
-                VkBuffer stagingBuffer;
-
                 // Calculate buffer size, accounting for format conversion
-                size_t bufferSize = size;
+                const size_t pixelCount =
+                    static_cast<size_t>(p.info.size.w) * p.info.size.h *
+                    p.depth;
                 if (p.needPadRgbToRgba)
                 {
-                    size_t pixelCount = static_cast<size_t>(p.info.size.w) * p.info.size.h;
-                    size_t dstPixelBytes = getDataByteCount(p.imageType, p.info.size.w, p.info.size.h, p.depth, p.internalFormat) / pixelCount;
-                    bufferSize = pixelCount * dstPixelBytes;
+                    uploadSize = pixelCount * pixel_size;
                 }
-        
-                VkBufferCreateInfo bufInfo = {};
-                bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-                bufInfo.size = bufferSize;
-                bufInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-                VmaAllocation stagingAllocation;
-                VmaAllocationCreateInfo allocInfo = {};
-
-                allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
-                allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                                  VMA_ALLOCATION_CREATE_MAPPED_BIT; // Map automatically
-        
-                VK_CHECK(vmaCreateBuffer(ctx.allocator, &bufInfo, &allocInfo,
-                                         &stagingBuffer, &stagingAllocation,
-                                         nullptr));
 
-                void* mapped;
-                VK_CHECK(vmaMapMemory(ctx.allocator, stagingAllocation,
-                                      &mapped));
+                // Use the shared staging ring
+                const StagingMemory staging =
+                    acquireStaging(ctx.allocator, uploadSize);
                 
-                if (p.needPadRgbToRgba &&
-                    p.info.pixelType == image::PixelType::RGBA_F32)
+                if (p.needPadRgbToRgba)
                 {
-                    size_t pixelCount = static_cast<size_t>(p.info.size.w) * p.info.size.h;
-                    const float* s = reinterpret_cast<const float*>(data);
-                    float* d = reinterpret_cast<float*>(mapped);
-                    for (size_t i = 0; i < pixelCount; ++i)
+                    if (!image::copyRGBToRGBA(
+                            data, rgbType, pixelCount, staging.data))
                     {
-                        d[i * 4 + 0] = s[i * 3 + 0]; // R
-                        d[i * 4 + 1] = s[i * 3 + 1]; // G
-                        d[i * 4 + 2] = s[i * 3 + 2]; // B
-                        d[i * 4 + 3] = 1.0f;         // A
+                        releaseStaging(ctx.allocator, staging);
+                        throw std::runtime_error("Unknown pixel type for RGB->RGBA conversion");
                     }
                 }
                 else
                 {
-                    std::memcpy(mapped, data, size);
+                    std::memcpy(staging.data, data, size);
                 }
-
-                vmaUnmapMemory(ctx.allocator, stagingAllocation);
-                vmaFlushAllocation(ctx.allocator, stagingAllocation, 0,
-                                   VK_WHOLE_SIZE);
+                flushStaging(ctx.allocator, staging, uploadSize);
 
                 // Transition image for copy
                 VkCommandBuffer cmd =
@@ -1062,7 +969,7 @@ namespace tl
                 // Copy from staging buffer to image
 
                 VkBufferImageCopy region = {};
-                region.bufferOffset = 0;
+                region.bufferOffset = staging.offset;
                 region.bufferRowLength = 0;
                 region.bufferImageHeight = 0;
 
@@ -1077,7 +984,7 @@ namespace tl
                     static_cast<uint32_t>(p.info.size.h), p.depth};
 
                 vkCmdCopyBufferToImage(
-                    cmd, stagingBuffer, p.image,
+                    cmd, staging.buffer, p.image,
                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
 
@@ -1095,10 +1002,12 @@ namespace tl
                     endSingleTimeCommands(cmd, device, p.commandPool, queue);
                 }
                 
-                vmaDestroyBuffer(ctx.allocator, stagingBuffer, stagingAllocation);
+                releaseStaging(ctx.allocator, staging);
                 
                 p.currentLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             }
+
+            addUpload(uploadSize, t0);
         }
 
         void Texture::copy(const uint8_t* data, const image::Info& info,
@@ -12,6 +12,7 @@
 
 #include <tlCore/Image.h>
 
+#include <chrono>
 #include <memory>
 
 namespace tl
@@ -174,6 +175,14 @@ namespace tl
 
             //! Get the total number of bytes currently used.
             static size_t getTotalByteCount();
+
+            //! Get the total number of bytes uploaded to textures.
+            static size_t getUploadByteCount();
+
+            //! Get the total time spent uploading to textures. Uploads wait
+            //! for the transfer to complete, so this is time the calling
+            //! thread was blocked.
+            static std::chrono::microseconds getUploadTime();
             
         private:
             Fl_Vk_Context& ctx;
@@ -6,6 +6,7 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 #include <tlCore/AudioSystem.h>
 
 #include <cstring>
@@ -37,6 +38,8 @@ namespace tl
             _convert();
             _interleave();
             _move();
+            _ringBuffer();
+            _underrun();
             _resample();
         }
 
@@ -450,6 +453,170 @@ namespace tl
                     TLRENDER_ASSERT(i == p[i * 2 + 1]);
                 }
             }
+            {
+                const Info info(2, DataType::S16, 10);
+
+                std::list<std::shared_ptr<Audio> > list;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    auto item = Audio::create(info, 4);
+                    for (size_t j = 0; j < 4; ++j)
+                    {
+                        reinterpret_cast<audio::S16_T*>(
+                            item->getData())[j * 2] = i * 4 + j;
+                        reinterpret_cast<audio::S16_T*>(
+                            item->getData())[j * 2 + 1] = i * 4 + j;
+                    }
+                    list.push_back(item);
+                }
+
+                TLRENDER_ASSERT(0 == discard(list, 0));
+                TLRENDER_ASSERT(16 == getSampleCount(list));
+                TLRENDER_ASSERT(10 == discard(list, 10));
+                TLRENDER_ASSERT(2 == list.size());
+                TLRENDER_ASSERT(6 == getSampleCount(list));
+                TLRENDER_ASSERT(
+                    10 == reinterpret_cast<audio::S16_T*>(
+                              list.front()->getData())[0]);
+                TLRENDER_ASSERT(6 == discard(list, 10));
+                TLRENDER_ASSERT(list.empty());
+            }
+        }
+
+        void AudioTest::_ringBuffer()
+        {
+            const Info info(2, DataType::S16, 10);
+            auto ringBuffer = RingBuffer::create(info, 8);
+            TLRENDER_ASSERT(info == ringBuffer->getInfo());
+            TLRENDER_ASSERT(8 == ringBuffer->getCapacity());
+            TLRENDER_ASSERT(8 == ringBuffer->getWriteAvailable());
+            TLRENDER_ASSERT(0 == ringBuffer->getReadAvailable());
+
+            std::vector<audio::S16_T> in(10 * 2);
+            for (size_t i = 0; i < 10; ++i)
+            {
+                in[i * 2] = i;
+                in[i * 2 + 1] = i;
+            }
+            const uint8_t* inP = reinterpret_cast<const uint8_t*>(in.data());
+            TLRENDER_ASSERT(6 == ringBuffer->write(inP, 6));
+            TLRENDER_ASSERT(2 == ringBuffer->getWriteAvailable());
+            TLRENDER_ASSERT(6 == ringBuffer->getReadAvailable());
+
+            std::vector<audio::S16_T> out(10 * 2, 0);
+            uint8_t* outP = reinterpret_cast<uint8_t*>(out.data());
+            TLRENDER_ASSERT(4 == ringBuffer->read(outP, 4));
+            for (size_t i = 0; i < 4; ++i)
+            {
+                TLRENDER_ASSERT(i == out[i * 2]);
+                TLRENDER_ASSERT(i == out[i * 2 + 1]);
+            }
+
+            // Wrap around the end of the buffer.
+            TLRENDER_ASSERT(
+                4 == ringBuffer->write(inP + 6 * info.getByteCount(), 4));
+            TLRENDER_ASSERT(2 == ringBuffer->getWriteAvailable());
+            TLRENDER_ASSERT(6 == ringBuffer->read(outP, 10));
+            for (size_t i = 0; i < 6; ++i)
+            {
+                TLRENDER_ASSERT(i + 4 == out[i * 2]);
+                TLRENDER_ASSERT(i + 4 == out[i * 2 + 1]);
+            }
+
+            // Full buffer.
+            TLRENDER_ASSERT(8 == ringBuffer->write(inP, 10));
+            TLRENDER_ASSERT(0 == ringBuffer->getWriteAvailable());
+            TLRENDER_ASSERT(0 == ringBuffer->write(inP, 1));
+            ringBuffer->addUnderrun(2);
+            ringBuffer->discard();
+            TLRENDER_ASSERT(0 == ringBuffer->getReadAvailable());
+            TLRENDER_ASSERT(8 == ringBuffer->getWriteAvailable());
+            TLRENDER_ASSERT(0 == ringBuffer->takeUnderrun());
+        }
+
+        void AudioTest::_underrun()
+        {
+            // Mix the samples ahead of the consumer the same way the player
+            // does, where each sample holds its position, and check that
+            // the mix position stays in sync with the consumer when the
+            // ring buffer runs short.
+            const Info info(1, DataType::S16, 10);
+            auto ringBuffer = RingBuffer::create(info, 8);
+            std::list<std::shared_ptr<Audio> > buffer;
+            size_t outputFrame = 0;
+            auto produce = [&](size_t sampleCount)
+            {
+                if (const size_t underrun = ringBuffer->takeUnderrun())
+                {
+                    discard(buffer, underrun);
+                    outputFrame += underrun;
+                }
+                if (sampleCount > 0)
+                {
+                    const size_t position =
+                        outputFrame + getSampleCount(buffer);
+                    auto item = Audio::create(info, sampleCount);
+                    for (size_t i = 0; i < sampleCount; ++i)
+                    {
+                        reinterpret_cast<S16_T*>(item->getData())[i] =
+                            position + i;
+                    }
+                    buffer.push_back(item);
+                }
+                const size_t writeCount = std::min(
+                    ringBuffer->getWriteAvailable(), getSampleCount(buffer));
+                std::vector<uint8_t> data(writeCount * info.getByteCount());
+                move(buffer, data.data(), writeCount);
+                ringBuffer->write(data.data(), writeCount);
+                outputFrame += writeCount;
+            };
+            size_t consumed = 0;
+            auto consume = [&](size_t sampleCount)
+            {
+                std::vector<S16_T> data(sampleCount, 0);
+                const size_t readCount = ringBuffer->read(
+                    reinterpret_cast<uint8_t*>(data.data()), sampleCount);
+                for (size_t i = 0; i < readCount; ++i)
+                {
+                    TLRENDER_ASSERT(consumed + i == data[i]);
+                }
+                ringBuffer->addUnderrun(sampleCount - readCount);
+                consumed += sampleCount;
+            };
+
+            // The mix position is the position of the next sample the
+            // consumer reads.
+            auto position = [&]
+            { return outputFrame - ringBuffer->getReadAvailable(); };
+
+            // The consumer starts before the ring buffer is filled.
+            consume(3);
+            produce(4);
+            TLRENDER_ASSERT(3 + 4 == outputFrame);
+            TLRENDER_ASSERT(consumed == position());
+            consume(4);
+
+            // Underrun while samples are waiting to be written.
+            produce(12);
+            TLRENDER_ASSERT(4 == getSampleCount(buffer));
+            consume(10);
+            TLRENDER_ASSERT(2 == ringBuffer->takeUnderrun());
+            ringBuffer->addUnderrun(2);
+            produce(0);
+            TLRENDER_ASSERT(consumed == position());
+            TLRENDER_ASSERT(2 == ringBuffer->getReadAvailable());
+
+            // Underrun larger than the samples waiting to be written.
+            consume(6);
+            produce(0);
+            TLRENDER_ASSERT(consumed == position());
+            TLRENDER_ASSERT(0 == getSampleCount(buffer));
+
+            // The consumer reads the samples for its position.
+            produce(8);
+            consume(5);
+            consume(3);
+            TLRENDER_ASSERT(0 == ringBuffer->takeUnderrun());
         }
 
         void AudioTest::_resample()
@@ -30,6 +30,8 @@ namespace tl
             void _convert();
             void _interleave();
             void _move();
+            void _ringBuffer();
+            void _underrun();
             void _resample();
         };
     } // namespace core_tests
@@ -194,6 +194,60 @@ namespace tl
                 }
             }
 
+            {
+                std::vector<FileInfo> list;
+                ListOptions options;
+                options.sequenceExtensions = {".exr", ".tif"};
+                file::list(tmp, list, options);
+                const size_t size = list.size();
+
+                options.stat = false;
+                size_t callbacks = 0;
+                file::list(
+                    tmp, list, options,
+                    [&callbacks](const std::vector<FileInfo>& value)
+                    {
+                        ++callbacks;
+                        return true;
+                    });
+                TLRENDER_ASSERT(callbacks > 0);
+                TLRENDER_ASSERT(size == list.size());
+                TLRENDER_ASSERT(Type::Directory == list[0].getType());
+
+                file::list(
+                    tmp, list, options,
+                    [](const std::vector<FileInfo>&) { return false; });
+                TLRENDER_ASSERT(list.size() <= size);
+            }
+
+            {
+                // Enough files for more than one batch of directory entries,
+                // so the threads reading the information are used again.
+                const std::string dir = file::Path(tmp, "many").get();
+                mkdir(dir);
+                const size_t count = 5000;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "file" << i << ".txt";
+                    FileIO::create(
+                        file::Path(dir, ss.str()).get(), Mode::Write);
+                }
+                std::vector<FileInfo> list;
+                ListOptions options;
+                options.sequence = false;
+                file::list(dir, list, options);
+                TLRENDER_ASSERT(count == list.size());
+                std::set<std::string> fileNames;
+                for (const auto& i : list)
+                {
+                    TLRENDER_ASSERT(Type::File == i.getType());
+                    TLRENDER_ASSERT(i.getTime() > 0);
+                    fileNames.insert(i.getPath().get());
+                }
+                TLRENDER_ASSERT(count == fileNames.size());
+            }
+
             std::vector<ListOptions> optionsList;
             for (auto sort : getListSortEnums())
             {
@@ -216,6 +270,11 @@ namespace tl
                 options.sequence = false;
                 optionsList.push_back({options});
             }
+            {
+                ListOptions options;
+                options.stat = false;
+                optionsList.push_back({options});
+            }
             for (const auto& options : optionsList)
             {
                 std::vector<FileInfo> list;
@@ -5,9 +5,14 @@
 #include <tlCoreTest/ImageTest.h>
 
 #include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/FileIO.h>
 #include <tlCore/Image.h>
+#include <tlCore/Path.h>
 #include <tlCore/StringFormat.h>
 
+#include <cstring>
+
 using namespace tl::image;
 
 namespace tl
@@ -209,6 +214,66 @@ namespace tl
                    << " data byte count: " << getDataByteCount(info);
                 _print(ss.str());
             }
+            for (auto i :
+                 {PixelType::RGB_U8, PixelType::RGB_U16, PixelType::RGB_F16,
+                  PixelType::RGB_F32})
+            {
+                // Use a count that is not a multiple of the vector width
+                // to exercise the scalar tail.
+                const size_t pixelCount = 37;
+                const size_t channelByteCount = getBitDepth(i) / 8;
+                std::vector<uint8_t> rgb(pixelCount * 3 * channelByteCount);
+                for (size_t j = 0; j < rgb.size(); ++j)
+                {
+                    rgb[j] = static_cast<uint8_t>(j * 7);
+                }
+                std::vector<uint8_t> rgba(pixelCount * 4 * channelByteCount);
+                TLRENDER_ASSERT(
+                    copyRGBToRGBA(rgb.data(), i, pixelCount, rgba.data()));
+                for (size_t j = 0; j < pixelCount; ++j)
+                {
+                    TLRENDER_ASSERT(
+                        0 == std::memcmp(
+                                 rgba.data() + j * 4 * channelByteCount,
+                                 rgb.data() + j * 3 * channelByteCount,
+                                 3 * channelByteCount));
+                }
+                for (size_t j : {size_t(0), pixelCount - 1})
+                {
+                    const uint8_t* alpha =
+                        rgba.data() + (j * 4 + 3) * channelByteCount;
+                    switch (i)
+                    {
+                    case PixelType::RGB_U8:
+                        TLRENDER_ASSERT(0xff == alpha[0]);
+                        break;
+                    case PixelType::RGB_U16:
+                    case PixelType::RGB_F16:
+                    {
+                        uint16_t value = 0;
+                        std::memcpy(&value, alpha, sizeof(value));
+                        const uint16_t one =
+                            PixelType::RGB_U16 == i ? 0xffff : 0x3c00;
+                        TLRENDER_ASSERT(one == value);
+                        break;
+                    }
+                    case PixelType::RGB_F32:
+                    {
+                        float value = 0.F;
+                        std::memcpy(&value, alpha, sizeof(value));
+                        TLRENDER_ASSERT(1.F == value);
+                        break;
+                    }
+                    default:
+                        break;
+                    }
+                }
+            }
+            {
+                uint8_t data[4] = {0, 0, 0, 0};
+                TLRENDER_ASSERT(
+                    !copyRGBToRGBA(data, PixelType::RGBA_U8, 1, data));
+            }
         }
 
         void ImageTest::_image()
@@ -239,6 +304,44 @@ namespace tl
                 TLRENDER_ASSERT(image->getWidth() == 1);
                 TLRENDER_ASSERT(image->getHeight() == 2);
                 TLRENDER_ASSERT(image->getPixelType() == PixelType::L_U8);
+                TLRENDER_ASSERT(!image->isMemoryMapped());
+            }
+            {
+                const std::string fileName =
+                    file::Path(file::createTempDir(), "ImageTest.raw").get();
+                const uint8_t data[] = {0, 1, 2, 3, 4, 5};
+                auto io = file::FileIO::create(fileName, file::Mode::Write);
+                io->write(data, sizeof(data));
+                io = file::FileIO::create(
+                    fileName, file::Mode::Read, file::ReadType::MemoryMapped);
+                const Info info(2, 2, PixelType::L_U8);
+                auto image = Image::create(info, io, 2);
+                io.reset();
+                TLRENDER_ASSERT(image->isMemoryMapped());
+                TLRENDER_ASSERT(image->getDataByteCount() == 4);
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    TLRENDER_ASSERT(image->getData()[i] == data[i + 2]);
+                }
+
+                // Writing to the image changes a copy and not the file.
+                image->zero();
+                TLRENDER_ASSERT(0 == image->getData()[0]);
+                io = file::FileIO::create(fileName, file::Mode::Read);
+                uint8_t fileData[sizeof(data)];
+                io->read(fileData, sizeof(data));
+                TLRENDER_ASSERT(0 == memcmp(fileData, data, sizeof(data)));
+                try
+                {
+                    io = file::FileIO::create(
+                        fileName, file::Mode::Read,
+                        file::ReadType::MemoryMapped);
+                    Image::create(info, io, 4);
+                    TLRENDER_ASSERT(false);
+                }
+                catch (const std::exception&)
+                {
+                }
             }
         }
 
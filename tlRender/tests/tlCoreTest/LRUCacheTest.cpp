@@ -7,6 +7,10 @@
 #include <tlCore/Assert.h>
 #include <tlCore/LRUCache.h>
 #include <tlCore/Memory.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <map>
 
 using namespace tl::memory;
 
@@ -27,6 +31,12 @@ namespace tl
         }
 
         void LRUCacheTest::run()
+        {
+            _cache();
+            _benchmark();
+        }
+
+        void LRUCacheTest::_cache()
         {
             {
                 LRUCache<int, int> c;
@@ -66,9 +76,8 @@ namespace tl
                 TLRENDER_ASSERT(c.contains(1));
                 TLRENDER_ASSERT(c.contains(3));
                 TLRENDER_ASSERT(c.contains(4));
-                const auto l = c.getKeys();
-                TLRENDER_ASSERT(std::vector<int>({1, 3, 4}) == c.getKeys());
-                TLRENDER_ASSERT(std::vector<int>({2, 4, 5}) == c.getValues());
+                TLRENDER_ASSERT(std::vector<int>({3, 1, 4}) == c.getKeys());
+                TLRENDER_ASSERT(std::vector<int>({4, 2, 5}) == c.getValues());
             }
             {
                 LRUCache<int, int> c;
@@ -86,9 +95,125 @@ namespace tl
                 TLRENDER_ASSERT(c.contains(1));
                 TLRENDER_ASSERT(c.contains(3));
                 TLRENDER_ASSERT(c.contains(4));
-                const auto l = c.getKeys();
-                TLRENDER_ASSERT(std::vector<int>({1, 3, 4}) == c.getKeys());
-                TLRENDER_ASSERT(std::vector<int>({2, 4, 5}) == c.getValues());
+                TLRENDER_ASSERT(std::vector<int>({3, 1, 4}) == c.getKeys());
+                TLRENDER_ASSERT(std::vector<int>({4, 2, 5}) == c.getValues());
+                TLRENDER_ASSERT(3 * memory::megabyte == c.getSize());
+                c.add(4, 6, 2 * memory::megabyte);
+                TLRENDER_ASSERT(!c.contains(3));
+                TLRENDER_ASSERT(3 * memory::megabyte == c.getSize());
+                c.remove(4);
+                TLRENDER_ASSERT(memory::megabyte == c.getSize());
+                c.clear();
+                TLRENDER_ASSERT(0 == c.getSize());
+                TLRENDER_ASSERT(0 == c.getCount());
+            }
+        }
+
+        namespace
+        {
+            // The previous implementation, which kept the entries in a map
+            // and scanned the access counters for eviction. Kept here for
+            // comparison.
+            template <typename T, typename U> class MapLRUCache
+            {
+            public:
+                void setMax(size_t value) { _max = value; }
+
+                bool get(const T& key, U& value)
+                {
+                    auto i = _map.find(key);
+                    if (i != _map.end())
+                    {
+                        value = i->second.first;
+                        _counts[key] = ++_counter;
+                        return true;
+                    }
+                    return false;
+                }
+
+                void add(const T& key, const U& value, size_t size)
+                {
+                    _map[key] = std::make_pair(value, size);
+                    _counts[key] = ++_counter;
+                    size_t total = 0;
+                    for (const auto& i : _map)
+                    {
+                        total += i.second.second;
+                    }
+                    if (total > _max)
+                    {
+                        std::map<int64_t, T> sorted;
+                        for (const auto& i : _counts)
+                        {
+                            sorted[i.second] = i.first;
+                        }
+                        while (total > _max)
+                        {
+                            auto begin = sorted.begin();
+                            auto i = _map.find(begin->second);
+                            total -= i->second.second;
+                            _map.erase(i);
+                            _counts.erase(begin->second);
+                            sorted.erase(begin);
+                        }
+                    }
+                }
+
+            private:
+                size_t _max = 10000;
+                std::map<T, std::pair<U, size_t> > _map;
+                std::map<T, int64_t> _counts;
+                int64_t _counter = 0;
+            };
+
+            template <typename C, typename K>
+            std::chrono::microseconds
+            benchmark(C& c, const std::vector<K>& keys)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                int value = 0;
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    // Look up the previous frames as a player would, then
+                    // add the new frame.
+                    for (size_t j = 1; j < 4 && j <= i; ++j)
+                    {
+                        c.get(keys[i - j], value);
+                    }
+                    c.add(keys[i], static_cast<int>(i), 1);
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                    t1 - t0);
+            }
+        } // namespace
+
+        void LRUCacheTest::_benchmark()
+        {
+            // The I/O cache keys are benchmarked in io_tests::CacheTest.
+            const size_t count = 1000;
+            const size_t frames = 20000;
+            std::vector<std::string> stringKeys;
+            for (size_t i = 0; i < frames; ++i)
+            {
+                stringKeys.push_back(
+                    string::Format("/shots/sh010/plate/sh010_plate.####.exr;"
+                                   "{0};{1} 24;OpenEXR/ChannelGrouping:Known")
+                        .arg(i)
+                        .arg(i));
+            }
+            {
+                MapLRUCache<std::string, int> c;
+                c.setMax(count);
+                _print(string::Format("Map LRU, string keys: {0}us")
+                           .arg(benchmark(c, stringKeys).count()));
+            }
+            {
+                LRUCache<std::string, int> c;
+                c.setMax(count);
+                _print(string::Format("Hashed LRU, string keys: {0}us")
+                           .arg(benchmark(c, stringKeys).count()));
+                TLRENDER_ASSERT(count == c.getCount());
             }
         }
     } // namespace core_tests
@@ -20,6 +20,10 @@ namespace tl
             create(const std::shared_ptr<system::Context>&);
 
             void run() override;
+
+        private:
+            void _cache();
+            void _benchmark();
         };
     } // namespace core_tests
 } // namespace tl
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/CacheTest.h>
+
+#include <tlIO/Cache.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/LRUCache.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        CacheTest::CacheTest(const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::CacheTest", context)
+        {
+        }
+
+        std::shared_ptr<CacheTest>
+        CacheTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<CacheTest>(new CacheTest(context));
+        }
+
+        void CacheTest::run()
+        {
+            _keys();
+            _cache();
+            _largeItems();
+            _lru();
+            _benchmark();
+        }
+
+        namespace
+        {
+            CacheKey getKey(int frame)
+            {
+                return getVideoCacheKey(
+                    file::Path("test.exr"), otime::RationalTime(frame, 24.0),
+                    Options(), Options());
+            }
+
+            VideoData getVideoData(int frame, const image::Size& size)
+            {
+                return VideoData(
+                    otime::RationalTime(frame, 24.0), 0,
+                    image::Image::create(
+                        size.w, size.h, image::PixelType::RGBA_U8));
+            }
+        } // namespace
+
+        void CacheTest::_keys()
+        {
+            const file::Path path("test.0.exr");
+            const auto a = getVideoCacheKey(
+                path, otime::RationalTime(0.0, 24.0), Options(), Options());
+            const auto b = getVideoCacheKey(
+                path, otime::RationalTime(0.0, 24.0), Options(),
+                {{"ClearFrame", "1"}});
+            const auto c = getVideoCacheKey(
+                path, otime::RationalTime(1.0, 24.0), Options(), Options());
+            const auto d = getVideoCacheKey(
+                file::Path("test.1.exr"), otime::RationalTime(0.0, 24.0),
+                Options(), Options());
+            TLRENDER_ASSERT(a == b);
+            TLRENDER_ASSERT(a != c);
+            TLRENDER_ASSERT(a != d);
+
+            // Each distinct path has its own ID.
+            TLRENDER_ASSERT(getCachePathID(path) == a.path);
+            TLRENDER_ASSERT(
+                getCachePathID(file::Path("test.0.exr")) == a.path);
+            TLRENDER_ASSERT(
+                getCachePathID(file::Path("test.1.exr")) == d.path);
+            TLRENDER_ASSERT(a.path != d.path);
+            TLRENDER_ASSERT(
+                getCachePathID(file::Path("/a/test.exr")) !=
+                getCachePathID(file::Path("/b/test.exr")));
+        }
+
+        void CacheTest::_cache()
+        {
+            auto cache = Cache::create(4);
+            TLRENDER_ASSERT(4 == cache->getShardCount());
+            const size_t byteCount = image::getDataByteCount(
+                image::Info(16, 16, image::PixelType::RGBA_U8));
+            cache->setMax(byteCount * 100);
+            TLRENDER_ASSERT(0 == cache->getSize());
+            std::vector<CacheKey> keys;
+            for (int i = 0; i < 10; ++i)
+            {
+                keys.push_back(getKey(i));
+                cache->addVideo(keys.back(), getVideoData(i, image::Size(16, 16)));
+            }
+            TLRENDER_ASSERT(byteCount * 10 == cache->getSize());
+            TLRENDER_ASSERT(cache->getPercentage() > 0.F);
+            VideoData videoData;
+            for (const auto& key : keys)
+            {
+                TLRENDER_ASSERT(cache->containsVideo(key));
+                TLRENDER_ASSERT(cache->getVideo(key, videoData));
+            }
+
+            // Replacing an item does not change the size.
+            cache->addVideo(keys[1], getVideoData(1, image::Size(16, 16)));
+            TLRENDER_ASSERT(byteCount * 10 == cache->getSize());
+
+            cache->removeVideo(keys[0]);
+            TLRENDER_ASSERT(!cache->containsVideo(keys[0]));
+            TLRENDER_ASSERT(byteCount * 9 == cache->getSize());
+            cache->setMax(0);
+            TLRENDER_ASSERT(0 == cache->getSize());
+            cache->setMax(byteCount * 100);
+            cache->addVideo(keys[0], VideoData());
+            cache->clear();
+            TLRENDER_ASSERT(0 == cache->getSize());
+        }
+
+        void CacheTest::_largeItems()
+        {
+            // Items larger than the maximum divided by the number of shards
+            // must stay in the cache while the total is below the maximum.
+            const image::Size size(256, 256);
+            const size_t byteCount = image::getDataByteCount(
+                image::Info(size, image::PixelType::RGBA_U8));
+            auto cache = Cache::create(16);
+            cache->setMax(byteCount * 10);
+            std::vector<CacheKey> keys;
+            for (int i = 0; i < 8; ++i)
+            {
+                keys.push_back(getKey(i));
+                cache->addVideo(keys.back(), getVideoData(i, size));
+            }
+            TLRENDER_ASSERT(byteCount * 8 == cache->getSize());
+            for (const auto& key : keys)
+            {
+                TLRENDER_ASSERT(cache->containsVideo(key));
+            }
+
+            // The video budget is 90% of the maximum, so adding one more
+            // item evicts the oldest.
+            keys.push_back(getKey(8));
+            cache->addVideo(keys.back(), getVideoData(8, size));
+            keys.push_back(getKey(9));
+            cache->addVideo(keys.back(), getVideoData(9, size));
+            TLRENDER_ASSERT(byteCount * 9 == cache->getSize());
+            TLRENDER_ASSERT(!cache->containsVideo(keys[0]));
+            for (size_t i = 1; i < keys.size(); ++i)
+            {
+                TLRENDER_ASSERT(cache->containsVideo(keys[i]));
+            }
+
+            // A single item larger than an equal share of every shard.
+            cache->clear();
+            cache->setMax(byteCount * 2);
+            cache->addVideo(keys[0], getVideoData(0, size));
+            TLRENDER_ASSERT(cache->containsVideo(keys[0]));
+            TLRENDER_ASSERT(byteCount == cache->getSize());
+        }
+
+        void CacheTest::_lru()
+        {
+            // The least recently used items of the whole cache are evicted
+            // first, whichever shard they are in.
+            const image::Size size(16, 16);
+            const size_t byteCount = image::getDataByteCount(
+                image::Info(size, image::PixelType::RGBA_U8));
+            auto cache = Cache::create(16);
+            cache->setMax(byteCount * 10);
+            std::vector<CacheKey> keys;
+            for (int i = 0; i < 9; ++i)
+            {
+                keys.push_back(getKey(i));
+                cache->addVideo(keys.back(), getVideoData(i, size));
+            }
+            TLRENDER_ASSERT(byteCount * 9 == cache->getSize());
+
+            // Use the first items so the next ones are the oldest.
+            VideoData videoData;
+            for (int i = 0; i < 4; ++i)
+            {
+                TLRENDER_ASSERT(cache->getVideo(keys[i], videoData));
+            }
+            for (int i = 9; i < 13; ++i)
+            {
+                keys.push_back(getKey(i));
+                cache->addVideo(keys.back(), getVideoData(i, size));
+            }
+            TLRENDER_ASSERT(byteCount * 9 == cache->getSize());
+            for (int i = 0; i < 4; ++i)
+            {
+                TLRENDER_ASSERT(cache->containsVideo(keys[i]));
+            }
+            for (int i = 4; i < 8; ++i)
+            {
+                TLRENDER_ASSERT(!cache->containsVideo(keys[i]));
+            }
+            for (int i = 8; i < 13; ++i)
+            {
+                TLRENDER_ASSERT(cache->containsVideo(keys[i]));
+            }
+        }
+
+        namespace
+        {
+            template <typename K>
+            std::chrono::microseconds
+            benchmark(memory::LRUCache<K, int>& c, const std::vector<K>& keys)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                int value = 0;
+                for (size_t i = 0; i < keys.size(); ++i)
+                {
+                    // Look up the previous frames as a player would, then
+                    // add the new frame.
+                    for (size_t j = 1; j < 4 && j <= i; ++j)
+                    {
+                        c.get(keys[i - j], value);
+                    }
+                    c.add(keys[i], static_cast<int>(i), 1);
+                }
+                const auto t1 = std::chrono::steady_clock::now();
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                    t1 - t0);
+            }
+        } // namespace
+
+        void CacheTest::_benchmark()
+        {
+            // The LRU cache with the I/O cache keys and the access pattern
+            // of a player. LRUCacheTest has the same benchmark with string
+            // keys.
+            const size_t count = 1000;
+            const size_t frames = 20000;
+            const file::Path path("/shots/sh010/plate/sh010_plate.0.exr");
+            const Options options = {{"OpenEXR/ChannelGrouping", "Known"}};
+            std::vector<CacheKey> keys;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < frames; ++i)
+            {
+                keys.push_back(getVideoCacheKey(
+                    path, otime::RationalTime(i, 24.0), options, Options()));
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            _print(string::Format("Keys created: {0}us")
+                       .arg(std::chrono::duration_cast<
+                                std::chrono::microseconds>(t1 - t0)
+                                .count()));
+            memory::LRUCache<CacheKey, int> c;
+            c.setMax(count);
+            _print(string::Format("LRU, cache keys: {0}us")
+                       .arg(benchmark(c, keys).count()));
+            TLRENDER_ASSERT(count == c.getCount());
+            int value = 0;
+            TLRENDER_ASSERT(c.get(keys[frames - 1], value));
+            TLRENDER_ASSERT(!c.get(keys[frames - count - 1], value));
+        }
+    } // namespace io_tests
+} // namespace tl
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class CacheTest : public tests::ITest
+        {
+        protected:
+            CacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<CacheTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _keys();
+            void _cache();
+            void _largeItems();
+            void _lru();
+            void _benchmark();
+        };
+    } // namespace io_tests
+} // namespace tl
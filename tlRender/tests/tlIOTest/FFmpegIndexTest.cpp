@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/FFmpegIndexTest.h>
+
+#include <tlIO/FFmpeg.h>
+#include <tlIO/FFmpegReadPrivate.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/StringFormat.h>
+
+extern "C"
+{
+#include <libavformat/avformat.h>
+} // extern "C"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        FFmpegIndexTest::FFmpegIndexTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::FFmpegIndexTest", context)
+        {
+        }
+
+        std::shared_ptr<FFmpegIndexTest> FFmpegIndexTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<FFmpegIndexTest>(
+                new FFmpegIndexTest(context));
+        }
+
+        void FFmpegIndexTest::run()
+        {
+            _index("H264");
+            _index("ProRes");
+        }
+
+        namespace
+        {
+            // Get the presentation timestamps of the keyframes by reading
+            // all of the packets.
+            std::vector<int64_t> getKeyframes(
+                const std::string& fileName, int& stream)
+            {
+                std::vector<int64_t> out;
+                AVFormatContext* avFormatContext = nullptr;
+                if (avformat_open_input(
+                        &avFormatContext, fileName.c_str(), nullptr,
+                        nullptr) < 0)
+                {
+                    return out;
+                }
+                stream = av_find_best_stream(
+                    avFormatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+                AVPacket* avPacket = av_packet_alloc();
+                while (stream >= 0 &&
+                       av_read_frame(avFormatContext, avPacket) >= 0)
+                {
+                    if (avPacket->stream_index == stream &&
+                        (avPacket->flags & AV_PKT_FLAG_KEY))
+                    {
+                        out.push_back(avPacket->pts);
+                    }
+                    av_packet_unref(avPacket);
+                }
+                av_packet_free(&avPacket);
+                avformat_close_input(&avFormatContext);
+                std::sort(out.begin(), out.end());
+                return out;
+            }
+
+            bool waitReady(const ffmpeg::KeyframeIndex& index)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                while (!index.isReady())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    if (std::chrono::steady_clock::now() - t0 >
+                        std::chrono::seconds(10))
+                        return false;
+                }
+                return true;
+            }
+
+            void check(
+                const ffmpeg::KeyframeIndex& index,
+                const std::vector<int64_t>& keyframes)
+            {
+                ffmpeg::KeyframeIndex::Entry entry;
+                TLRENDER_ASSERT(!index.getKeyframe(keyframes[0] - 1, entry));
+                for (size_t i = 0; i < keyframes.size(); ++i)
+                {
+                    // The presentation timestamp of each keyframe is found
+                    // exactly, and the frames after it belong to it.
+                    TLRENDER_ASSERT(index.getKeyframe(keyframes[i], entry));
+                    TLRENDER_ASSERT(keyframes[i] == entry.pts);
+                    if (i + 1 < keyframes.size())
+                    {
+                        TLRENDER_ASSERT(
+                            index.getKeyframe(keyframes[i + 1] - 1, entry));
+                        TLRENDER_ASSERT(keyframes[i] == entry.pts);
+                    }
+                }
+            }
+
+            std::vector<std::filesystem::path>
+            getIndexFiles(const std::string& dir)
+            {
+                std::vector<std::filesystem::path> out;
+                for (const auto& i : std::filesystem::directory_iterator(dir))
+                {
+                    if (i.path().extension() == ".idx")
+                    {
+                        out.push_back(i.path());
+                    }
+                }
+                return out;
+            }
+        } // namespace
+
+        void FFmpegIndexTest::_index(const std::string& profile)
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName =
+                dir + "/FFmpegIndexTest_" + profile + ".mp4";
+            const std::string indexDir = dir + "/index";
+            file::mkdir(indexDir);
+            try
+            {
+                // Write a movie with several GOPs.
+                const image::Info imageInfo(160, 90, image::PixelType::RGB_U8);
+                io::Info info;
+                info.video.push_back(imageInfo);
+                const otime::RationalTime duration(96.0, 24.0);
+                info.videoTime =
+                    otime::TimeRange(otime::RationalTime(0.0, 24.0), duration);
+                Options options;
+                options["FFmpeg/WriteProfile"] = profile;
+                {
+                    auto write = ffmpeg::Write::create(
+                        file::Path(fileName), info, options,
+                        _context ? _context->getLogSystem()
+                                 : std::weak_ptr<log::System>());
+                    auto image = image::Image::create(imageInfo);
+                    for (int i = 0; i < static_cast<int>(duration.value()); ++i)
+                    {
+                        // Change the image so that the frames differ.
+                        memset(image->getData(), i * 2, image->getDataByteCount());
+                        write->writeVideo(otime::RationalTime(i, 24.0), image);
+                    }
+                }
+                int stream = -1;
+                const auto keyframes = getKeyframes(fileName, stream);
+                TLRENDER_ASSERT(!keyframes.empty());
+                _print(string::Format("{0}: {1} keyframes")
+                           .arg(profile)
+                           .arg(keyframes.size()));
+
+                // Build the index.
+                {
+                    ffmpeg::KeyframeIndex index(fileName, stream, indexDir);
+                    TLRENDER_ASSERT(waitReady(index));
+                    check(index, keyframes);
+                }
+                auto indexFiles = getIndexFiles(indexDir);
+                TLRENDER_ASSERT(1 == indexFiles.size());
+                {
+                    std::ifstream f(indexFiles[0]);
+                    std::string header;
+                    std::getline(f, header);
+                    int indexStream = -1;
+                    size_t count = 0;
+                    f >> indexStream >> count;
+                    TLRENDER_ASSERT(header == "tlRender FFmpeg keyframe index 2");
+                    TLRENDER_ASSERT(stream == indexStream);
+                    TLRENDER_ASSERT(keyframes.size() == count);
+                }
+
+                // Load the saved index.
+                {
+                    ffmpeg::KeyframeIndex index(fileName, stream, indexDir);
+                    TLRENDER_ASSERT(waitReady(index));
+                    check(index, keyframes);
+                }
+
+                // An index file from an older version is built again.
+                {
+                    std::ofstream f(indexFiles[0]);
+                    f << "tlRender FFmpeg keyframe index 1\n" << stream << " 1\n"
+                      << "0 0 0\n";
+                }
+                {
+                    ffmpeg::KeyframeIndex index(fileName, stream, indexDir);
+                    TLRENDER_ASSERT(waitReady(index));
+                    check(index, keyframes);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+        }
+    } // namespace io_tests
+} // namespace tl
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/FFmpegReadTest.h>
+
+#include <tlIO/FFmpeg.h>
+#include <tlIO/FFmpegReadPrivate.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        FFmpegReadTest::FFmpegReadTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::FFmpegReadTest", context)
+        {
+        }
+
+        std::shared_ptr<FFmpegReadTest> FFmpegReadTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<FFmpegReadTest>(
+                new FFmpegReadTest(context));
+        }
+
+        void FFmpegReadTest::run()
+        {
+            _intraDecoders();
+        }
+
+        namespace
+        {
+            bool waitIntraDecoderThreads(size_t value)
+            {
+                const auto t0 = std::chrono::steady_clock::now();
+                while (ffmpeg::getIntraDecoderThreads() != value)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    if (std::chrono::steady_clock::now() - t0 >
+                        std::chrono::seconds(10))
+                        return false;
+                }
+                return true;
+            }
+
+            std::vector<std::shared_ptr<image::Image> > readAll(
+                const std::shared_ptr<ffmpeg::Read>& read,
+                const otime::RationalTime& duration)
+            {
+                // Queue all of the requests at once so that the additional
+                // decoders take them from the queue.
+                std::vector<std::future<io::VideoData> > futures;
+                for (int i = 0; i < static_cast<int>(duration.value()); ++i)
+                {
+                    futures.push_back(
+                        read->readVideo(otime::RationalTime(i, 24.0)));
+                }
+                std::vector<std::shared_ptr<image::Image> > out;
+                for (int i = 0; i < static_cast<int>(futures.size()); ++i)
+                {
+                    const auto videoData = futures[i].get();
+                    TLRENDER_ASSERT(videoData.time.strictly_equal(
+                        otime::RationalTime(i, 24.0)));
+                    TLRENDER_ASSERT(videoData.image);
+                    out.push_back(videoData.image);
+                }
+                return out;
+            }
+
+            bool isEqual(
+                const std::shared_ptr<image::Image>& a,
+                const std::shared_ptr<image::Image>& b)
+            {
+                return a->getInfo() == b->getInfo() &&
+                       0 == memcmp(
+                                a->getData(), b->getData(),
+                                a->getDataByteCount());
+            }
+        } // namespace
+
+        void FFmpegReadTest::_intraDecoders()
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName = dir + "/FFmpegReadTest_Intra.mov";
+            try
+            {
+                // Write an intra-only movie.
+                const image::Info imageInfo(160, 90, image::PixelType::RGB_U8);
+                io::Info info;
+                info.video.push_back(imageInfo);
+                const otime::RationalTime duration(48.0, 24.0);
+                info.videoTime =
+                    otime::TimeRange(otime::RationalTime(0.0, 24.0), duration);
+                Options options;
+                options["FFmpeg/WriteProfile"] = "ProRes";
+                const std::weak_ptr<log::System> logSystem =
+                    _context ? _context->getLogSystem()
+                             : std::weak_ptr<log::System>();
+                {
+                    auto write = ffmpeg::Write::create(
+                        file::Path(fileName), info, options, logSystem);
+                    auto image = image::Image::create(imageInfo);
+                    for (int i = 0; i < static_cast<int>(duration.value()); ++i)
+                    {
+                        memset(image->getData(), i * 2, image->getDataByteCount());
+                        write->writeVideo(otime::RationalTime(i, 24.0), image);
+                    }
+                }
+
+                // Decode the movie with a single decoder.
+                options.clear();
+                options["FFmpeg/IntraDecoderCount"] = "1";
+                std::vector<std::shared_ptr<image::Image> > images;
+                {
+                    auto read = ffmpeg::Read::create(
+                        file::Path(fileName), options, nullptr, logSystem);
+                    images = readAll(read, duration);
+                    TLRENDER_ASSERT(0 == ffmpeg::getIntraDecoderThreads());
+                }
+
+                // Decode the movie with additional decoders, the frames are
+                // the same and the decoders stay within the process limit.
+                options["FFmpeg/IntraDecoderCount"] = "4";
+                auto read = ffmpeg::Read::create(
+                    file::Path(fileName), options, nullptr, logSystem);
+                auto intraImages = readAll(read, duration);
+                TLRENDER_ASSERT(images.size() == intraImages.size());
+                for (size_t i = 0; i < images.size(); ++i)
+                {
+                    TLRENDER_ASSERT(isEqual(images[i], intraImages[i]));
+                }
+                const size_t threads = ffmpeg::getIntraDecoderThreads();
+                _print(string::Format("Intra decoder threads: {0}/{1}")
+                           .arg(threads)
+                           .arg(ffmpeg::getIntraDecoderThreadsMax()));
+                TLRENDER_ASSERT(threads <= 3);
+                TLRENDER_ASSERT(
+                    threads <= ffmpeg::getIntraDecoderThreadsMax());
+
+                // Releasing the memory stops the additional decoders, and
+                // they are started again by the next requests.
+                read->releaseMemory();
+                TLRENDER_ASSERT(waitIntraDecoderThreads(0));
+                intraImages = readAll(read, duration);
+                for (size_t i = 0; i < images.size(); ++i)
+                {
+                    TLRENDER_ASSERT(isEqual(images[i], intraImages[i]));
+                }
+                TLRENDER_ASSERT(threads == ffmpeg::getIntraDecoderThreads());
+                read.reset();
+                TLRENDER_ASSERT(0 == ffmpeg::getIntraDecoderThreads());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            std::error_code ec;
+            std::filesystem::remove_all(dir, ec);
+        }
+    } // namespace io_tests
+} // namespace tl
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class FFmpegReadTest : public tests::ITest
+        {
+        protected:
+            FFmpegReadTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<FFmpegReadTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _intraDecoders();
+        };
+    } // namespace io_tests
+} // namespace tl
@@ -173,6 +173,7 @@ namespace tl
                 {"FFmpeg/RequestTimeout", "1"},
                 {"FFmpeg/VideoBufferSize", "1"},
                 {"FFmpeg/AudioBufferSize", "1/1"},
+                {"FFmpeg/IntraDecoderCount", "4"},
                 {"FFmpeg/WriteProfile", "None"},
                 {"FFmpeg/WriteProfile", "H264"},
                 {"FFmpeg/WriteProfile", "ProRes"},
@@ -4,6 +4,7 @@
 
 #include <tlIOTest/IOTest.h>
 
+#include <tlIO/Cache.h>
 #include <tlIO/System.h>
 
 #include <tlCore/Assert.h>
@@ -32,6 +33,7 @@ namespace tl
         void IOTest::run()
         {
             _videoData();
+            _frameRequest();
             _ioSystem();
         }
 
@@ -66,6 +68,59 @@ namespace tl
             }
         }
 
+        void IOTest::_frameRequest()
+        {
+            {
+                const FrameRequest a;
+                TLRENDER_ASSERT(1.F == a.scale);
+                TLRENDER_ASSERT(!a.roi.isValid());
+                TLRENDER_ASSERT(1 == a.getSubsampleStep());
+                Options options;
+                setFrameRequest(options, a);
+                TLRENDER_ASSERT(options.empty());
+                TLRENDER_ASSERT(a == getFrameRequest(options));
+            }
+            {
+                FrameRequest a;
+                a.scale = .25F;
+                a.roi = math::Box2i(10, 20, 100, 200);
+                TLRENDER_ASSERT(4 == a.getSubsampleStep());
+                Options options;
+                setFrameRequest(options, a);
+                const FrameRequest b = getFrameRequest(options);
+                TLRENDER_ASSERT(a == b);
+                TLRENDER_ASSERT(
+                    getVideoCacheKey(
+                        file::Path("test.0.exr"),
+                        otime::RationalTime(0.0, 24.0), Options(), options) !=
+                    getVideoCacheKey(
+                        file::Path("test.0.exr"),
+                        otime::RationalTime(0.0, 24.0), Options(), Options()));
+                setFrameRequest(options, FrameRequest());
+                TLRENDER_ASSERT(options.empty());
+            }
+            {
+                FrameRequest a;
+                a.scale = .5F;
+                TLRENDER_ASSERT(2 == a.getSubsampleStep());
+                a.scale = .4F;
+                TLRENDER_ASSERT(2 == a.getSubsampleStep());
+                a.scale = 2.F;
+                TLRENDER_ASSERT(1 == a.getSubsampleStep());
+            }
+            {
+                const std::vector<uint16_t> in = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+                std::vector<uint16_t> out(3);
+                subsampleScanline(
+                    reinterpret_cast<const uint8_t*>(in.data()),
+                    reinterpret_cast<uint8_t*>(out.data()), out.size(),
+                    sizeof(uint16_t), 3);
+                TLRENDER_ASSERT(0 == out[0]);
+                TLRENDER_ASSERT(3 == out[1]);
+                TLRENDER_ASSERT(6 == out[2]);
+            }
+        }
+
         namespace
         {
             class DummyPlugin : public IPlugin
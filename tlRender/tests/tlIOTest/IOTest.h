@@ -23,6 +23,7 @@ namespace tl
 
         private:
             void _videoData();
+            void _frameRequest();
             void _ioSystem();
         };
     } // namespace io_tests
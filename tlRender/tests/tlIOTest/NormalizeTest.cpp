@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/NormalizeTest.h>
+
+#include <tlIO/Normalize.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        NormalizeTest::NormalizeTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::NormalizeTest", context)
+        {
+        }
+
+        std::shared_ptr<NormalizeTest>
+        NormalizeTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<NormalizeTest>(new NormalizeTest(context));
+        }
+
+        void NormalizeTest::run()
+        {
+            _normalize();
+            _benchmark();
+        }
+
+        namespace
+        {
+            // Fill an image with random values and a NaN, and return the
+            // expected minimum and maximum.
+            template <typename T>
+            void fill(
+                const std::shared_ptr<image::Image>& image,
+                math::Vector4f& minimum, math::Vector4f& maximum)
+            {
+                const image::Info& info = image->getInfo();
+                const size_t channels = image::getChannelCount(info.pixelType);
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    minimum[c] = std::numeric_limits<float>::max();
+                    maximum[c] = std::numeric_limits<float>::lowest();
+                }
+                std::mt19937 rng(1);
+                std::uniform_real_distribution<float> dist(-1000.F, 1000.F);
+                T* p = reinterpret_cast<T*>(image->getData());
+                const size_t count =
+                    static_cast<size_t>(info.size.w) * info.size.h * channels;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    p[i] = dist(rng);
+                }
+                // NaNs are ignored.
+                if (count > channels)
+                {
+                    p[channels] = std::numeric_limits<float>::quiet_NaN();
+                }
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const float value = static_cast<float>(p[i]);
+                    if (!std::isnan(value))
+                    {
+                        const size_t c = i % channels;
+                        minimum[c] = std::min(minimum[c], value);
+                        maximum[c] = std::max(maximum[c], value);
+                    }
+                }
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    if (minimum[c] >= maximum[c])
+                    {
+                        minimum[c] = 0.F;
+                        maximum[c] = 1.F;
+                    }
+                }
+            }
+        } // namespace
+
+        void NormalizeTest::_normalize()
+        {
+            // Odd sizes so that both the vector and scalar code is used.
+            const std::vector<image::Size> sizes = {
+                image::Size(1, 1), image::Size(7, 3), image::Size(33, 17),
+                image::Size(1921, 1081)};
+            const std::vector<image::PixelType> pixelTypes = {
+                image::PixelType::L_F16,  image::PixelType::L_F32,
+                image::PixelType::RGB_F16, image::PixelType::RGB_F32,
+                image::PixelType::RGBA_F16, image::PixelType::RGBA_F32};
+            for (const auto& size : sizes)
+            {
+                for (const auto pixelType : pixelTypes)
+                {
+                    const image::Info info(size, pixelType);
+                    auto image = image::Image::create(info);
+                    math::Vector4f expectedMin;
+                    math::Vector4f expectedMax;
+                    switch (image::getBitDepth(pixelType))
+                    {
+                    case 16:
+                        fill<half>(image, expectedMin, expectedMax);
+                        break;
+                    case 32:
+                        fill<float>(image, expectedMin, expectedMax);
+                        break;
+                    default:
+                        break;
+                    }
+                    math::Vector4f minimum;
+                    math::Vector4f maximum;
+                    normalizeImage(
+                        minimum, maximum, image, info, 0, size.w - 1, 0,
+                        size.h - 1);
+                    _print(string::Format("{0} {1}: {2} {3}")
+                               .arg(size)
+                               .arg(pixelType)
+                               .arg(serialize(minimum))
+                               .arg(serialize(maximum)));
+                    for (size_t c = 0; c < 4; ++c)
+                    {
+                        TLRENDER_ASSERT(expectedMin[c] == minimum[c]);
+                        TLRENDER_ASSERT(expectedMax[c] == maximum[c]);
+                    }
+                }
+            }
+            {
+                // L_F16 and L_F32 values outside of the byte range.
+                const image::Info info(16, 16, image::PixelType::L_F32);
+                auto image = image::Image::create(info);
+                float* p = reinterpret_cast<float*>(image->getData());
+                for (int i = 0; i < 16 * 16; ++i)
+                {
+                    p[i] = i * 100.F;
+                }
+                math::Vector4f minimum;
+                math::Vector4f maximum;
+                normalizeImage(minimum, maximum, image, info, 0, 15, 0, 15);
+                TLRENDER_ASSERT(0.F == minimum[0]);
+                TLRENDER_ASSERT(25500.F == maximum[0]);
+            }
+            {
+                // Constant channels are mapped to [0, 1].
+                const image::Info info(16, 16, image::PixelType::RGBA_F32);
+                auto image = image::Image::create(info);
+                image->zero();
+                math::Vector4f minimum;
+                math::Vector4f maximum;
+                normalizeImage(minimum, maximum, image, info, 0, 15, 0, 15);
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    TLRENDER_ASSERT(0.F == minimum[c]);
+                    TLRENDER_ASSERT(1.F == maximum[c]);
+                }
+            }
+        }
+
+        void NormalizeTest::_benchmark()
+        {
+            const image::Info info(3840, 2160, image::PixelType::RGBA_F32);
+            auto image = image::Image::create(info);
+            math::Vector4f expectedMin;
+            math::Vector4f expectedMax;
+            fill<float>(image, expectedMin, expectedMax);
+            const size_t count = 10;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                math::Vector4f minimum;
+                math::Vector4f maximum;
+                normalizeImage(
+                    minimum, maximum, image, info, 0, info.size.w - 1, 0,
+                    info.size.h - 1);
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> diff = t1 - t0;
+            const double seconds = diff.count() / count;
+            _print(string::Format("4K RGBA_F32: {0}ms, {1} GB/s")
+                       .arg(seconds * 1000.0)
+                       .arg(image->getDataByteCount() / seconds /
+                            (1024.0 * 1024.0 * 1024.0)));
+        }
+    } // namespace io_tests
+} // namespace tl
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class NormalizeTest : public tests::ITest
+        {
+        protected:
+            NormalizeTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<NormalizeTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _normalize();
+            void _benchmark();
+        };
+    } // namespace io_tests
+} // namespace tl
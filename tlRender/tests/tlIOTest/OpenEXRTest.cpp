@@ -9,7 +9,14 @@
 
 #include <tlCore/Assert.h>
 #include <tlCore/FileIO.h>
+#include <tlCore/StringFormat.h>
 
+#include <ImfChannelList.h>
+#include <ImfInputFile.h>
+#include <ImfOutputFile.h>
+#include <ImfTiledOutputFile.h>
+
+#include <chrono>
 #include <sstream>
 
 using namespace tl::io;
@@ -34,6 +41,8 @@ namespace tl
         {
             _enums();
             _io();
+            _benchmark();
+            _tiles();
         }
 
         void OpenEXRTest::_enums()
@@ -292,5 +301,324 @@ namespace tl
                 }
             }
         }
+
+        namespace
+        {
+            void writeWindow(
+                const std::string& fileName, const Imath::Box2i& displayWindow,
+                const Imath::Box2i& dataWindow, Imf::Compression compression)
+            {
+                Imf::Header header(
+                    displayWindow, dataWindow, 1.F, Imath::V2f(0.F, 0.F), 1.F,
+                    Imf::INCREASING_Y, compression);
+                const std::vector<std::string> channels = {"R", "G", "B", "A"};
+                for (const auto& channel : channels)
+                {
+                    header.channels().insert(
+                        channel.c_str(), Imf::Channel(Imf::HALF));
+                }
+                const int w = dataWindow.max.x - dataWindow.min.x + 1;
+                const int h = dataWindow.max.y - dataWindow.min.y + 1;
+                std::vector<half> data(w * h * 4);
+                for (int y = 0; y < h; ++y)
+                {
+                    for (int x = 0; x < w; ++x)
+                    {
+                        half* p = data.data() + (y * w + x) * 4;
+                        p[0] = x / static_cast<float>(w);
+                        p[1] = y / static_cast<float>(h);
+                        p[2] = 0.5F;
+                        p[3] = 1.F;
+                    }
+                }
+                Imf::FrameBuffer frameBuffer;
+                char* base = reinterpret_cast<char*>(
+                    data.data() - (dataWindow.min.y * w + dataWindow.min.x) * 4);
+                for (size_t c = 0; c < channels.size(); ++c)
+                {
+                    frameBuffer.insert(
+                        channels[c].c_str(),
+                        Imf::Slice(
+                            Imf::HALF, base + c * sizeof(half),
+                            4 * sizeof(half), w * 4 * sizeof(half)));
+                }
+                Imf::OutputFile f(fileName.c_str(), header);
+                f.setFrameBuffer(frameBuffer);
+                f.writePixels(h);
+            }
+
+            std::vector<half> readLines(
+                const std::string& fileName, const Imath::Box2i& dataWindow)
+            {
+                // Read the data window a line at a time, as a reference for
+                // the batched reads.
+                const int w = dataWindow.max.x - dataWindow.min.x + 1;
+                const int h = dataWindow.max.y - dataWindow.min.y + 1;
+                std::vector<half> out(w * h * 4);
+                Imf::FrameBuffer frameBuffer;
+                char* base = reinterpret_cast<char*>(
+                    out.data() - (dataWindow.min.y * w + dataWindow.min.x) * 4);
+                const std::vector<std::string> channels = {"R", "G", "B", "A"};
+                for (size_t c = 0; c < channels.size(); ++c)
+                {
+                    frameBuffer.insert(
+                        channels[c].c_str(),
+                        Imf::Slice(
+                            Imf::HALF, base + c * sizeof(half),
+                            4 * sizeof(half), w * 4 * sizeof(half)));
+                }
+                Imf::InputFile f(fileName.c_str());
+                f.setFrameBuffer(frameBuffer);
+                for (int y = dataWindow.min.y; y <= dataWindow.max.y; ++y)
+                {
+                    f.readPixels(y, y);
+                }
+                return out;
+            }
+
+            bool compareLines(
+                const std::shared_ptr<image::Image>& image,
+                const Imath::V2i& origin, const Imath::Box2i& dataWindow,
+                const std::vector<half>& lines)
+            {
+                // The origin is the position of the image in the data window
+                // coordinates. Pixels outside of the data window are zero.
+                const int w = dataWindow.max.x - dataWindow.min.x + 1;
+                const image::Size& size = image->getSize();
+                const half* p =
+                    reinterpret_cast<const half*>(image->getData());
+                for (int y = 0; y < size.h; ++y)
+                {
+                    const int dy = origin.y + y;
+                    for (int x = 0; x < size.w; ++x, p += 4)
+                    {
+                        const int dx = origin.x + x;
+                        const bool inside =
+                            dx >= dataWindow.min.x && dx <= dataWindow.max.x &&
+                            dy >= dataWindow.min.y && dy <= dataWindow.max.y;
+                        for (int c = 0; c < 4; ++c)
+                        {
+                            const half value =
+                                inside ? lines
+                                             [((dy - dataWindow.min.y) * w +
+                                               dx - dataWindow.min.x) *
+                                                  4 +
+                                              c]
+                                       : half(0.F);
+                            if (p[c].bits() != value.bits())
+                                return false;
+                        }
+                    }
+                }
+                return true;
+            }
+        } // namespace
+
+        void OpenEXRTest::_benchmark()
+        {
+            // Time reading images where the data window is different from
+            // the display window, and compare the pixels with the image read
+            // a line at a time. The data window inside of the display window
+            // is read directly into the image, the overscan is read in chunk
+            // batches, or in full when the display window is ignored.
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+            const Imath::Box2i displayWindow(
+                Imath::V2i(0, 0), Imath::V2i(2047, 1555));
+            struct Window
+            {
+                std::string name;
+                Imath::Box2i dataWindow;
+                bool ignoreDisplayWindow = false;
+            };
+            const std::vector<Window> windows = {
+                {"Inside",
+                 Imath::Box2i(Imath::V2i(64, 32), Imath::V2i(1983, 1523)),
+                 false},
+                {"Overscan",
+                 Imath::Box2i(Imath::V2i(-64, -32), Imath::V2i(2111, 1587)),
+                 false},
+                {"OverscanFull",
+                 Imath::Box2i(Imath::V2i(-64, -32), Imath::V2i(2111, 1587)),
+                 true}};
+            const std::vector<std::pair<std::string, Imf::Compression> >
+                compressions = {
+                    {"ZIP", Imf::ZIP_COMPRESSION},
+                    {"PIZ", Imf::PIZ_COMPRESSION},
+                    {"DWAA", Imf::DWAA_COMPRESSION}};
+            const size_t count = 10;
+            for (const auto& window : windows)
+            {
+                for (const auto& compression : compressions)
+                {
+                    try
+                    {
+                        const std::string fileName =
+                            string::Format("OpenEXRBenchmark_{0}_{1}.0.exr")
+                                .arg(window.name)
+                                .arg(compression.first);
+                        writeWindow(
+                            fileName, displayWindow, window.dataWindow,
+                            compression.second);
+                        Options options;
+                        options["OpenEXR/IgnoreDisplayWindow"] =
+                            window.ignoreDisplayWindow ? "1" : "0";
+                        io::VideoData videoData;
+                        const auto t0 = std::chrono::steady_clock::now();
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            auto read =
+                                plugin->read(file::Path(fileName), options);
+                            videoData =
+                                read->readVideo(otime::RationalTime(0.0, 24.0))
+                                    .get();
+                            TLRENDER_ASSERT(videoData.image);
+                            system->getCache()->clear();
+                        }
+                        const auto t1 = std::chrono::steady_clock::now();
+                        const std::chrono::duration<double> diff = t1 - t0;
+                        _print(string::Format("{0} {1}: {2}ms per frame")
+                                   .arg(window.name)
+                                   .arg(compression.first)
+                                   .arg(diff.count() * 1000.0 / count));
+
+                        TLRENDER_ASSERT(
+                            image::PixelType::RGBA_F16 ==
+                            videoData.image->getPixelType());
+                        const Imath::Box2i& origin =
+                            window.ignoreDisplayWindow ? window.dataWindow
+                                                       : displayWindow;
+                        TLRENDER_ASSERT(
+                            videoData.image->getSize() ==
+                            image::Size(
+                                origin.max.x - origin.min.x + 1,
+                                origin.max.y - origin.min.y + 1));
+                        TLRENDER_ASSERT(compareLines(
+                            videoData.image, origin.min, window.dataWindow,
+                            readLines(fileName, window.dataWindow)));
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _printError(e.what());
+                    }
+                }
+            }
+        }
+
+        void OpenEXRTest::_tiles()
+        {
+            auto system = _context->getSystem<System>();
+            auto plugin = system->getPlugin<exr::Plugin>();
+            const std::string fileName = "OpenEXRTiles.0.exr";
+            const int size = 512;
+            try
+            {
+                // Write a tiled mipmapped image, where the pixels of each
+                // level are the level number plus one.
+                const Imath::Box2i window(
+                    Imath::V2i(0, 0), Imath::V2i(size - 1, size - 1));
+                Imf::Header header(window, window);
+                header.channels().insert("R", Imf::Channel(Imf::HALF));
+                header.channels().insert("G", Imf::Channel(Imf::HALF));
+                header.channels().insert("B", Imf::Channel(Imf::HALF));
+                header.channels().insert("A", Imf::Channel(Imf::HALF));
+                header.setTileDescription(
+                    Imf::TileDescription(64, 64, Imf::MIPMAP_LEVELS));
+                Imf::TiledOutputFile f(fileName.c_str(), header);
+                for (int level = 0; level < f.numLevels(); ++level)
+                {
+                    const int w = f.levelWidth(level);
+                    const int h = f.levelHeight(level);
+                    std::vector<half> data(w * h * 4, half(level + 1.F));
+                    Imf::FrameBuffer frameBuffer;
+                    const std::vector<std::string> channels = {
+                        "R", "G", "B", "A"};
+                    for (size_t c = 0; c < channels.size(); ++c)
+                    {
+                        frameBuffer.insert(
+                            channels[c].c_str(),
+                            Imf::Slice(
+                                Imf::HALF,
+                                reinterpret_cast<char*>(data.data() + c),
+                                4 * sizeof(half), w * 4 * sizeof(half)));
+                    }
+                    f.setFrameBuffer(frameBuffer);
+                    f.writeTiles(
+                        0, f.numXTiles(level) - 1, 0, f.numYTiles(level) - 1,
+                        level);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+                return;
+            }
+            try
+            {
+                auto read = plugin->read(file::Path(fileName));
+                auto videoData =
+                    read->readVideo(otime::RationalTime(0.0, 24.0)).get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(
+                    videoData.image->getSize() == image::Size(size, size));
+                const half* p =
+                    reinterpret_cast<const half*>(videoData.image->getData());
+                TLRENDER_ASSERT(1.F == p[0]);
+                TLRENDER_ASSERT(1.F == p[(size * size - 1) * 4]);
+
+                // Read the level matching the zoom.
+                Options options;
+                options["OpenEXR/Zoom"] = "0.25";
+                videoData =
+                    read->readVideo(otime::RationalTime(0.0, 24.0), options)
+                        .get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(
+                    videoData.image->getSize() ==
+                    image::Size(size / 4, size / 4));
+                p = reinterpret_cast<const half*>(videoData.image->getData());
+                TLRENDER_ASSERT(3.F == p[0]);
+                TLRENDER_ASSERT(3.F == p[(size / 4 * size / 4 - 1) * 4]);
+
+                // Read only the tiles in the region of interest.
+                options.clear();
+                options["OpenEXR/ROI"] = "0 0 63 63";
+                videoData =
+                    read->readVideo(otime::RationalTime(0.0, 24.0), options)
+                        .get();
+                TLRENDER_ASSERT(videoData.image);
+                p = reinterpret_cast<const half*>(videoData.image->getData());
+                TLRENDER_ASSERT(1.F == p[0]);
+                TLRENDER_ASSERT(1.F == p[(63 * size + 63) * 4]);
+                TLRENDER_ASSERT(0.F == p[64 * 4]);
+                TLRENDER_ASSERT(0.F == p[64 * size * 4]);
+                TLRENDER_ASSERT(0.F == p[(size * size - 1) * 4]);
+
+                // Read the tiles of a level in the region of interest from
+                // a frame request. The region is scaled to the level.
+                options.clear();
+                io::FrameRequest frameRequest;
+                frameRequest.scale = .5F;
+                frameRequest.roi = math::Box2i(64, 64, 64, 64);
+                io::setFrameRequest(options, frameRequest);
+                videoData =
+                    read->readVideo(otime::RationalTime(0.0, 24.0), options)
+                        .get();
+                TLRENDER_ASSERT(videoData.image);
+                TLRENDER_ASSERT(
+                    videoData.image->getSize() ==
+                    image::Size(size / 2, size / 2));
+                const int levelSize = size / 2;
+                p = reinterpret_cast<const half*>(videoData.image->getData());
+                TLRENDER_ASSERT(2.F == p[0]);
+                TLRENDER_ASSERT(2.F == p[(63 * levelSize + 63) * 4]);
+                TLRENDER_ASSERT(0.F == p[64 * 4]);
+                TLRENDER_ASSERT(0.F == p[(levelSize * levelSize - 1) * 4]);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
     } // namespace io_tests
 } // namespace tl
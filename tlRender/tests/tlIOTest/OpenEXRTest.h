@@ -24,6 +24,8 @@ namespace tl
         private:
             void _enums();
             void _io();
+            void _benchmark();
+            void _tiles();
         };
     } // namespace io_tests
 } // namespace tl
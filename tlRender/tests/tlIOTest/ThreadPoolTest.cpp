@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlIOTest/ThreadPoolTest.h>
+
+#include <tlIO/ThreadPool.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/StringFormat.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        ThreadPoolTest::ThreadPoolTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("io_tests::ThreadPoolTest", context)
+        {
+        }
+
+        std::shared_ptr<ThreadPoolTest>
+        ThreadPoolTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ThreadPoolTest>(new ThreadPoolTest(context));
+        }
+
+        void ThreadPoolTest::run()
+        {
+            _tasks();
+            _priority();
+            _completion();
+            _parallelFor();
+        }
+
+        void ThreadPoolTest::_tasks()
+        {
+            {
+                auto pool = ThreadPool::create(0);
+                TLRENDER_ASSERT(1 == pool->getThreadCount());
+            }
+            {
+                const size_t count = 1000;
+                std::atomic<size_t> tasks = 0;
+                std::atomic<size_t> completions = 0;
+                {
+                    auto pool = ThreadPool::create(4);
+                    TLRENDER_ASSERT(4 == pool->getThreadCount());
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        pool->submit(
+                            [&tasks] { ++tasks; },
+                            [&completions] { ++completions; });
+                    }
+                    while (pool->getStats().completed < count)
+                    {
+                        std::this_thread::yield();
+                    }
+                    const ThreadPoolStats stats = pool->getStats();
+                    _print(string::Format(
+                               "Queue depth max: {0}, stolen: {1}, "
+                               "wait: {2}us, run: {3}us")
+                               .arg(stats.queueDepthMax)
+                               .arg(stats.stolen)
+                               .arg(stats.waitAverage.count())
+                               .arg(stats.runAverage.count()));
+                    TLRENDER_ASSERT(count == stats.submitted);
+                    TLRENDER_ASSERT(stats.queueDepthMax > 0);
+                    pool->resetStats();
+                    TLRENDER_ASSERT(0 == pool->getStats().completed);
+                }
+                TLRENDER_ASSERT(count == tasks);
+                TLRENDER_ASSERT(count == completions);
+            }
+            {
+                // Tasks submitted from a worker.
+                std::atomic<size_t> tasks = 0;
+                {
+                    auto pool = ThreadPool::create(2);
+                    std::weak_ptr<ThreadPool> weak(pool);
+                    pool->submit(
+                        [weak, &tasks]
+                        {
+                            ++tasks;
+                            if (auto pool = weak.lock())
+                            {
+                                pool->submit([&tasks] { ++tasks; });
+                            }
+                        });
+                    while (pool->getStats().completed < 2)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                TLRENDER_ASSERT(2 == tasks);
+            }
+            {
+                auto pool = ThreadPool::getGlobal();
+                TLRENDER_ASSERT(pool == ThreadPool::getGlobal());
+                TLRENDER_ASSERT(pool->getThreadCount() > 0);
+            }
+        }
+
+        void ThreadPoolTest::_priority()
+        {
+            // Keep the only worker busy while the tasks are queued, then
+            // check that the high priority tasks run first.
+            auto pool = ThreadPool::create(1);
+            std::atomic<bool> wait = true;
+            pool->submit(
+                [&wait]
+                {
+                    while (wait)
+                    {
+                        std::this_thread::yield();
+                    }
+                });
+            std::mutex mutex;
+            std::vector<int> order;
+            for (int i = 0; i < 4; ++i)
+            {
+                const ThreadPoolPriority priority =
+                    i < 2 ? ThreadPoolPriority::Normal
+                          : ThreadPoolPriority::High;
+                pool->submit(
+                    [&mutex, &order, i]
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        order.push_back(i);
+                    },
+                    nullptr, priority);
+            }
+            wait = false;
+            while (pool->getStats().completed < 5)
+            {
+                std::this_thread::yield();
+            }
+            TLRENDER_ASSERT(std::vector<int>({2, 3, 0, 1}) == order);
+        }
+
+        void ThreadPoolTest::_completion()
+        {
+            // Each owner waits on its own condition variable, and only the
+            // completions of its own tasks wake it.
+            auto pool = ThreadPool::create(2);
+            struct Owner
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                size_t completed = 0;
+            };
+            Owner a;
+            Owner b;
+            auto submit = [pool](Owner& owner)
+            {
+                pool->submit(
+                    [] {},
+                    [&owner]
+                    {
+                        std::unique_lock<std::mutex> lock(owner.mutex);
+                        ++owner.completed;
+                        owner.cv.notify_one();
+                    });
+            };
+            submit(a);
+            submit(a);
+            submit(b);
+            {
+                std::unique_lock<std::mutex> lock(a.mutex);
+                a.cv.wait(lock, [&a] { return 2 == a.completed; });
+            }
+            {
+                std::unique_lock<std::mutex> lock(b.mutex);
+                b.cv.wait(lock, [&b] { return 1 == b.completed; });
+            }
+            while (pool->getStats().completed < 3)
+            {
+                std::this_thread::yield();
+            }
+            TLRENDER_ASSERT(2 == a.completed);
+            TLRENDER_ASSERT(1 == b.completed);
+        }
+
+        void ThreadPoolTest::_parallelFor()
+        {
+            auto pool = ThreadPool::create(4);
+            for (const size_t count : {0, 1, 99, 1000, 10007})
+            {
+                std::vector<int> values(count, 0);
+                pool->parallelFor(
+                    count, 100,
+                    [&values](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            ++values[i];
+                        }
+                    });
+                for (const int value : values)
+                {
+                    TLRENDER_ASSERT(1 == value);
+                }
+            }
+            {
+                // Call from tasks running on all of the worker threads.
+                std::atomic<size_t> total = 0;
+                std::atomic<size_t> tasks = 0;
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    pool->submit(
+                        [pool, &total, &tasks]
+                        {
+                            pool->parallelFor(
+                                1000, 10,
+                                [&total](size_t begin, size_t end)
+                                { total += end - begin; });
+                            ++tasks;
+                        });
+                }
+                while (tasks < 8)
+                {
+                    std::this_thread::yield();
+                }
+                TLRENDER_ASSERT(8000 == total);
+            }
+        }
+    } // namespace io_tests
+} // namespace tl
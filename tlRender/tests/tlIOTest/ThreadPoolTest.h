@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class ThreadPoolTest : public tests::ITest
+        {
+        protected:
+            ThreadPoolTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<ThreadPoolTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _tasks();
+            void _priority();
+            void _completion();
+            void _parallelFor();
+        };
+    } // namespace io_tests
+} // namespace tl
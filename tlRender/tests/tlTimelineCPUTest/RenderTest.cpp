@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineCPUTest/RenderTest.h>
+
+#include <tlTimelineCPU/Render.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/Math.h>
+#include <tlCore/StringFormat.h>
+
+using namespace tl::timeline_cpu;
+
+namespace tl
+{
+    namespace timeline_cpu_tests
+    {
+        RenderTest::RenderTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_cpu_tests::RenderTest", context)
+        {
+        }
+
+        std::shared_ptr<RenderTest>
+        RenderTest::create(const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<RenderTest>(new RenderTest(context));
+        }
+
+        void RenderTest::run()
+        {
+            _rect();
+            _fillRule();
+            _blend();
+            _image();
+            _compare();
+        }
+
+        namespace
+        {
+            const math::Size2i renderSize(8, 8);
+
+            void begin(
+                const std::shared_ptr<Render>& render,
+                const image::Color4f& clearColor = image::Color4f(0.F, 0.F, 0.F, 1.F))
+            {
+                timeline::RenderOptions renderOptions;
+                renderOptions.clearColor = clearColor;
+                render->begin(renderSize, renderOptions);
+            }
+
+            // The rendered image is mirrored, the first row is the top.
+            image::Color4f
+            getPixel(const std::shared_ptr<Render>& render, int x, int y)
+            {
+                const auto& image = render->getImage();
+                TLRENDER_ASSERT(image->getInfo().layout.mirror.y);
+                const float* p = reinterpret_cast<const float*>(
+                                     image->getData()) +
+                                 (static_cast<size_t>(y) * image->getWidth() +
+                                  x) * 4;
+                return image::Color4f(p[0], p[1], p[2], p[3]);
+            }
+
+            bool isEqual(const image::Color4f& a, const image::Color4f& b)
+            {
+                return math::fuzzyCompare(a.r, b.r, .1e-5F) &&
+                       math::fuzzyCompare(a.g, b.g, .1e-5F) &&
+                       math::fuzzyCompare(a.b, b.b, .1e-5F) &&
+                       math::fuzzyCompare(a.a, b.a, .1e-5F);
+            }
+
+            std::shared_ptr<image::Image> createImage(
+                const math::Size2i& size,
+                const std::vector<image::Color4f>& colors)
+            {
+                auto out = image::Image::create(
+                    size.w, size.h, image::PixelType::RGBA_F32);
+                float* p = reinterpret_cast<float*>(out->getData());
+                for (size_t i = 0; i < colors.size(); ++i, p += 4)
+                {
+                    p[0] = colors[i].r;
+                    p[1] = colors[i].g;
+                    p[2] = colors[i].b;
+                    p[3] = colors[i].a;
+                }
+                return out;
+            }
+
+            std::shared_ptr<image::Image>
+            createImage(const math::Size2i& size, const image::Color4f& color)
+            {
+                return createImage(
+                    size, std::vector<image::Color4f>(size.w * size.h, color));
+            }
+        } // namespace
+
+        void RenderTest::_rect()
+        {
+            auto render = Render::create(_context);
+            const image::Color4f color(1.F, .5F, .25F, 1.F);
+            begin(render);
+            render->drawRect(math::Box2i(2, 3, 4, 2), color);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    const bool inside = x >= 2 && x < 6 && y >= 3 && y < 5;
+                    TLRENDER_ASSERT(isEqual(
+                        getPixel(render, x, y),
+                        inside ? color : image::Color4f(0.F, 0.F, 0.F, 1.F)));
+                }
+            }
+
+            // The clipping rectangle limits drawing.
+            begin(render);
+            render->setClipRectEnabled(true);
+            render->setClipRect(math::Box2i(0, 0, 4, 8));
+            render->drawRect(math::Box2i(0, 0, 8, 8), color);
+            render->setClipRectEnabled(false);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    TLRENDER_ASSERT(isEqual(
+                        getPixel(render, x, y),
+                        x < 4 ? color : image::Color4f(0.F, 0.F, 0.F, 1.F)));
+                }
+            }
+        }
+
+        void RenderTest::_fillRule()
+        {
+            // Triangles and rectangles that share edges cover each pixel
+            // exactly once, so a translucent color is only blended once.
+            // The diagonal of the triangles passes through pixel centers.
+            auto render = Render::create(_context);
+            const image::Color4f color(1.F, 1.F, 1.F, .5F);
+            const image::Color4f result(.5F, .5F, .5F, .75F);
+            begin(render);
+            geom::TriangleMesh2 mesh;
+            mesh.v.push_back(math::Vector2f(0.F, 0.F));
+            mesh.v.push_back(math::Vector2f(8.F, 0.F));
+            mesh.v.push_back(math::Vector2f(8.F, 8.F));
+            mesh.v.push_back(math::Vector2f(0.F, 8.F));
+            geom::Triangle2 triangle;
+            triangle.v[0].v = 1;
+            triangle.v[1].v = 2;
+            triangle.v[2].v = 4;
+            mesh.triangles.push_back(triangle);
+            triangle.v[0].v = 2;
+            triangle.v[1].v = 3;
+            triangle.v[2].v = 4;
+            mesh.triangles.push_back(triangle);
+            render->drawMesh(mesh, math::Vector2i(), color);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    TLRENDER_ASSERT(isEqual(getPixel(render, x, y), result));
+                }
+            }
+
+            begin(render);
+            render->drawRect(math::Box2i(0, 0, 3, 8), color);
+            render->drawRect(math::Box2i(3, 0, 5, 4), color);
+            render->drawRect(math::Box2i(3, 4, 5, 4), color);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    TLRENDER_ASSERT(isEqual(getPixel(render, x, y), result));
+                }
+            }
+        }
+
+        void RenderTest::_blend()
+        {
+            auto render = Render::create(_context);
+            const image::Color4f background(0.F, 0.F, 1.F, 1.F);
+            const math::Box2i box(0, 0, 8, 8);
+
+            // Rectangles blend with the source alpha.
+            begin(render, background);
+            render->drawRect(box, image::Color4f(1.F, 0.F, 0.F, .25F));
+            render->end();
+            TLRENDER_ASSERT(isEqual(
+                getPixel(render, 4, 4),
+                image::Color4f(.25F, 0.F, .75F, .8125F)));
+
+            // Images use the alpha blend options.
+            const image::Color4f color(1.F, 0.F, 0.F, .25F);
+            const auto image = createImage(math::Size2i(1, 1), color);
+            const std::vector<std::pair<timeline::AlphaBlend, image::Color4f> >
+                data = {
+                    {timeline::AlphaBlend::kNone, color},
+                    {timeline::AlphaBlend::Straight,
+                     image::Color4f(.25F, 0.F, .75F, 1.F)},
+                    {timeline::AlphaBlend::Premultiplied,
+                     image::Color4f(1.F, 0.F, .75F, 1.F)}};
+            for (const auto& i : data)
+            {
+                timeline::ImageOptions imageOptions;
+                imageOptions.alphaBlend = i.first;
+                begin(render, background);
+                render->drawImage(
+                    image, box, image::Color4f(1.F, 1.F, 1.F), imageOptions);
+                render->end();
+                _print(string::Format("Alpha blend {0}: {1}")
+                           .arg(i.first)
+                           .arg(getPixel(render, 4, 4)));
+                TLRENDER_ASSERT(isEqual(getPixel(render, 4, 4), i.second));
+            }
+        }
+
+        void RenderTest::_image()
+        {
+            // The image rows are stored from the bottom up, red and green
+            // are on the top row.
+            auto render = Render::create(_context);
+            const image::Color4f red(1.F, 0.F, 0.F, 1.F);
+            const image::Color4f green(0.F, 1.F, 0.F, 1.F);
+            const image::Color4f blue(0.F, 0.F, 1.F, 1.F);
+            const image::Color4f white(1.F, 1.F, 1.F, 1.F);
+            const auto image =
+                createImage(math::Size2i(2, 2), {blue, white, red, green});
+            timeline::ImageOptions imageOptions;
+            imageOptions.imageFilters.minify = timeline::ImageFilter::Nearest;
+            imageOptions.imageFilters.magnify = timeline::ImageFilter::Nearest;
+            begin(render);
+            render->drawImage(
+                image, math::Box2i(0, 0, 8, 8), image::Color4f(1.F, 1.F, 1.F),
+                imageOptions);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    const image::Color4f& expected =
+                        y < 4 ? (x < 4 ? red : green) : (x < 4 ? blue : white);
+                    TLRENDER_ASSERT(isEqual(getPixel(render, x, y), expected));
+                }
+            }
+
+            // The color multiplies the image.
+            begin(render);
+            render->drawImage(
+                image, math::Box2i(2, 2, 4, 4), image::Color4f(.5F, .5F, .5F),
+                imageOptions);
+            render->end();
+            TLRENDER_ASSERT(isEqual(
+                getPixel(render, 2, 2), image::Color4f(.5F, 0.F, 0.F, 1.F)));
+            TLRENDER_ASSERT(isEqual(
+                getPixel(render, 5, 5), image::Color4f(.5F, .5F, .5F, 1.F)));
+            TLRENDER_ASSERT(isEqual(
+                getPixel(render, 1, 1), image::Color4f(0.F, 0.F, 0.F, 1.F)));
+        }
+
+        void RenderTest::_compare()
+        {
+            auto render = Render::create(_context);
+            const image::Color4f a(.75F, .5F, .25F, 1.F);
+            const image::Color4f b(.25F, .5F, 1.F, 1.F);
+            std::vector<timeline::VideoFrame> videoFrames(2);
+            videoFrames[0].size = image::Size(renderSize.w, renderSize.h);
+            videoFrames[0].layers.resize(1);
+            videoFrames[0].layers[0].image = createImage(renderSize, a);
+            videoFrames[1].size = image::Size(renderSize.w, renderSize.h);
+            videoFrames[1].layers.resize(1);
+            videoFrames[1].layers[0].image = createImage(renderSize, b);
+            const std::vector<math::Box2i> boxes = {
+                math::Box2i(0, 0, renderSize.w, renderSize.h),
+                math::Box2i(0, 0, renderSize.w, renderSize.h)};
+
+            const std::vector<
+                std::pair<timeline::CompareMode, image::Color4f> >
+                data = {
+                    {timeline::CompareMode::A, a},
+                    {timeline::CompareMode::B, b},
+                    // The overlay adds the alpha, the same as the GL
+                    // renderer with a floating point color buffer.
+                    {timeline::CompareMode::Overlay,
+                     image::Color4f(.5F, .5F, .625F, 1.5F)},
+                    {timeline::CompareMode::Difference,
+                     image::Color4f(.5F, 0.F, .75F, 1.F)}};
+            for (const auto& i : data)
+            {
+                timeline::CompareOptions compareOptions;
+                compareOptions.mode = i.first;
+                compareOptions.overlay = .5F;
+                begin(render);
+                render->drawVideo(videoFrames, boxes, {}, {}, compareOptions);
+                render->end();
+                for (int y = 0; y < renderSize.h; ++y)
+                {
+                    for (int x = 0; x < renderSize.w; ++x)
+                    {
+                        TLRENDER_ASSERT(
+                            isEqual(getPixel(render, x, y), i.second));
+                    }
+                }
+            }
+
+            // A vertical wipe through the center shows A on the left and B
+            // on the right.
+            timeline::CompareOptions compareOptions;
+            compareOptions.mode = timeline::CompareMode::Wipe;
+            compareOptions.wipeCenter = math::Vector2f(.5F, .5F);
+            compareOptions.wipeRotation = 0.F;
+            begin(render);
+            render->drawVideo(videoFrames, boxes, {}, {}, compareOptions);
+            render->end();
+            for (int y = 0; y < renderSize.h; ++y)
+            {
+                for (int x = 0; x < renderSize.w; ++x)
+                {
+                    TLRENDER_ASSERT(
+                        isEqual(getPixel(render, x, y), x < 4 ? a : b));
+                }
+            }
+        }
+    } // namespace timeline_cpu_tests
+} // namespace tl
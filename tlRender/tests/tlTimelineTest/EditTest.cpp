@@ -13,6 +13,9 @@
 #include <tlCore/StringFormat.h>
 
 #include <opentimelineio/clip.h>
+#include <opentimelineio/externalReference.h>
+
+#include <chrono>
 
 using namespace tl::timeline;
 
@@ -57,9 +60,79 @@ namespace tl
 
         void EditTest::run()
         {
+            _copy();
             _move();
         }
 
+        void EditTest::_copy()
+        {
+            // Copy a large synthetic timeline, and compare the time with a
+            // round trip through JSON.
+            otio::SerializableObject::Retainer<otio::Timeline> otioTimeline(
+                new otio::Timeline);
+            const size_t clipCount = 2000;
+            for (const auto& kind :
+                 {otio::Track::Kind::video, otio::Track::Kind::audio})
+            {
+                auto otioTrack = new otio::Track(kind, std::nullopt, kind);
+                otioTimeline->tracks()->append_child(otioTrack);
+                for (size_t i = 0; i < clipCount; ++i)
+                {
+                    otioTrack->append_child(new otio::Clip(
+                        string::Format("Clip {0}").arg(i),
+                        new otio::ExternalReference(
+                            string::Format("clip{0}.mov").arg(i),
+                            otime::TimeRange(
+                                otime::RationalTime(0.0, 24.0),
+                                otime::RationalTime(240.0, 24.0))),
+                        otime::TimeRange(
+                            otime::RationalTime(i % 24, 24.0),
+                            otime::RationalTime(24.0, 24.0))));
+                }
+            }
+            uint8_t memory[] = {1, 2, 3, 4};
+            auto otioTrack = otio::dynamic_retainer_cast<otio::Track>(
+                otioTimeline->tracks()->children()[0]);
+            otioTrack->append_child(new otio::Clip(
+                "Memory",
+                new RawMemoryReference("memory.ppm", memory, sizeof(memory)),
+                otime::TimeRange(
+                    otime::RationalTime(0.0, 24.0),
+                    otime::RationalTime(24.0, 24.0))));
+
+            auto t = std::chrono::steady_clock::now();
+            auto otioTimeline2 = copy(otioTimeline);
+            const std::chrono::duration<float> copyTime =
+                std::chrono::steady_clock::now() - t;
+
+            t = std::chrono::steady_clock::now();
+            otio::SerializableObject::Retainer<otio::Timeline> otioTimeline3(
+                dynamic_cast<otio::Timeline*>(otio::Timeline::from_json_string(
+                    otioTimeline->to_json_string())));
+            const std::chrono::duration<float> jsonTime =
+                std::chrono::steady_clock::now() - t;
+
+            _print(string::Format("Copy {0} clips: {1}ms, JSON: {2}ms")
+                       .arg(clipCount * 2 + 1)
+                       .arg(copyTime.count() * 1000.F)
+                       .arg(jsonTime.count() * 1000.F));
+            TLRENDER_ASSERT(otioTimeline2->is_equivalent_to(*otioTimeline3));
+            TLRENDER_ASSERT(
+                otioTimeline2->find_clips().size() == clipCount * 2 + 1);
+
+            // The in-memory data is copied, and the source timeline is left
+            // unchanged.
+            auto clip = getClip(otioTimeline2, 0, clipCount);
+            auto ref =
+                dynamic_cast<RawMemoryReference*>(clip->media_reference());
+            TLRENDER_ASSERT(ref);
+            TLRENDER_ASSERT(memory == ref->memory());
+            TLRENDER_ASSERT(sizeof(memory) == ref->memory_size());
+            TLRENDER_ASSERT(ref->metadata().empty());
+            clip = getClip(otioTimeline, 0, clipCount);
+            TLRENDER_ASSERT(clip->media_reference()->metadata().empty());
+        }
+
         void EditTest::_move()
         {
             {
@@ -227,8 +300,8 @@ namespace tl
                         otime::RationalTime(48000.0, 48000.0))));
 
                 std::vector<MoveData> moveData;
-                moveData.push_back({0, 2, 2, 0, 0, 0});
-                moveData.push_back({1, 2, 2, 1, 0, 0});
+                moveData.push_back({MoveType::Clip, 0, 2, 2, 0, 0, 0});
+                moveData.push_back({MoveType::Clip, 1, 2, 2, 1, 0, 0});
                 auto otioTimeline2 = move(otioTimeline, moveData);
                 TLRENDER_ASSERT(
                     "Video 2" == getChild(otioTimeline2, 0, 0)->name());
@@ -244,8 +317,8 @@ namespace tl
                     "Audio 1" == getChild(otioTimeline2, 1, 2)->name());
 
                 moveData.clear();
-                moveData.push_back({0, 1, 1, 0, 3, 3});
-                moveData.push_back({1, 1, 1, 1, 3, 3});
+                moveData.push_back({MoveType::Clip, 0, 1, 1, 0, 3, 3});
+                moveData.push_back({MoveType::Clip, 1, 1, 1, 1, 3, 3});
                 auto otioTimeline3 = move(otioTimeline2, moveData);
                 TLRENDER_ASSERT(
                     "Video 2" == getChild(otioTimeline3, 0, 0)->name());
@@ -296,13 +369,14 @@ namespace tl
                 TLRENDER_ASSERT(
                     "Video 0" == getChild(otioTimeline3, 0, 0)->name());
             }
-            for (const auto otio : {"SingleClip.otio", "SingleClipSeq.otio"})
+            for (const auto fileName :
+                 {"SingleClip.otio", "SingleClipSeq.otio"})
             {
                 for (const auto toMemoryReference :
                      {ToMemoryReference::Shared, ToMemoryReference::Raw})
                 {
-                    auto otioTimeline = timeline::create(
-                        file::Path(TLRENDER_SAMPLE_DATA, otio), _context);
+                    file::Path path(TLRENDER_SAMPLE_DATA, fileName);
+                    auto otioTimeline = timeline::create(path, _context);
                     auto track = dynamic_cast<otio::Track*>(
                         otioTimeline->tracks()->children()[0].value);
                     track->append_child(new otio::Clip(
@@ -370,10 +444,11 @@ namespace tl
                     }
                 }
             }
-            for (const auto otioz : {"SingleClip.otioz", "SingleClipSeq.otioz"})
+            for (const auto fileName :
+                 {"SingleClip.otioz", "SingleClipSeq.otioz"})
             {
-                auto otioTimeline = timeline::create(
-                    file::Path(TLRENDER_SAMPLE_DATA, otioz), _context);
+                file::Path path(TLRENDER_SAMPLE_DATA, fileName);
+                auto otioTimeline = timeline::create(path, _context);
                 auto track = dynamic_cast<otio::Track*>(
                     otioTimeline->tracks()->children()[0].value);
                 track->append_child(new otio::Clip(
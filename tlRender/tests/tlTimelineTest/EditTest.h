@@ -22,6 +22,7 @@ namespace tl
             void run() override;
 
         private:
+            void _copy();
             void _move();
         };
     } // namespace timeline_tests
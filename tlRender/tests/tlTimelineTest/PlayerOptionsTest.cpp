@@ -29,6 +29,12 @@ namespace tl
         }
 
         void PlayerOptionsTest::run()
+        {
+            _options();
+            _adaptiveReadAhead();
+        }
+
+        void PlayerOptionsTest::_options()
         {
             {
                 _enum<TimerMode>("TimerMode", getTimerModeEnums);
@@ -39,6 +45,14 @@ namespace tl
                 TLRENDER_ASSERT(v == v);
                 TLRENDER_ASSERT(v != PlayerCacheOptions());
             }
+            {
+                PlayerCacheOptions v;
+                v.adaptive = true;
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+                v = PlayerCacheOptions();
+                v.adaptiveMinimum = otime::RationalTime(2.0, 1.0);
+                TLRENDER_ASSERT(v != PlayerCacheOptions());
+            }
             {
                 PlayerOptions v;
                 v.timerMode = TimerMode::Audio;
@@ -46,5 +60,88 @@ namespace tl
                 TLRENDER_ASSERT(v != PlayerOptions());
             }
         }
+
+        void PlayerOptionsTest::_adaptiveReadAhead()
+        {
+            // A 100 second in/out range at 24 FPS.
+            const double rate = 24.0;
+            AdaptiveReadAheadState state;
+            state.inOutRange = otime::TimeRange(
+                otime::RationalTime(0.0, rate),
+                otime::RationalTime(2400.0, rate));
+            state.currentTime = otime::RationalTime(0.0, rate);
+            const otime::RationalTime readAhead(50.0, 1.0);
+            const otime::RationalTime readBehind(.5, 1.0);
+            const otime::RationalTime minimum(1.0, 1.0);
+            const auto get = [&](const AdaptiveReadAheadState& state)
+            {
+                const otime::RationalTime out = getAdaptiveReadAhead(
+                    readAhead, readBehind, minimum, state);
+                TLRENDER_ASSERT(rate == out.rate());
+                return out.value();
+            };
+
+            // The full read ahead is used when stopped and before the
+            // throughput is measured.
+            TLRENDER_ASSERT(1200.0 == get(state));
+            state.playback = Playback::Forward;
+            state.speed = rate;
+            TLRENDER_ASSERT(1200.0 == get(state));
+
+            // The read ahead is limited to what fits in the cache.
+            {
+                auto s = state;
+                s.videoCacheMax = 100;
+                TLRENDER_ASSERT(88.0 == get(s));
+                s.videoCacheMax = 10;
+                TLRENDER_ASSERT(1.0 == get(s));
+            }
+
+            // The I/O keeps up, only the minimum is read ahead.
+            state.decodeFPS = 48.0;
+            TLRENDER_ASSERT(24.0 == get(state));
+            state.speed = -rate;
+            TLRENDER_ASSERT(24.0 == get(state));
+            state.speed = 2.0 * rate;
+            TLRENDER_ASSERT(48.0 == get(state));
+            {
+                auto s = state;
+                const otime::RationalTime zero(0.0, 1.0);
+                TLRENDER_ASSERT(
+                    1.0 ==
+                    getAdaptiveReadAhead(readAhead, readBehind, zero, s)
+                        .value());
+            }
+
+            // The whole in/out range fits, so it is all read ahead.
+            {
+                auto s = state;
+                s.inOutRange = otime::TimeRange(
+                    otime::RationalTime(0.0, rate),
+                    otime::RationalTime(240.0, rate));
+                TLRENDER_ASSERT(1200.0 == get(s));
+            }
+
+            // The I/O falls behind at half speed, half of the rest of the
+            // in/out range is read ahead.
+            state.speed = rate;
+            state.decodeFPS = 12.0;
+            TLRENDER_ASSERT(1199.0 == get(state));
+            state.currentTime = otime::RationalTime(1200.0, rate);
+            TLRENDER_ASSERT(599.0 == get(state));
+            state.playback = Playback::Reverse;
+            TLRENDER_ASSERT(600.0 == get(state));
+
+            // When looping the whole in/out range is played.
+            state.loop = true;
+            TLRENDER_ASSERT(1200.0 == get(state));
+
+            // The read ahead option is the maximum.
+            TLRENDER_ASSERT(
+                240.0 == getAdaptiveReadAhead(
+                             otime::RationalTime(10.0, 1.0), readBehind,
+                             minimum, state)
+                             .value());
+        }
     } // namespace timeline_tests
 } // namespace tl
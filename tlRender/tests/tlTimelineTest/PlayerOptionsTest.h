@@ -20,6 +20,10 @@ namespace tl
             create(const std::shared_ptr<system::Context>&);
 
             void run() override;
+
+        private:
+            void _options();
+            void _adaptiveReadAhead();
         };
     } // namespace timeline_tests
 } // namespace tl
@@ -61,6 +61,12 @@ namespace tl
             a.fileSequenceAudio = FileSequenceAudio::Directory;
             TLRENDER_ASSERT(a == a);
             TLRENDER_ASSERT(a != Options());
+            Options b;
+            b.readerCount = 1;
+            TLRENDER_ASSERT(b != Options());
+            b = Options();
+            b.readAheadClipCount = 0;
+            TLRENDER_ASSERT(b != Options());
         }
 
         void TimelineTest::_util() {}
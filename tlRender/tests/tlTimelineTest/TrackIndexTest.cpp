@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/TrackIndexTest.h>
+
+#include <tlTimeline/TrackIndex.h>
+
+#include <tlCore/Assert.h>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        TrackIndexTest::TrackIndexTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::TrackIndexTest", context)
+        {
+        }
+
+        std::shared_ptr<TrackIndexTest> TrackIndexTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<TrackIndexTest>(
+                new TrackIndexTest(context));
+        }
+
+        void TrackIndexTest::run()
+        {
+            _find();
+            _transitions();
+        }
+
+        namespace
+        {
+            otime::TimeRange range(double start, double duration)
+            {
+                return otime::TimeRange(
+                    otime::RationalTime(start, 24.0),
+                    otime::RationalTime(duration, 24.0));
+            }
+
+            int64_t find(const TrackIndex& index, double value)
+            {
+                return index.find(otime::RationalTime(value, 24.0));
+            }
+
+            // Find the first range that contains the time by checking all
+            // of them.
+            int64_t findLinear(
+                const std::vector<otime::TimeRange>& ranges, double value)
+            {
+                const otime::RationalTime time(value, 24.0);
+                for (size_t i = 0; i < ranges.size(); ++i)
+                {
+                    if (ranges[i].contains(time))
+                        return i;
+                }
+                return -1;
+            }
+        } // namespace
+
+        void TrackIndexTest::_find()
+        {
+            {
+                const TrackIndex index;
+                TLRENDER_ASSERT(0 == index.getSize());
+                TLRENDER_ASSERT(-1 == find(index, 0.0));
+            }
+            {
+                // Clips and a gap.
+                const TrackIndex index(
+                    {range(0.0, 10.0), range(10.0, 5.0), range(15.0, 1.0),
+                     range(16.0, 20.0)});
+                TLRENDER_ASSERT(4 == index.getSize());
+                TLRENDER_ASSERT(-1 == find(index, -1.0));
+                TLRENDER_ASSERT(0 == find(index, 0.0));
+                TLRENDER_ASSERT(0 == find(index, 9.0));
+                TLRENDER_ASSERT(1 == find(index, 10.0));
+                TLRENDER_ASSERT(1 == find(index, 14.0));
+                TLRENDER_ASSERT(2 == find(index, 15.0));
+                TLRENDER_ASSERT(3 == find(index, 16.0));
+                TLRENDER_ASSERT(3 == find(index, 35.0));
+                TLRENDER_ASSERT(-1 == find(index, 36.0));
+            }
+            {
+                // Times in between the ranges.
+                const TrackIndex index({range(10.0, 5.0), range(20.0, 5.0)});
+                TLRENDER_ASSERT(-1 == find(index, 5.0));
+                TLRENDER_ASSERT(-1 == find(index, 17.0));
+                TLRENDER_ASSERT(1 == find(index, 20.0));
+            }
+        }
+
+        void TrackIndexTest::_transitions()
+        {
+            // A transition overlaps the clips on either side, and an empty
+            // range never contains a time.
+            const std::vector<otime::TimeRange> ranges = {
+                range(0.0, 10.0), range(8.0, 4.0), range(10.0, 10.0),
+                range(20.0, 0.0), range(20.0, 2.0), range(20.0, 10.0),
+                range(28.0, 0.0), range(30.0, 5.0)};
+            const TrackIndex index(ranges);
+            TLRENDER_ASSERT(0 == find(index, 8.0));
+            TLRENDER_ASSERT(1 == find(index, 10.0));
+            TLRENDER_ASSERT(2 == find(index, 12.0));
+            TLRENDER_ASSERT(4 == find(index, 20.0));
+            TLRENDER_ASSERT(5 == find(index, 22.0));
+            for (double i = -2.0; i < 40.0; i += .5)
+            {
+                TLRENDER_ASSERT(findLinear(ranges, i) == find(index, i));
+            }
+        }
+    } // namespace timeline_tests
+} // namespace tl
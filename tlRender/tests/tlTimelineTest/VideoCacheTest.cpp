@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineTest/VideoCacheTest.h>
+
+#include <tlTimeline/VideoCache.h>
+
+#include <tlCore/Assert.h>
+
+#include <limits>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        VideoCacheTest::VideoCacheTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("timeline_tests::VideoCacheTest", context)
+        {
+        }
+
+        std::shared_ptr<VideoCacheTest> VideoCacheTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<VideoCacheTest>(
+                new VideoCacheTest(context));
+        }
+
+        void VideoCacheTest::run()
+        {
+            _byteCount();
+            _priority();
+            _cache();
+            _evict();
+        }
+
+        namespace
+        {
+            const double rate = 24.0;
+
+            otime::RationalTime frame(double value)
+            {
+                return otime::RationalTime(value, rate);
+            }
+
+            // A video frame with a 4x4 RGBA image, 64 bytes.
+            std::vector<VideoFrame> createVideoFrames()
+            {
+                VideoFrame videoFrame;
+                videoFrame.layers.resize(1);
+                videoFrame.layers[0].image =
+                    image::Image::create(4, 4, image::PixelType::RGBA_U8);
+                return {videoFrame};
+            }
+
+            VideoCachePriority createPriority(
+                double currentTime, double readBehind, bool reverse = false)
+            {
+                VideoCachePriority out;
+                out.currentTime = frame(currentTime);
+                out.inOutRange = otime::TimeRange(frame(0.0), frame(100.0));
+                out.readBehind = frame(readBehind);
+                out.reverse = reverse;
+                return out;
+            }
+        } // namespace
+
+        void VideoCacheTest::_byteCount()
+        {
+            {
+                VideoFrame videoFrame;
+                TLRENDER_ASSERT(0 == getByteCount(videoFrame));
+            }
+            {
+                // Images shared by the layers are only counted once.
+                auto videoFrame = createVideoFrames()[0];
+                TLRENDER_ASSERT(64 == getByteCount(videoFrame));
+                videoFrame.layers[0].imageB = videoFrame.layers[0].image;
+                TLRENDER_ASSERT(64 == getByteCount(videoFrame));
+                videoFrame.layers.push_back(videoFrame.layers[0]);
+                TLRENDER_ASSERT(64 == getByteCount(videoFrame));
+                videoFrame.layers[1].imageB =
+                    image::Image::create(2, 2, image::PixelType::RGBA_U8);
+                TLRENDER_ASSERT(80 == getByteCount(videoFrame));
+            }
+            {
+                // Planar images are counted with the line padding.
+                std::vector<uint8_t> data(96);
+                const uint8_t* planes[3] = {
+                    data.data(), data.data() + 64, data.data() + 80};
+                const int lineSize[3] = {16, 8, 8};
+                VideoFrame videoFrame;
+                videoFrame.layers.resize(1);
+                videoFrame.layers[0].image = image::Image::create(
+                    image::Info(8, 4, image::PixelType::YUV_420P_U8), nullptr,
+                    planes, lineSize);
+                TLRENDER_ASSERT(96 == getByteCount(videoFrame));
+            }
+        }
+
+        void VideoCacheTest::_priority()
+        {
+            // The frames ahead of the current time come first, then the
+            // frames reached by looping, then the read behind frames.
+            VideoCachePriority priority;
+            const auto get = [&priority](double value)
+            { return getVideoCachePriority(frame(value), priority); };
+            {
+                priority = createPriority(50.0, 10.0);
+                TLRENDER_ASSERT(0.0 == get(50.0));
+                TLRENDER_ASSERT(49.0 == get(99.0));
+                TLRENDER_ASSERT(50.0 == get(0.0));
+                TLRENDER_ASSERT(89.0 == get(39.0));
+                TLRENDER_ASSERT(105.0 == get(45.0));
+                TLRENDER_ASSERT(110.0 == get(40.0));
+                TLRENDER_ASSERT(
+                    std::numeric_limits<double>::max() == get(100.0));
+            }
+            {
+                priority = createPriority(50.0, 10.0, true);
+                TLRENDER_ASSERT(5.0 == get(45.0));
+                TLRENDER_ASSERT(89.0 == get(61.0));
+                TLRENDER_ASSERT(105.0 == get(55.0));
+            }
+        }
+
+        void VideoCacheTest::_cache()
+        {
+            VideoCache cache;
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+
+            const auto videoFrames = createVideoFrames();
+            cache.add(frame(0.0), videoFrames);
+            cache.add(frame(1.0), videoFrames);
+            TLRENDER_ASSERT(2 == cache.getCount());
+            TLRENDER_ASSERT(128 == cache.getByteCount());
+            TLRENDER_ASSERT(cache.contains(frame(0.0)));
+            std::vector<VideoFrame> value;
+            TLRENDER_ASSERT(cache.get(frame(1.0), value));
+            TLRENDER_ASSERT(videoFrames == value);
+            TLRENDER_ASSERT(!cache.get(frame(2.0), value));
+
+            // Replacing frames does not count them twice.
+            cache.add(frame(1.0), videoFrames);
+            TLRENDER_ASSERT(128 == cache.getByteCount());
+
+            cache.remove(frame(0.0));
+            TLRENDER_ASSERT(!cache.contains(frame(0.0)));
+            TLRENDER_ASSERT(64 == cache.getByteCount());
+            cache.remove(frame(0.0));
+            TLRENDER_ASSERT(64 == cache.getByteCount());
+
+            cache.clear();
+            TLRENDER_ASSERT(0 == cache.getCount());
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+        }
+
+        void VideoCacheTest::_evict()
+        {
+            const auto videoFrames = createVideoFrames();
+            {
+                // Fill a ten frame budget the way the player does: make
+                // room by evicting the frames that playback reaches after
+                // the requested one.
+                const size_t max = 10 * 64;
+                VideoCache cache;
+                auto priority = createPriority(0.0, 2.0);
+                const auto reserve = [&](double value)
+                {
+                    while (cache.getByteCount() + 64 > max)
+                    {
+                        if (!cache.evict(
+                                getVideoCachePriority(frame(value), priority),
+                                priority))
+                            return false;
+                    }
+                    cache.add(frame(value), videoFrames);
+                    return true;
+                };
+                for (double i = 0.0; i < 10.0; ++i)
+                {
+                    TLRENDER_ASSERT(reserve(i));
+                }
+                TLRENDER_ASSERT(!reserve(10.0));
+                TLRENDER_ASSERT(640 == cache.getByteCount());
+
+                // Playback moves ahead, the read behind frames that are the
+                // furthest from the current time are evicted first, then
+                // the frames that are only reached by looping.
+                priority.currentTime = frame(5.0);
+                TLRENDER_ASSERT(reserve(10.0));
+                TLRENDER_ASSERT(!cache.contains(frame(3.0)));
+                TLRENDER_ASSERT(reserve(11.0));
+                TLRENDER_ASSERT(!cache.contains(frame(4.0)));
+                TLRENDER_ASSERT(reserve(12.0));
+                TLRENDER_ASSERT(!cache.contains(frame(2.0)));
+                TLRENDER_ASSERT(640 == cache.getByteCount());
+
+                // Frames outside of the in/out range are evicted before
+                // anything else.
+                cache.add(frame(200.0), videoFrames);
+                TLRENDER_ASSERT(cache.evict(0.0, priority));
+                TLRENDER_ASSERT(!cache.contains(frame(200.0)));
+            }
+            {
+                // Only the frames next to the in/out points, the current
+                // time, and the read behind are checked. Compare with
+                // checking every frame.
+                for (int test = 0; test < 200; ++test)
+                {
+                    const auto priority = createPriority(
+                        (test * 37) % 100, (test * 7) % 20, test % 2);
+                    VideoCache cache;
+                    for (int i = -5; i < 105; ++i)
+                    {
+                        if ((i * 13 + test) % 3 != 0)
+                        {
+                            cache.add(frame(i), videoFrames);
+                        }
+                    }
+                    while (cache.getCount() > 0)
+                    {
+                        double highest = -1.0;
+                        for (const auto& i : cache.getFrames())
+                        {
+                            highest = std::max(
+                                highest,
+                                getVideoCachePriority(i.first, priority));
+                        }
+                        const auto frames = cache.getFrames();
+                        TLRENDER_ASSERT(cache.evict(-1.0, priority));
+                        for (const auto& i : frames)
+                        {
+                            if (!cache.contains(i.first))
+                            {
+                                TLRENDER_ASSERT(
+                                    highest ==
+                                    getVideoCachePriority(i.first, priority));
+                            }
+                        }
+                    }
+                    TLRENDER_ASSERT(!cache.evict(-1.0, priority));
+                }
+            }
+        }
+    } // namespace timeline_tests
+} // namespace tl
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        class VideoCacheTest : public tests::ITest
+        {
+        protected:
+            VideoCacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<VideoCacheTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _byteCount();
+            void _priority();
+            void _cache();
+            void _evict();
+        };
+    } // namespace timeline_tests
+} // namespace tl
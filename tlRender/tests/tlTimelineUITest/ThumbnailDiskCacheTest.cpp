@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include <tlTimelineUITest/ThumbnailDiskCacheTest.h>
+
+#include <tlTimelineUI/ThumbnailDiskCache.h>
+#include <tlTimelineUI/ThumbnailSystem.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace tl::TIMELINEUI;
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace timelineui_tests
+    {
+        ThumbnailDiskCacheTest::ThumbnailDiskCacheTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("timelineui_tests::ThumbnailDiskCacheTest", context)
+        {
+        }
+
+        std::shared_ptr<ThumbnailDiskCacheTest> ThumbnailDiskCacheTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<ThumbnailDiskCacheTest>(
+                new ThumbnailDiskCacheTest(context));
+        }
+
+        void ThumbnailDiskCacheTest::run()
+        {
+            _format();
+            _collisions();
+            _eviction();
+            _reload();
+            _keys();
+        }
+
+        namespace
+        {
+            const std::string fileHeader = "tlRender thumbnail cache 1";
+
+            // The image data is not compressible, so the files for images
+            // of the same size and keys of the same length are about the
+            // same size.
+            std::shared_ptr<image::Image> createImage(uint32_t seed)
+            {
+                auto out =
+                    image::Image::create(16, 16, image::PixelType::RGBA_U8);
+                uint8_t* p = out->getData();
+                for (size_t i = 0; i < out->getDataByteCount(); ++i)
+                {
+                    seed = seed * 1664525U + 1013904223U;
+                    p[i] = seed >> 24;
+                }
+                return out;
+            }
+
+            bool isEqual(
+                const std::shared_ptr<image::Image>& a,
+                const std::shared_ptr<image::Image>& b)
+            {
+                return a && b && a->getInfo() == b->getInfo() &&
+                       0 == std::memcmp(
+                                a->getData(), b->getData(),
+                                a->getDataByteCount());
+            }
+
+            std::string getFileName(
+                const std::string& dir, const std::string& key)
+            {
+                std::stringstream ss;
+                ss << dir << '/' << std::hex << std::setfill('0')
+                   << std::setw(16) << std::hash<std::string>()(key)
+                   << ".tlc";
+                return ss.str();
+            }
+
+            size_t getFileSize(const std::string& fileName)
+            {
+                std::error_code ec;
+                const auto out = fs::file_size(fileName, ec);
+                return ec ? 0 : out;
+            }
+
+            template <typename T>
+            void read(std::ifstream& f, T& value)
+            {
+                f.read(reinterpret_cast<char*>(&value), sizeof(T));
+            }
+        } // namespace
+
+        void ThumbnailDiskCacheTest::_format()
+        {
+            const std::string dir = file::createTempDir();
+            ThumbnailDiskCache cache;
+            TLRENDER_ASSERT(cache.getDir().empty());
+            const auto image = createImage(0);
+            cache.addThumbnail("thumbnail", image);
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+
+            cache.setDir(dir);
+            TLRENDER_ASSERT(dir == cache.getDir());
+            cache.addThumbnail("thumbnail", image);
+            const std::string fileName = getFileName(dir, "thumbnail");
+            TLRENDER_ASSERT(getFileSize(fileName) > 0);
+            TLRENDER_ASSERT(getFileSize(fileName) == cache.getByteCount());
+
+            // The file starts with the header, the entry type, and the key,
+            // followed by the uncompressed and compressed sizes, and then
+            // the compressed data.
+            {
+                std::ifstream f(fileName, std::ios::binary);
+                std::string header(fileHeader.size(), 0);
+                f.read(&header[0], header.size());
+                TLRENDER_ASSERT(fileHeader == header);
+                uint8_t type = 255;
+                read(f, type);
+                TLRENDER_ASSERT(0 == type);
+                uint32_t keySize = 0;
+                read(f, keySize);
+                TLRENDER_ASSERT(9 == keySize);
+                std::string key(keySize, 0);
+                f.read(&key[0], keySize);
+                TLRENDER_ASSERT("thumbnail" == key);
+                uint64_t size = 0;
+                uint64_t compressedSize = 0;
+                read(f, size);
+                read(f, compressedSize);
+                TLRENDER_ASSERT(
+                    sizeof(int32_t) * 3 + image->getDataByteCount() == size);
+                TLRENDER_ASSERT(
+                    fileHeader.size() + sizeof(type) + sizeof(keySize) +
+                        keySize + sizeof(size) + sizeof(compressedSize) +
+                        compressedSize ==
+                    getFileSize(fileName));
+                TLRENDER_ASSERT(f);
+            }
+
+            std::shared_ptr<image::Image> image2;
+            TLRENDER_ASSERT(cache.getThumbnail("thumbnail", image2));
+            TLRENDER_ASSERT(isEqual(image, image2));
+            TLRENDER_ASSERT(!cache.getThumbnail("missing", image2));
+
+            // Waveforms.
+            auto mesh = std::make_shared<geom::TriangleMesh2>();
+            mesh->v.push_back(math::Vector2f(0.F, 0.F));
+            mesh->v.push_back(math::Vector2f(1.F, 0.F));
+            mesh->v.push_back(math::Vector2f(1.F, 1.F));
+            mesh->c.push_back(math::Vector4f(1.F, .5F, .25F, 1.F));
+            geom::Triangle2 triangle;
+            triangle.v[0] = geom::Vertex2(1, 0, 1);
+            triangle.v[1] = geom::Vertex2(2, 0, 1);
+            triangle.v[2] = geom::Vertex2(3, 0, 1);
+            mesh->triangles.push_back(triangle);
+            cache.addWaveform("waveform", mesh);
+            std::shared_ptr<geom::TriangleMesh2> mesh2;
+            TLRENDER_ASSERT(cache.getWaveform("waveform", mesh2));
+            TLRENDER_ASSERT(mesh2);
+            TLRENDER_ASSERT(mesh->v == mesh2->v);
+            TLRENDER_ASSERT(mesh->c == mesh2->c);
+            TLRENDER_ASSERT(mesh2->t.empty());
+            TLRENDER_ASSERT(1 == mesh2->triangles.size());
+            for (size_t i = 0; i < 3; ++i)
+            {
+                TLRENDER_ASSERT(triangle.v[i].v == mesh2->triangles[0].v[i].v);
+                TLRENDER_ASSERT(triangle.v[i].t == mesh2->triangles[0].v[i].t);
+                TLRENDER_ASSERT(triangle.v[i].c == mesh2->triangles[0].v[i].c);
+            }
+
+            // Corrupt files are removed.
+            const std::string waveformFileName = getFileName(dir, "waveform");
+            const size_t byteCount = cache.getByteCount();
+            const size_t waveformByteCount = getFileSize(waveformFileName);
+            fs::resize_file(waveformFileName, waveformByteCount / 2);
+            TLRENDER_ASSERT(!cache.getWaveform("waveform", mesh2));
+            TLRENDER_ASSERT(!fs::exists(waveformFileName));
+            TLRENDER_ASSERT(
+                byteCount - waveformByteCount == cache.getByteCount());
+
+            // Disabling the cache.
+            cache.setDir(std::string());
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+            TLRENDER_ASSERT(!cache.getThumbnail("thumbnail", image2));
+            fs::remove_all(dir);
+        }
+
+        void ThumbnailDiskCacheTest::_collisions()
+        {
+            // Simulate a hash collision by copying the file for one key to
+            // the file name of another key.
+            const std::string dir = file::createTempDir();
+            const auto image = createImage(1);
+            {
+                ThumbnailDiskCache cache;
+                cache.setDir(dir);
+                cache.addThumbnail("a", image);
+            }
+            const std::string fileNameB = getFileName(dir, "b");
+            fs::copy_file(getFileName(dir, "a"), fileNameB);
+
+            ThumbnailDiskCache cache;
+            cache.setDir(dir);
+            std::shared_ptr<image::Image> image2;
+            TLRENDER_ASSERT(!cache.getThumbnail("b", image2));
+            TLRENDER_ASSERT(!image2);
+
+            // The file is left for the other key.
+            TLRENDER_ASSERT(fs::exists(fileNameB));
+            TLRENDER_ASSERT(cache.getThumbnail("a", image2));
+            TLRENDER_ASSERT(isEqual(image, image2));
+
+            // An entry of a different type is not returned.
+            std::shared_ptr<geom::TriangleMesh2> mesh;
+            TLRENDER_ASSERT(!cache.getWaveform("a", mesh));
+            TLRENDER_ASSERT(cache.getThumbnail("a", image2));
+            fs::remove_all(dir);
+        }
+
+        void ThumbnailDiskCacheTest::_eviction()
+        {
+            const std::string dir = file::createTempDir();
+            ThumbnailDiskCache cache;
+            cache.setDir(dir);
+            const auto imageA = createImage(2);
+            const auto imageB = createImage(3);
+            const auto imageC = createImage(4);
+            cache.addThumbnail("a", imageA);
+            cache.addThumbnail("b", imageB);
+            const size_t sizeA = getFileSize(getFileName(dir, "a"));
+            const size_t sizeB = getFileSize(getFileName(dir, "b"));
+            TLRENDER_ASSERT(sizeA + sizeB == cache.getByteCount());
+
+            // Room for two entries, "a" is used so "b" is the least recently
+            // used and is evicted.
+            const size_t max = sizeA + sizeB + 16;
+            cache.setMax(max);
+            TLRENDER_ASSERT(max == cache.getMax());
+            std::shared_ptr<image::Image> image;
+            TLRENDER_ASSERT(cache.getThumbnail("a", image));
+            cache.addThumbnail("c", imageC);
+            TLRENDER_ASSERT(cache.getByteCount() <= max);
+            TLRENDER_ASSERT(!fs::exists(getFileName(dir, "b")));
+            TLRENDER_ASSERT(!cache.getThumbnail("b", image));
+            TLRENDER_ASSERT(cache.getThumbnail("a", image));
+            TLRENDER_ASSERT(isEqual(imageA, image));
+            TLRENDER_ASSERT(cache.getThumbnail("c", image));
+            TLRENDER_ASSERT(isEqual(imageC, image));
+
+            // Lowering the maximum evicts entries.
+            cache.setMax(sizeA + 16);
+            TLRENDER_ASSERT(cache.getByteCount() <= sizeA + 16);
+            TLRENDER_ASSERT(!cache.getThumbnail("a", image));
+            TLRENDER_ASSERT(cache.getThumbnail("c", image));
+
+            // A zero maximum disables adding entries.
+            cache.setMax(0);
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+            cache.addThumbnail("a", imageA);
+            TLRENDER_ASSERT(0 == cache.getByteCount());
+            TLRENDER_ASSERT(!fs::exists(getFileName(dir, "a")));
+            fs::remove_all(dir);
+        }
+
+        void ThumbnailDiskCacheTest::_reload()
+        {
+            const std::string dir = file::createTempDir();
+            const auto imageA = createImage(5);
+            const auto imageB = createImage(6);
+            size_t byteCount = 0;
+            {
+                ThumbnailDiskCache cache;
+                cache.setDir(dir);
+                cache.addThumbnail("a", imageA);
+                cache.addThumbnail("b", imageB);
+                byteCount = cache.getByteCount();
+            }
+
+            // Files that are not cache entries are ignored.
+            {
+                std::ofstream f(dir + "/other.txt");
+                f << "other";
+            }
+
+            // The modification times give the least recently used order.
+            const auto now = fs::file_time_type::clock::now();
+            fs::last_write_time(
+                getFileName(dir, "a"), now - std::chrono::hours(1));
+            fs::last_write_time(getFileName(dir, "b"), now);
+            {
+                ThumbnailDiskCache cache;
+                cache.setDir(dir);
+                TLRENDER_ASSERT(byteCount == cache.getByteCount());
+                std::shared_ptr<image::Image> image;
+                TLRENDER_ASSERT(cache.getThumbnail("a", image));
+                TLRENDER_ASSERT(isEqual(imageA, image));
+                TLRENDER_ASSERT(cache.getThumbnail("b", image));
+                TLRENDER_ASSERT(isEqual(imageB, image));
+            }
+            fs::last_write_time(
+                getFileName(dir, "a"), now - std::chrono::hours(1));
+            fs::last_write_time(getFileName(dir, "b"), now);
+            {
+                ThumbnailDiskCache cache;
+                cache.setMax(getFileSize(getFileName(dir, "b")) + 16);
+                cache.setDir(dir);
+                TLRENDER_ASSERT(!fs::exists(getFileName(dir, "a")));
+                std::shared_ptr<image::Image> image;
+                TLRENDER_ASSERT(!cache.getThumbnail("a", image));
+                TLRENDER_ASSERT(cache.getThumbnail("b", image));
+                TLRENDER_ASSERT(fs::exists(dir + "/other.txt"));
+            }
+            fs::remove_all(dir);
+        }
+
+        void ThumbnailDiskCacheTest::_keys()
+        {
+            const std::string dir = file::createTempDir();
+            const auto write = [](const std::string& fileName, size_t size)
+            {
+                std::ofstream f(fileName, std::ios::binary);
+                f << std::string(size, 'x');
+            };
+            const otime::RationalTime time(1.0, 24.0);
+
+            // The key changes when the file is modified.
+            const file::Path path(dir, "image.ppm");
+            write(path.get(), 10);
+            const std::string key = ThumbnailCache::getThumbnailKey(
+                100, path, time, io::Options());
+            TLRENDER_ASSERT(
+                key == ThumbnailCache::getThumbnailKey(
+                           100, path, time, io::Options()));
+            write(path.get(), 20);
+            TLRENDER_ASSERT(
+                key != ThumbnailCache::getThumbnailKey(
+                           100, path, time, io::Options()));
+            const otime::TimeRange timeRange(time, time);
+            const std::string waveformKey = ThumbnailCache::getWaveformKey(
+                math::Size2i(100, 20), path, timeRange, io::Options());
+            write(path.get(), 30);
+            TLRENDER_ASSERT(
+                waveformKey != ThumbnailCache::getWaveformKey(
+                                   math::Size2i(100, 20), path, timeRange,
+                                   io::Options()));
+
+            // For sequences the key uses the file of the frame.
+            write(dir + "/render.0001.ppm", 10);
+            write(dir + "/render.0002.ppm", 10);
+            const file::Path sequence(dir, "render.0001.ppm");
+            const otime::RationalTime time2(2.0, 24.0);
+            const std::string key1 = ThumbnailCache::getThumbnailKey(
+                100, sequence, time, io::Options());
+            const std::string key2 = ThumbnailCache::getThumbnailKey(
+                100, sequence, time2, io::Options());
+            write(dir + "/render.0002.ppm", 20);
+            TLRENDER_ASSERT(
+                key1 == ThumbnailCache::getThumbnailKey(
+                            100, sequence, time, io::Options()));
+            TLRENDER_ASSERT(
+                key2 != ThumbnailCache::getThumbnailKey(
+                            100, sequence, time2, io::Options()));
+
+            // Thumbnails for files that can not be found are only cached in
+            // memory.
+            auto cache = ThumbnailCache::create(_context);
+            const std::string cacheDir = file::createTempDir();
+            cache->setDiskCacheDir(cacheDir);
+            const auto image = createImage(7);
+            const std::string missingKey = ThumbnailCache::getThumbnailKey(
+                100, file::Path(dir, "missing.ppm"), time, io::Options());
+            cache->addThumbnail(missingKey, image);
+            TLRENDER_ASSERT(0 == cache->getDiskCacheByteCount());
+            std::shared_ptr<image::Image> image2;
+            TLRENDER_ASSERT(cache->getThumbnail(missingKey, image2));
+            cache->addThumbnail(key1, image);
+            TLRENDER_ASSERT(cache->getDiskCacheByteCount() > 0);
+            fs::remove_all(cacheDir);
+            fs::remove_all(dir);
+        }
+    } // namespace timelineui_tests
+} // namespace tl
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace timelineui_tests
+    {
+        class ThumbnailDiskCacheTest : public tests::ITest
+        {
+        protected:
+            ThumbnailDiskCacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<ThumbnailDiskCacheTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _format();
+            void _collisions();
+            void _eviction();
+            void _reload();
+            void _keys();
+        };
+    } // namespace timelineui_tests
+} // namespace tl
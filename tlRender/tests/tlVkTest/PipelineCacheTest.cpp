@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#include <tlVkTest/PipelineCacheTest.h>
+
+#include <tlVk/PipelineCache.h>
+
+#include <tlCore/Assert.h>
+#include <tlCore/File.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace tl::vlk;
+
+namespace fs = std::filesystem;
+
+namespace tl
+{
+    namespace vlk_tests
+    {
+        PipelineCacheTest::PipelineCacheTest(
+            const std::shared_ptr<system::Context>& context) :
+            ITest("vlk_tests::PipelineCacheTest", context)
+        {
+        }
+
+        std::shared_ptr<PipelineCacheTest> PipelineCacheTest::create(
+            const std::shared_ptr<system::Context>& context)
+        {
+            return std::shared_ptr<PipelineCacheTest>(
+                new PipelineCacheTest(context));
+        }
+
+        void PipelineCacheTest::run()
+        {
+            _format();
+            _validation();
+            _readWrite();
+        }
+
+        namespace
+        {
+            const std::string fileHeader = "tlRender Vulkan pipeline cache 1";
+
+            //! Size of VkPipelineCacheHeaderVersionOne.
+            const uint32_t vkHeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+
+            VkPhysicalDeviceProperties createProps()
+            {
+                VkPhysicalDeviceProperties out;
+                std::memset(&out, 0, sizeof(out));
+                out.driverVersion = 7;
+                out.vendorID = 0x10de;
+                out.deviceID = 0x1234;
+                for (uint8_t i = 0; i < VK_UUID_SIZE; ++i)
+                {
+                    out.pipelineCacheUUID[i] = i;
+                }
+                return out;
+            }
+
+            // Create pipeline cache data the way the driver does, with the
+            // Vulkan header followed by the driver's own data.
+            std::vector<uint8_t> createData(
+                const VkPhysicalDeviceProperties& props, size_t size,
+                uint32_t version = VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+            {
+                std::vector<uint8_t> out(vkHeaderSize + size);
+                const uint32_t header[4] = {
+                    vkHeaderSize, version, props.vendorID, props.deviceID};
+                std::memcpy(out.data(), header, sizeof(header));
+                std::memcpy(
+                    out.data() + sizeof(header), props.pipelineCacheUUID,
+                    VK_UUID_SIZE);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    out[vkHeaderSize + i] = static_cast<uint8_t>(i * 7);
+                }
+                return out;
+            }
+
+            // Write a file without any checks.
+            void writeFile(
+                const std::string& fileName, const std::string& header,
+                uint32_t driverVersion, uint64_t size,
+                const std::vector<uint8_t>& data)
+            {
+                std::ofstream f(fileName, std::ios::binary);
+                f.write(header.data(), header.size());
+                f.write(
+                    reinterpret_cast<const char*>(&driverVersion),
+                    sizeof(driverVersion));
+                f.write(reinterpret_cast<const char*>(&size), sizeof(size));
+                f.write(
+                    reinterpret_cast<const char*>(data.data()), data.size());
+            }
+
+            std::vector<uint8_t> readFile(const std::string& fileName)
+            {
+                std::ifstream f(fileName, std::ios::binary);
+                return std::vector<uint8_t>(
+                    std::istreambuf_iterator<char>(f),
+                    std::istreambuf_iterator<char>());
+            }
+        } // namespace
+
+        void PipelineCacheTest::_format()
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName = dir + "/cache/pipeline_cache.bin";
+            const auto props = createProps();
+            const auto data = createData(props, 100);
+            TLRENDER_ASSERT(writePipelineCache(fileName, props, data));
+
+            // The file has the text header, the driver version, the size of
+            // the data, and the data.
+            const auto file = readFile(fileName);
+            const size_t headerSize =
+                fileHeader.size() + sizeof(uint32_t) + sizeof(uint64_t);
+            TLRENDER_ASSERT(headerSize + data.size() == file.size());
+            TLRENDER_ASSERT(
+                0 == std::memcmp(
+                         file.data(), fileHeader.data(), fileHeader.size()));
+            uint32_t driverVersion = 0;
+            std::memcpy(
+                &driverVersion, file.data() + fileHeader.size(),
+                sizeof(driverVersion));
+            TLRENDER_ASSERT(props.driverVersion == driverVersion);
+            uint64_t size = 0;
+            std::memcpy(
+                &size, file.data() + fileHeader.size() + sizeof(uint32_t),
+                sizeof(size));
+            TLRENDER_ASSERT(data.size() == size);
+            TLRENDER_ASSERT(
+                0 == std::memcmp(
+                         file.data() + headerSize, data.data(), data.size()));
+
+            // The temporary file is renamed.
+            size_t count = 0;
+            for (const auto& i : fs::directory_iterator(dir + "/cache"))
+            {
+                TLRENDER_ASSERT(i.path().filename() == "pipeline_cache.bin");
+                ++count;
+            }
+            TLRENDER_ASSERT(1 == count);
+
+            fs::remove_all(dir);
+        }
+
+        void PipelineCacheTest::_validation()
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName = dir + "/pipeline_cache.bin";
+            const auto props = createProps();
+            const auto data = createData(props, 100);
+            TLRENDER_ASSERT(writePipelineCache(fileName, props, data));
+            TLRENDER_ASSERT(data == readPipelineCache(fileName, props));
+
+            // The file is not used with a different driver or device.
+            {
+                auto other = props;
+                ++other.driverVersion;
+                TLRENDER_ASSERT(readPipelineCache(fileName, other).empty());
+            }
+            {
+                auto other = props;
+                ++other.vendorID;
+                TLRENDER_ASSERT(readPipelineCache(fileName, other).empty());
+            }
+            {
+                auto other = props;
+                ++other.deviceID;
+                TLRENDER_ASSERT(readPipelineCache(fileName, other).empty());
+            }
+            for (size_t i = 0; i < VK_UUID_SIZE; i += 5)
+            {
+                auto other = props;
+                other.pipelineCacheUUID[i] ^= 0xff;
+                TLRENDER_ASSERT(readPipelineCache(fileName, other).empty());
+            }
+
+            // The Vulkan header must be valid.
+            {
+                writePipelineCache(fileName, props, createData(props, 10, 2));
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+            {
+                auto other = data;
+                const uint32_t headerSize = vkHeaderSize - 1;
+                std::memcpy(other.data(), &headerSize, sizeof(headerSize));
+                writePipelineCache(fileName, props, other);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+            {
+                auto other = data;
+                const uint32_t headerSize = other.size() + 1;
+                std::memcpy(other.data(), &headerSize, sizeof(headerSize));
+                writePipelineCache(fileName, props, other);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+            {
+                const std::vector<uint8_t> other(
+                    data.begin(), data.begin() + vkHeaderSize - 1);
+                writePipelineCache(fileName, props, other);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+            {
+                writePipelineCache(fileName, props, std::vector<uint8_t>());
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+
+            // The file header must be valid.
+            {
+                writeFile(
+                    fileName, "tlRender Vulkan pipeline cache 0",
+                    props.driverVersion, data.size(), data);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+                writeFile(
+                    fileName, fileHeader, props.driverVersion, data.size(),
+                    data);
+                TLRENDER_ASSERT(data == readPipelineCache(fileName, props));
+            }
+            {
+                // Truncated.
+                writeFile(
+                    fileName, fileHeader, props.driverVersion,
+                    data.size() + 1, data);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+                writeFile(fileName, fileHeader.substr(0, 10), 0, 0, {});
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+            {
+                // Too large.
+                writeFile(
+                    fileName, fileHeader, props.driverVersion,
+                    uint64_t(1) << 40, data);
+                TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+            }
+
+            fs::remove_all(dir);
+        }
+
+        void PipelineCacheTest::_readWrite()
+        {
+            const std::string dir = file::createTempDir();
+            const std::string fileName = dir + "/pipeline_cache.bin";
+            const auto props = createProps();
+
+            TLRENDER_ASSERT(readPipelineCache(fileName, props).empty());
+
+            const auto data = createData(props, 1000);
+            TLRENDER_ASSERT(writePipelineCache(fileName, props, data));
+            TLRENDER_ASSERT(data == readPipelineCache(fileName, props));
+
+            // Writing replaces the file.
+            const auto data2 = createData(props, 10);
+            TLRENDER_ASSERT(writePipelineCache(fileName, props, data2));
+            TLRENDER_ASSERT(data2 == readPipelineCache(fileName, props));
+
+            // The file is not written where the directory can not be
+            // created.
+            const std::string fileName2 = fileName + "/pipeline_cache.bin";
+            TLRENDER_ASSERT(!writePipelineCache(fileName2, props, data));
+            TLRENDER_ASSERT(readPipelineCache(fileName2, props).empty());
+            TLRENDER_ASSERT(data2 == readPipelineCache(fileName, props));
+
+            fs::remove_all(dir);
+        }
+    } // namespace vlk_tests
+} // namespace tl
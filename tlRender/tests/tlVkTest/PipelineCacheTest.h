@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2025-Present Gonzalo Garramuño
+// All rights reserved.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace vlk_tests
+    {
+        class PipelineCacheTest : public tests::ITest
+        {
+        protected:
+            PipelineCacheTest(const std::shared_ptr<system::Context>&);
+
+        public:
+            static std::shared_ptr<PipelineCacheTest>
+            create(const std::shared_ptr<system::Context>&);
+
+            void run() override;
+
+        private:
+            void _format();
+            void _validation();
+            void _readWrite();
+        };
+    } // namespace vlk_tests
+} // namespace tl
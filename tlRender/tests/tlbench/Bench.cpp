@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include "Bench.h"
+
+#include <tlTimeline/Player.h>
+#include <tlTimeline/Timeline.h>
+
+#include <tlIO/Cache.h>
+#include <tlIO/DPX.h>
+#include <tlIO/System.h>
+#if defined(TLRENDER_FFMPEG)
+#    include <tlIO/FFmpeg.h>
+#endif // TLRENDER_FFMPEG
+#if defined(TLRENDER_EXR)
+#    include <tlIO/OpenEXR.h>
+#endif // TLRENDER_EXR
+#if defined(TLRENDER_TIFF)
+#    include <tlIO/TIFF.h>
+#endif // TLRENDER_TIFF
+
+#include <tlCore/Context.h>
+#include <tlCore/File.h>
+#include <tlCore/Time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace tl
+{
+    namespace bench
+    {
+        namespace
+        {
+            typedef std::chrono::steady_clock Clock;
+
+            double seconds(const Clock::time_point& t)
+            {
+                const std::chrono::duration<double> diff = Clock::now() - t;
+                return diff.count();
+            }
+
+            void fill(const std::shared_ptr<image::Image>& image, size_t frame)
+            {
+                // Keep every byte below 0x40 so that half and float pixel
+                // types never contain infinities or NaNs.
+                uint8_t* data = image->getData();
+                const size_t byteCount = image->getDataByteCount();
+                const size_t width = std::max(
+                    static_cast<size_t>(image->getWidth()), size_t(1));
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    data[i] = static_cast<uint8_t>(
+                        ((i % width) * 7 + (i / width) * 3 + frame) & 0x3f);
+                }
+            }
+
+            template <typename T>
+            void generate(
+                const std::string& name, const std::string& fileName,
+                bool sequence, const image::PixelType pixelType,
+                const io::Options& ioOptions, const Options& options,
+                const std::shared_ptr<system::Context>& context,
+                std::vector<Media>& out)
+            {
+                auto ioSystem = context->getSystem<io::System>();
+                auto plugin = ioSystem->getPlugin<T>();
+                if (!plugin)
+                    return;
+                const auto imageInfo = plugin->getWriteInfo(
+                    image::Info(options.size, pixelType), ioOptions);
+                if (!imageInfo.isValid())
+                    return;
+
+                Media media;
+                media.name = name;
+                media.path = file::Path(options.tempDir, fileName);
+                media.info = imageInfo;
+
+                io::Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = otime::TimeRange(
+                    otime::RationalTime(0.0, options.rate),
+                    otime::RationalTime(options.frames, options.rate));
+                auto image = image::Image::create(imageInfo);
+                const auto t = Clock::now();
+                {
+                    auto write = plugin->write(media.path, info, ioOptions);
+                    for (size_t i = 0; i < options.frames; ++i)
+                    {
+                        fill(image, i);
+                        write->writeVideo(
+                            otime::RationalTime(i, options.rate), image,
+                            ioOptions);
+                    }
+                }
+                media.writeSeconds = seconds(t);
+                if (sequence)
+                {
+                    media.path.setFrames(math::Int64Range(
+                        0, static_cast<int64_t>(options.frames) - 1));
+                }
+                out.push_back(media);
+            }
+
+            bool hasImage(const std::vector<timeline::VideoFrame>& frames)
+            {
+                return !frames.empty() && !frames.front().layers.empty() &&
+                       frames.front().layers.front().image;
+            }
+
+            nlohmann::json latency(std::vector<double>& values)
+            {
+                nlohmann::json out;
+                if (!values.empty())
+                {
+                    std::sort(values.begin(), values.end());
+                    double sum = 0.0;
+                    for (const auto value : values)
+                    {
+                        sum += value;
+                    }
+                    out["meanUs"] = sum / values.size() * 1000000.0;
+                    out["medianUs"] = values[values.size() / 2] * 1000000.0;
+                    out["p99Us"] =
+                        values[std::min(
+                            values.size() - 1, values.size() * 99 / 100)] *
+                        1000000.0;
+                    out["maxUs"] = values.back() * 1000000.0;
+                }
+                return out;
+            }
+
+            nlohmann::json play(
+                const std::shared_ptr<timeline::Player>& player,
+                timeline::Playback playback, const Options& options)
+            {
+                const auto& timeRange = player->getTimeRange();
+                player->seek(
+                    timeline::Playback::Forward == playback
+                        ? timeRange.start_time()
+                        : timeRange.end_time_inclusive());
+                player->setPlayback(playback);
+
+                size_t frames = 0;
+                size_t dropped = 0;
+                otime::RationalTime prev = time::invalidTime;
+                const auto t = Clock::now();
+                double elapsed = 0.0;
+                while ((elapsed = seconds(t)) < options.playSeconds)
+                {
+                    player->tick();
+                    const auto& currentVideo = player->getCurrentVideo();
+                    if (hasImage(currentVideo))
+                    {
+                        const auto& current = currentVideo.front().time;
+                        if (current != prev)
+                        {
+                            ++frames;
+                            if (time::isValid(prev))
+                            {
+                                // Frames that were skipped count as dropped,
+                                // ignoring the jump when the player loops.
+                                const double step =
+                                    std::abs(current.value() - prev.value());
+                                if (step > 1.0 &&
+                                    step < timeRange.duration().value() - 1.0)
+                                {
+                                    dropped +=
+                                        static_cast<size_t>(step - 1.0);
+                                }
+                            }
+                            prev = current;
+                        }
+                    }
+                    time::sleep(std::chrono::microseconds(500));
+                }
+                player->setPlayback(timeline::Playback::Stop);
+
+                nlohmann::json out;
+                out["frames"] = frames;
+                out["dropped"] = dropped;
+                out["fps"] = elapsed > 0.0 ? frames / elapsed : 0.0;
+                return out;
+            }
+        } // namespace
+
+        std::vector<Media> generateMedia(
+            const Options& options,
+            const std::shared_ptr<system::Context>& context)
+        {
+            std::vector<Media> out;
+            generate<dpx::Plugin>(
+                "DPX", "bench_dpx.0000.dpx", true, image::PixelType::RGB_U10,
+                io::Options(), options, context, out);
+#if defined(TLRENDER_EXR)
+            generate<exr::Plugin>(
+                "OpenEXR", "bench_exr.0000.exr", true,
+                image::PixelType::RGBA_F16, io::Options(), options, context,
+                out);
+#endif // TLRENDER_EXR
+#if defined(TLRENDER_TIFF)
+            generate<tiff::Plugin>(
+                "TIFF", "bench_tiff.0000.tif", true, image::PixelType::RGB_U16,
+                io::Options(), options, context, out);
+#endif // TLRENDER_TIFF
+#if defined(TLRENDER_FFMPEG)
+            generate<ffmpeg::Plugin>(
+                "FFmpeg H264", "bench_h264.mp4", false,
+                image::PixelType::RGB_U8, {{"FFmpeg/WriteProfile", "H264"}},
+                options, context, out);
+            generate<ffmpeg::Plugin>(
+                "FFmpeg ProRes", "bench_prores.mov", false,
+                image::PixelType::RGB_U8, {{"FFmpeg/WriteProfile", "ProRes"}},
+                options, context, out);
+#endif // TLRENDER_FFMPEG
+            return out;
+        }
+
+        nlohmann::json benchDecode(
+            const Media& media, const Options& options,
+            const std::shared_ptr<system::Context>& context)
+        {
+            nlohmann::json out;
+            auto ioSystem = context->getSystem<io::System>();
+            const auto plugin = ioSystem->getPlugin(media.path);
+            if (!plugin)
+                return out;
+
+            // Decode one frame at a time, which measures the per-frame
+            // latency.
+            {
+                auto read = plugin->read(media.path);
+                const auto info = read->getInfo().get();
+                const double start = info.videoTime.start_time().value();
+                std::vector<double> values;
+                const auto t = Clock::now();
+                for (size_t i = 0; i < options.frames; ++i)
+                {
+                    const auto t2 = Clock::now();
+                    const auto videoData =
+                        read->readVideo(
+                                otime::RationalTime(start + i, options.rate))
+                            .get();
+                    values.push_back(seconds(t2));
+                }
+                const double elapsed = seconds(t);
+                out["serialFps"] =
+                    elapsed > 0.0 ? options.frames / elapsed : 0.0;
+                out["frame"] = latency(values);
+            }
+
+            // Request every frame up front so the reader can decode in
+            // parallel.
+            {
+                auto read = plugin->read(media.path);
+                const auto info = read->getInfo().get();
+                const double start = info.videoTime.start_time().value();
+                const auto t = Clock::now();
+                std::vector<std::future<io::VideoData> > futures;
+                for (size_t i = 0; i < options.frames; ++i)
+                {
+                    futures.push_back(read->readVideo(
+                        otime::RationalTime(start + i, options.rate)));
+                }
+                size_t count = 0;
+                for (auto& future : futures)
+                {
+                    if (future.get().image)
+                    {
+                        ++count;
+                    }
+                }
+                const double elapsed = seconds(t);
+                out["parallelFps"] = elapsed > 0.0 ? count / elapsed : 0.0;
+                out["decoded"] = count;
+            }
+            return out;
+        }
+
+        nlohmann::json benchCache(
+            const Media& media, const Options& options,
+            const std::shared_ptr<system::Context>& context)
+        {
+            nlohmann::json out;
+            auto ioSystem = context->getSystem<io::System>();
+            const auto plugin = ioSystem->getPlugin(media.path);
+            if (!plugin)
+                return out;
+
+            auto read = plugin->read(media.path);
+            const auto info = read->getInfo().get();
+            const double start = info.videoTime.start_time().value();
+            auto cache = io::Cache::create();
+            cache->setMax(std::numeric_limits<size_t>::max());
+            std::vector<io::CacheKey> keys;
+            for (size_t i = 0; i < options.frames; ++i)
+            {
+                const otime::RationalTime time(start + i, options.rate);
+                const auto key = io::getVideoCacheKey(
+                    media.path, time, io::Options(), io::Options());
+                cache->addVideo(key, read->readVideo(time).get());
+                keys.push_back(key);
+            }
+
+            std::vector<double> hits;
+            std::vector<double> misses;
+            io::VideoData videoData;
+            for (size_t i = 0; i < options.cacheLookups; ++i)
+            {
+                const auto& key = keys[i % keys.size()];
+                auto t = Clock::now();
+                cache->getVideo(key, videoData);
+                hits.push_back(seconds(t));
+
+                const auto missKey = io::getVideoCacheKey(
+                    media.path,
+                    otime::RationalTime(
+                        start + options.frames + i, options.rate),
+                    io::Options(), io::Options());
+                t = Clock::now();
+                cache->getVideo(missKey, videoData);
+                misses.push_back(seconds(t));
+            }
+            out["hit"] = latency(hits);
+            out["miss"] = latency(misses);
+            return out;
+        }
+
+        nlohmann::json benchPlayer(
+            const Media& media, const Options& options,
+            const std::shared_ptr<system::Context>& context)
+        {
+            nlohmann::json out;
+            file::Path path = media.path;
+            const auto t = Clock::now();
+            auto timeline = timeline::Timeline::create(path, context);
+            auto player = timeline::Player::create(timeline, context);
+            if (options.speed > 0.0)
+            {
+                player->setSpeed(options.speed);
+            }
+            while (!hasImage(player->getCurrentVideo()) && seconds(t) < 10.0)
+            {
+                player->tick();
+                time::sleep(std::chrono::microseconds(100));
+            }
+            out["firstFrameMs"] = seconds(t) * 1000.0;
+            out["speed"] = player->getSpeed();
+            out["forward"] = play(player, timeline::Playback::Forward, options);
+            out["reverse"] = play(player, timeline::Playback::Reverse, options);
+            return out;
+        }
+    } // namespace bench
+} // namespace tl
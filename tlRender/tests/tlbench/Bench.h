@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#pragma once
+
+#include <tlCore/Image.h>
+#include <tlCore/Path.h>
+
+#include <nlohmann/json.hpp>
+
+namespace tl
+{
+    namespace system
+    {
+        class Context;
+    }
+
+    namespace bench
+    {
+        //! Benchmark options.
+        struct Options
+        {
+            std::string tempDir;
+            image::Size size = image::Size(1920, 1080);
+            size_t frames = 48;
+            double rate = 24.0;
+            double speed = 0.0;
+            float playSeconds = 3.F;
+            size_t cacheLookups = 10000;
+        };
+
+        //! Synthetic media written for a benchmark run.
+        struct Media
+        {
+            std::string name;
+            file::Path path;
+            image::Info info;
+            double writeSeconds = 0.0;
+        };
+
+        //! Write synthetic media with each of the available plugins.
+        std::vector<Media> generateMedia(
+            const Options&, const std::shared_ptr<system::Context>&);
+
+        //! Measure decode throughput, both one frame at a time and with all
+        //! of the requests in flight at once.
+        nlohmann::json benchDecode(
+            const Media&, const Options&,
+            const std::shared_ptr<system::Context>&);
+
+        //! Measure I/O cache hit and miss latency.
+        nlohmann::json benchCache(
+            const Media&, const Options&,
+            const std::shared_ptr<system::Context>&);
+
+        //! Measure player time to first frame and the sustained frame rate
+        //! when playing forward and in reverse.
+        nlohmann::json benchPlayer(
+            const Media&, const Options&,
+            const std::shared_ptr<system::Context>&);
+    } // namespace bench
+} // namespace tl
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright (c) 2021-2024 Darby Johnston
+// All rights reserved.
+
+#include "Bench.h"
+
+#include <tlTimeline/Init.h>
+
+#include <tlCore/Context.h>
+#include <tlCore/File.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace tl;
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout
+            << "Usage: tlbench [options]\n"
+            << "\n"
+            << "Generate synthetic media with each available I/O plugin and\n"
+            << "measure decode throughput, cache latency, and playback.\n"
+            << "\n"
+            << "Options:\n"
+            << "  -o <file>        Write the JSON results to a file instead "
+               "of stdout.\n"
+            << "  -frames <n>      Number of frames to generate (48).\n"
+            << "  -size <w> <h>    Image size (1920 1080).\n"
+            << "  -seconds <s>     Playback time per direction (3).\n"
+            << "  -speed <fps>     Playback speed, 0 for the media rate "
+               "(0).\n"
+            << "  -lookups <n>     Number of cache lookups (10000).\n"
+            << "  -temp <dir>      Directory for the generated media.\n"
+            << "  -keep            Keep the generated media.\n";
+    }
+
+    void removeMedia(const bench::Media& media)
+    {
+        const auto& frames = media.path.getFrames();
+        if (frames.has_value())
+        {
+            for (int64_t i = frames->getMin(); i <= frames->getMax(); ++i)
+            {
+                file::rm(media.path.getFrame(i, true));
+            }
+        }
+        else
+        {
+            file::rm(media.path.get());
+        }
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    bench::Options options;
+    std::string output;
+    bool keep = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const int remaining = argc - i - 1;
+        if ("-o" == arg && remaining >= 1)
+        {
+            output = argv[++i];
+        }
+        else if ("-frames" == arg && remaining >= 1)
+        {
+            options.frames = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if ("-size" == arg && remaining >= 2)
+        {
+            options.size.w = std::atoi(argv[++i]);
+            options.size.h = std::atoi(argv[++i]);
+        }
+        else if ("-seconds" == arg && remaining >= 1)
+        {
+            options.playSeconds = std::atof(argv[++i]);
+        }
+        else if ("-speed" == arg && remaining >= 1)
+        {
+            options.speed = std::atof(argv[++i]);
+        }
+        else if ("-lookups" == arg && remaining >= 1)
+        {
+            options.cacheLookups = std::max(std::atoi(argv[++i]), 1);
+        }
+        else if ("-temp" == arg && remaining >= 1)
+        {
+            options.tempDir = argv[++i];
+        }
+        else if ("-keep" == arg)
+        {
+            keep = true;
+        }
+        else
+        {
+            printUsage();
+            return "-h" == arg || "-help" == arg ? 0 : 1;
+        }
+    }
+    bool removeTempDir = false;
+    if (options.tempDir.empty())
+    {
+        options.tempDir = file::createTempDir();
+        removeTempDir = !keep;
+    }
+    else
+    {
+        file::mkdir(options.tempDir);
+    }
+    if (!options.tempDir.empty() && options.tempDir.back() != '/' &&
+        options.tempDir.back() != '\\')
+    {
+        options.tempDir.push_back('/');
+    }
+
+    nlohmann::json json;
+    int r = 0;
+    try
+    {
+        auto context = system::Context::create();
+        timeline::init(context);
+        auto logObserver = observer::ListObserver<log::Item>::create(
+            context->getSystem<log::System>()->observeLog(),
+            [](const std::vector<log::Item>& value)
+            {
+                const size_t options =
+                    static_cast<size_t>(log::StringConvert::Time) |
+                    static_cast<size_t>(log::StringConvert::Prefix);
+                for (const auto& i : value)
+                {
+                    if (log::Type::Message != i.type)
+                    {
+                        std::cerr << "[LOG] " << toString(i, options)
+                                  << std::endl;
+                    }
+                }
+            },
+            observer::CallbackAction::Suppress);
+        context->tick();
+
+        json["version"] = TLRENDER_VERSION;
+        json["settings"]["frames"] = options.frames;
+        json["settings"]["width"] = options.size.w;
+        json["settings"]["height"] = options.size.h;
+        json["settings"]["rate"] = options.rate;
+        json["settings"]["playSeconds"] = options.playSeconds;
+        json["settings"]["cacheLookups"] = options.cacheLookups;
+
+        const auto media = bench::generateMedia(options, context);
+        for (const auto& i : media)
+        {
+            std::cerr << "Benchmarking: " << i.name << std::endl;
+            nlohmann::json item;
+            std::stringstream ss;
+            ss << i.info.pixelType;
+            item["pixelType"] = ss.str();
+            item["writeFps"] =
+                i.writeSeconds > 0.0 ? options.frames / i.writeSeconds : 0.0;
+            item["decode"] = bench::benchDecode(i, options, context);
+            context->tick();
+            item["cache"] = bench::benchCache(i, options, context);
+            context->tick();
+            item["player"] = bench::benchPlayer(i, options, context);
+            context->tick();
+            json["plugins"][i.name] = item;
+            if (!keep)
+            {
+                removeMedia(i);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        r = 1;
+    }
+    if (removeTempDir)
+    {
+        file::rmdir(options.tempDir);
+    }
+
+    if (output.empty())
+    {
+        std::cout << json.dump(4) << std::endl;
+    }
+    else
+    {
+        std::ofstream file(output);
+        file << json.dump(4) << std::endl;
+    }
+    return r;
+}
@@ -9,6 +9,14 @@
 #include <tlGLTest/TextureTest.h>
 #include <tlGL/Init.h>
 
+#include <tlTimelineUITest/ThumbnailDiskCacheTest.h>
+
+#if defined(TLRENDER_VK)
+#    include <tlVkTest/PipelineCacheTest.h>
+#endif // TLRENDER_VK
+
+#include <tlTimelineCPUTest/RenderTest.h>
+
 #include <tlTimelineTest/CompareOptionsTest.h>
 #include <tlTimelineTest/DisplayOptionsTest.h>
 #include <tlTimelineTest/EditTest.h>
@@ -20,14 +28,21 @@
 #include <tlTimelineTest/PlayerOptionsTest.h>
 #include <tlTimelineTest/PlayerTest.h>
 #include <tlTimelineTest/TimelineTest.h>
+#include <tlTimelineTest/TrackIndexTest.h>
 #include <tlTimelineTest/UtilTest.h>
+#include <tlTimelineTest/VideoCacheTest.h>
 
+#include <tlIOTest/CacheTest.h>
 #include <tlIOTest/CineonTest.h>
 #include <tlIOTest/DPXTest.h>
 #include <tlIOTest/IOTest.h>
+#include <tlIOTest/NormalizeTest.h>
 #include <tlIOTest/PPMTest.h>
 #include <tlIOTest/SGITest.h>
+#include <tlIOTest/ThreadPoolTest.h>
 #if defined(TLRENDER_FFMPEG)
+#    include <tlIOTest/FFmpegIndexTest.h>
+#    include <tlIOTest/FFmpegReadTest.h>
 #    include <tlIOTest/FFmpegTest.h>
 #endif // TLRENDER_FFMPEG
 #if defined(TLRENDER_JPEG)
@@ -135,20 +150,25 @@ void ioTests(
     std::vector<std::shared_ptr<tests::ITest> >& tests,
     const std::shared_ptr<system::Context>& context)
 {
+    tests.push_back(io_tests::CacheTest::create(context));
 //     tests.push_back(io_tests::CineonTest::create(context));
 //     tests.push_back(io_tests::DPXTest::create(context));
-//     tests.push_back(io_tests::IOTest::create(context));
+    tests.push_back(io_tests::IOTest::create(context));
 //     tests.push_back(io_tests::PPMTest::create(context));
 //     tests.push_back(io_tests::SGITest::create(context));
-// #if defined(TLRENDER_FFMPEG)
-//     tests.push_back(io_tests::FFmpegTest::create(context));
-// #endif // TLRENDER_FFMPEG
+    tests.push_back(io_tests::NormalizeTest::create(context));
+    tests.push_back(io_tests::ThreadPoolTest::create(context));
+#if defined(TLRENDER_FFMPEG)
+    tests.push_back(io_tests::FFmpegIndexTest::create(context));
+    tests.push_back(io_tests::FFmpegReadTest::create(context));
+    // tests.push_back(io_tests::FFmpegTest::create(context));
+#endif // TLRENDER_FFMPEG
 // #if defined(TLRENDER_JPEG)
 //     tests.push_back(io_tests::JPEGTest::create(context));
 // #endif // TLRENDER_JPEG
-// #if defined(TLRENDER_EXR)
-//     tests.push_back(io_tests::OpenEXRTest::create(context));
-// #endif // TLRENDER_EXR
+#if defined(TLRENDER_EXR)
+    tests.push_back(io_tests::OpenEXRTest::create(context));
+#endif // TLRENDER_EXR
 // #if defined(TLRENDER_PNG)
 //     tests.push_back(io_tests::PNGTest::create(context));
 // #endif // TLRENDER_PNG
@@ -166,16 +186,41 @@ void timelineTests(
 {
     // tests.push_back(timeline_tests::CompareOptionsTest::create(context));
     // tests.push_back(timeline_tests::DisplayOptionsTest::create(context));
-    // tests.push_back(timeline_tests::EditTest::create(context));
+    tests.push_back(timeline_tests::EditTest::create(context));
     // tests.push_back(timeline_tests::IRenderTest::create(context));
     // tests.push_back(timeline_tests::ImageOptionsTest::create(context));
     // tests.push_back(timeline_tests::LUTOptionsTest::create(context));
     // tests.push_back(timeline_tests::MemoryReferenceTest::create(context));
     // tests.push_back(timeline_tests::OCIOOptionsTest::create(context));
-    // tests.push_back(timeline_tests::PlayerOptionsTest::create(context));
+    tests.push_back(timeline_tests::PlayerOptionsTest::create(context));
     // tests.push_back(timeline_tests::PlayerTest::create(context));
     // tests.push_back(timeline_tests::TimelineTest::create(context));
+    tests.push_back(timeline_tests::TrackIndexTest::create(context));
     // tests.push_back(timeline_tests::UtilTest::create(context));
+    tests.push_back(timeline_tests::VideoCacheTest::create(context));
+}
+
+void timelineCPUTests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+    tests.push_back(timeline_cpu_tests::RenderTest::create(context));
+}
+
+void timelineUITests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+    tests.push_back(timelineui_tests::ThumbnailDiskCacheTest::create(context));
+}
+
+void vkTests(
+    std::vector<std::shared_ptr<tests::ITest> >& tests,
+    const std::shared_ptr<system::Context>& context)
+{
+#if defined(TLRENDER_VK)
+    tests.push_back(vlk_tests::PipelineCacheTest::create(context));
+#endif // TLRENDER_VK
 }
 
 void appTests(
@@ -187,7 +232,7 @@ void appTests(
 int main(int argc, char* argv[])
 {
     auto context = system::Context::create();
-    // timeline::init(context);
+    timeline::init(context);
 
     auto logObserver = observer::ListObserver<log::Item>::create(
         context->getSystem<log::System>()->observeLog(),
@@ -210,8 +255,11 @@ int main(int argc, char* argv[])
     // tests.push_back(timeline_tests::TimelineTest::create(context));
     coreTests(tests, context);
     // glTests(tests, context);
-    // ioTests(tests, context);
-    // timelineTests(tests, context);
+    ioTests(tests, context);
+    timelineTests(tests, context);
+    timelineCPUTests(tests, context);
+    timelineUITests(tests, context);
+    vkTests(tests, context);
 
     for (const auto& test : tests)
     {